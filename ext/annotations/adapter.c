@@ -85,6 +85,55 @@ static const zend_function_entry phalcon_annotations_adapter_method_entry[] = {
 	PHP_FE_END
 };
 
+/**
+ * Builds the collection of a single method or property straight from the reflection data,
+ * the rest of the members are neither mapped back nor wrapped in collections. The collection
+ * is kept in the reflection so asking again for the same member returns it
+ */
+static int phalcon_annotations_adapter_get_member(zval *return_value, zval *reflection, const char *built, uint32_t built_length, const char *cache, uint32_t cache_length, const char *section, uint32_t section_length, zval *name)
+{
+	zval annotations = {}, reflection_data = {}, members = {}, member = {}, member_annotations = {};
+	int flag;
+
+	if (!instanceof_function(Z_OBJCE_P(reflection), phalcon_annotations_reflection_ce)) {
+		return FAILURE;
+	}
+
+	/**
+	 * The collections are already built, reuse them
+	 */
+	phalcon_read_property(&annotations, reflection, built, built_length, PH_READONLY);
+	if (Z_TYPE(annotations) != IS_NULL) {
+		return FAILURE;
+	}
+
+	if (phalcon_read_property_array(return_value, reflection, cache, cache_length, name, PH_COPY)) {
+		return SUCCESS;
+	}
+
+	phalcon_read_property(&reflection_data, reflection, SL("_reflectionData"), PH_READONLY);
+	if (!phalcon_array_isset_fetch_str(&members, &reflection_data, section, section_length, PH_READONLY) || Z_TYPE(members) != IS_ARRAY) {
+		return FAILURE;
+	}
+
+	if (phalcon_array_isset_fetch(&member, &members, name, PH_READONLY)) {
+		phalcon_annotations_reflection_unpack(&member_annotations, reflection, &member);
+	}
+
+	object_init_ex(return_value, phalcon_annotations_collection_ce);
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, return_value, "__construct", &member_annotations);
+	zval_ptr_dtor(&member_annotations);
+
+	if (flag == FAILURE) {
+		zval_ptr_dtor(return_value);
+		ZVAL_NULL(return_value);
+		return FAILURE;
+	}
+
+	phalcon_update_property_array(reflection, cache, cache_length, name, return_value);
+	return SUCCESS;
+}
+
 
 /**
  * Phalcon\Annotations\Adapter initializer
@@ -171,7 +220,9 @@ PHP_METHOD(Phalcon_Annotations_Adapter, get){
 	 * Try to read the annotations from the adapter
 	 */
 	PHALCON_CALL_METHOD(&class_annotations, getThis(), "read", &real_class_name);
-	if (Z_TYPE(class_annotations) == IS_NULL) {
+	if (Z_TYPE(class_annotations) == IS_OBJECT) {
+		phalcon_update_property_array(getThis(), SL("_annotations"), &real_class_name, &class_annotations);
+	} else if (Z_TYPE(class_annotations) == IS_NULL) {
 		/**
 		 * Get the annotations reader
 		 */
@@ -249,6 +300,11 @@ PHP_METHOD(Phalcon_Annotations_Adapter, getMethod){
 	 * A valid annotations reflection is an object
 	 */
 	if (Z_TYPE(class_annotations) == IS_OBJECT) {
+		if (phalcon_annotations_adapter_get_member(return_value, &class_annotations, SL("_methodAnnotations"), SL("_methodCollections"), SL("methods"), method_name) == SUCCESS || EG(exception)) {
+			zval_ptr_dtor(&class_annotations);
+			return;
+		}
+
 		PHALCON_CALL_METHOD(&methods, &class_annotations, "getmethodsannotations");
 		if (Z_TYPE(methods) == IS_ARRAY) {
 			ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(methods), idx, str_key, method) {
@@ -329,6 +385,11 @@ PHP_METHOD(Phalcon_Annotations_Adapter, getProperty){
 	 * A valid annotations reflection is an object
 	 */
 	if (Z_TYPE(class_annotations) == IS_OBJECT) {
+		if (phalcon_annotations_adapter_get_member(return_value, &class_annotations, SL("_propertyAnnotations"), SL("_propertyCollections"), SL("properties"), property_name) == SUCCESS || EG(exception)) {
+			zval_ptr_dtor(&class_annotations);
+			return;
+		}
+
 		PHALCON_CALL_METHOD(&properties, &class_annotations, "getpropertiesannotations");
 		if (Z_TYPE(properties) == IS_ARRAY) {
 			ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(properties), idx, str_key, property) {
@@ -0,0 +1,291 @@
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2014 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "annotations/adapter/yac.h"
+#include "annotations/adapter.h"
+#include "annotations/adapterinterface.h"
+#include "annotations/reflection.h"
+
+#include <sys/stat.h>
+#include <Zend/zend_smart_str.h>
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+#include "kernel/fcall.h"
+#include "kernel/array.h"
+#include "kernel/object.h"
+#include "kernel/operators.h"
+#include "kernel/reflection.h"
+#include "kernel/variables.h"
+
+#ifdef PHALCON_CACHE_YAC
+#include <time.h>
+#include "cache/yac/storage.h"
+#endif
+
+/**
+ * Phalcon\Annotations\Adapter\Yac
+ *
+ * Stores the parsed annotations in the shared memory of yac, so every worker reuses the
+ * annotations parsed by the first one. Entries are keyed by the file declaring the class,
+ * its inode and its modification time. Methods and properties are kept in a compact binary
+ * form and only the ones that are requested are mapped back
+ *
+ *<code>
+ * $annotations = new \Phalcon\Annotations\Adapter\Yac();
+ *</code>
+ */
+zend_class_entry *phalcon_annotations_adapter_yac_ce;
+
+PHP_METHOD(Phalcon_Annotations_Adapter_Yac, read);
+PHP_METHOD(Phalcon_Annotations_Adapter_Yac, write);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_annotations_adapter_yac_read, 0, 0, 1)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_annotations_adapter_yac_write, 0, 0, 2)
+	ZEND_ARG_INFO(0, key)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
+static const zend_function_entry phalcon_annotations_adapter_yac_method_entry[] = {
+	PHP_ME(Phalcon_Annotations_Adapter_Yac, read, arginfo_phalcon_annotations_adapter_yac_read, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Annotations_Adapter_Yac, write, arginfo_phalcon_annotations_adapter_yac_write, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+/**
+ * Phalcon\Annotations\Adapter\Yac initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Annotations_Adapter_Yac){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Annotations\\Adapter, Yac, annotations_adapter_yac, phalcon_annotations_adapter_ce, phalcon_annotations_adapter_yac_method_entry, 0);
+
+	zend_class_implements(phalcon_annotations_adapter_yac_ce, 1, phalcon_annotations_adapterinterface_ce);
+
+	return SUCCESS;
+}
+
+#ifdef PHALCON_CACHE_YAC
+
+/**
+ * Resolves the file declaring the class, the entry stores the class name, the file, its inode
+ * and its mtime and they are compared on every hit to rule out hash collisions and stale files
+ */
+static int phalcon_annotations_adapter_yac_identity(zval *identity, char *key, size_t size, int *key_len, zval *class_name)
+{
+	zend_class_entry *ce;
+	zend_string *filename, *lower_name;
+	zend_ulong hash;
+	struct stat st;
+	smart_str buf = {0};
+
+	if (!PHALCON_GLOBAL(cache).enable_yac || Z_TYPE_P(class_name) != IS_STRING) {
+		return FAILURE;
+	}
+
+	ce = phalcon_fetch_class(class_name, ZEND_FETCH_CLASS_AUTO | ZEND_FETCH_CLASS_SILENT);
+	if (!ce || ce->type != ZEND_USER_CLASS) {
+		return FAILURE;
+	}
+
+	filename = phalcon_get_class_filename(ce);
+	if (!filename || stat(ZSTR_VAL(filename), &st) != 0) {
+		return FAILURE;
+	}
+
+	lower_name = zend_string_tolower(ce->name);
+
+	smart_str_append(&buf, lower_name);
+	smart_str_appendc(&buf, '\0');
+	smart_str_append(&buf, filename);
+	smart_str_appendl(&buf, (const char *)&st.st_ino, sizeof(st.st_ino));
+	smart_str_0(&buf);
+
+	hash = zend_inline_hash_func(ZSTR_VAL(buf.s), ZSTR_LEN(buf.s));
+	smart_str_free(&buf);
+
+	*key_len = snprintf(key, size, "phalcon_an_%lx_%lx", (unsigned long)hash, (unsigned long)st.st_mtime);
+
+	array_init_size(identity, 4);
+	add_assoc_str_ex(identity, SL("class"), lower_name);
+	add_assoc_str_ex(identity, SL("file"), zend_string_copy(filename));
+	add_assoc_long_ex(identity, SL("inode"), (zend_long)st.st_ino);
+	add_assoc_long_ex(identity, SL("mtime"), (zend_long)st.st_mtime);
+
+	return SUCCESS;
+}
+
+/**
+ * Packs every member separately, a member is only mapped back when it's requested
+ */
+static int phalcon_annotations_adapter_yac_pack_members(zval *return_value, zval *members)
+{
+	zval *member;
+	zend_string *str_key;
+	ulong idx;
+
+	array_init(return_value);
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(members), idx, str_key, member) {
+		zval packed = {};
+		smart_str buf = {0};
+
+		if (phalcon_binary_pack(&buf, member) == FAILURE) {
+			smart_str_free(&buf);
+			return FAILURE;
+		}
+
+		smart_str_0(&buf);
+		ZVAL_STR(&packed, buf.s);
+
+		if (str_key) {
+			zend_hash_update(Z_ARRVAL_P(return_value), str_key, &packed);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), idx, &packed);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return SUCCESS;
+}
+
+#endif
+
+/**
+ * Reads parsed annotations from the shared memory
+ *
+ * @param string $key
+ * @return Phalcon\Annotations\Reflection
+ */
+PHP_METHOD(Phalcon_Annotations_Adapter_Yac, read){
+
+	zval *key;
+#ifdef PHALCON_CACHE_YAC
+	zval identity = {}, entry = {}, stored_identity = {}, reflection_data = {};
+	char yac_key[PHALCON_CACHE_YAC_STORAGE_MAX_KEY_LEN], *data = NULL;
+	const char *p, *end;
+	unsigned int size = 0, flag = 0;
+	int key_len;
+#endif
+
+	phalcon_fetch_params(0, 1, 0, &key);
+
+#ifdef PHALCON_CACHE_YAC
+	if (phalcon_annotations_adapter_yac_identity(&identity, yac_key, sizeof(yac_key), &key_len, key) == FAILURE) {
+		RETURN_NULL();
+	}
+
+	if (!phalcon_cache_yac_storage_find(yac_key, key_len, &data, &size, &flag, (unsigned long)time(NULL))) {
+		zval_ptr_dtor(&identity);
+		RETURN_NULL();
+	}
+
+	p   = data;
+	end = data + size;
+
+	/**
+	 * Only the entry itself is mapped back, the members stay packed inside the reflection
+	 */
+	if (phalcon_binary_unpack(&entry, &p, end) == SUCCESS && p == end
+		&& phalcon_array_isset_fetch_str(&stored_identity, &entry, SL("identity"), PH_READONLY) && PHALCON_IS_IDENTICAL(&stored_identity, &identity)
+		&& phalcon_array_isset_fetch_str(&reflection_data, &entry, SL("data"), PH_READONLY) && Z_TYPE(reflection_data) == IS_ARRAY) {
+		object_init_ex(return_value, phalcon_annotations_reflection_ce);
+		phalcon_update_property(return_value, SL("_reflectionData"), &reflection_data);
+		phalcon_update_property_bool(return_value, SL("_packed"), 1);
+	} else {
+		ZVAL_NULL(return_value);
+	}
+
+	zval_ptr_dtor(&entry);
+	zval_ptr_dtor(&identity);
+	efree(data);
+#else
+	RETURN_NULL();
+#endif
+}
+
+/**
+ * Writes parsed annotations to the shared memory
+ *
+ * @param string $key
+ * @param Phalcon\Annotations\Reflection $data
+ */
+PHP_METHOD(Phalcon_Annotations_Adapter_Yac, write){
+
+	zval *key, *data;
+#ifdef PHALCON_CACHE_YAC
+	zval identity = {}, reflection_data = {}, packed_data = {}, reflection_class = {}, reflection_members = {}, members = {}, entry = {};
+	char yac_key[PHALCON_CACHE_YAC_STORAGE_MAX_KEY_LEN];
+	smart_str buf = {0};
+	int key_len, status = SUCCESS;
+#endif
+
+	phalcon_fetch_params(0, 2, 0, &key, &data);
+
+#ifdef PHALCON_CACHE_YAC
+	if (Z_TYPE_P(data) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(data), phalcon_annotations_reflection_ce)) {
+		return;
+	}
+
+	if (phalcon_annotations_adapter_yac_identity(&identity, yac_key, sizeof(yac_key), &key_len, key) == FAILURE) {
+		return;
+	}
+
+	PHALCON_CALL_METHOD(&reflection_data, data, "getreflectiondata");
+
+	array_init(&packed_data);
+
+	if (Z_TYPE(reflection_data) == IS_ARRAY) {
+		if (phalcon_array_isset_fetch_str(&reflection_class, &reflection_data, SL("class"), PH_READONLY)) {
+			if ((status = phalcon_binary_pack(&buf, &reflection_class)) == SUCCESS) {
+				smart_str_0(&buf);
+				add_assoc_str_ex(&packed_data, SL("class"), buf.s);
+				buf.s = NULL;
+			}
+		}
+
+		if (status == SUCCESS && phalcon_array_isset_fetch_str(&reflection_members, &reflection_data, SL("methods"), PH_READONLY) && Z_TYPE(reflection_members) == IS_ARRAY) {
+			status = phalcon_annotations_adapter_yac_pack_members(&members, &reflection_members);
+			phalcon_array_update_str(&packed_data, SL("methods"), &members, 0);
+		}
+
+		if (status == SUCCESS && phalcon_array_isset_fetch_str(&reflection_members, &reflection_data, SL("properties"), PH_READONLY) && Z_TYPE(reflection_members) == IS_ARRAY) {
+			status = phalcon_annotations_adapter_yac_pack_members(&members, &reflection_members);
+			phalcon_array_update_str(&packed_data, SL("properties"), &members, 0);
+		}
+	}
+
+	if (status == SUCCESS) {
+		array_init_size(&entry, 2);
+		phalcon_array_update_str(&entry, SL("identity"), &identity, PH_COPY);
+		phalcon_array_update_str(&entry, SL("data"), &packed_data, PH_COPY);
+
+		smart_str_free(&buf);
+		if (phalcon_binary_pack(&buf, &entry) == SUCCESS && ZSTR_LEN(buf.s) <= PHALCON_CACHE_YAC_STORAGE_MAX_ENTRY_LEN) {
+			phalcon_cache_yac_storage_update(yac_key, key_len, ZSTR_VAL(buf.s), ZSTR_LEN(buf.s), IS_STRING, 0, 0, (unsigned long)time(NULL));
+		}
+		zval_ptr_dtor(&entry);
+	}
+
+	smart_str_free(&buf);
+	zval_ptr_dtor(&packed_data);
+	zval_ptr_dtor(&reflection_data);
+	zval_ptr_dtor(&identity);
+#endif
+}
@@ -30,6 +30,7 @@
 #include "kernel/file.h"
 #include "kernel/hash.h"
 #include "kernel/operators.h"
+#include "kernel/variables.h"
 
 /**
  * Phalcon\Annotations\Reflection
@@ -87,10 +88,65 @@ PHALCON_INIT_CLASS(Phalcon_Annotations_Reflection){
 	zend_declare_property_null(phalcon_annotations_reflection_ce, SL("_classAnnotations"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_annotations_reflection_ce, SL("_methodAnnotations"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_annotations_reflection_ce, SL("_propertyAnnotations"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_annotations_reflection_ce, SL("_methodCollections"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_annotations_reflection_ce, SL("_propertyCollections"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_annotations_reflection_ce, SL("_packed"), 0, ZEND_ACC_PROTECTED);
 
 	return SUCCESS;
 }
 
+/**
+ * Returns the parsed annotations of one entry of the reflection data. Reflections read from
+ * shared memory keep every entry packed and only map back the ones that are requested
+ */
+int phalcon_annotations_reflection_unpack(zval *return_value, zval *object, zval *data) {
+
+	zval packed = {};
+	const char *p, *end;
+
+	phalcon_read_property(&packed, object, SL("_packed"), PH_READONLY);
+	if (!zend_is_true(&packed)) {
+		ZVAL_COPY(return_value, data);
+		return SUCCESS;
+	}
+
+	if (Z_TYPE_P(data) != IS_STRING) {
+		ZVAL_NULL(return_value);
+		return FAILURE;
+	}
+
+	p   = Z_STRVAL_P(data);
+	end = p + Z_STRLEN_P(data);
+
+	if (phalcon_binary_unpack(return_value, &p, end) == FAILURE || p != end) {
+		zval_ptr_dtor(return_value);
+		ZVAL_NULL(return_value);
+		return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+static void phalcon_annotations_reflection_unpack_members(zval *return_value, zval *object, zval *members) {
+
+	zval *member;
+	zend_string *str_key;
+	ulong idx;
+
+	array_init(return_value);
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(members), idx, str_key, member) {
+		zval annotations = {};
+
+		phalcon_annotations_reflection_unpack(&annotations, object, member);
+		if (str_key) {
+			zend_hash_update(Z_ARRVAL_P(return_value), str_key, &annotations);
+		} else {
+			zend_hash_index_update(Z_ARRVAL_P(return_value), idx, &annotations);
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+
 /**
  * Phalcon\Annotations\Reflection constructor
  *
@@ -120,8 +176,13 @@ PHP_METHOD(Phalcon_Annotations_Reflection, getClassAnnotations){
 	if (Z_TYPE(annotations) != IS_OBJECT) {
 		phalcon_read_property(&reflection_data, getThis(), SL("_reflectionData"), PH_READONLY);
 		if (phalcon_array_isset_fetch_str(&reflection_class, &reflection_data, SL("class"), PH_READONLY)) {
+			zval class_annotations = {};
+
+			phalcon_annotations_reflection_unpack(&class_annotations, getThis(), &reflection_class);
+
 			object_init_ex(return_value, phalcon_annotations_collection_ce);
-			PHALCON_CALL_METHOD(NULL, return_value, "__construct", &reflection_class);
+			PHALCON_CALL_METHOD(NULL, return_value, "__construct", &class_annotations);
+			zval_ptr_dtor(&class_annotations);
 
 			phalcon_update_property(getThis(), SL("_classAnnotations"), return_value);
 			return;
@@ -153,15 +214,18 @@ PHP_METHOD(Phalcon_Annotations_Reflection, getMethodsAnnotations){
 				array_init(return_value);
 
 				ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(reflection_methods), idx, str_key, reflection_method) {
-					zval method_name = {}, collection = {};
+					zval method_name = {}, method_annotations = {}, collection = {};
 					if (str_key) {
 						ZVAL_STR(&method_name, str_key);
 					} else {
 						ZVAL_LONG(&method_name, idx);
 					}
 
+					phalcon_annotations_reflection_unpack(&method_annotations, getThis(), reflection_method);
+
 					object_init_ex(&collection, phalcon_annotations_collection_ce);
-					PHALCON_CALL_METHOD(NULL, &collection, "__construct", reflection_method);
+					PHALCON_CALL_METHOD(NULL, &collection, "__construct", &method_annotations);
+					zval_ptr_dtor(&method_annotations);
 
 					phalcon_array_update(return_value, &method_name, &collection, 0);
 				} ZEND_HASH_FOREACH_END();
@@ -197,15 +261,18 @@ PHP_METHOD(Phalcon_Annotations_Reflection, getPropertiesAnnotations){
 				array_init(return_value);
 
 				ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(reflection_properties), idx, str_key, reflection_property) {
-					zval property = {}, collection = {};
+					zval property = {}, property_annotations = {}, collection = {};
 					if (str_key) {
 						ZVAL_STR(&property, str_key);
 					} else {
 						ZVAL_LONG(&property, idx);
 					}
 
+					phalcon_annotations_reflection_unpack(&property_annotations, getThis(), reflection_property);
+
 					object_init_ex(&collection, phalcon_annotations_collection_ce);
-					PHALCON_CALL_METHOD(NULL, &collection, "__construct", reflection_property);
+					PHALCON_CALL_METHOD(NULL, &collection, "__construct", &property_annotations);
+					zval_ptr_dtor(&property_annotations);
 
 					phalcon_array_update(return_value, &property, &collection, 0);
 				} ZEND_HASH_FOREACH_END();
@@ -229,8 +296,37 @@ PHP_METHOD(Phalcon_Annotations_Reflection, getPropertiesAnnotations){
  */
 PHP_METHOD(Phalcon_Annotations_Reflection, getReflectionData){
 
+	zval packed = {}, reflection_data = {}, reflection_class = {}, reflection_members = {}, class_annotations = {}, members = {};
+
+	phalcon_read_property(&packed, getThis(), SL("_packed"), PH_READONLY);
+	if (!zend_is_true(&packed)) {
+		RETURN_MEMBER(getThis(), "_reflectionData");
+	}
+
+	/**
+	 * The raw definitions are requested, every packed entry is mapped back once
+	 */
+	phalcon_read_property(&reflection_data, getThis(), SL("_reflectionData"), PH_READONLY);
 
-	RETURN_MEMBER(getThis(), "_reflectionData");
+	array_init(return_value);
+
+	if (phalcon_array_isset_fetch_str(&reflection_class, &reflection_data, SL("class"), PH_READONLY)) {
+		phalcon_annotations_reflection_unpack(&class_annotations, getThis(), &reflection_class);
+		phalcon_array_update_str(return_value, SL("class"), &class_annotations, 0);
+	}
+
+	if (phalcon_array_isset_fetch_str(&reflection_members, &reflection_data, SL("methods"), PH_READONLY) && Z_TYPE(reflection_members) == IS_ARRAY) {
+		phalcon_annotations_reflection_unpack_members(&members, getThis(), &reflection_members);
+		phalcon_array_update_str(return_value, SL("methods"), &members, 0);
+	}
+
+	if (phalcon_array_isset_fetch_str(&reflection_members, &reflection_data, SL("properties"), PH_READONLY) && Z_TYPE(reflection_members) == IS_ARRAY) {
+		phalcon_annotations_reflection_unpack_members(&members, getThis(), &reflection_members);
+		phalcon_array_update_str(return_value, SL("properties"), &members, 0);
+	}
+
+	phalcon_update_property(getThis(), SL("_reflectionData"), return_value);
+	phalcon_update_property_bool(getThis(), SL("_packed"), 0);
 }
 
 /**
@@ -240,7 +336,7 @@ PHP_METHOD(Phalcon_Annotations_Reflection, getReflectionData){
  */
 PHP_METHOD(Phalcon_Annotations_Reflection, __set_state){
 
-	zval *data, reflection_data = {};
+	zval *data, reflection_data = {}, packed = {};
 
 	phalcon_fetch_params(0, 1, 0, &data);
 
@@ -251,6 +347,10 @@ PHP_METHOD(Phalcon_Annotations_Reflection, __set_state){
 		if (phalcon_array_isset_fetch_str(&reflection_data, data, SL("_reflectionData"), PH_READONLY)) {
 			object_init_ex(return_value, phalcon_annotations_reflection_ce);
 			PHALCON_CALL_METHOD(NULL, return_value, "__construct", &reflection_data);
+
+			if (phalcon_array_isset_fetch_str(&packed, data, SL("_packed"), PH_READONLY) && zend_is_true(&packed)) {
+				phalcon_update_property_bool(return_value, SL("_packed"), 1);
+			}
 			return;
 		}
 	}
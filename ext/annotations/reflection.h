@@ -26,4 +26,6 @@ extern zend_class_entry *phalcon_annotations_reflection_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Annotations_Reflection);
 
+int phalcon_annotations_reflection_unpack(zval *return_value, zval *object, zval *data);
+
 #endif /* PHALCON_ANNOTATIONS_REFLECTION_H */
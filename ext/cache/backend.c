@@ -23,6 +23,14 @@
 #include "cache/frontendinterface.h"
 #include "cache/exception.h"
 #include "di/injectable.h"
+#ifndef PHP_WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <main/php_open_temporary_file.h>
+#endif
+
+#include <math.h>
+#include <ext/standard/php_rand.h>
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -32,6 +40,8 @@
 #include "kernel/fcall.h"
 #include "kernel/operators.h"
 #include "kernel/exception.h"
+#include "kernel/concat.h"
+#include "kernel/time.h"
 
 /**
  * Phalcon\Cache\Backend
@@ -48,12 +58,26 @@ PHP_METHOD(Phalcon_Cache_Backend, getOptions);
 PHP_METHOD(Phalcon_Cache_Backend, isFresh);
 PHP_METHOD(Phalcon_Cache_Backend, isStarted);
 PHP_METHOD(Phalcon_Cache_Backend, getLifetime);
+PHP_METHOD(Phalcon_Cache_Backend, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend, deleteMultiple);
+PHP_METHOD(Phalcon_Cache_Backend, getOrCompute);
+PHP_METHOD(Phalcon_Cache_Backend, _lock);
+PHP_METHOD(Phalcon_Cache_Backend, _unlock);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, frontend)
 	ZEND_ARG_TYPE_INFO(0, options, IS_ARRAY, 1)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend_getorcompute, 0, 0, 2)
+	ZEND_ARG_INFO(0, keyName)
+	ZEND_ARG_CALLABLE_INFO(0, producer, 0)
+	ZEND_ARG_TYPE_INFO(0, lifetime, IS_LONG, 1)
+	ZEND_ARG_TYPE_INFO(0, graceLifetime, IS_LONG, 1)
+	ZEND_ARG_TYPE_INFO(0, beta, IS_DOUBLE, 1)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_cache_backend_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Backend, __construct, arginfo_phalcon_cache_backend___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Cache_Backend, start, arginfo_phalcon_cache_backendinterface_start, ZEND_ACC_PUBLIC)
@@ -63,9 +87,34 @@ static const zend_function_entry phalcon_cache_backend_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Backend, isFresh, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend, isStarted, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend, getLifetime, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend, getOrCompute, arginfo_phalcon_cache_backend_getorcompute, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend, _lock, arginfo_phalcon_cache_backend__lock, ZEND_ACC_PROTECTED)
+	PHP_ME(Phalcon_Cache_Backend, _unlock, arginfo_phalcon_cache_backend__unlock, ZEND_ACC_PROTECTED)
 	PHP_FE_END
 };
 
+/**
+ * Number of times a process that did not get the lock polls for the value, and the pause between polls
+ */
+#define PHALCON_CACHE_BACKEND_LOCK_RETRIES 20
+#define PHALCON_CACHE_BACKEND_LOCK_WAIT 50000
+
+/**
+ * Seconds a regeneration lock is held at most
+ */
+#define PHALCON_CACHE_BACKEND_LOCK_LIFETIME 30
+
+#ifndef PHP_WIN32
+/**
+ * File whose byte ranges are locked by the default lock, it stays open as closing any descriptor
+ * of the file releases every lock the process holds on it
+ */
+static int phalcon_cache_backend_lock_fd = -1;
+#endif
+
 /**
  * Phalcon\Cache\Backend initializer
  */
@@ -80,6 +129,7 @@ PHALCON_INIT_CLASS(Phalcon_Cache_Backend){
 	zend_declare_property_null(phalcon_cache_backend_ce, SL("_lastLifetime"), ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_fresh"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_cache_backend_ce, SL("_started"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_cache_backend_ce, SL("_locks"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_cache_backend_ce, 1, phalcon_cache_backendinterface_ce);
 
@@ -233,3 +283,410 @@ PHP_METHOD(Phalcon_Cache_Backend, getLifetime){
 	}
 	RETURN_ZVAL(&lifetime, 0, 0);
 }
+
+/**
+ * Returns the cached contents of several keys, missing keys are returned as null.
+ * Adapters able to fetch many keys in one round-trip override this method
+ *
+ *<code>
+ * $values = $cache->getMultiple(array('user-1', 'user-2'));
+ *</code>
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name;
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	if (!lifetime) {
+		lifetime = &PHALCON_GLOBAL(z_null);
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval value = {};
+		PHALCON_CALL_METHOD(&value, getThis(), "get", key_name, lifetime);
+		phalcon_array_update(return_value, key_name, &value, 0);
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Stores several key/value pairs, null values are skipped
+ *
+ *<code>
+ * $cache->saveMultiple(array('user-1' => $user1, 'user-2' => $user2), 3600);
+ *</code>
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value;
+	zend_string *str_key;
+	ulong idx;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime) {
+		lifetime = &PHALCON_GLOBAL(z_null);
+	}
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval key_name = {}, ret = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+		if (str_key) {
+			ZVAL_STR(&key_name, str_key);
+		} else {
+			ZVAL_LONG(&key_name, idx);
+		}
+		PHALCON_CALL_METHOD(&ret, getThis(), "save", &key_name, value, lifetime, &PHALCON_GLOBAL(z_false));
+		if (!zend_is_true(&ret)) {
+			success = 0;
+		}
+		zval_ptr_dtor(&ret);
+	} ZEND_HASH_FOREACH_END();
+
+	RETURN_BOOL(success);
+}
+
+/**
+ * Deletes several keys
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, deleteMultiple){
+
+	zval *keys, *key_name;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval ret = {};
+		PHALCON_CALL_METHOD(&ret, getThis(), "delete", key_name);
+		if (!zend_is_true(&ret)) {
+			success = 0;
+		}
+		zval_ptr_dtor(&ret);
+	} ZEND_HASH_FOREACH_END();
+
+	RETURN_BOOL(success);
+}
+
+/**
+ * Reads an entry written by getOrCompute(), entries are stored as array(value, expire, delta)
+ */
+static int phalcon_cache_backend_read_entry(zval *entry, zval *value, double *expire, double *delta)
+{
+	zval tmp = {};
+
+	if (Z_TYPE_P(entry) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(entry)) != 3) {
+		return 0;
+	}
+
+	if (!phalcon_array_isset_fetch_long(value, entry, 0, PH_READONLY)) {
+		return 0;
+	}
+
+	if (!phalcon_array_isset_fetch_long(&tmp, entry, 1, PH_READONLY)) {
+		return 0;
+	}
+	*expire = zval_get_double(&tmp);
+
+	if (!phalcon_array_isset_fetch_long(&tmp, entry, 2, PH_READONLY)) {
+		return 0;
+	}
+	*delta = zval_get_double(&tmp);
+
+	return 1;
+}
+
+/**
+ * Runs the producer and stores its result with the soft expiration and the time it took to compute
+ */
+static int phalcon_cache_backend_compute(zval *return_value, zval *object, zval *key_name, zval *producer, zend_long ttl, zend_long hard_ttl)
+{
+	zval value = {}, entry = {}, lifetime = {};
+	double start, delta;
+	int flag;
+
+	start = phalcon_get_microtime();
+
+	PHALCON_CALL_USER_FUNC_FLAG(flag, &value, producer, key_name);
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	delta = phalcon_get_microtime() - start;
+
+	array_init_size(&entry, 3);
+	phalcon_array_append(&entry, &value, PH_COPY);
+	add_next_index_double(&entry, start + delta + (double)ttl);
+	add_next_index_double(&entry, delta);
+
+	ZVAL_LONG(&lifetime, hard_ttl);
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, object, "save", key_name, &entry, &lifetime, &PHALCON_GLOBAL(z_false));
+	zval_ptr_dtor(&entry);
+
+	ZVAL_COPY_VALUE(return_value, &value);
+	return flag;
+}
+
+/**
+ * Releases the lock file held for a key by the default lock
+ */
+static int phalcon_cache_backend_release_lock(zval *object, zval *key_name)
+{
+	zval locks = {}, fd = {};
+
+	phalcon_read_property(&locks, object, SL("_locks"), PH_READONLY);
+	if (Z_TYPE(locks) != IS_ARRAY || !phalcon_array_isset_fetch(&fd, &locks, key_name, PH_READONLY)) {
+		return 0;
+	}
+
+#ifndef PHP_WIN32
+	if (Z_TYPE(fd) == IS_LONG && phalcon_cache_backend_lock_fd >= 0) {
+		struct flock range;
+
+		memset(&range, 0, sizeof(range));
+		range.l_type = F_UNLCK;
+		range.l_whence = SEEK_SET;
+		range.l_start = (off_t)Z_LVAL(fd);
+		range.l_len = 1;
+		fcntl(phalcon_cache_backend_lock_fd, F_SETLK, &range);
+	}
+#endif
+
+	phalcon_unset_property_array(object, SL("_locks"), key_name);
+	return 1;
+}
+
+/**
+ * Computes the value while holding the regeneration lock and releases it afterwards, also when
+ * the producer throws so the processes waiting for the key can take the lock
+ */
+static void phalcon_cache_backend_compute_locked(zval *return_value, zval *object, zval *key_name, zval *producer, zend_long ttl, zend_long hard_ttl)
+{
+	int flag;
+
+	if (phalcon_cache_backend_compute(return_value, object, key_name, producer, ttl, hard_ttl) == FAILURE || EG(exception)) {
+		zend_exception_save();
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, object, "_unlock", key_name);
+		zend_exception_restore();
+		return;
+	}
+
+	PHALCON_CALL_METHOD(NULL, object, "_unlock", key_name);
+}
+
+/**
+ * Returns the cached content of a key, computing it with the producer when it is missing.
+ *
+ * Once the lifetime is over the stale value is still served for $graceLifetime seconds while a
+ * single process regenerates it. Processes that find no value at all wait a short time for the
+ * one holding the lock instead of calling the producer too. A positive $beta refreshes the value
+ * probabilistically before it expires, the higher the sooner; the expensive keys are refreshed earlier
+ *
+ *<code>
+ * $posts = $cache->getOrCompute('posts', function($key) {
+ *     return Posts::find()->toArray();
+ * }, 300, 60);
+ *</code>
+ *
+ * @param int|string $keyName
+ * @param callable $producer
+ * @param long $lifetime
+ * @param long $graceLifetime
+ * @param double $beta
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Cache_Backend, getOrCompute){
+
+	zval *key_name, *producer, *lifetime = NULL, *grace_lifetime = NULL, *beta = NULL, tmp = {}, hard_lifetime = {}, lock_lifetime = {}, entry = {}, value = {}, locked = {};
+	zend_long ttl, grace = 0;
+	double expire, delta, now;
+	int i;
+
+	phalcon_fetch_params(0, 2, 3, &key_name, &producer, &lifetime, &grace_lifetime, &beta);
+
+	if (!phalcon_is_callable(producer)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_cache_exception_ce, "The producer must be callable");
+		return;
+	}
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&tmp, getThis(), "getlifetime");
+		ttl = phalcon_get_intval(&tmp);
+		zval_ptr_dtor(&tmp);
+	} else {
+		ttl = Z_LVAL_P(lifetime);
+	}
+
+	if (grace_lifetime && Z_TYPE_P(grace_lifetime) == IS_LONG && Z_LVAL_P(grace_lifetime) > 0) {
+		grace = Z_LVAL_P(grace_lifetime);
+	}
+
+	ZVAL_LONG(&hard_lifetime, ttl + grace);
+	ZVAL_LONG(&lock_lifetime, PHALCON_CACHE_BACKEND_LOCK_LIFETIME);
+
+	PHALCON_CALL_METHOD(&entry, getThis(), "get", key_name, &hard_lifetime);
+
+	if (phalcon_cache_backend_read_entry(&entry, &value, &expire, &delta)) {
+		now = phalcon_get_microtime();
+
+		if (now < expire) {
+			/* Probabilistic early expiration: now - delta * beta * log(random) >= expire */
+			if (!beta || phalcon_get_doubleval(beta) <= 0 || delta <= 0
+				|| now - delta * phalcon_get_doubleval(beta) * log(((double)(php_mt_rand() >> 1) + 1.0) / ((double)PHP_MT_RAND_MAX + 1.0)) < expire) {
+				RETVAL_ZVAL(&value, 1, 0);
+				zval_ptr_dtor(&entry);
+				return;
+			}
+		}
+
+		/* Stale, only the process holding the lock regenerates it, the others serve the old value */
+		PHALCON_CALL_METHOD(&locked, getThis(), "_lock", key_name, &lock_lifetime);
+		if (!zend_is_true(&locked)) {
+			RETVAL_ZVAL(&value, 1, 0);
+			zval_ptr_dtor(&entry);
+			return;
+		}
+		zval_ptr_dtor(&entry);
+
+		phalcon_cache_backend_compute_locked(return_value, getThis(), key_name, producer, ttl, ttl + grace);
+		return;
+	}
+	zval_ptr_dtor(&entry);
+
+	/* Missing, coalesce the concurrent requests on the lock */
+	PHALCON_CALL_METHOD(&locked, getThis(), "_lock", key_name, &lock_lifetime);
+	if (zend_is_true(&locked)) {
+		phalcon_cache_backend_compute_locked(return_value, getThis(), key_name, producer, ttl, ttl + grace);
+		return;
+	}
+
+	for (i = 0; i < PHALCON_CACHE_BACKEND_LOCK_RETRIES; i++) {
+		usleep(PHALCON_CACHE_BACKEND_LOCK_WAIT);
+
+		PHALCON_CALL_METHOD(&entry, getThis(), "get", key_name, &hard_lifetime);
+		if (phalcon_cache_backend_read_entry(&entry, &value, &expire, &delta)) {
+			RETVAL_ZVAL(&value, 1, 0);
+			zval_ptr_dtor(&entry);
+			return;
+		}
+		zval_ptr_dtor(&entry);
+		ZVAL_UNDEF(&entry);
+
+		/* The holder finished without storing a value or gave up the lock, take it over */
+		zval_ptr_dtor(&locked);
+		PHALCON_CALL_METHOD(&locked, getThis(), "_lock", key_name, &lock_lifetime);
+		if (zend_is_true(&locked)) {
+			PHALCON_CALL_METHOD(&entry, getThis(), "get", key_name, &hard_lifetime);
+			if (phalcon_cache_backend_read_entry(&entry, &value, &expire, &delta)) {
+				RETVAL_ZVAL(&value, 1, 0);
+				zval_ptr_dtor(&entry);
+				PHALCON_CALL_METHOD(NULL, getThis(), "_unlock", key_name);
+				return;
+			}
+			zval_ptr_dtor(&entry);
+
+			phalcon_cache_backend_compute_locked(return_value, getThis(), key_name, producer, ttl, ttl + grace);
+			return;
+		}
+	}
+
+	/* The lock holder is taking too long, compute it here */
+	phalcon_cache_backend_compute(return_value, getThis(), key_name, producer, ttl, ttl + grace);
+}
+
+/**
+ * Tries to take the regeneration lock of a key without blocking.
+ * The default lock is local to the machine: every key locks its own byte of a single lock file
+ * in the temporary directory with fcntl(), at the offset given by the hash of the key, so the
+ * lock of a process that dies is released by the kernel. The locks belong to the process, a
+ * process taking a lock it already holds (a producer calling getOrCompute() for its own key)
+ * gets it again. Adapters shared between hosts override it with a lock key stored in the
+ * backend itself
+ *
+ * @param int|string $keyName
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _lock){
+
+	zval *key_name, *lifetime;
+#ifndef PHP_WIN32
+	zval locks = {}, prefix = {}, prefixed_key = {}, handle = {};
+	char path[MAXPATHLEN];
+	struct flock range;
+	zend_ulong offset;
+#endif
+
+	phalcon_fetch_params(0, 2, 0, &key_name, &lifetime);
+
+#ifndef PHP_WIN32
+	phalcon_read_property(&locks, getThis(), SL("_locks"), PH_READONLY);
+	if (Z_TYPE(locks) == IS_ARRAY && phalcon_array_isset(&locks, key_name)) {
+		RETURN_TRUE;
+	}
+
+	if (phalcon_cache_backend_lock_fd < 0) {
+		snprintf(path, sizeof(path), "%s/phalcon_cache.lock", php_get_temporary_directory());
+
+		phalcon_cache_backend_lock_fd = open(path, O_RDWR | O_CREAT, 0600);
+		if (phalcon_cache_backend_lock_fd < 0) {
+			/* The lock file can't be used, every process regenerates */
+			RETURN_TRUE;
+		}
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	PHALCON_CONCAT_VV(&prefixed_key, &prefix, key_name);
+	offset = zend_inline_hash_func(Z_STRVAL(prefixed_key), Z_STRLEN(prefixed_key)) % ZEND_LONG_MAX;
+	zval_ptr_dtor(&prefixed_key);
+
+	memset(&range, 0, sizeof(range));
+	range.l_type = F_WRLCK;
+	range.l_whence = SEEK_SET;
+	range.l_start = (off_t)offset;
+	range.l_len = 1;
+
+	if (fcntl(phalcon_cache_backend_lock_fd, F_SETLK, &range) != 0) {
+		RETURN_FALSE;
+	}
+
+	ZVAL_LONG(&handle, (zend_long)offset);
+	phalcon_update_property_array(getThis(), SL("_locks"), key_name, &handle);
+	RETURN_TRUE;
+#else
+	/* Without fcntl() there is no local lock, every process regenerates */
+	RETURN_TRUE;
+#endif
+}
+
+/**
+ * Releases the regeneration lock of a key
+ *
+ * @param int|string $keyName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend, _unlock){
+
+	zval *key_name;
+
+	phalcon_fetch_params(0, 1, 0, &key_name);
+
+	RETURN_BOOL(phalcon_cache_backend_release_lock(getThis(), key_name));
+}
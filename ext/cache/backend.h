@@ -26,4 +26,13 @@ extern zend_class_entry *phalcon_cache_backend_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Cache_Backend);
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend__lock, 0, 0, 2)
+	ZEND_ARG_INFO(0, keyName)
+	ZEND_ARG_TYPE_INFO(0, lifetime, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_backend__unlock, 0, 0, 1)
+	ZEND_ARG_INFO(0, keyName)
+ZEND_END_ARG_INFO()
+
 #endif /* PHALCON_CACHE_BACKEND_H */
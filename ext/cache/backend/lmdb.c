@@ -76,6 +76,9 @@ PHP_METHOD(Phalcon_Cache_Backend_Lmdb, __construct);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, get);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, save);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, delete);
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, deleteMultiple);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, queryKeys);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, exists);
 PHP_METHOD(Phalcon_Cache_Backend_Lmdb, increment);
@@ -92,6 +95,9 @@ static const zend_function_entry phalcon_cache_backend_lmdb_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, get, arginfo_phalcon_cache_backendinterface_get, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, save, arginfo_phalcon_cache_backendinterface_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, delete, arginfo_phalcon_cache_backendinterface_delete, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Lmdb, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Lmdb, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Lmdb, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, exists, arginfo_phalcon_cache_backendinterface_exists, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Lmdb, increment, arginfo_phalcon_cache_backendinterface_increment, ZEND_ACC_PUBLIC)
@@ -461,3 +467,164 @@ PHP_METHOD(Phalcon_Cache_Backend_Lmdb, flush){
 
 	RETURN_TRUE;
 }
+
+/**
+ * Returns the cached contents of several keys inside one transaction, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, lmdb = {}, frontend = {}, flags = {}, expired_keys = {};
+	long now;
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	if (lifetime && Z_TYPE_P(lifetime) == IS_NULL) {
+		lifetime = NULL;
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		return;
+	}
+
+	phalcon_read_property(&lmdb, getThis(), SL("_lmdb"), PH_READONLY);
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	now = (long)time(NULL);
+
+	/**
+	 * Readers don't take the writer lock, expired keys are removed afterwards in a write transaction
+	 */
+	ZVAL_LONG(&flags, MDB_RDONLY);
+	PHALCON_CALL_METHOD(NULL, &lmdb, "begin", &flags);
+
+	array_init(&expired_keys);
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval cached_content = {}, val = {}, save_time = {}, expired = {}, value = {};
+
+		PHALCON_CALL_METHOD(&cached_content, &lmdb, "get", key_name);
+		if (Z_TYPE(cached_content) != IS_ARRAY || !phalcon_array_isset_fetch_long(&val, &cached_content, 0, PH_READONLY)) {
+			zval_ptr_dtor(&cached_content);
+			phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+			continue;
+		}
+
+		if (lifetime && phalcon_array_isset_fetch_long(&save_time, &cached_content, 2, PH_READONLY)) {
+			if ((now - phalcon_get_intval(&save_time)) > phalcon_get_intval(lifetime)) {
+				zval_ptr_dtor(&cached_content);
+				phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+				continue;
+			}
+		}
+
+		if (phalcon_array_isset_fetch_long(&expired, &cached_content, 1, PH_READONLY)) {
+			if (phalcon_get_intval(&expired) < now) {
+				phalcon_array_append(&expired_keys, key_name, PH_COPY);
+			}
+		}
+
+		if (PHALCON_IS_NOT_EMPTY(&val)) {
+			PHALCON_CALL_METHOD(&value, &frontend, "afterretrieve", &val);
+			phalcon_array_update(return_value, key_name, &value, 0);
+		} else {
+			phalcon_array_update(return_value, key_name, &val, PH_COPY);
+		}
+		zval_ptr_dtor(&cached_content);
+	} ZEND_HASH_FOREACH_END();
+	PHALCON_CALL_METHOD(NULL, &lmdb, "commit");
+
+	if (zend_hash_num_elements(Z_ARRVAL(expired_keys))) {
+		PHALCON_CALL_METHOD(NULL, &lmdb, "begin");
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(expired_keys), key_name) {
+			PHALCON_CALL_METHOD(NULL, &lmdb, "del", key_name);
+		} ZEND_HASH_FOREACH_END();
+		PHALCON_CALL_METHOD(NULL, &lmdb, "commit");
+	}
+	zval_ptr_dtor(&expired_keys);
+}
+
+/**
+ * Stores several key/value pairs inside one transaction, null values are skipped
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value, lmdb = {}, frontend = {}, ttl = {}, expired = {};
+	zend_string *str_key;
+	ulong idx;
+	long now_time;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&ttl, getThis(), "getlifetime");
+	} else {
+		ZVAL_COPY_VALUE(&ttl, lifetime);
+	}
+	now_time = (long)time(NULL);
+	ZVAL_LONG(&expired, (now_time + phalcon_get_intval(&ttl)));
+
+	phalcon_read_property(&lmdb, getThis(), SL("_lmdb"), PH_READONLY);
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	PHALCON_CALL_METHOD(NULL, &lmdb, "begin");
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval key_name = {}, prepared_val = {}, cached_content = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+		if (str_key) {
+			ZVAL_STR(&key_name, str_key);
+		} else {
+			ZVAL_LONG(&key_name, idx);
+		}
+
+		PHALCON_CALL_METHOD(&prepared_val, &frontend, "beforestore", value);
+
+		array_init_size(&cached_content, 3);
+		phalcon_array_append(&cached_content, &prepared_val, 0);
+		phalcon_array_append(&cached_content, &expired, PH_COPY);
+		phalcon_array_append_long(&cached_content, now_time, 0);
+
+		PHALCON_CALL_METHOD(NULL, &lmdb, "put", &key_name, &cached_content);
+		zval_ptr_dtor(&cached_content);
+	} ZEND_HASH_FOREACH_END();
+	PHALCON_CALL_METHOD(NULL, &lmdb, "commit");
+
+	RETURN_TRUE;
+}
+
+/**
+ * Deletes several keys inside one transaction
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Lmdb, deleteMultiple){
+
+	zval *keys, *key_name, lmdb = {};
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	phalcon_read_property(&lmdb, getThis(), SL("_lmdb"), PH_READONLY);
+
+	PHALCON_CALL_METHOD(NULL, &lmdb, "begin");
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval ret = {};
+		PHALCON_CALL_METHOD(&ret, &lmdb, "del", key_name);
+		if (!zend_is_true(&ret)) {
+			success = 0;
+		}
+	} ZEND_HASH_FOREACH_END();
+	PHALCON_CALL_METHOD(NULL, &lmdb, "commit");
+
+	RETURN_BOOL(success);
+}
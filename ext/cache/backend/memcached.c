@@ -78,6 +78,11 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcached, _connect);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, get);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, save);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, delete);
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, deleteMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, _lock);
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, _unlock);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, queryKeys);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, exists);
 PHP_METHOD(Phalcon_Cache_Backend_Memcached, increment);
@@ -101,6 +106,11 @@ static const zend_function_entry phalcon_cache_backend_memcached_method_entry[]
 	PHP_ME(Phalcon_Cache_Backend_Memcached, get, arginfo_phalcon_cache_backendinterface_get, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Memcached, save, arginfo_phalcon_cache_backendinterface_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Memcached, delete, arginfo_phalcon_cache_backendinterface_delete, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Memcached, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Memcached, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Memcached, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Memcached, _lock, arginfo_phalcon_cache_backend__lock, ZEND_ACC_PROTECTED)
+	PHP_ME(Phalcon_Cache_Backend_Memcached, _unlock, arginfo_phalcon_cache_backend__unlock, ZEND_ACC_PROTECTED)
 	PHP_ME(Phalcon_Cache_Backend_Memcached, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Memcached, exists, arginfo_phalcon_cache_backendinterface_exists, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Memcached, increment, arginfo_phalcon_cache_backendinterface_increment, ZEND_ACC_PUBLIC)
@@ -622,3 +632,265 @@ PHP_METHOD(Phalcon_Cache_Backend_Memcached, setTrackingKey)
 
 	RETURN_THIS();
 }
+
+/**
+ * Returns the cached contents of several keys with a single getMulti, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, memcache = {}, frontend = {}, prefix = {}, prefixed_keys = {}, values = {};
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		return;
+	}
+
+	phalcon_read_property(&memcache, getThis(), SL("_memcache"), PH_COPY);
+	if (Z_TYPE(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&memcache, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	array_init_size(&prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval prefixed_key = {};
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, key_name);
+		phalcon_array_append(&prefixed_keys, &prefixed_key, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	PHALCON_CALL_METHOD(&values, &memcache, "getmulti", &prefixed_keys);
+	zval_ptr_dtor(&memcache);
+
+	/* getMulti only returns the keys that were found, indexed by the prefixed key */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval prefixed_key = {}, cached_content = {}, value = {};
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, key_name);
+		if (Z_TYPE(values) != IS_ARRAY || !phalcon_array_isset_fetch(&cached_content, &values, &prefixed_key, PH_READONLY) || PHALCON_IS_FALSE(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+		} else if (phalcon_is_numeric(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &cached_content, PH_COPY);
+		} else {
+			PHALCON_CALL_METHOD(&value, &frontend, "afterretrieve", &cached_content);
+			phalcon_array_update(return_value, key_name, &value, 0);
+		}
+		zval_ptr_dtor(&prefixed_key);
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&prefixed_keys);
+	zval_ptr_dtor(&values);
+}
+
+/**
+ * Stores several key/value pairs with a single setMulti, null values are skipped
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value, memcache = {}, frontend = {}, prefix = {}, ttl = {}, data = {}, success = {}, options = {}, special_key = {}, keys = {};
+	zend_string *str_key;
+	ulong idx;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&ttl, getThis(), "getlifetime");
+	} else {
+		ZVAL_COPY(&ttl, lifetime);
+	}
+
+	phalcon_read_property(&memcache, getThis(), SL("_memcache"), PH_COPY);
+	if (Z_TYPE(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&memcache, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	array_init_size(&data, zend_hash_num_elements(Z_ARRVAL_P(items)));
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval key_name = {}, prefixed_key = {}, prepared_content = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+		if (str_key) {
+			ZVAL_STR(&key_name, str_key);
+		} else {
+			ZVAL_LONG(&key_name, idx);
+		}
+
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, &key_name);
+		if (phalcon_is_numeric(value)) {
+			ZVAL_COPY(&prepared_content, value);
+		} else {
+			PHALCON_CALL_METHOD(&prepared_content, &frontend, "beforestore", value);
+		}
+		phalcon_array_update(&data, &prefixed_key, &prepared_content, 0);
+		zval_ptr_dtor(&prefixed_key);
+	} ZEND_HASH_FOREACH_END();
+
+	if (!zend_hash_num_elements(Z_ARRVAL(data))) {
+		zval_ptr_dtor(&data);
+		zval_ptr_dtor(&memcache);
+		zval_ptr_dtor(&ttl);
+		RETURN_TRUE;
+	}
+
+	PHALCON_CALL_METHOD(&success, &memcache, "setmulti", &data, &ttl);
+
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	if (zend_is_true(&success) && phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key)) {
+		/* Update the stats key once for the whole batch */
+		PHALCON_CALL_METHOD(&keys, &memcache, "get", &special_key);
+		if (Z_TYPE(keys) != IS_ARRAY) {
+			array_init(&keys);
+		}
+
+		ZEND_HASH_FOREACH_KEY(Z_ARRVAL(data), idx, str_key) {
+			zval prefixed_key = {};
+			if (str_key) {
+				ZVAL_STR(&prefixed_key, str_key);
+			} else {
+				ZVAL_LONG(&prefixed_key, idx);
+			}
+			phalcon_array_update(&keys, &prefixed_key, &ttl, PH_COPY);
+		} ZEND_HASH_FOREACH_END();
+
+		PHALCON_CALL_METHOD(NULL, &memcache, "set", &special_key, &keys);
+		zval_ptr_dtor(&keys);
+	}
+	zval_ptr_dtor(&data);
+	zval_ptr_dtor(&memcache);
+	zval_ptr_dtor(&ttl);
+
+	RETURN_BOOL(zend_is_true(&success));
+}
+
+/**
+ * Deletes several keys with a single deleteMulti
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, deleteMultiple){
+
+	zval *keys, *key_name, memcache = {}, prefix = {}, prefixed_keys = {}, options = {}, special_key = {}, tracked_keys = {}, results = {}, *result;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		RETURN_TRUE;
+	}
+
+	phalcon_read_property(&memcache, getThis(), SL("_memcache"), PH_COPY);
+	if (Z_TYPE(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&memcache, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	array_init_size(&prefixed_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval prefixed_key = {};
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, key_name);
+		phalcon_array_append(&prefixed_keys, &prefixed_key, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	if (phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key)) {
+		PHALCON_CALL_METHOD(&tracked_keys, &memcache, "get", &special_key);
+		if (Z_TYPE(tracked_keys) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(prefixed_keys), key_name) {
+				phalcon_array_unset(&tracked_keys, key_name, 0);
+			} ZEND_HASH_FOREACH_END();
+			PHALCON_CALL_METHOD(NULL, &memcache, "set", &special_key, &tracked_keys);
+		}
+		zval_ptr_dtor(&tracked_keys);
+	}
+
+	/* deleteMulti replies true or a result code for every key */
+	PHALCON_CALL_METHOD(&results, &memcache, "deletemulti", &prefixed_keys);
+	zval_ptr_dtor(&prefixed_keys);
+	zval_ptr_dtor(&memcache);
+
+	if (Z_TYPE(results) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(results), result) {
+			if (!PHALCON_IS_TRUE(result)) {
+				success = 0;
+				break;
+			}
+		} ZEND_HASH_FOREACH_END();
+	} else {
+		success = zend_is_true(&results);
+	}
+	zval_ptr_dtor(&results);
+
+	RETURN_BOOL(success);
+}
+
+/**
+ * Takes the regeneration lock of a key with Memcached::add(), shared by every host using the servers
+ *
+ * @param int|string $keyName
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, _lock){
+
+	zval *key_name, *lifetime, memcache = {}, prefix = {}, lock_key = {}, ret = {};
+
+	phalcon_fetch_params(0, 2, 0, &key_name, &lifetime);
+
+	phalcon_read_property(&memcache, getThis(), SL("_memcache"), PH_COPY);
+	if (Z_TYPE(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&memcache, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	PHALCON_CONCAT_SVV(&lock_key, "_PHCL", &prefix, key_name);
+
+	PHALCON_CALL_METHOD(&ret, &memcache, "add", &lock_key, &PHALCON_GLOBAL(z_one), lifetime);
+	zval_ptr_dtor(&lock_key);
+	zval_ptr_dtor(&memcache);
+
+	RETURN_BOOL(zend_is_true(&ret));
+}
+
+/**
+ * Releases the regeneration lock of a key
+ *
+ * @param int|string $keyName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Memcached, _unlock){
+
+	zval *key_name, memcache = {}, prefix = {}, lock_key = {};
+
+	phalcon_fetch_params(0, 1, 0, &key_name);
+
+	phalcon_read_property(&memcache, getThis(), SL("_memcache"), PH_COPY);
+	if (Z_TYPE(memcache) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&memcache, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	PHALCON_CONCAT_SVV(&lock_key, "_PHCL", &prefix, key_name);
+
+	PHALCON_RETURN_CALL_METHOD(&memcache, "delete", &lock_key);
+	zval_ptr_dtor(&lock_key);
+	zval_ptr_dtor(&memcache);
+}
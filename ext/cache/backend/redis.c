@@ -73,6 +73,11 @@ PHP_METHOD(Phalcon_Cache_Backend_Redis, _connect);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, get);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, save);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, delete);
+PHP_METHOD(Phalcon_Cache_Backend_Redis, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Redis, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Redis, deleteMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Redis, _lock);
+PHP_METHOD(Phalcon_Cache_Backend_Redis, _unlock);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, queryKeys);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, exists);
 PHP_METHOD(Phalcon_Cache_Backend_Redis, increment);
@@ -97,6 +102,11 @@ static const zend_function_entry phalcon_cache_backend_redis_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Backend_Redis, get, arginfo_phalcon_cache_backendinterface_get, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Redis, save, arginfo_phalcon_cache_backendinterface_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Redis, delete, arginfo_phalcon_cache_backendinterface_delete, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Redis, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Redis, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Redis, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Redis, _lock, arginfo_phalcon_cache_backend__lock, ZEND_ACC_PROTECTED)
+	PHP_ME(Phalcon_Cache_Backend_Redis, _unlock, arginfo_phalcon_cache_backend__unlock, ZEND_ACC_PROTECTED)
 	PHP_ME(Phalcon_Cache_Backend_Redis, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Redis, exists, arginfo_phalcon_cache_backendinterface_exists, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Redis, increment, arginfo_phalcon_cache_backendinterface_increment, ZEND_ACC_PUBLIC)
@@ -622,3 +632,322 @@ PHP_METHOD(Phalcon_Cache_Backend_Redis, setTrackingKey)
 
 	RETURN_THIS();
 }
+
+/**
+ * Returns the cached contents of several keys with a single MGET, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Redis, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, redis = {}, frontend = {}, prefix = {}, last_keys = {}, values = {};
+	ulong idx = 0;
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		return;
+	}
+
+	phalcon_read_property(&redis, getThis(), SL("_redis"), PH_COPY);
+	if (Z_TYPE(redis) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&redis, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	array_init_size(&last_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval last_key = {};
+		PHALCON_CONCAT_SVV(&last_key, "_PHCR", &prefix, key_name);
+		phalcon_array_append(&last_keys, &last_key, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	PHALCON_CALL_METHOD(&values, &redis, "mget", &last_keys);
+	zval_ptr_dtor(&last_keys);
+	zval_ptr_dtor(&redis);
+
+	/* MGET returns the values in the same order as the requested keys */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval cached_content = {}, value = {};
+		if (Z_TYPE(values) != IS_ARRAY || !phalcon_array_isset_fetch_long(&cached_content, &values, idx, PH_READONLY) || PHALCON_IS_FALSE(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+		} else if (phalcon_is_numeric(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &cached_content, PH_COPY);
+		} else {
+			PHALCON_CALL_METHOD(&value, &frontend, "afterretrieve", &cached_content);
+			phalcon_array_update(return_value, key_name, &value, 0);
+		}
+		idx++;
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&values);
+}
+
+/**
+ * Leaves the pipeline opened by multi() after a failed call, otherwise every later command on
+ * the connection would be queued instead of sent
+ */
+static int phalcon_cache_backend_redis_discard(zval *redis)
+{
+	int flag;
+
+	zend_exception_save();
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, redis, "discard");
+	zend_exception_restore();
+
+	return flag;
+}
+
+/**
+ * Stores several key/value pairs in one pipelined round-trip, null values are skipped
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Redis, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value, redis = {}, frontend = {}, prefix = {}, ttl = {}, mode = {}, options = {}, special_key = {}, results = {}, *result;
+	zend_string *str_key;
+	ulong idx;
+	int track_keys, flag = SUCCESS;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&ttl, getThis(), "getlifetime");
+	} else {
+		ZVAL_COPY(&ttl, lifetime);
+	}
+
+	phalcon_read_property(&redis, getThis(), SL("_redis"), PH_COPY);
+	if (Z_TYPE(redis) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&redis, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	track_keys = phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key);
+
+	/* Redis::PIPELINE */
+	ZVAL_LONG(&mode, 2);
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "multi", &mode);
+	if (flag == FAILURE) {
+		zval_ptr_dtor(&redis);
+		zval_ptr_dtor(&ttl);
+		return;
+	}
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval key_name = {}, prefixed_key = {}, last_key = {}, prepared_content = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+		if (str_key) {
+			ZVAL_STR(&key_name, str_key);
+		} else {
+			ZVAL_LONG(&key_name, idx);
+		}
+
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, &key_name);
+		PHALCON_CONCAT_SV(&last_key, "_PHCR", &prefixed_key);
+
+		if (phalcon_is_numeric(value)) {
+			ZVAL_COPY(&prepared_content, value);
+		} else {
+			PHALCON_CALL_METHOD_FLAG(flag, &prepared_content, &frontend, "beforestore", value);
+		}
+
+		if (flag == SUCCESS) {
+			if (zend_is_true(&ttl)) {
+				PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "setex", &last_key, &ttl, &prepared_content);
+			} else {
+				PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "set", &last_key, &prepared_content);
+			}
+		}
+		zval_ptr_dtor(&prepared_content);
+		zval_ptr_dtor(&last_key);
+
+		if (flag == SUCCESS && track_keys) {
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "sadd", &special_key, &prefixed_key);
+		}
+		zval_ptr_dtor(&prefixed_key);
+
+		if (flag == FAILURE) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (flag == FAILURE) {
+		phalcon_cache_backend_redis_discard(&redis);
+		zval_ptr_dtor(&redis);
+		zval_ptr_dtor(&ttl);
+		return;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &results, &redis, "exec");
+	zval_ptr_dtor(&redis);
+	zval_ptr_dtor(&ttl);
+	if (flag == FAILURE) {
+		return;
+	}
+
+	if (Z_TYPE(results) != IS_ARRAY) {
+		zval_ptr_dtor(&results);
+		RETURN_FALSE;
+	}
+
+	/* SADD replies with the number of added members, only SET/SETEX can reply false */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(results), result) {
+		if (PHALCON_IS_FALSE(result)) {
+			zval_ptr_dtor(&results);
+			RETURN_FALSE;
+		}
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&results);
+
+	RETURN_TRUE;
+}
+
+/**
+ * Deletes several keys with a single DEL
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Redis, deleteMultiple){
+
+	zval *keys, *key_name, redis = {}, prefix = {}, last_keys = {}, options = {}, special_key = {}, mode = {}, ret = {};
+	int track_keys, flag = SUCCESS;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		RETURN_TRUE;
+	}
+
+	phalcon_read_property(&redis, getThis(), SL("_redis"), PH_COPY);
+	if (Z_TYPE(redis) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&redis, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	track_keys = phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key);
+
+	if (track_keys) {
+		/* Redis::PIPELINE */
+		ZVAL_LONG(&mode, 2);
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "multi", &mode);
+		if (flag == FAILURE) {
+			zval_ptr_dtor(&redis);
+			return;
+		}
+	}
+
+	array_init_size(&last_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval prefixed_key = {}, last_key = {};
+		PHALCON_CONCAT_VV(&prefixed_key, &prefix, key_name);
+		PHALCON_CONCAT_SV(&last_key, "_PHCR", &prefixed_key);
+		if (track_keys) {
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "srem", &special_key, &prefixed_key);
+		}
+		zval_ptr_dtor(&prefixed_key);
+		phalcon_array_append(&last_keys, &last_key, 0);
+		if (flag == FAILURE) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (track_keys) {
+		if (flag == FAILURE) {
+			phalcon_cache_backend_redis_discard(&redis);
+			zval_ptr_dtor(&last_keys);
+			zval_ptr_dtor(&redis);
+			return;
+		}
+
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &redis, "exec");
+		if (flag == FAILURE) {
+			zval_ptr_dtor(&last_keys);
+			zval_ptr_dtor(&redis);
+			return;
+		}
+	}
+
+	PHALCON_CALL_METHOD(&ret, &redis, "delete", &last_keys);
+	zval_ptr_dtor(&last_keys);
+	zval_ptr_dtor(&redis);
+
+	RETURN_BOOL(phalcon_get_intval(&ret) == zend_hash_num_elements(Z_ARRVAL_P(keys)));
+}
+
+/**
+ * Takes the regeneration lock of a key with SET NX, shared by every host using the server
+ *
+ * @param int|string $keyName
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Redis, _lock){
+
+	zval *key_name, *lifetime, redis = {}, prefix = {}, lock_key = {}, options = {}, ret = {};
+
+	phalcon_fetch_params(0, 2, 0, &key_name, &lifetime);
+
+	phalcon_read_property(&redis, getThis(), SL("_redis"), PH_COPY);
+	if (Z_TYPE(redis) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&redis, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	PHALCON_CONCAT_SVV(&lock_key, "_PHCL", &prefix, key_name);
+
+	array_init_size(&options, 2);
+	phalcon_array_append_str(&options, SL("nx"), 0);
+	phalcon_array_update_str(&options, SL("ex"), lifetime, PH_COPY);
+
+	PHALCON_CALL_METHOD(&ret, &redis, "set", &lock_key, &PHALCON_GLOBAL(z_one), &options);
+	zval_ptr_dtor(&options);
+	zval_ptr_dtor(&lock_key);
+	zval_ptr_dtor(&redis);
+
+	RETURN_BOOL(zend_is_true(&ret));
+}
+
+/**
+ * Releases the regeneration lock of a key
+ *
+ * @param int|string $keyName
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Redis, _unlock){
+
+	zval *key_name, redis = {}, prefix = {}, lock_key = {}, ret = {};
+
+	phalcon_fetch_params(0, 1, 0, &key_name);
+
+	phalcon_read_property(&redis, getThis(), SL("_redis"), PH_COPY);
+	if (Z_TYPE(redis) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&redis, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&prefix, getThis(), SL("_prefix"), PH_READONLY);
+
+	PHALCON_CONCAT_SVV(&lock_key, "_PHCL", &prefix, key_name);
+
+	PHALCON_CALL_METHOD(&ret, &redis, "delete", &lock_key);
+	zval_ptr_dtor(&lock_key);
+	zval_ptr_dtor(&redis);
+
+	RETURN_BOOL(zend_is_true(&ret));
+}
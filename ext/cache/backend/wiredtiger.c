@@ -71,6 +71,9 @@ PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, __construct);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, get);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, save);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, delete);
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, deleteMultiple);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, queryKeys);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, exists);
 PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, increment);
@@ -87,6 +90,9 @@ static const zend_function_entry phalcon_cache_backend_wiredtiger_method_entry[]
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, get, arginfo_phalcon_cache_backendinterface_get, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, save, arginfo_phalcon_cache_backendinterface_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, delete, arginfo_phalcon_cache_backendinterface_delete, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, exists, arginfo_phalcon_cache_backendinterface_exists, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Wiredtiger, increment, arginfo_phalcon_cache_backendinterface_increment, ZEND_ACC_PUBLIC)
@@ -442,3 +448,143 @@ PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, flush){
 
 	RETURN_TRUE;
 }
+
+/**
+ * Returns the cached contents of several keys with a single cursor call, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, cursor = {}, frontend = {}, values = {};
+	zend_string *str_key;
+	ulong idx;
+	long int now;
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		return;
+	}
+
+	phalcon_read_property(&cursor, getThis(), SL("_cursor"), PH_READONLY);
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	/* The cursor indexes the values like the requested keys */
+	PHALCON_CALL_METHOD(&values, &cursor, "gets", keys);
+
+	now = (long int)time(NULL);
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(keys), idx, str_key, key_name) {
+		zval index = {}, cached_content = {}, val = {}, expired = {}, value = {};
+		if (str_key) {
+			ZVAL_STR(&index, str_key);
+		} else {
+			ZVAL_LONG(&index, idx);
+		}
+
+		if (Z_TYPE(values) != IS_ARRAY || !phalcon_array_isset_fetch(&cached_content, &values, &index, PH_READONLY)
+			|| Z_TYPE(cached_content) != IS_ARRAY || !phalcon_array_isset_fetch_long(&val, &cached_content, 0, PH_READONLY)) {
+			phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+			continue;
+		}
+
+		if (phalcon_array_isset_fetch_long(&expired, &cached_content, 1, PH_READONLY)) {
+			if (phalcon_get_intval(&expired) < now) {
+				PHALCON_CALL_METHOD(NULL, &cursor, "delete", key_name);
+			}
+		}
+
+		if (PHALCON_IS_NOT_EMPTY(&val)) {
+			PHALCON_CALL_METHOD(&value, &frontend, "afterretrieve", &val);
+			phalcon_array_update(return_value, key_name, &value, 0);
+		} else {
+			phalcon_array_update(return_value, key_name, &val, PH_COPY);
+		}
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&values);
+}
+
+/**
+ * Stores several key/value pairs inside one transaction, null values are skipped
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value, cursor = {}, frontend = {}, ttl = {}, expired = {}, data = {}, success = {};
+	zend_string *str_key;
+	ulong idx;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&ttl, getThis(), "getlifetime");
+	} else {
+		ZVAL_COPY_VALUE(&ttl, lifetime);
+	}
+	ZVAL_LONG(&expired, (time(NULL) + phalcon_get_intval(&ttl)));
+
+	phalcon_read_property(&cursor, getThis(), SL("_cursor"), PH_READONLY);
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	array_init_size(&data, zend_hash_num_elements(Z_ARRVAL_P(items)));
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval prepared_val = {}, cached_content = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+
+		PHALCON_CALL_METHOD(&prepared_val, &frontend, "beforestore", value);
+
+		array_init_size(&cached_content, 2);
+		phalcon_array_append(&cached_content, &prepared_val, 0);
+		phalcon_array_append(&cached_content, &expired, PH_COPY);
+
+		if (str_key) {
+			phalcon_array_update_string(&data, str_key, &cached_content, 0);
+		} else {
+			phalcon_array_update_long(&data, idx, &cached_content, 0);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	/* Cursor::sets() writes the whole batch in one transaction and rolls back on failure */
+	PHALCON_CALL_METHOD(&success, &cursor, "sets", &data);
+	zval_ptr_dtor(&data);
+
+	RETURN_BOOL(!PHALCON_IS_FALSE(&success));
+}
+
+/**
+ * Deletes several keys inside one transaction
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Wiredtiger, deleteMultiple){
+
+	zval *keys, *key_name, wiredtiger = {}, cursor = {};
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	phalcon_read_property(&wiredtiger, getThis(), SL("_wiredtiger"), PH_READONLY);
+	phalcon_read_property(&cursor, getThis(), SL("_cursor"), PH_READONLY);
+
+	PHALCON_CALL_METHOD(NULL, &wiredtiger, "begin");
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval ret = {};
+		PHALCON_CALL_METHOD(&ret, &cursor, "delete", key_name);
+		if (!zend_is_true(&ret)) {
+			success = 0;
+		}
+	} ZEND_HASH_FOREACH_END();
+	PHALCON_CALL_METHOD(NULL, &wiredtiger, "commit");
+
+	RETURN_BOOL(success);
+}
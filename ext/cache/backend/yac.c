@@ -71,6 +71,9 @@ PHP_METHOD(Phalcon_Cache_Backend_Yac, _connect);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, get);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, save);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, delete);
+PHP_METHOD(Phalcon_Cache_Backend_Yac, getMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Yac, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Backend_Yac, deleteMultiple);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, queryKeys);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, exists);
 PHP_METHOD(Phalcon_Cache_Backend_Yac, increment);
@@ -94,6 +97,9 @@ static const zend_function_entry phalcon_cache_backend_yac_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Backend_Yac, get, arginfo_phalcon_cache_backendinterface_get, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Yac, save, arginfo_phalcon_cache_backendinterface_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Yac, delete, arginfo_phalcon_cache_backendinterface_delete, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Yac, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Yac, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Backend_Yac, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Yac, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Yac, exists, arginfo_phalcon_cache_backendinterface_exists, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Backend_Yac, increment, arginfo_phalcon_cache_backendinterface_increment, ZEND_ACC_PUBLIC)
@@ -540,3 +546,196 @@ PHP_METHOD(Phalcon_Cache_Backend_Yac, setTrackingKey)
 
 	RETURN_THIS();
 }
+
+/**
+ * Returns the cached contents of several keys with a single lookup pass, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Yac, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, yac = {}, frontend = {}, last_keys = {}, values = {};
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		return;
+	}
+
+	phalcon_read_property(&yac, getThis(), SL("_yac"), PH_COPY);
+	if (Z_TYPE(yac) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&yac, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	array_init_size(&last_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval last_key = {};
+		PHALCON_CONCAT_SV(&last_key, "_PHCY", key_name);
+		phalcon_array_append(&last_keys, &last_key, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	PHALCON_CALL_METHOD(&values, &yac, "get", &last_keys);
+	zval_ptr_dtor(&yac);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval last_key = {}, cached_content = {}, value = {};
+		PHALCON_CONCAT_SV(&last_key, "_PHCY", key_name);
+		if (Z_TYPE(values) != IS_ARRAY || !phalcon_array_isset_fetch(&cached_content, &values, &last_key, PH_READONLY) || PHALCON_IS_FALSE(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+		} else if (phalcon_is_numeric(&cached_content)) {
+			phalcon_array_update(return_value, key_name, &cached_content, PH_COPY);
+		} else {
+			PHALCON_CALL_METHOD(&value, &frontend, "afterretrieve", &cached_content);
+			phalcon_array_update(return_value, key_name, &value, 0);
+		}
+		zval_ptr_dtor(&last_key);
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&last_keys);
+	zval_ptr_dtor(&values);
+}
+
+/**
+ * Stores several key/value pairs with a single storage call, null values are skipped
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Yac, saveMultiple){
+
+	zval *items, *lifetime = NULL, *value, yac = {}, frontend = {}, ttl = {}, data = {}, success = {}, options = {}, special_key = {}, keys = {};
+	zend_string *str_key;
+	ulong idx;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime || Z_TYPE_P(lifetime) != IS_LONG) {
+		PHALCON_CALL_METHOD(&ttl, getThis(), "getlifetime");
+	} else {
+		ZVAL_COPY(&ttl, lifetime);
+	}
+
+	phalcon_read_property(&yac, getThis(), SL("_yac"), PH_COPY);
+	if (Z_TYPE(yac) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&yac, getThis(), "_connect");
+	}
+
+	phalcon_read_property(&frontend, getThis(), SL("_frontend"), PH_READONLY);
+
+	array_init_size(&data, zend_hash_num_elements(Z_ARRVAL_P(items)));
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+		zval key_name = {}, last_key = {}, prepared_content = {};
+		if (Z_TYPE_P(value) == IS_NULL) {
+			continue;
+		}
+		if (str_key) {
+			ZVAL_STR(&key_name, str_key);
+		} else {
+			ZVAL_LONG(&key_name, idx);
+		}
+
+		PHALCON_CONCAT_SV(&last_key, "_PHCY", &key_name);
+		if (phalcon_is_numeric(value)) {
+			ZVAL_COPY(&prepared_content, value);
+		} else {
+			PHALCON_CALL_METHOD(&prepared_content, &frontend, "beforestore", value);
+		}
+		phalcon_array_update(&data, &last_key, &prepared_content, 0);
+		zval_ptr_dtor(&last_key);
+	} ZEND_HASH_FOREACH_END();
+
+	if (!zend_hash_num_elements(Z_ARRVAL(data))) {
+		zval_ptr_dtor(&data);
+		zval_ptr_dtor(&yac);
+		zval_ptr_dtor(&ttl);
+		RETURN_TRUE;
+	}
+
+	/**
+	 * Phalcon\Cache\Yac reads the ttl from the third argument and the Yac extension from the second one
+	 */
+	PHALCON_CALL_METHOD(&success, &yac, "set", &data, &ttl, &ttl);
+	zval_ptr_dtor(&data);
+
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	if (zend_is_true(&success) && phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key)) {
+		PHALCON_CALL_METHOD(&keys, &yac, "get", &special_key);
+		if (Z_TYPE(keys) != IS_ARRAY) {
+			array_init(&keys);
+		}
+
+		ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(items), idx, str_key, value) {
+			zval key_name = {};
+			if (Z_TYPE_P(value) == IS_NULL) {
+				continue;
+			}
+			if (str_key) {
+				ZVAL_STR(&key_name, str_key);
+			} else {
+				ZVAL_LONG(&key_name, idx);
+			}
+			phalcon_array_update(&keys, &key_name, &ttl, PH_COPY);
+		} ZEND_HASH_FOREACH_END();
+
+		PHALCON_CALL_METHOD(NULL, &yac, "set", &special_key, &keys);
+		zval_ptr_dtor(&keys);
+	}
+	zval_ptr_dtor(&yac);
+	zval_ptr_dtor(&ttl);
+
+	RETURN_BOOL(zend_is_true(&success));
+}
+
+/**
+ * Deletes several keys with a single storage call
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Backend_Yac, deleteMultiple){
+
+	zval *keys, *key_name, yac = {}, last_keys = {}, options = {}, special_key = {}, tracked_keys = {}, ret = {};
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	if (!zend_hash_num_elements(Z_ARRVAL_P(keys))) {
+		RETURN_TRUE;
+	}
+
+	phalcon_read_property(&yac, getThis(), SL("_yac"), PH_COPY);
+	if (Z_TYPE(yac) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&yac, getThis(), "_connect");
+	}
+
+	array_init_size(&last_keys, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		zval last_key = {};
+		PHALCON_CONCAT_SV(&last_key, "_PHCY", key_name);
+		phalcon_array_append(&last_keys, &last_key, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	PHALCON_CALL_METHOD(&ret, &yac, "delete", &last_keys);
+	zval_ptr_dtor(&last_keys);
+
+	phalcon_read_property(&options, getThis(), SL("_options"), PH_READONLY);
+
+	if (zend_is_true(&ret) && phalcon_array_isset_fetch_str(&special_key, &options, SL("statsKey"), PH_READONLY) && PHALCON_IS_NOT_EMPTY_STRING(&special_key)) {
+		PHALCON_CALL_METHOD(&tracked_keys, &yac, "get", &special_key);
+		if (Z_TYPE(tracked_keys) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+				phalcon_array_unset(&tracked_keys, key_name, 0);
+			} ZEND_HASH_FOREACH_END();
+			PHALCON_CALL_METHOD(NULL, &yac, "set", &special_key, &tracked_keys);
+		}
+		zval_ptr_dtor(&tracked_keys);
+	}
+	zval_ptr_dtor(&yac);
+
+	RETURN_BOOL(zend_is_true(&ret));
+}
@@ -35,6 +35,9 @@ static const zend_function_entry phalcon_cache_backendinterface_method_entry[] =
 	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, queryKeys, arginfo_phalcon_cache_backendinterface_querykeys)
 	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, exists, arginfo_phalcon_cache_backendinterface_exists)
 	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, flush, NULL)
+	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple)
+	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple)
+	PHP_ABSTRACT_ME(Phalcon_Cache_BackendInterface, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple)
 	PHP_FE_END
 };
 
@@ -158,3 +161,29 @@ PHALCON_DOC_METHOD(Phalcon_Cache_BackendInterface, decrement);
  * @return boolean
  */
 PHALCON_DOC_METHOD(Phalcon_Cache_BackendInterface, flush);
+
+/**
+ * Returns the cached contents of several keys, missing keys are returned as null
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BackendInterface, getMultiple);
+
+/**
+ * Stores several key/value pairs
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BackendInterface, saveMultiple);
+
+/**
+ * Deletes several keys
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHALCON_DOC_METHOD(Phalcon_Cache_BackendInterface, deleteMultiple);
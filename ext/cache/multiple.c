@@ -26,6 +26,7 @@
 #include "kernel/exception.h"
 #include "kernel/object.h"
 #include "kernel/fcall.h"
+#include "kernel/array.h"
 
 /**
  * Phalcon\Cache\Multiple
@@ -80,6 +81,9 @@ PHP_METHOD(Phalcon_Cache_Multiple, start);
 PHP_METHOD(Phalcon_Cache_Multiple, save);
 PHP_METHOD(Phalcon_Cache_Multiple, delete);
 PHP_METHOD(Phalcon_Cache_Multiple, exists);
+PHP_METHOD(Phalcon_Cache_Multiple, getMultiple);
+PHP_METHOD(Phalcon_Cache_Multiple, saveMultiple);
+PHP_METHOD(Phalcon_Cache_Multiple, deleteMultiple);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_cache_multiple___construct, 0, 0, 0)
 	ZEND_ARG_TYPE_INFO(0, backends, IS_ARRAY, 1)
@@ -123,6 +127,9 @@ static const zend_function_entry phalcon_cache_multiple_method_entry[] = {
 	PHP_ME(Phalcon_Cache_Multiple, save, arginfo_phalcon_cache_multiple_save, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Multiple, delete, arginfo_phalcon_cache_multiple_delete, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Cache_Multiple, exists, arginfo_phalcon_cache_multiple_exists, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Multiple, getMultiple, arginfo_phalcon_cache_backendinterface_getmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Multiple, saveMultiple, arginfo_phalcon_cache_backendinterface_savemultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Cache_Multiple, deleteMultiple, arginfo_phalcon_cache_backendinterface_deletemultiple, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -320,3 +327,142 @@ PHP_METHOD(Phalcon_Cache_Multiple, exists){
 
 	RETURN_FALSE;
 }
+
+/**
+ * Returns the cached contents of several keys reading the internal backends in order.
+ * Every backend is asked only for the keys still missing, and the keys found in a
+ * slower backend are written back to the faster ones that missed them
+ *
+ *<code>
+ * $values = $cache->getMultiple(array('user-1', 'user-2'));
+ *</code>
+ *
+ * @param array $keys
+ * @param long $lifetime
+ * @return array
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, getMultiple){
+
+	zval *keys, *lifetime = NULL, *key_name, backends = {}, *backend, missing = {}, visited = {};
+
+	phalcon_fetch_params(0, 1, 1, &keys, &lifetime);
+
+	if (!lifetime) {
+		lifetime = &PHALCON_GLOBAL(z_null);
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+	array_init_size(&missing, zend_hash_num_elements(Z_ARRVAL_P(keys)));
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key_name) {
+		phalcon_array_update(return_value, key_name, &PHALCON_GLOBAL(z_null), PH_COPY);
+		phalcon_array_append(&missing, key_name, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+
+	phalcon_read_property(&backends, getThis(), SL("_backends"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(backends) != IS_ARRAY) {
+		zval_ptr_dtor(&missing);
+		return;
+	}
+
+	array_init(&visited);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(backends), backend) {
+		zval values = {}, found = {}, still_missing = {}, *faster;
+
+		if (!zend_hash_num_elements(Z_ARRVAL(missing))) {
+			break;
+		}
+
+		PHALCON_CALL_METHOD(&values, backend, "getmultiple", &missing, lifetime);
+
+		array_init(&found);
+		array_init(&still_missing);
+
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(missing), key_name) {
+			zval value = {};
+			if (Z_TYPE(values) == IS_ARRAY && phalcon_array_isset_fetch(&value, &values, key_name, PH_READONLY) && Z_TYPE(value) > IS_NULL) {
+				phalcon_array_update(return_value, key_name, &value, PH_COPY);
+				phalcon_array_update(&found, key_name, &value, PH_COPY);
+			} else {
+				phalcon_array_append(&still_missing, key_name, PH_COPY);
+			}
+		} ZEND_HASH_FOREACH_END();
+		zval_ptr_dtor(&values);
+
+		/* Backfill the faster backends, all of them missed these keys */
+		if (zend_hash_num_elements(Z_ARRVAL(found))) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(visited), faster) {
+				PHALCON_CALL_METHOD(NULL, faster, "savemultiple", &found, lifetime);
+			} ZEND_HASH_FOREACH_END();
+		}
+		zval_ptr_dtor(&found);
+
+		zval_ptr_dtor(&missing);
+		ZVAL_COPY_VALUE(&missing, &still_missing);
+
+		phalcon_array_append(&visited, backend, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&visited);
+	zval_ptr_dtor(&missing);
+}
+
+/**
+ * Stores several key/value pairs into all backends
+ *
+ * @param array $items
+ * @param long $lifetime
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, saveMultiple){
+
+	zval *items, *lifetime = NULL, backends = {}, *backend;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 1, &items, &lifetime);
+
+	if (!lifetime) {
+		lifetime = &PHALCON_GLOBAL(z_null);
+	}
+
+	phalcon_read_property(&backends, getThis(), SL("_backends"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(backends) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(backends), backend) {
+			zval ret = {};
+			PHALCON_CALL_METHOD(&ret, backend, "savemultiple", items, lifetime);
+			if (!zend_is_true(&ret)) {
+				success = 0;
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	RETURN_BOOL(success);
+}
+
+/**
+ * Deletes several keys from each backend
+ *
+ * @param array $keys
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Cache_Multiple, deleteMultiple){
+
+	zval *keys, backends = {}, *backend;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &keys);
+
+	phalcon_read_property(&backends, getThis(), SL("_backends"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(backends) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(backends), backend) {
+			zval ret = {};
+			PHALCON_CALL_METHOD(&ret, backend, "deletemultiple", keys);
+			if (!zend_is_true(&ret)) {
+				success = 0;
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	RETURN_BOOL(success);
+}
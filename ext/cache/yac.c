@@ -526,7 +526,10 @@ PHP_METHOD(Phalcon_Cache_Yac, flush) {
 		RETURN_FALSE;
 	}
 
-	phalcon_cache_yac_storage_flush();
+	/* Slots still owned by a writer are skipped, report that the flush was partial */
+	if (phalcon_cache_yac_storage_flush()) {
+		RETURN_FALSE;
+	}
 
 	RETURN_TRUE;
 }
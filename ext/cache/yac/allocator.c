@@ -91,44 +91,46 @@ void phalcon_cache_yac_allocator_shutdown(void) /* {{{ */ {
 }
 /* }}} */
 
+static inline void *phalcon_cache_yac_allocator_segment_alloc(phalcon_cache_yac_shared_segment *segment, unsigned long size) /* {{{ */ {
+	unsigned int pos;
+
+	/* Don't push pos further past the end once the segment is full */
+	if (segment->pos > segment->size - size) {
+		return NULL;
+	}
+
+	pos = PHALCON_CACHE_YAC_FETCH_ADD(&segment->pos, (unsigned int)size);
+	if (pos <= segment->size - size) {
+		return (void *)((char *)segment->p + pos);
+	}
+
+	return NULL;
+}
+/* }}} */
+
 static inline void *phalcon_cache_yac_allocator_alloc_algo2(unsigned long size, int hash) /* {{{ */ {
 	phalcon_cache_yac_shared_segment *segment;
-	unsigned int seg_size, retry, pos, current;
+	unsigned int pos, current;
+	int i, max;
+	void *p;
 
 	current = hash & PHALCON_CACHE_YAC_SG(segments_num_mask);
-	/* do we really need lock here? it depends the real life exam */
-	retry = 3;
-do_retry:
 	segment = PHALCON_CACHE_YAC_SG(segments)[current];
-	seg_size = segment->size;
-	pos = segment->pos;
-	if ((seg_size - pos) >= size) {
-do_alloc:
-		pos += size;
-		segment->pos = pos;
-		if (segment->pos == pos) {
-			return (void *)((char *)segment->p + (pos - size));
-		} else if (retry--) {
-			goto do_retry;
-		}
-		return NULL;
-    } else {
-		int i, max;
-		max = (PHALCON_CACHE_YAC_SG(segments_num) > 4)? 4 : PHALCON_CACHE_YAC_SG(segments_num);
-		for (i = 1; i < max; i++) {
-			segment = PHALCON_CACHE_YAC_SG(segments)[(current + i) & PHALCON_CACHE_YAC_SG(segments_num_mask)];
-			seg_size = segment->size;
-			pos = segment->pos;
-			if ((seg_size - pos) >= size) {
-				current = (current + i) & PHALCON_CACHE_YAC_SG(segments_num_mask);
-				goto do_alloc;
-			}
+	max = (PHALCON_CACHE_YAC_SG(segments_num) > 4)? 4 : PHALCON_CACHE_YAC_SG(segments_num);
+	for (i = 0; i < max; i++) {
+		segment = PHALCON_CACHE_YAC_SG(segments)[(current + i) & PHALCON_CACHE_YAC_SG(segments_num_mask)];
+		if ((p = phalcon_cache_yac_allocator_segment_alloc(segment, size))) {
+			return p;
 		}
-		segment->pos = 0;
-		pos = 0;
-		++PHALCON_CACHE_YAC_SG(recycles);
-		goto do_alloc;
 	}
+
+	/* All candidates are full, only one of the racing writers gets to recycle the last one */
+	pos = segment->pos;
+	if (pos > segment->size - size && PHALCON_CACHE_YAC_CAS(&segment->pos, pos, 0)) {
+		PHALCON_CACHE_YAC_COUNTER_INC(recycles);
+	}
+
+	return phalcon_cache_yac_allocator_segment_alloc(segment, size);
 }
 /* }}} */
 
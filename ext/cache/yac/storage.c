@@ -17,6 +17,12 @@
 */
 
 #include "php.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <unistd.h>
+
 #include "cache/yac/storage.h"
 #include "cache/yac/allocator.h"
 
@@ -47,10 +53,8 @@ int phalcon_cache_yac_storage_startup(unsigned long fsize, unsigned long size, c
 	PHALCON_CACHE_YAC_SG(slots_size) 	= real_size;
 	PHALCON_CACHE_YAC_SG(slots_mask) 	= real_size - 1;
 	PHALCON_CACHE_YAC_SG(slots_num)  	= 0;
-	PHALCON_CACHE_YAC_SG(fails)      	= 0;
-	PHALCON_CACHE_YAC_SG(hits)  		= 0;
-	PHALCON_CACHE_YAC_SG(miss)    	= 0;
-	PHALCON_CACHE_YAC_SG(kicks)    	= 0;
+
+	memset((char *)PHALCON_CACHE_YAC_SG(counters), 0, sizeof(PHALCON_CACHE_YAC_SG(counters)));
 
    	memset((char *)PHALCON_CACHE_YAC_SG(slots), 0, sizeof(phalcon_cache_yac_kv_key) * real_size);
 
@@ -63,6 +67,40 @@ void phalcon_cache_yac_storage_shutdown(void) /* {{{ */ {
 }
 /* }}} */
 
+phalcon_cache_yac_counters * phalcon_cache_yac_storage_counters(void) /* {{{ */ {
+	int cpu = -1;
+
+#if defined(__linux__)
+	cpu = sched_getcpu();
+#endif
+	if (cpu < 0) {
+		cpu = (int)getpid();
+	}
+
+	return &PHALCON_CACHE_YAC_SG(counters)[cpu & (PHALCON_CACHE_YAC_COUNTERS_NUM - 1)].c;
+}
+/* }}} */
+
+/* {{{ Per slot seqlock, writers make the sequence odd while they own the slot and
+ * readers retry when the sequence is odd or changed while they were copying
+ */
+static inline int phalcon_cache_yac_slot_acquire(phalcon_cache_yac_kv_key *p, unsigned int seq) {
+	if (seq & 1) {
+		return 0;
+	}
+	return PHALCON_CACHE_YAC_CAS(&p->seq, seq, seq + 1);
+}
+
+static inline void phalcon_cache_yac_slot_release(phalcon_cache_yac_kv_key *p, unsigned int acquired, phalcon_cache_yac_kv_key *k) {
+	if (k) {
+		k->seq = acquired;
+		*p = *k;
+	}
+	PHALCON_CACHE_YAC_BARRIER();
+	p->seq = acquired + 1;
+}
+/* }}} */
+
 /* {{{ MurmurHash2 (Austin Appleby)
  */
 static inline ulong phalcon_cache_yac_inline_hash_func1(char *data, unsigned int len) {
@@ -290,69 +328,91 @@ static inline unsigned int phalcon_cache_yac_crc32(char *data, unsigned int size
 }
 /* }}} */
 
-int phalcon_cache_yac_storage_find(char *key, unsigned int len, char **data, unsigned int *size, unsigned int *flag, unsigned long tv) /* {{{ */ {
-	ulong h, hash, seed;
-	phalcon_cache_yac_kv_key k, *p;
-	phalcon_cache_yac_kv_val v;
-
-	hash = h = phalcon_cache_yac_inline_hash_func1(key, len);
-	p = &(PHALCON_CACHE_YAC_SG(slots)[h & PHALCON_CACHE_YAC_SG(slots_mask)]);
-	k = *p;
-	if (k.val) {
-		char *s;
-		uint i;
-		if (k.h == hash && PHALCON_CACHE_YAC_KEY_KLEN(k) == len) {
-			v = *(k.val);
-			if (!memcmp(k.key, key, len)) {
-				s = emalloc(PHALCON_CACHE_YAC_KEY_VLEN(k) + 1);
-				memcpy(s, (char *)k.val->data, PHALCON_CACHE_YAC_KEY_VLEN(k));
-do_verify:
-				if (k.len != v.len) {
-					efree(s);
-					++PHALCON_CACHE_YAC_SG(miss);
-					return 0;
-				}
+/* {{{ Copies the value of a slot, returns 1 on hit, 0 when the slot holds another key
+ * and -1 when the key was found but the value is stale or could not be read consistently
+ */
+static int phalcon_cache_yac_storage_read_slot(phalcon_cache_yac_kv_key *p, char *key, unsigned int len, ulong hash, char **data, unsigned int *size, unsigned int *flag, unsigned long tv) {
+	phalcon_cache_yac_kv_key k;
+	unsigned int seq, vlen, v_len, retry = PHALCON_CACHE_YAC_READ_RETRIES;
+	char *s = NULL;
 
-				if (k.ttl) {
-					if (k.ttl <= tv) {
-						++PHALCON_CACHE_YAC_SG(miss);
-						efree(s);
-						return 0;
-					}
-				}
+	do {
+		seq = p->seq;
+		if (seq & 1) {
+			continue;
+		}
+		PHALCON_CACHE_YAC_BARRIER();
+		k = *p;
 
-				if (k.crc != phalcon_cache_yac_crc32(s, PHALCON_CACHE_YAC_KEY_VLEN(k))) {
+		if (!k.val || k.h != hash || PHALCON_CACHE_YAC_KEY_KLEN(k) != len || memcmp(k.key, key, len)) {
+			PHALCON_CACHE_YAC_BARRIER();
+			if (p->seq == seq) {
+				if (s) {
 					efree(s);
-					++PHALCON_CACHE_YAC_SG(miss);
-					return 0;
 				}
-				s[PHALCON_CACHE_YAC_KEY_VLEN(k)] = '\0';
-				k.val->atime = tv;
-				*data = s;
-				*size = PHALCON_CACHE_YAC_KEY_VLEN(k);
-				*flag = k.flag;
-				++PHALCON_CACHE_YAC_SG(hits);
-				return 1;
+				return 0;
 			}
+			continue;
+		}
+
+		vlen = PHALCON_CACHE_YAC_KEY_VLEN(k);
+		if (vlen > k.size || vlen > PHALCON_CACHE_YAC_STORAGE_MAX_ENTRY_LEN) {
+			continue;
+		}
+
+		s = s ? erealloc(s, vlen + 1) : emalloc(vlen + 1);
+		memcpy(s, (char *)k.val->data, vlen);
+		v_len = k.val->len;
+
+		PHALCON_CACHE_YAC_BARRIER();
+		if (p->seq != seq) {
+			continue;
+		}
+
+		/* The value memory may have been recycled by the allocator for another key */
+		if (k.len != v_len || (k.ttl && k.ttl <= tv) || k.crc != phalcon_cache_yac_crc32(s, vlen)) {
+			break;
 		}
 
+		s[vlen] = '\0';
+		if (k.val->atime != tv) {
+			k.val->atime = tv;
+		}
+		*data = s;
+		*size = vlen;
+		*flag = k.flag;
+		return 1;
+	} while (retry--);
+
+	if (s) {
+		efree(s);
+	}
+	return -1;
+}
+/* }}} */
+
+int phalcon_cache_yac_storage_find(char *key, unsigned int len, char **data, unsigned int *size, unsigned int *flag, unsigned long tv) /* {{{ */ {
+	ulong h, hash, seed;
+	uint i;
+	int ret;
+
+	hash = h = phalcon_cache_yac_inline_hash_func1(key, len);
+	ret = phalcon_cache_yac_storage_read_slot(&(PHALCON_CACHE_YAC_SG(slots)[h & PHALCON_CACHE_YAC_SG(slots_mask)]), key, len, hash, data, size, flag, tv);
+
+	if (!ret) {
 		seed = phalcon_cache_yac_inline_hash_func2(key, len);
-		for (i = 0; i < 3; i++) {
+		for (i = 0; i < 3 && !ret; i++) {
 			h += seed & PHALCON_CACHE_YAC_SG(slots_mask);
-			p = &(PHALCON_CACHE_YAC_SG(slots)[h & PHALCON_CACHE_YAC_SG(slots_mask)]);
-			k = *p;
-			if (k.h == hash && PHALCON_CACHE_YAC_KEY_KLEN(k) == len) {
-				v = *(k.val);
-				if (!memcmp(k.key, key, len)) {
-					s = emalloc(PHALCON_CACHE_YAC_KEY_VLEN(k) + 1);
-					memcpy(s, (char *)k.val->data, PHALCON_CACHE_YAC_KEY_VLEN(k));
-					goto do_verify;
-				}
-			}
+			ret = phalcon_cache_yac_storage_read_slot(&(PHALCON_CACHE_YAC_SG(slots)[h & PHALCON_CACHE_YAC_SG(slots_mask)]), key, len, hash, data, size, flag, tv);
 		}
 	}
 
-	++PHALCON_CACHE_YAC_SG(miss);
+	if (ret == 1) {
+		PHALCON_CACHE_YAC_COUNTER_INC(hits);
+		return 1;
+	}
+
+	PHALCON_CACHE_YAC_COUNTER_INC(miss);
 
 	return 0;
 }
@@ -369,10 +429,13 @@ void phalcon_cache_yac_storage_delete(char *key, unsigned int len, int ttl, unsi
 		uint i;
 		if (k.h == hash && PHALCON_CACHE_YAC_KEY_KLEN(k) == len) {
 			if (!memcmp((char *)k.key, key, len)) {
-				if (ttl == 0) {
-					p->ttl = 1;
-				} else {
-					p->ttl = ttl + tv;
+				if (phalcon_cache_yac_slot_acquire(p, k.seq)) {
+					if (ttl == 0) {
+						p->ttl = 1;
+					} else {
+						p->ttl = ttl + tv;
+					}
+					phalcon_cache_yac_slot_release(p, k.seq + 1, NULL);
 				}
 				return;
 			}
@@ -386,7 +449,10 @@ void phalcon_cache_yac_storage_delete(char *key, unsigned int len, int ttl, unsi
 			if (k.val == NULL) {
 				return;
 			} else if (k.h == hash && PHALCON_CACHE_YAC_KEY_KLEN(k) == len && !memcmp((char *)k.key, key, len)) {
-				p->ttl = 1;
+				if (phalcon_cache_yac_slot_acquire(p, k.seq)) {
+					p->ttl = 1;
+					phalcon_cache_yac_slot_release(p, k.seq + 1, NULL);
+				}
 				return;
 			}
 		}
@@ -394,13 +460,32 @@ void phalcon_cache_yac_storage_delete(char *key, unsigned int len, int ttl, unsi
 }
 /* }}} */
 
+static inline void phalcon_cache_yac_storage_fill(phalcon_cache_yac_kv_key *k, phalcon_cache_yac_kv_val *val, char *key, unsigned int len, char *data, unsigned int size, unsigned int flag, int ttl, unsigned long tv) /* {{{ */ {
+	val->atime = tv;
+	PHALCON_CACHE_YAC_KEY_SET_LEN(*val, len, size);
+	memcpy(val->data, data, size);
+
+	if (ttl) {
+		k->ttl = tv + ttl;
+	} else {
+		k->ttl = 0;
+	}
+	k->val = val;
+	k->flag = flag;
+	memcpy(k->key, key, len);
+	PHALCON_CACHE_YAC_KEY_SET_LEN(*k, len, size);
+}
+/* }}} */
+
 int phalcon_cache_yac_storage_update(char *key, unsigned int len, char *data, unsigned int size, unsigned int flag, int ttl, int add, unsigned long tv) /* {{{ */ {
-	ulong hash, h;
+	ulong hash, h, crc;
 	int idx = 0, is_valid;
 	phalcon_cache_yac_kv_key *p, k, *paths[4];
-	phalcon_cache_yac_kv_val *val, *s;
+	phalcon_cache_yac_kv_val *val;
 	unsigned long real_size;
 
+	crc = phalcon_cache_yac_crc32(data, size);
+
 	hash = h = phalcon_cache_yac_inline_hash_func1(key, len);
 	paths[idx++] = p = &(PHALCON_CACHE_YAC_SG(slots)[h & PHALCON_CACHE_YAC_SG(slots_mask)]);
 	k = *p;
@@ -415,56 +500,35 @@ do_update:
 			if (add && (!k.ttl || k.ttl > tv) && is_valid) {
 				return 0;
 			}
-			if (k.size >= size && is_valid) {
-				s = emalloc(sizeof(phalcon_cache_yac_kv_val) + size - 1);
-				memcpy(s->data, data, size);
-				if (ttl) {
-					k.ttl = (ulong)tv + ttl;
-				} else {
-					k.ttl = 0;
+			if (k.size >= (sizeof(phalcon_cache_yac_kv_val) + size - 1) && is_valid) {
+				/* Another writer got the slot since we looked at it, let it win */
+				if (!phalcon_cache_yac_slot_acquire(p, k.seq)) {
+					return 0;
 				}
-				s->atime = tv;
-				PHALCON_CACHE_YAC_KEY_SET_LEN(*s, len, size);
-				memcpy((char *)k.val, (char *)s, sizeof(phalcon_cache_yac_kv_val) + size - 1);
-				k.crc = phalcon_cache_yac_crc32(s->data, size);
-				k.flag = flag;
-				memcpy(k.key, key, len);
-				PHALCON_CACHE_YAC_KEY_SET_LEN(k, len, size);
-				*p = k;
-				efree(s);
+				k.h = hash;
+				k.crc = crc;
+				phalcon_cache_yac_storage_fill(&k, k.val, key, len, data, size, flag, ttl, tv);
+				phalcon_cache_yac_slot_release(p, k.seq + 1, &k);
 				return 1;
 			} else {
-				uint msize;
 				real_size = phalcon_cache_yac_allocator_real_size(sizeof(phalcon_cache_yac_kv_val) + (size * PHALCON_CACHE_YAC_STORAGE_FACTOR) - 1);
 				if (!real_size) {
-					++PHALCON_CACHE_YAC_SG(fails);
+					PHALCON_CACHE_YAC_COUNTER_INC(fails);
 					return 0;
 				}
-				msize = sizeof(phalcon_cache_yac_kv_val) + size - 1;
-				s = emalloc(sizeof(phalcon_cache_yac_kv_val) + size - 1);
-				memcpy(s->data, data, size);
-				s->atime = tv;
-				PHALCON_CACHE_YAC_KEY_SET_LEN(*s, len, size);
 				val = phalcon_cache_yac_allocator_raw_alloc(real_size, (int)hash);
 				if (val) {
-					memcpy((char *)val, (char *)s, msize);
-					if (ttl) {
-						k.ttl = tv + ttl;
-					} else {
-						k.ttl = 0;
+					if (!phalcon_cache_yac_slot_acquire(p, k.seq)) {
+						return 0;
 					}
-					k.crc = phalcon_cache_yac_crc32(s->data, size);
-					k.val = val;
-					k.flag = flag;
+					k.h = hash;
+					k.crc = crc;
 					k.size = real_size;
-					memcpy(k.key, key, len);
-					PHALCON_CACHE_YAC_KEY_SET_LEN(k, len, size);
-					*p = k;
-					efree(s);
+					phalcon_cache_yac_storage_fill(&k, val, key, len, data, size, flag, ttl, tv);
+					phalcon_cache_yac_slot_release(p, k.seq + 1, &k);
 					return 1;
 				}
-				++PHALCON_CACHE_YAC_SG(fails);
-				efree(s);
+				PHALCON_CACHE_YAC_COUNTER_INC(fails);
 				return 0;
 			}
 		} else {
@@ -489,13 +553,14 @@ do_update:
 			for (i = 0; i < idx; i++) {
 				if ((paths[i]->ttl && paths[i]->ttl <= tv) || paths[i]->len != paths[i]->val->len) {
 					p = paths[i];
+					k = *p;
 					goto do_add;
 				} else if (paths[i]->val->atime < max_atime) {
 					max_atime = paths[i]->val->atime;
 					p = paths[i];
 				}
 			}
-			++PHALCON_CACHE_YAC_SG(kicks);
+			PHALCON_CACHE_YAC_COUNTER_INC(kicks);
 			k = *p;
 			k.h = hash;
 
@@ -505,61 +570,82 @@ do_update:
 do_add:
 		real_size = phalcon_cache_yac_allocator_real_size(sizeof(phalcon_cache_yac_kv_val) + (size * PHALCON_CACHE_YAC_STORAGE_FACTOR) - 1);
 		if (!real_size) {
-			++PHALCON_CACHE_YAC_SG(fails);
+			PHALCON_CACHE_YAC_COUNTER_INC(fails);
 			return 0;
 		}
-		s = emalloc(sizeof(phalcon_cache_yac_kv_val) + size - 1);
-		memcpy(s->data, data, size);
-		s->atime = tv;
-		PHALCON_CACHE_YAC_KEY_SET_LEN(*s, len, size);
 		val = phalcon_cache_yac_allocator_raw_alloc(real_size, (int)hash);
 		if (val) {
-			memcpy((char *)val, (char *)s, sizeof(phalcon_cache_yac_kv_val) + size - 1);
+			if (!phalcon_cache_yac_slot_acquire(p, k.seq)) {
+				return 0;
+			}
 			if (p->val == NULL) {
-				++PHALCON_CACHE_YAC_SG(slots_num);
+				PHALCON_CACHE_YAC_FETCH_ADD(&PHALCON_CACHE_YAC_SG(slots_num), 1);
 			}
 			k.h = hash;
-			k.val = val;
-			k.flag = flag;
+			k.crc = crc;
 			k.size = real_size;
-			k.crc = phalcon_cache_yac_crc32(s->data, size);
-			memcpy(k.key, key, len);
-			PHALCON_CACHE_YAC_KEY_SET_LEN(k, len, size);
-			if (ttl) {
-				k.ttl = tv + ttl;
-			} else {
-				k.ttl = 0;
-			}
-			*p = k;
-			efree(s);
+			phalcon_cache_yac_storage_fill(&k, val, key, len, data, size, flag, ttl, tv);
+			phalcon_cache_yac_slot_release(p, k.seq + 1, &k);
 			return 1;
 		}
-		++PHALCON_CACHE_YAC_SG(fails);
-		efree(s);
+		PHALCON_CACHE_YAC_COUNTER_INC(fails);
 	}
 
 	return 0;
 }
 /* }}} */
 
-void phalcon_cache_yac_storage_flush(void) /* {{{ */ {
-	PHALCON_CACHE_YAC_SG(slots_num) = 0;
-	memset((char *)PHALCON_CACHE_YAC_SG(slots), 0, sizeof(phalcon_cache_yac_kv_key) * PHALCON_CACHE_YAC_SG(slots_size));
+unsigned int phalcon_cache_yac_storage_flush(void) /* {{{ */ {
+	phalcon_cache_yac_kv_key empty, *p;
+	unsigned int i, seq, spins, busy = 0;
+
+	memset(&empty, 0, sizeof(phalcon_cache_yac_kv_key));
+
+	/* Every slot is emptied as a writer would do it, a slot still owned by a writer is left alone */
+	for (i = 0; i < PHALCON_CACHE_YAC_SG(slots_size); i++) {
+		p = &(PHALCON_CACHE_YAC_SG(slots)[i]);
+		spins = 0;
+		while (1) {
+			seq = p->seq;
+			if (phalcon_cache_yac_slot_acquire(p, seq)) {
+				phalcon_cache_yac_slot_release(p, seq + 1, &empty);
+				break;
+			}
+			if (spins++ >= PHALCON_CACHE_YAC_FLUSH_SPINS) {
+				busy++;
+				break;
+			}
+			sched_yield();
+		}
+	}
+
+	PHALCON_CACHE_YAC_SG(slots_num) = busy;
+
+	return busy;
 }
 /* }}} */
 
 phalcon_cache_yac_storage_info * phalcon_cache_yac_storage_get_info(void) /* {{{ */ {
 	phalcon_cache_yac_storage_info *info = emalloc(sizeof(phalcon_cache_yac_storage_info));
+	int i;
 
 	info->k_msize = (unsigned long)PHALCON_CACHE_YAC_SG(first_seg).size;
 	info->v_msize = (unsigned long)PHALCON_CACHE_YAC_SG(segments)[0]->size * (unsigned long)PHALCON_CACHE_YAC_SG(segments_num);
 	info->segment_size = PHALCON_CACHE_YAC_SG(segments)[0]->size;
 	info->segments_num = PHALCON_CACHE_YAC_SG(segments_num);
-	info->hits = PHALCON_CACHE_YAC_SG(hits);
-	info->miss = PHALCON_CACHE_YAC_SG(miss);
-	info->fails = PHALCON_CACHE_YAC_SG(fails);
-	info->kicks = PHALCON_CACHE_YAC_SG(kicks);
-	info->recycles = PHALCON_CACHE_YAC_SG(recycles);
+	info->hits = 0;
+	info->miss = 0;
+	info->fails = 0;
+	info->kicks = 0;
+	info->recycles = 0;
+	for (i = 0; i < PHALCON_CACHE_YAC_COUNTERS_NUM; i++) {
+		phalcon_cache_yac_counters *c = &PHALCON_CACHE_YAC_SG(counters)[i].c;
+		info->hits += c->hits;
+		info->miss += c->miss;
+		info->fails += c->fails;
+		info->kicks += c->kicks;
+		info->recycles += c->recycles;
+	}
 	info->slots_size = PHALCON_CACHE_YAC_SG(slots_size);
 	info->slots_num = PHALCON_CACHE_YAC_SG(slots_num);
 
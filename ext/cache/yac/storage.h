@@ -28,6 +28,20 @@
 #define PHALCON_CACHE_YAC_KEY_VLEN(k)				((k).len >> PHALCON_CACHE_YAC_KEY_VLEN_BITS)
 #define PHALCON_CACHE_YAC_KEY_SET_LEN(k, kl, vl)	    ((k).len = (vl << PHALCON_CACHE_YAC_KEY_VLEN_BITS) | (kl & PHALCON_CACHE_YAC_KEY_KLEN_MASK))
 #define PHALCON_CACHE_YAC_FULL_CRC_THRESHOLD         256
+#define PHALCON_CACHE_YAC_READ_RETRIES               3
+#define PHALCON_CACHE_YAC_FLUSH_SPINS                1000
+#define PHALCON_CACHE_YAC_CACHE_LINE_SIZE            64
+#define PHALCON_CACHE_YAC_COUNTERS_NUM               64
+
+#if defined(__GNUC__) || defined(__clang__)
+# define PHALCON_CACHE_YAC_CAS(p, o, n)              __sync_bool_compare_and_swap((p), (o), (n))
+# define PHALCON_CACHE_YAC_FETCH_ADD(p, v)           __sync_fetch_and_add((p), (v))
+# define PHALCON_CACHE_YAC_BARRIER()                 __sync_synchronize()
+#else
+# define PHALCON_CACHE_YAC_CAS(p, o, n)              ((*(p) == (o)) ? (*(p) = (n), 1) : 0)
+# define PHALCON_CACHE_YAC_FETCH_ADD(p, v)           ((*(p) += (v)) - (v))
+# define PHALCON_CACHE_YAC_BARRIER()
+#endif
 
 typedef struct {
 	unsigned long atime;
@@ -36,6 +50,7 @@ typedef struct {
 } phalcon_cache_yac_kv_val;
 
 typedef struct {
+	volatile unsigned int seq; /* odd while a writer owns the slot */
 	unsigned long h;
 	unsigned long crc;
 	unsigned int ttl;
@@ -80,15 +95,25 @@ typedef struct {
 } phalcon_cache_yac_storage_info;
 
 typedef struct {
-	phalcon_cache_yac_kv_key  *slots;
-	unsigned int slots_mask;
-	unsigned int slots_num;
-	unsigned int slots_size;
+	unsigned long hits;
 	unsigned int miss;
 	unsigned int fails;
 	unsigned int kicks;
 	unsigned int recycles;
-	unsigned long hits;
+} phalcon_cache_yac_counters;
+
+/* Each cpu bumps its own cache line, the totals are only summed up by get_info */
+typedef union {
+	phalcon_cache_yac_counters c;
+	char pad[PHALCON_CACHE_YAC_CACHE_LINE_SIZE];
+} phalcon_cache_yac_counters_line;
+
+typedef struct {
+	phalcon_cache_yac_counters_line counters[PHALCON_CACHE_YAC_COUNTERS_NUM]; /* first, so lines stay aligned with the segment */
+	phalcon_cache_yac_kv_key  *slots;
+	unsigned int slots_mask;
+	volatile unsigned int slots_num;
+	unsigned int slots_size;
 	phalcon_cache_yac_shared_segment **segments;
 	unsigned int segments_num;
 	unsigned int segments_num_mask;
@@ -99,12 +124,16 @@ extern phalcon_cache_yac_storage_globals *phalcon_cache_yac_storage;
 
 #define PHALCON_CACHE_YAC_SG(element) (phalcon_cache_yac_storage->element)
 
+phalcon_cache_yac_counters *phalcon_cache_yac_storage_counters(void);
+
+#define PHALCON_CACHE_YAC_COUNTER_INC(element) PHALCON_CACHE_YAC_FETCH_ADD(&phalcon_cache_yac_storage_counters()->element, 1)
+
 int phalcon_cache_yac_storage_startup(unsigned long first_size, unsigned long size, char **err);
 void phalcon_cache_yac_storage_shutdown(void);
 int phalcon_cache_yac_storage_find(char *key, unsigned int len, char **data, unsigned int *size, unsigned int *flag, unsigned long tv);
 int phalcon_cache_yac_storage_update(char *key, unsigned int len, char *data, unsigned int size, unsigned int falg, int ttl, int add, unsigned long tv);
 void phalcon_cache_yac_storage_delete(char *key, unsigned int len, int ttl, unsigned long tv);
-void phalcon_cache_yac_storage_flush(void);
+unsigned int phalcon_cache_yac_storage_flush(void);
 const char * phalcon_cache_yac_storage_shared_yac_name(void);
 phalcon_cache_yac_storage_info * phalcon_cache_yac_storage_get_info(void);
 void phalcon_cache_yac_storage_free_info(phalcon_cache_yac_storage_info *info);
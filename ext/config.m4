@@ -530,6 +530,7 @@ db/adapterinterface.c \
 db/dialect.c \
 db/adapter.c \
 db/rawvalue.c \
+db/pool.c \
 db/columninterface.c \
 forms/form.c \
 forms/manager.c \
@@ -655,6 +656,7 @@ mvc/model/metadata/strategy/introspection.c \
 mvc/model/metadata/strategy/annotations.c \
 mvc/model/metadata/apc.c \
 mvc/model/metadata/memory.c \
+mvc/model/metadata/snapshot.c \
 mvc/model/metadata/session.c \
 mvc/model/metadata/memcached.c \
 mvc/model/metadata/redis.c \
@@ -691,6 +693,7 @@ mvc/model/transaction/manager.c \
 mvc/model/transaction/exception.c \
 mvc/model/queryinterface.c \
 mvc/model/row.c \
+mvc/model/row/columnar.c \
 mvc/model/criteria.c \
 mvc/model/resultset/complex.c \
 mvc/model/resultset/simple.c \
@@ -822,6 +825,7 @@ annotations/annotation.c \
 annotations/readerinterface.c \
 annotations/adapter/files.c \
 annotations/adapter/apc.c \
+annotations/adapter/yac.c \
 annotations/adapter/memory.c \
 annotations/adapter/cache.c \
 annotations/exception.c \
@@ -55,6 +55,8 @@ PHP_METHOD(Phalcon_Db_Adapter, fetchOne);
 PHP_METHOD(Phalcon_Db_Adapter, fetchAll);
 PHP_METHOD(Phalcon_Db_Adapter, insert);
 PHP_METHOD(Phalcon_Db_Adapter, insertAsDict);
+PHP_METHOD(Phalcon_Db_Adapter, insertMultiple);
+PHP_METHOD(Phalcon_Db_Adapter, upsertMultiple);
 PHP_METHOD(Phalcon_Db_Adapter, update);
 PHP_METHOD(Phalcon_Db_Adapter, delete);
 PHP_METHOD(Phalcon_Db_Adapter, getColumnList);
@@ -114,6 +116,22 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_insertasdict, 0, 0, 2)
 	ZEND_ARG_INFO(0, dataTypes)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_insertmultiple, 0, 0, 2)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, rows)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, dataTypes)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_upsertmultiple, 0, 0, 2)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, rows)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, dataTypes)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, conflictFields)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_db_adapter_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter, __construct, NULL, ZEND_ACC_PROTECTED|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Db_Adapter, setProfiler, arginfo_phalcon_db_adapter_setprofiler, ZEND_ACC_PUBLIC)
@@ -124,6 +142,8 @@ static const zend_function_entry phalcon_db_adapter_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter, fetchAll, arginfo_phalcon_db_adapterinterface_fetchall, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter, insert, arginfo_phalcon_db_adapterinterface_insert, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter, insertAsDict, arginfo_phalcon_db_adapter_insertasdict, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter, insertMultiple, arginfo_phalcon_db_adapter_insertmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter, upsertMultiple, arginfo_phalcon_db_adapter_upsertmultiple, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter, update, arginfo_phalcon_db_adapterinterface_update, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter, delete, arginfo_phalcon_db_adapterinterface_delete, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter, getColumnList, arginfo_phalcon_db_adapterinterface_getcolumnlist, ZEND_ACC_PUBLIC)
@@ -190,6 +210,7 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter){
 	zend_declare_property_null(phalcon_db_adapter_ce, SL("_sqlBindTypes"), ZEND_ACC_PROTECTED);
 	zend_declare_property_long(phalcon_db_adapter_ce, SL("_transactionLevel"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_long(phalcon_db_adapter_ce, SL("_transactionsWithSavepoints"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_adapter_ce, SL("_maxBindParameters"), 999, ZEND_ACC_PROTECTED);
 	zend_declare_property_long(phalcon_db_adapter_ce, SL("_connectionConsecutive"), 0, ZEND_ACC_PROTECTED|ZEND_ACC_STATIC);
 
 	zend_class_implements(phalcon_db_adapter_ce, 1, phalcon_db_adapterinterface_ce);
@@ -643,6 +664,361 @@ PHP_METHOD(Phalcon_Db_Adapter, insertAsDict){
 	zval_ptr_dtor(&fields);
 }
 
+/**
+ * Escapes a list of identifiers the same way insert() does
+ */
+static void phalcon_db_adapter_escape_fields(zval *return_value, zval *object, zval *fields)
+{
+	zval *field;
+
+	if (Z_TYPE_P(fields) != IS_ARRAY || !PHALCON_GLOBAL(db).escape_identifiers) {
+		ZVAL_COPY(return_value, fields);
+		return;
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(fields)));
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(fields), field) {
+		zval escaped_field = {};
+		PHALCON_CALL_METHOD(&escaped_field, object, "escapeidentifier", field);
+		phalcon_array_append(return_value, &escaped_field, 0);
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Sends a chunk of rows built by insertMultiple/upsertMultiple to the database
+ */
+static int phalcon_db_adapter_execute_multiple(zval *object, zval *table, zval *fields, zval *rows, zval *values, zval *types, zval *update_fields, zval *conflict_fields, int upsert)
+{
+	zval dialect = {}, sql = {}, success = {};
+	int flag;
+
+	phalcon_read_property(&dialect, object, SL("_dialect"), PH_NOISY|PH_READONLY);
+
+	if (upsert) {
+		PHALCON_CALL_METHOD_FLAG(flag, &sql, &dialect, "upsertmultiple", table, fields, rows, update_fields, conflict_fields);
+	} else {
+		PHALCON_CALL_METHOD_FLAG(flag, &sql, &dialect, "insertmultiple", table, fields, rows);
+	}
+
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &success, object, "execute", &sql, values, types);
+	zval_ptr_dtor(&sql);
+
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	flag = zend_is_true(&success) ? SUCCESS : FAILURE;
+	zval_ptr_dtor(&success);
+	return flag;
+}
+
+/**
+ * Shared implementation of insertMultiple and upsertMultiple, rows are sent in chunks
+ * that keep every statement under the bind parameters limit of the adapter
+ */
+static void phalcon_db_adapter_insert_multiple(zval *return_value, zval *object, zval *table, zval *rows, zval *fields, zval *data_types, zval *update_fields, zval *conflict_fields, int upsert)
+{
+	zval column_names = {}, escaped_table = {}, escaped_fields = {}, escaped_update = {}, escaped_conflict = {}, max_parameters = {};
+	zval chunk_rows = {}, chunk_values = {}, chunk_types = {}, exception_message = {}, *first_row = NULL, *row, *value;
+	zend_string *str_key;
+	zend_long number_fields, chunk_size, in_chunk = 0;
+	int success = 1;
+
+	if (Z_TYPE_P(rows) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The second parameter for insertMultiple isn't an Array");
+		return;
+	}
+
+	if (!zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_CONCAT_SVS(&exception_message, "Unable to insert into ", table, " without data");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_db_exception_ce, &exception_message);
+		return;
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(rows), row) {
+		first_row = row;
+		break;
+	} ZEND_HASH_FOREACH_END();
+
+	if (!first_row || Z_TYPE_P(first_row) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(first_row))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Every row must be a non empty array");
+		return;
+	}
+
+	/**
+	 * Without explicit fields the keys of the first row are used when they are names
+	 */
+	if (Z_TYPE_P(fields) == IS_ARRAY) {
+		ZVAL_COPY(&column_names, fields);
+	} else {
+		ZEND_HASH_FOREACH_STR_KEY(Z_ARRVAL_P(first_row), str_key) {
+			if (!str_key) {
+				break;
+			}
+			if (Z_TYPE(column_names) != IS_ARRAY) {
+				array_init(&column_names);
+			}
+			phalcon_array_append_string(&column_names, str_key, PH_COPY);
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	if (Z_TYPE(column_names) == IS_ARRAY) {
+		number_fields = zend_hash_num_elements(Z_ARRVAL(column_names));
+	} else {
+		number_fields = zend_hash_num_elements(Z_ARRVAL_P(first_row));
+	}
+
+	if (upsert && Z_TYPE(column_names) != IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Upserts require the names of the fields");
+		return;
+	}
+
+	phalcon_read_property(&max_parameters, object, SL("_maxBindParameters"), PH_NOISY|PH_READONLY);
+	chunk_size = phalcon_get_intval(&max_parameters) / (number_fields ? number_fields : 1);
+	if (chunk_size < 1) {
+		chunk_size = 1;
+	}
+
+	if (PHALCON_GLOBAL(db).escape_identifiers) {
+		PHALCON_CALL_METHOD(&escaped_table, object, "escapeidentifier", table);
+	} else {
+		ZVAL_COPY(&escaped_table, table);
+	}
+
+	phalcon_db_adapter_escape_fields(&escaped_fields, object, &column_names);
+	if (EG(exception)) {
+		goto end;
+	}
+
+	if (upsert) {
+		phalcon_db_adapter_escape_fields(&escaped_update, object, update_fields);
+		phalcon_db_adapter_escape_fields(&escaped_conflict, object, conflict_fields);
+		if (EG(exception)) {
+			goto end;
+		}
+	}
+
+	array_init(&chunk_rows);
+	array_init(&chunk_values);
+	if (Z_TYPE_P(data_types) == IS_ARRAY) {
+		array_init(&chunk_types);
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(rows), row) {
+		zval placeholders = {}, *field;
+		zend_long position = 0;
+
+		if (Z_TYPE_P(row) != IS_ARRAY || zend_hash_num_elements(Z_ARRVAL_P(row)) != number_fields) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The fields count does not match the values count of every row");
+			success = 0;
+			break;
+		}
+
+		array_init_size(&placeholders, number_fields);
+
+		/**
+		 * Objects are casted using __toString, null values are converted to string 'null',
+		 * everything else is passed as '?'
+		 */
+		if (Z_TYPE(column_names) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(column_names), field) {
+				zval bind_type = {};
+				value = Z_TYPE_P(field) == IS_STRING ? zend_symtable_find(Z_ARRVAL_P(row), Z_STR_P(field)) : NULL;
+				if (!value && !(value = zend_hash_index_find(Z_ARRVAL_P(row), position))) {
+					PHALCON_CONCAT_SVS(&exception_message, "The field ", field, " is missing in one of the rows");
+					PHALCON_THROW_EXCEPTION_ZVAL(phalcon_db_exception_ce, &exception_message);
+					success = 0;
+					break;
+				}
+
+				if (Z_TYPE_P(value) == IS_OBJECT) {
+					zval str_value = {};
+					phalcon_strval(&str_value, value);
+					phalcon_array_append(&placeholders, &str_value, 0);
+				} else if (Z_TYPE_P(value) == IS_NULL) {
+					phalcon_array_append_str(&placeholders, SL("null"), 0);
+				} else {
+					phalcon_array_append_str(&placeholders, SL("?"), 0);
+					phalcon_array_append(&chunk_values, value, PH_COPY);
+					if (Z_TYPE_P(data_types) == IS_ARRAY) {
+						if (!phalcon_array_isset_fetch(&bind_type, data_types, field, PH_READONLY) && !phalcon_array_isset_fetch_long(&bind_type, data_types, position, PH_READONLY)) {
+							PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Incomplete number of bind types");
+							success = 0;
+							break;
+						}
+						phalcon_array_append(&chunk_types, &bind_type, PH_COPY);
+					}
+				}
+				position++;
+			} ZEND_HASH_FOREACH_END();
+		} else {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(row), value) {
+				zval bind_type = {};
+				if (Z_TYPE_P(value) == IS_OBJECT) {
+					zval str_value = {};
+					phalcon_strval(&str_value, value);
+					phalcon_array_append(&placeholders, &str_value, 0);
+				} else if (Z_TYPE_P(value) == IS_NULL) {
+					phalcon_array_append_str(&placeholders, SL("null"), 0);
+				} else {
+					phalcon_array_append_str(&placeholders, SL("?"), 0);
+					phalcon_array_append(&chunk_values, value, PH_COPY);
+					if (Z_TYPE_P(data_types) == IS_ARRAY) {
+						if (!phalcon_array_isset_fetch_long(&bind_type, data_types, position, PH_READONLY)) {
+							PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Incomplete number of bind types");
+							success = 0;
+							break;
+						}
+						phalcon_array_append(&chunk_types, &bind_type, PH_COPY);
+					}
+				}
+				position++;
+			} ZEND_HASH_FOREACH_END();
+		}
+
+		if (!success) {
+			zval_ptr_dtor(&placeholders);
+			break;
+		}
+
+		phalcon_array_append(&chunk_rows, &placeholders, 0);
+
+		if (++in_chunk >= chunk_size) {
+			if (phalcon_db_adapter_execute_multiple(object, &escaped_table, &escaped_fields, &chunk_rows, &chunk_values, Z_TYPE_P(data_types) == IS_ARRAY ? &chunk_types : data_types, &escaped_update, &escaped_conflict, upsert) == FAILURE) {
+				success = 0;
+				break;
+			}
+
+			zend_hash_clean(Z_ARRVAL(chunk_rows));
+			zend_hash_clean(Z_ARRVAL(chunk_values));
+			if (Z_TYPE(chunk_types) == IS_ARRAY) {
+				zend_hash_clean(Z_ARRVAL(chunk_types));
+			}
+			in_chunk = 0;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	if (success && in_chunk > 0) {
+		if (phalcon_db_adapter_execute_multiple(object, &escaped_table, &escaped_fields, &chunk_rows, &chunk_values, Z_TYPE_P(data_types) == IS_ARRAY ? &chunk_types : data_types, &escaped_update, &escaped_conflict, upsert) == FAILURE) {
+			success = 0;
+		}
+	}
+
+	zval_ptr_dtor(&chunk_rows);
+	zval_ptr_dtor(&chunk_values);
+	zval_ptr_dtor(&chunk_types);
+
+	if (!EG(exception)) {
+		RETVAL_BOOL(success);
+	}
+
+end:
+	zval_ptr_dtor(&column_names);
+	zval_ptr_dtor(&escaped_table);
+	zval_ptr_dtor(&escaped_fields);
+	zval_ptr_dtor(&escaped_update);
+	zval_ptr_dtor(&escaped_conflict);
+}
+
+/**
+ * Inserts several rows into a table with multi-row INSERT statements. Rows can be lists
+ * in the order of $fields or arrays indexed by the field names. The rows are split in as many
+ * statements as needed to keep every statement under the bind parameters limit of the adapter
+ *
+ * <code>
+ * $success = $connection->insertMultiple(
+ *     "robots",
+ *     array(
+ *         array("Astro Boy", 1952),
+ *         array("Bender", 2999)
+ *     ),
+ *     array("name", "year")
+ * );
+ *
+ * //Next SQL sentence is sent to the database system
+ * INSERT INTO `robots` (`name`, `year`) VALUES ("Astro boy", 1952), ("Bender", 2999);
+ * </code>
+ *
+ * @param string|array $table
+ * @param array $rows
+ * @param array $fields
+ * @param array $dataTypes
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Adapter, insertMultiple){
+
+	zval *table, *rows, *fields = NULL, *data_types = NULL;
+
+	phalcon_fetch_params(0, 2, 2, &table, &rows, &fields, &data_types);
+
+	if (!fields) {
+		fields = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!data_types) {
+		data_types = &PHALCON_GLOBAL(z_null);
+	}
+
+	phalcon_db_adapter_insert_multiple(return_value, getThis(), table, rows, fields, data_types, &PHALCON_GLOBAL(z_null), &PHALCON_GLOBAL(z_null), 0);
+}
+
+/**
+ * Inserts several rows into a table updating the ones that already exist. MySQL uses
+ * ON DUPLICATE KEY UPDATE, PostgreSQL uses ON CONFLICT ($conflictFields is required) and
+ * SQLite uses INSERT OR REPLACE. By default every field not part of $conflictFields is updated
+ *
+ * <code>
+ * $success = $connection->upsertMultiple(
+ *     "robots",
+ *     array(
+ *         array("id" => 1, "name" => "Astro Boy"),
+ *         array("id" => 2, "name" => "Bender")
+ *     ),
+ *     null,
+ *     null,
+ *     array("name"),
+ *     array("id")
+ * );
+ * </code>
+ *
+ * @param string|array $table
+ * @param array $rows
+ * @param array $fields
+ * @param array $dataTypes
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Adapter, upsertMultiple){
+
+	zval *table, *rows, *fields = NULL, *data_types = NULL, *update_fields = NULL, *conflict_fields = NULL;
+
+	phalcon_fetch_params(0, 2, 4, &table, &rows, &fields, &data_types, &update_fields, &conflict_fields);
+
+	if (!fields) {
+		fields = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!data_types) {
+		data_types = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!update_fields) {
+		update_fields = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!conflict_fields) {
+		conflict_fields = &PHALCON_GLOBAL(z_null);
+	}
+
+	phalcon_db_adapter_insert_multiple(return_value, getThis(), table, rows, fields, data_types, update_fields, conflict_fields, 1);
+}
+
 /**
  * Updates data on a table using custom RBDM SQL syntax
  *
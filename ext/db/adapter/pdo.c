@@ -23,6 +23,7 @@
 #include "db/exception.h"
 #include "db/result/pdo.h"
 #include "db/column.h"
+#include "db/profiler.h"
 #include "debug.h"
 
 #include <ext/pdo/php_pdo_driver.h>
@@ -55,14 +56,96 @@
  *		'port' => '3306'
  *	));
  *</code>
+ *
+ * The option 'statementCacheSize' keeps up to that number of prepared statements per connection
+ * so the SQL sent repeatedly by query/execute is only prepared once
  */
 zend_class_entry *phalcon_db_adapter_pdo_ce;
 
+/**
+ * Returns a prepared statement for the SQL, reusing the cached one unless a resultset is still using it
+ */
+static int phalcon_db_adapter_pdo_prepare_cached(zval *return_value, zval *object, zval *sql_statement)
+{
+	zval cache_size = {}, cache = {}, statement = {}, profiler = {}, first_key = {};
+	zend_string *str_key;
+	ulong idx;
+	int flag;
+
+	phalcon_read_property(&cache_size, object, SL("_statementCacheSize"), PH_NOISY|PH_READONLY);
+	if (phalcon_get_intval(&cache_size) <= 0 || Z_TYPE_P(sql_statement) != IS_STRING) {
+		PHALCON_CALL_METHOD_FLAG(flag, return_value, object, "prepare", sql_statement);
+		return flag;
+	}
+
+	phalcon_read_property(&profiler, object, SL("_profiler"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(profiler) != IS_OBJECT || !instanceof_function(Z_OBJCE(profiler), phalcon_db_profiler_ce)) {
+		ZVAL_NULL(&profiler);
+	}
+
+	if (phalcon_read_property_array(&statement, object, SL("_statementCache"), sql_statement, PH_READONLY)
+		&& Z_TYPE(statement) == IS_OBJECT && GC_REFCOUNT(Z_OBJ(statement)) == 1) {
+		ZVAL_COPY(return_value, &statement);
+
+		/**
+		 * Move the statement to the end to keep the least recently used one first
+		 */
+		phalcon_unset_property_array(object, SL("_statementCache"), sql_statement);
+		phalcon_update_property_array(object, SL("_statementCache"), sql_statement, return_value);
+
+		if (Z_TYPE(profiler) == IS_OBJECT) {
+			phalcon_property_incr(&profiler, SL("_statementCacheHits"));
+		}
+
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, return_value, "closecursor");
+		return flag;
+	}
+
+	if (Z_TYPE(profiler) == IS_OBJECT) {
+		phalcon_property_incr(&profiler, SL("_statementCacheMisses"));
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, return_value, object, "prepare", sql_statement);
+	if (flag == FAILURE || Z_TYPE_P(return_value) != IS_OBJECT) {
+		return flag;
+	}
+
+	/**
+	 * A statement in use by a resultset is not replaced, the new one is used only once
+	 */
+	if (Z_TYPE(statement) == IS_OBJECT) {
+		return SUCCESS;
+	}
+
+	phalcon_read_property(&cache, object, SL("_statementCache"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(cache) == IS_ARRAY) {
+		if (zend_hash_num_elements(Z_ARRVAL(cache)) >= phalcon_get_intval(&cache_size)) {
+			ZEND_HASH_FOREACH_KEY(Z_ARRVAL(cache), idx, str_key) {
+				if (str_key) {
+					ZVAL_STR_COPY(&first_key, str_key);
+				} else {
+					ZVAL_LONG(&first_key, idx);
+				}
+				break;
+			} ZEND_HASH_FOREACH_END();
+
+			phalcon_unset_property_array(object, SL("_statementCache"), &first_key);
+			zval_ptr_dtor(&first_key);
+		}
+	} else {
+		phalcon_update_property_empty_array(object, SL("_statementCache"));
+	}
+
+	phalcon_update_property_array(object, SL("_statementCache"), sql_statement, return_value);
+	return SUCCESS;
+}
+
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, __construct);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, prepare);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, executePrepared);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, query);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, stream);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, affectedRows);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, close);
@@ -78,6 +161,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, getTransactionLevel);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, isUnderTransaction);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, getInternalHandler);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, getErrorInfo);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, clearStatementCache);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, descriptor)
@@ -111,6 +195,7 @@ static const zend_function_entry phalcon_db_adapter_pdo_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter_Pdo, prepare, arginfo_phalcon_db_adapter_pdo_prepare, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, executePrepared, arginfo_phalcon_db_adapter_pdo_executeprepared, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, query, arginfo_phalcon_db_adapterinterface_query, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter_Pdo, stream, arginfo_phalcon_db_adapter_pdo_stream, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, execute, arginfo_phalcon_db_adapterinterface_execute, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, affectedRows, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, close, NULL, ZEND_ACC_PUBLIC)
@@ -126,6 +211,7 @@ static const zend_function_entry phalcon_db_adapter_pdo_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter_Pdo, isUnderTransaction, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, getInternalHandler, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo, getErrorInfo, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter_Pdo, clearStatementCache, NULL, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -140,6 +226,8 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo){
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_affectedRows"), ZEND_ACC_PROTECTED);
 	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_transactionLevel"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_schema"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_adapter_pdo_ce, SL("_statementCache"), ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_adapter_pdo_ce, SL("_statementCacheSize"), 0, ZEND_ACC_PROTECTED);
 
 	return SUCCESS;
 }
@@ -187,6 +275,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, __construct){
 PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect)
 {
 	zval *desc = NULL, descriptor = {}, username = {}, password = {}, options = {}, dsn_parts = {}, *value, dsn_attributes = {}, pdo_type = {}, dsn = {}, persistent = {}, pdo = {};
+	zval statement_cache_size = {};
 	zend_class_entry *ce;
 	zend_string *str_key;
 	ulong idx;
@@ -244,6 +333,14 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect)
 		phalcon_array_unset_str(&descriptor, SL("persistent"), 0);
 	}
 
+	/**
+	 * Check the number of prepared statements to keep
+	 */
+	if (phalcon_array_isset_fetch_str(&statement_cache_size, &descriptor, SL("statementCacheSize"), PH_READONLY)) {
+		phalcon_update_property_long(getThis(), SL("_statementCacheSize"), phalcon_get_intval(&statement_cache_size));
+		phalcon_array_unset_str(&descriptor, SL("statementCacheSize"), 0);
+	}
+
 	/**
 	 * Check if the user has defined a custom dsn
 	 */
@@ -284,6 +381,11 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, connect)
 	zval_ptr_dtor(&password);
 	zval_ptr_dtor(&options);
 
+	/**
+	 * The statements prepared by a previous connection can't be reused
+	 */
+	phalcon_update_property_null(getThis(), SL("_statementCache"));
+
 	phalcon_update_property(getThis(), SL("_pdo"), &pdo);
 	zval_ptr_dtor(&pdo);
 }
@@ -521,7 +623,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 	}
 	zval_ptr_dtor(&status);
 
-	PHALCON_CALL_METHOD(&statement, getThis(), "prepare", sql_statement);
+	RETURN_ON_FAILURE(phalcon_db_adapter_pdo_prepare_cached(&statement, getThis(), sql_statement));
 	if (Z_TYPE(statement) == IS_OBJECT){
 		PHALCON_CALL_METHOD(&new_statement, getThis(), "executeprepared", &statement, bind_params, bind_types);
 		zval_ptr_dtor(&statement);
@@ -546,6 +648,81 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, query){
 	RETURN_ZVAL(&statement, 0, 0);
 }
 
+/**
+ * Sends a SQL statement returning rows that are streamed from the server instead of being
+ * buffered by the client, the returned result can only be traversed forward once.
+ * The statement is never taken from the statement cache because it keeps in use until the last row is fetched
+ *
+ *<code>
+ *	$result = $connection->stream("SELECT * FROM robots");
+ *	while ($robot = $result->fetch()) {
+ *		echo $robot->name;
+ *	}
+ *</code>
+ *
+ * @param  string $sqlStatement
+ * @param  array $bindParams
+ * @param  array $bindTypes
+ * @param  int $prefetch
+ * @return Phalcon\Db\ResultInterface
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, stream){
+
+	zval *sql_statement, *bind_params = NULL, *bind_types = NULL, *prefetch = NULL, event_name = {}, status = {};
+	zval statement = {}, new_statement = {};
+
+	phalcon_fetch_params(0, 1, 3, &sql_statement, &bind_params, &bind_types, &prefetch);
+
+	if (!bind_params) {
+		bind_params = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!bind_types) {
+		bind_types = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
+		zval debug_message = {};
+		PHALCON_CONCAT_SV(&debug_message, "SQL STREAM: ", sql_statement);
+		PHALCON_DEBUG_LOG(&debug_message);
+		zval_ptr_dtor(&debug_message);
+	}
+
+	phalcon_update_property(getThis(), SL("_sqlStatement"), sql_statement);
+	phalcon_update_property(getThis(), SL("_sqlVariables"), bind_params);
+	phalcon_update_property(getThis(), SL("_sqlBindTypes"), bind_types);
+
+	ZVAL_STRING(&event_name, "db:beforeQuery");
+	PHALCON_CALL_METHOD(&status, getThis(), "fireeventcancel", &event_name, bind_params);
+	zval_ptr_dtor(&event_name);
+	if (PHALCON_IS_FALSE(&status)) {
+		RETURN_FALSE;
+	}
+	zval_ptr_dtor(&status);
+
+	PHALCON_CALL_METHOD(&statement, getThis(), "prepare", sql_statement);
+	if (Z_TYPE(statement) == IS_OBJECT) {
+		PHALCON_CALL_METHOD(&new_statement, getThis(), "executeprepared", &statement, bind_params, bind_types);
+		zval_ptr_dtor(&statement);
+		ZVAL_COPY_VALUE(&statement, &new_statement);
+	}
+
+	ZVAL_STRING(&event_name, "db:afterQuery");
+	PHALCON_CALL_METHOD(NULL, getThis(), "fireevent", &event_name, &statement);
+	zval_ptr_dtor(&event_name);
+
+	if (likely(Z_TYPE(statement) == IS_OBJECT)) {
+		object_init_ex(return_value, phalcon_db_result_pdo_ce);
+		PHALCON_CALL_METHOD(NULL, return_value, "__construct", getThis(), &statement, sql_statement, bind_params, bind_types);
+		zval_ptr_dtor(&statement);
+
+		phalcon_update_property_bool(return_value, SL("_streaming"), 1);
+		return;
+	}
+
+	RETURN_ZVAL(&statement, 0, 0);
+}
+
 /**
  * Sends SQL statements to the database server returning the success state.
  * Use this method only when the SQL statement sent to the server doesn't return any row
@@ -607,7 +784,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, execute){
 	}
 	zval_ptr_dtor(&status);
 
-	PHALCON_CALL_METHOD(&statement, getThis(), "prepare", sql_statement);
+	RETURN_ON_FAILURE(phalcon_db_adapter_pdo_prepare_cached(&statement, getThis(), sql_statement));
 	if (Z_TYPE(statement) == IS_OBJECT) {
 		PHALCON_CALL_METHOD(&new_statement, getThis(), "executeprepared", &statement, bind_params, bind_types);
 		PHALCON_CALL_METHOD(&affected_rows, &new_statement, "rowcount");
@@ -659,6 +836,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, close){
 
 	phalcon_read_property(&pdo, getThis(), SL("_pdo"), PH_NOISY|PH_READONLY);
 	if (likely(Z_TYPE(pdo) == IS_OBJECT)) {
+		phalcon_update_property_null(getThis(), SL("_statementCache"));
 		phalcon_update_property(getThis(), SL("_pdo"), &PHALCON_GLOBAL(z_null));
 		RETURN_TRUE;
 	}
@@ -1185,3 +1363,20 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo, getErrorInfo){
 	phalcon_read_property(&pdo, getThis(), SL("_pdo"), PH_NOISY|PH_READONLY);
 	PHALCON_RETURN_CALL_METHOD(&pdo, "errorinfo");
 }
+
+/**
+ * Removes the prepared statements kept by the connection, needed after changing the
+ * structure of a table used by cached statements
+ *
+ *<code>
+ * $connection->execute('ALTER TABLE robots ADD COLUMN price DECIMAL(10,2)');
+ * $connection->clearStatementCache();
+ *</code>
+ *
+ * @return Phalcon\Db\Adapter\Pdo
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo, clearStatementCache){
+
+	phalcon_update_property_null(getThis(), SL("_statementCache"));
+	RETURN_THIS();
+}
@@ -26,4 +26,11 @@ extern zend_class_entry *phalcon_db_adapter_pdo_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo);
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_adapter_pdo_stream, 0, 0, 1)
+	ZEND_ARG_INFO(0, sqlStatement)
+	ZEND_ARG_INFO(0, placeholders)
+	ZEND_ARG_INFO(0, dataTypes)
+	ZEND_ARG_INFO(0, prefetch)
+ZEND_END_ARG_INFO()
+
 #endif /* PHALCON_DB_ADAPTER_PDO_H */
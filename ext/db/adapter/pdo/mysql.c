@@ -60,6 +60,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, escapeBytea);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, unescapeBytea);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, escapeArray);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, unescapeArray);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, stream);
 
 static const zend_function_entry phalcon_db_adapter_pdo_mysql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Mysql, escapeIdentifier, arginfo_phalcon_db_adapterinterface_escapeidentifier, ZEND_ACC_PUBLIC)
@@ -68,6 +69,7 @@ static const zend_function_entry phalcon_db_adapter_pdo_mysql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Mysql, unescapeBytea, arginfo_phalcon_db_adapterinterface_unescapebytea, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Mysql, escapeArray, arginfo_phalcon_db_adapterinterface_escapearray, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Mysql, unescapeArray, arginfo_phalcon_db_adapterinterface_unescapearray, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter_Pdo_Mysql, stream, arginfo_phalcon_db_adapter_pdo_stream, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -80,6 +82,7 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo_Mysql){
 
 	zend_declare_property_string(phalcon_db_adapter_pdo_mysql_ce, SL("_type"), "mysql", ZEND_ACC_PROTECTED);
 	zend_declare_property_string(phalcon_db_adapter_pdo_mysql_ce, SL("_dialectType"), "mysql", ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_adapter_pdo_mysql_ce, SL("_maxBindParameters"), 65535, ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_db_adapter_pdo_mysql_ce, 1, phalcon_db_adapterinterface_ce);
 
@@ -546,3 +549,67 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, unescapeArray){
 
 	RETURN_CTOR(value);
 }
+
+/**
+ * Sends a SQL statement as an unbuffered query, the rows are read from the server as they are fetched.
+ * No other statement can be sent through the connection until all the rows were fetched
+ *
+ *<code>
+ *	$result = $connection->stream("SELECT * FROM robots");
+ *	while ($robot = $result->fetch()) {
+ *		echo $robot->name;
+ *	}
+ *</code>
+ *
+ * @param  string $sqlStatement
+ * @param  array $bindParams
+ * @param  array $bindTypes
+ * @param  int $prefetch
+ * @return Phalcon\Db\ResultInterface
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Mysql, stream){
+
+	zval *sql_statement, *bind_params = NULL, *bind_types = NULL, *prefetch = NULL, pdo = {}, attribute = {}, buffered = {};
+	int flag;
+
+	phalcon_fetch_params(0, 1, 3, &sql_statement, &bind_params, &bind_types, &prefetch);
+
+	if (!bind_params) {
+		bind_params = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!bind_types) {
+		bind_types = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!prefetch) {
+		prefetch = &PHALCON_GLOBAL(z_null);
+	}
+
+	phalcon_read_property(&pdo, getThis(), SL("_pdo"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(pdo) != IS_OBJECT) {
+		PHALCON_RETURN_CALL_PARENT(phalcon_db_adapter_pdo_mysql_ce, getThis(), "stream", sql_statement, bind_params, bind_types, prefetch);
+		return;
+	}
+
+	/**
+	 * PDO::MYSQL_ATTR_USE_BUFFERED_QUERY is read when the statement is executed
+	 */
+	ZVAL_LONG(&attribute, PDO_ATTR_DRIVER_SPECIFIC);
+	PHALCON_CALL_METHOD(&buffered, &pdo, "getattribute", &attribute);
+	PHALCON_CALL_METHOD(NULL, &pdo, "setattribute", &attribute, &PHALCON_GLOBAL(z_false));
+
+	PHALCON_RETURN_CALL_PARENT_FLAG(flag, phalcon_db_adapter_pdo_mysql_ce, getThis(), "stream", sql_statement, bind_params, bind_types, prefetch);
+
+	/**
+	 * The buffering is restored even when the statement failed
+	 */
+	if (flag == FAILURE) {
+		zend_exception_save();
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &pdo, "setattribute", &attribute, &buffered);
+		zend_exception_restore();
+	} else {
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &pdo, "setattribute", &attribute, &buffered);
+	}
+	zval_ptr_dtor(&buffered);
+}
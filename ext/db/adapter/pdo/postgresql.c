@@ -21,6 +21,7 @@
 
 #include "db/adapter/pdo/postgresql.h"
 #include "db/adapter/pdo.h"
+#include "db/result/pdo.h"
 #include "db/adapterinterface.h"
 #include "db/exception.h"
 #include "db/column.h"
@@ -68,6 +69,7 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, escapeBytea);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, unescapeBytea);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, escapeArray);
 PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, unescapeArray);
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, stream);
 
 static const zend_function_entry phalcon_db_adapter_pdo_postgresql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Postgresql, connect, arginfo_phalcon_db_adapterinterface_connect, ZEND_ACC_PUBLIC)
@@ -79,6 +81,7 @@ static const zend_function_entry phalcon_db_adapter_pdo_postgresql_method_entry[
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Postgresql, unescapeBytea, arginfo_phalcon_db_adapterinterface_unescapebytea, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Postgresql, escapeArray, arginfo_phalcon_db_adapterinterface_escapearray, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Adapter_Pdo_Postgresql, unescapeArray, arginfo_phalcon_db_adapterinterface_unescapearray, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Adapter_Pdo_Postgresql, stream, arginfo_phalcon_db_adapter_pdo_stream, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -91,6 +94,8 @@ PHALCON_INIT_CLASS(Phalcon_Db_Adapter_Pdo_Postgresql){
 
 	zend_declare_property_string(phalcon_db_adapter_pdo_postgresql_ce, SL("_type"), "pgsql", ZEND_ACC_PROTECTED);
 	zend_declare_property_string(phalcon_db_adapter_pdo_postgresql_ce, SL("_dialectType"), "postgresql", ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_adapter_pdo_postgresql_ce, SL("_maxBindParameters"), 65535, ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_adapter_pdo_postgresql_ce, SL("_cursors"), 0, ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_db_adapter_pdo_postgresql_ce, 1, phalcon_db_adapterinterface_ce);
 
@@ -695,3 +700,102 @@ PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, unescapeArray){
 
 	RETURN_ON_FAILURE(phalcon_json_decode(return_value, &ret, 1));
 }
+
+/**
+ * Sends a SQL statement through a server side cursor, the rows are fetched in batches of 'prefetch' rows
+ * so only one batch is kept by the client. Cursors only live inside a transaction, one is started when
+ * the connection isn't under a transaction and it's committed once the last row is fetched
+ *
+ *<code>
+ *	$result = $connection->stream("SELECT * FROM robots", null, null, 500);
+ *	while ($robot = $result->fetch()) {
+ *		echo $robot->name;
+ *	}
+ *</code>
+ *
+ * @param  string $sqlStatement
+ * @param  array $bindParams
+ * @param  array $bindTypes
+ * @param  int $prefetch
+ * @return Phalcon\Db\ResultInterface
+ */
+PHP_METHOD(Phalcon_Db_Adapter_Pdo_Postgresql, stream){
+
+	zval *sql_statement, *bind_params = NULL, *bind_types = NULL, *prefetch = NULL, under_transaction = {}, cursors = {};
+	zval cursor = {}, declare_sql = {}, declared = {}, size = {}, fetch_sql = {}, statement = {}, new_statement = {};
+	zend_long batch_size = 1000;
+	int flag;
+
+	phalcon_fetch_params(0, 1, 3, &sql_statement, &bind_params, &bind_types, &prefetch);
+
+	if (!bind_params) {
+		bind_params = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (!bind_types) {
+		bind_types = &PHALCON_GLOBAL(z_null);
+	}
+
+	if (prefetch && Z_TYPE_P(prefetch) != IS_NULL) {
+		batch_size = phalcon_get_intval(prefetch);
+		if (batch_size <= 0) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The number of rows to prefetch must be greater than zero");
+			return;
+		}
+	}
+
+	PHALCON_CALL_METHOD(&under_transaction, getThis(), "isundertransaction");
+	if (!zend_is_true(&under_transaction)) {
+		PHALCON_CALL_METHOD(NULL, getThis(), "begin");
+	}
+
+	phalcon_property_incr(getThis(), SL("_cursors"));
+	phalcon_read_property(&cursors, getThis(), SL("_cursors"), PH_READONLY);
+	PHALCON_CONCAT_SV(&cursor, "phalcon_cursor_", &cursors);
+
+	PHALCON_CONCAT_SVSV(&declare_sql, "DECLARE ", &cursor, " NO SCROLL CURSOR FOR ", sql_statement);
+	PHALCON_CALL_PARENT_FLAG(flag, &declared, phalcon_db_adapter_pdo_postgresql_ce, getThis(), "stream", &declare_sql, bind_params, bind_types);
+	zval_ptr_dtor(&declare_sql);
+	zval_ptr_dtor(&declared);
+
+	if (flag == SUCCESS) {
+		ZVAL_LONG(&size, batch_size);
+		PHALCON_CONCAT_SVSV(&fetch_sql, "FETCH FORWARD ", &size, " FROM ", &cursor);
+		PHALCON_CALL_METHOD_FLAG(flag, &statement, getThis(), "prepare", &fetch_sql);
+		zval_ptr_dtor(&fetch_sql);
+	}
+
+	if (flag == SUCCESS && Z_TYPE(statement) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_FLAG(flag, &new_statement, getThis(), "executeprepared", &statement);
+		zval_ptr_dtor(&statement);
+		ZVAL_COPY_VALUE(&statement, &new_statement);
+	}
+
+	if (flag == FAILURE || Z_TYPE(statement) != IS_OBJECT) {
+		zval_ptr_dtor(&statement);
+		zval_ptr_dtor(&cursor);
+
+		/**
+		 * Leave the connection as it was found
+		 */
+		if (!zend_is_true(&under_transaction)) {
+			if (flag == FAILURE) {
+				zend_exception_save();
+				PHALCON_CALL_METHOD_FLAG(flag, NULL, getThis(), "rollback");
+				zend_exception_restore();
+			} else {
+				PHALCON_CALL_METHOD(NULL, getThis(), "rollback");
+			}
+		}
+		RETURN_FALSE;
+	}
+
+	object_init_ex(return_value, phalcon_db_result_pdo_ce);
+	PHALCON_CALL_METHOD(NULL, return_value, "__construct", getThis(), &statement, sql_statement, bind_params, bind_types);
+	zval_ptr_dtor(&statement);
+
+	phalcon_update_property_bool(return_value, SL("_streaming"), 1);
+	phalcon_update_property(return_value, SL("_cursor"), &cursor);
+	phalcon_update_property_bool(return_value, SL("_cursorTransaction"), !zend_is_true(&under_transaction));
+	zval_ptr_dtor(&cursor);
+}
@@ -53,6 +53,8 @@ PHP_METHOD(Phalcon_Db_Dialect, getSqlExpressionFunctionCall);
 PHP_METHOD(Phalcon_Db_Dialect, getSqlTable);
 PHP_METHOD(Phalcon_Db_Dialect, select);
 PHP_METHOD(Phalcon_Db_Dialect, insert);
+PHP_METHOD(Phalcon_Db_Dialect, insertMultiple);
+PHP_METHOD(Phalcon_Db_Dialect, upsertMultiple);
 PHP_METHOD(Phalcon_Db_Dialect, update);
 PHP_METHOD(Phalcon_Db_Dialect, delete);
 PHP_METHOD(Phalcon_Db_Dialect, supportsSavepoints);
@@ -121,6 +123,8 @@ static const zend_function_entry phalcon_db_dialect_method_entry[] = {
 	PHP_ME(Phalcon_Db_Dialect, getSqlTable, arginfo_phalcon_db_dialect_getsqltable, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect, select, arginfo_phalcon_db_dialectinterface_select, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect, insert, arginfo_phalcon_db_dialectinterface_insert, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Dialect, insertMultiple, arginfo_phalcon_db_dialect_insertmultiple, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Dialect, upsertMultiple, arginfo_phalcon_db_dialect_upsertmultiple, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect, update, arginfo_phalcon_db_dialectinterface_update, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect, delete, arginfo_phalcon_db_dialectinterface_delete, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect, supportsSavepoints, NULL, ZEND_ACC_PUBLIC)
@@ -146,6 +150,7 @@ PHALCON_INIT_CLASS(Phalcon_Db_Dialect){
 
 	zend_declare_property_null(phalcon_db_dialect_ce, SL("_escapeChar"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_db_dialect_ce, SL("_customFunctions"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_dialect_ce, SL("_planId"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_db_dialect_ce, 1, phalcon_db_dialectinterface_ce);
 
@@ -1119,6 +1124,107 @@ PHP_METHOD(Phalcon_Db_Dialect, insert)
 	zval_ptr_dtor(&joined_values);
 }
 
+/**
+ * Builds a multi-row INSERT statement from already escaped identifiers, every row is a list
+ * of placeholders or raw SQL values
+ */
+void phalcon_db_dialect_build_insert_multiple(zval *return_value, const char *verb, zval *table, zval *fields, zval *rows)
+{
+	zval joined_rows = {}, joined_values = {}, joined_fields = {}, *row;
+
+	array_init_size(&joined_rows, zend_hash_num_elements(Z_ARRVAL_P(rows)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(rows), row) {
+		zval joined_row = {};
+		phalcon_fast_join_str(&joined_row, SL(", "), row);
+		phalcon_array_append(&joined_rows, &joined_row, 0);
+	} ZEND_HASH_FOREACH_END();
+
+	phalcon_fast_join_str(&joined_values, SL("), ("), &joined_rows);
+	zval_ptr_dtor(&joined_rows);
+
+	ZVAL_STRING(return_value, verb);
+	if (Z_TYPE_P(fields) == IS_ARRAY) {
+		phalcon_fast_join_str(&joined_fields, SL(", "), fields);
+		PHALCON_SCONCAT_SVSVSVS(return_value, " ", table, " (", &joined_fields, ") VALUES (", &joined_values, ")");
+		zval_ptr_dtor(&joined_fields);
+	} else {
+		PHALCON_SCONCAT_SVSVS(return_value, " ", table, " VALUES (", &joined_values, ")");
+	}
+	zval_ptr_dtor(&joined_values);
+}
+
+/**
+ * Returns the fields updated by an upsert, by default every inserted field that is not part of the conflict target
+ */
+void phalcon_db_dialect_get_upsert_fields(zval *return_value, zval *fields, zval *update_fields, zval *conflict_fields)
+{
+	zval *field;
+
+	if (update_fields && Z_TYPE_P(update_fields) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(update_fields))) {
+		ZVAL_COPY(return_value, update_fields);
+		return;
+	}
+
+	array_init(return_value);
+	if (Z_TYPE_P(fields) != IS_ARRAY) {
+		return;
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(fields), field) {
+		if (conflict_fields && Z_TYPE_P(conflict_fields) == IS_ARRAY && phalcon_fast_in_array(field, conflict_fields)) {
+			continue;
+		}
+		phalcon_array_append(return_value, field, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Builds an INSERT statement for several rows at once. The table and the fields must be already escaped
+ *
+ *<code>
+ * echo $dialect->insertMultiple('`robots`', array('`name`', '`year`'), array(array('?', '?'), array('?', 'null')));
+ * // INSERT INTO `robots` (`name`, `year`) VALUES (?, ?), (?, null)
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $rows
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect, insertMultiple){
+
+	zval *table, *fields, *rows;
+
+	phalcon_fetch_params(0, 3, 0, &table, &fields, &rows);
+
+	if (Z_TYPE_P(rows) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Invalid INSERT definition");
+		return;
+	}
+
+	phalcon_db_dialect_build_insert_multiple(return_value, "INSERT INTO", table, fields, rows);
+}
+
+/**
+ * Builds an INSERT statement for several rows that updates the existing ones,
+ * every dialect must implement its own syntax
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $rows
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect, upsertMultiple){
+
+	zval *table, *fields, *rows, *update_fields = NULL, *conflict_fields = NULL;
+
+	phalcon_fetch_params(0, 3, 2, &table, &fields, &rows, &update_fields, &conflict_fields);
+
+	PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Upserts are not supported by this dialect");
+}
+
 /**
  * Builds a UPDATE statement
  *
@@ -1465,6 +1571,9 @@ PHP_METHOD(Phalcon_Db_Dialect, registerCustomFunction){
 
 	phalcon_update_property_array(getThis(), SL("_customFunctions"), name, custom_function);
 
+	/* SQL generated by PHQL plans before the function was known is not reused */
+	phalcon_update_property_null(getThis(), SL("_planId"));
+
 	RETURN_THIS();
 }
 
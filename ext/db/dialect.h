@@ -26,4 +26,21 @@ extern zend_class_entry *phalcon_db_dialect_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Db_Dialect);
 
+void phalcon_db_dialect_build_insert_multiple(zval *return_value, const char *verb, zval *table, zval *fields, zval *rows);
+void phalcon_db_dialect_get_upsert_fields(zval *return_value, zval *fields, zval *update_fields, zval *conflict_fields);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_insertmultiple, 0, 0, 3)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, rows)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_upsertmultiple, 0, 0, 3)
+	ZEND_ARG_INFO(0, table)
+	ZEND_ARG_INFO(0, fields)
+	ZEND_ARG_INFO(0, rows)
+	ZEND_ARG_INFO(0, updateFields)
+	ZEND_ARG_INFO(0, conflictFields)
+ZEND_END_ARG_INFO()
+
 #endif /* PHALCON_DB_DIALECT_H */
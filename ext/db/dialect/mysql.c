@@ -67,6 +67,7 @@ PHP_METHOD(Phalcon_Db_Dialect_Mysql, describeIndexes);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, describeReferences);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, tableOptions);
 PHP_METHOD(Phalcon_Db_Dialect_Mysql, getDefaultValue);
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, upsertMultiple);
 
 static const zend_function_entry phalcon_db_dialect_mysql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Dialect_Mysql, getColumnDefinition, arginfo_phalcon_db_dialectinterface_getcolumndefinition, ZEND_ACC_PUBLIC)
@@ -93,6 +94,7 @@ static const zend_function_entry phalcon_db_dialect_mysql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Dialect_Mysql, describeReferences, arginfo_phalcon_db_dialectinterface_describereferences, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Mysql, tableOptions, arginfo_phalcon_db_dialectinterface_tableoptions, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Mysql, getDefaultValue, arginfo_phalcon_db_dialectinterface_getdefaultvalue, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Dialect_Mysql, upsertMultiple, arginfo_phalcon_db_dialect_upsertmultiple, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -1259,3 +1261,55 @@ PHP_METHOD(Phalcon_Db_Dialect_Mysql, getDefaultValue){
 	PHALCON_CONCAT_SVS(return_value, "\"", &value_cslashes, "\"");
 	zval_ptr_dtor(&value_cslashes);
 }
+
+/**
+ * Builds a multi-row INSERT that updates the rows already present using ON DUPLICATE KEY UPDATE
+ *
+ *<code>
+ * echo $dialect->upsertMultiple('`robots`', array('`id`', '`name`'), array(array('?', '?'), array('?', '?')));
+ * // INSERT INTO `robots` (`id`, `name`) VALUES (?, ?), (?, ?) ON DUPLICATE KEY UPDATE `id` = VALUES(`id`), `name` = VALUES(`name`)
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $rows
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Mysql, upsertMultiple){
+
+	zval *table, *fields, *rows, *update_fields = NULL, *conflict_fields = NULL, updates = {}, assignments = {}, joined_assignments = {}, *field;
+
+	phalcon_fetch_params(0, 3, 2, &table, &fields, &rows, &update_fields, &conflict_fields);
+
+	if (Z_TYPE_P(fields) != IS_ARRAY || Z_TYPE_P(rows) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Invalid INSERT definition");
+		return;
+	}
+
+	phalcon_db_dialect_get_upsert_fields(&updates, fields, update_fields, conflict_fields);
+
+	/**
+	 * Without fields to update the duplicated rows are left as they are
+	 */
+	if (!zend_hash_num_elements(Z_ARRVAL(updates))) {
+		zval_ptr_dtor(&updates);
+		ZVAL_COPY(&updates, fields);
+	}
+
+	array_init(&assignments);
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(updates), field) {
+		zval assignment = {};
+		PHALCON_CONCAT_VSVS(&assignment, field, " = VALUES(", field, ")");
+		phalcon_array_append(&assignments, &assignment, 0);
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&updates);
+
+	phalcon_fast_join_str(&joined_assignments, SL(", "), &assignments);
+	zval_ptr_dtor(&assignments);
+
+	phalcon_db_dialect_build_insert_multiple(return_value, "INSERT INTO", table, fields, rows);
+	PHALCON_SCONCAT_SV(return_value, " ON DUPLICATE KEY UPDATE ", &joined_assignments);
+	zval_ptr_dtor(&joined_assignments);
+}
@@ -67,6 +67,7 @@ PHP_METHOD(Phalcon_Db_Dialect_Postgresql, describeIndexes);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, describeReferences);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, tableOptions);
 PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getDefaultValue);
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, upsertMultiple);
 
 static const zend_function_entry phalcon_db_dialect_postgresql_method_entry[] = {
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, getColumnDefinition, arginfo_phalcon_db_dialectinterface_getcolumndefinition, ZEND_ACC_PUBLIC)
@@ -93,6 +94,7 @@ static const zend_function_entry phalcon_db_dialect_postgresql_method_entry[] =
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, describeReferences, arginfo_phalcon_db_dialectinterface_describereferences, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, tableOptions, arginfo_phalcon_db_dialectinterface_tableoptions, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Postgresql, getDefaultValue, arginfo_phalcon_db_dialectinterface_getdefaultvalue, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Dialect_Postgresql, upsertMultiple, arginfo_phalcon_db_dialect_upsertmultiple, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -1078,3 +1080,60 @@ PHP_METHOD(Phalcon_Db_Dialect_Postgresql, getDefaultValue){
 	PHALCON_CONCAT_SVS(return_value, "\"", &value_cslashes, "\"");
 	zval_ptr_dtor(&value_cslashes);
 }
+
+/**
+ * Builds a multi-row INSERT that updates the rows already present using ON CONFLICT
+ *
+ *<code>
+ * echo $dialect->upsertMultiple('"robots"', array('"id"', '"name"'), array(array('?', '?')), null, array('"id"'));
+ * // INSERT INTO "robots" ("id", "name") VALUES (?, ?) ON CONFLICT ("id") DO UPDATE SET "name" = EXCLUDED."name"
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $rows
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Postgresql, upsertMultiple){
+
+	zval *table, *fields, *rows, *update_fields = NULL, *conflict_fields = NULL, updates = {}, assignments = {}, joined_assignments = {};
+	zval joined_conflict = {}, *field;
+
+	phalcon_fetch_params(0, 3, 2, &table, &fields, &rows, &update_fields, &conflict_fields);
+
+	if (Z_TYPE_P(fields) != IS_ARRAY || Z_TYPE_P(rows) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Invalid INSERT definition");
+		return;
+	}
+
+	if (!conflict_fields || Z_TYPE_P(conflict_fields) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(conflict_fields))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "PostgreSQL upserts require the conflict fields");
+		return;
+	}
+
+	phalcon_fast_join_str(&joined_conflict, SL(", "), conflict_fields);
+
+	phalcon_db_dialect_build_insert_multiple(return_value, "INSERT INTO", table, fields, rows);
+
+	phalcon_db_dialect_get_upsert_fields(&updates, fields, update_fields, conflict_fields);
+	if (!zend_hash_num_elements(Z_ARRVAL(updates))) {
+		PHALCON_SCONCAT_SVS(return_value, " ON CONFLICT (", &joined_conflict, ") DO NOTHING");
+	} else {
+		array_init(&assignments);
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(updates), field) {
+			zval assignment = {};
+			PHALCON_CONCAT_VSV(&assignment, field, " = EXCLUDED.", field);
+			phalcon_array_append(&assignments, &assignment, 0);
+		} ZEND_HASH_FOREACH_END();
+
+		phalcon_fast_join_str(&joined_assignments, SL(", "), &assignments);
+		zval_ptr_dtor(&assignments);
+
+		PHALCON_SCONCAT_SVSV(return_value, " ON CONFLICT (", &joined_conflict, ") DO UPDATE SET ", &joined_assignments);
+		zval_ptr_dtor(&joined_assignments);
+	}
+	zval_ptr_dtor(&updates);
+	zval_ptr_dtor(&joined_conflict);
+}
@@ -68,6 +68,7 @@ PHP_METHOD(Phalcon_Db_Dialect_Sqlite, describeIndex);
 PHP_METHOD(Phalcon_Db_Dialect_Sqlite, describeReferences);
 PHP_METHOD(Phalcon_Db_Dialect_Sqlite, tableOptions);
 PHP_METHOD(Phalcon_Db_Dialect_Sqlite, getDefaultValue);
+PHP_METHOD(Phalcon_Db_Dialect_Sqlite, upsertMultiple);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_dialect_sqlite_describeindex, 0, 0, 1)
 	ZEND_ARG_INFO(0, indexName)
@@ -99,6 +100,7 @@ static const zend_function_entry phalcon_db_dialect_sqlite_method_entry[] = {
 	PHP_ME(Phalcon_Db_Dialect_Sqlite, describeReferences, arginfo_phalcon_db_dialectinterface_describereferences, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Sqlite, tableOptions, arginfo_phalcon_db_dialectinterface_tableoptions, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Dialect_Sqlite, getDefaultValue, arginfo_phalcon_db_dialectinterface_getdefaultvalue, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Dialect_Sqlite, upsertMultiple, arginfo_phalcon_db_dialect_upsertmultiple, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -937,3 +939,33 @@ PHP_METHOD(Phalcon_Db_Dialect_Sqlite, getDefaultValue){
 	PHALCON_CONCAT_SVS(return_value, "\"", &value_cslashes, "\"");
 	zval_ptr_dtor(&value_cslashes);
 }
+
+/**
+ * Builds a multi-row INSERT OR REPLACE statement. SQLite replaces the whole conflicting row,
+ * so the update and conflict fields are not used
+ *
+ *<code>
+ * echo $dialect->upsertMultiple('"robots"', array('"id"', '"name"'), array(array('?', '?')));
+ * // INSERT OR REPLACE INTO "robots" ("id", "name") VALUES (?, ?)
+ *</code>
+ *
+ * @param string $table
+ * @param array $fields
+ * @param array $rows
+ * @param array $updateFields
+ * @param array $conflictFields
+ * @return string
+ */
+PHP_METHOD(Phalcon_Db_Dialect_Sqlite, upsertMultiple){
+
+	zval *table, *fields, *rows, *update_fields = NULL, *conflict_fields = NULL;
+
+	phalcon_fetch_params(0, 3, 2, &table, &fields, &rows, &update_fields, &conflict_fields);
+
+	if (Z_TYPE_P(rows) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(rows))) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Invalid INSERT definition");
+		return;
+	}
+
+	phalcon_db_dialect_build_insert_multiple(return_value, "INSERT OR REPLACE INTO", table, fields, rows);
+}
@@ -0,0 +1,633 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2014 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "db/pool.h"
+#include "db/adapterinterface.h"
+#include "db/exception.h"
+
+#include <time.h>
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+#include "kernel/object.h"
+#include "kernel/array.h"
+#include "kernel/fcall.h"
+#include "kernel/operators.h"
+#include "kernel/exception.h"
+
+/**
+ * Phalcon\Db\Pool
+ *
+ * Holds the read replicas and the primary connections of a database. Every read picks a replica
+ * using weighted round-robin or the replica with less statements sent, replicas marked as
+ * unhealthy or lagging too much are left out until the cooldown expires. Once a model has written
+ * to the primary or a transaction was started its reads are sent to the primary too.
+ *
+ * Registering the pool as the connection service makes the ORM use it transparently
+ *
+ *<code>
+ *	$pool = new Phalcon\Db\Pool(array(
+ *		'strategy' => Phalcon\Db\Pool::STRATEGY_LEAST_OUTSTANDING,
+ *		'cooldown' => 30,
+ *		'maxLag' => 5
+ *	));
+ *
+ *	$pool->addWriteConnection(function() use ($config) {
+ *		return new Phalcon\Db\Adapter\Pdo\Mysql($config->primary->toArray());
+ *	});
+ *
+ *	$pool->addReadConnection(function() use ($config) {
+ *		return new Phalcon\Db\Adapter\Pdo\Mysql($config->replica1->toArray());
+ *	}, 2);
+ *
+ *	$pool->addReadConnection(function() use ($config) {
+ *		return new Phalcon\Db\Adapter\Pdo\Mysql($config->replica2->toArray());
+ *	});
+ *
+ *	$di->setShared('db', $pool);
+ *</code>
+ */
+zend_class_entry *phalcon_db_pool_ce;
+
+PHP_METHOD(Phalcon_Db_Pool, __construct);
+PHP_METHOD(Phalcon_Db_Pool, addReadConnection);
+PHP_METHOD(Phalcon_Db_Pool, addWriteConnection);
+PHP_METHOD(Phalcon_Db_Pool, getReadConnection);
+PHP_METHOD(Phalcon_Db_Pool, getWriteConnection);
+PHP_METHOD(Phalcon_Db_Pool, markUnhealthy);
+PHP_METHOD(Phalcon_Db_Pool, setReplicationLag);
+PHP_METHOD(Phalcon_Db_Pool, pin);
+PHP_METHOD(Phalcon_Db_Pool, isPinned);
+PHP_METHOD(Phalcon_Db_Pool, unpin);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool___construct, 0, 0, 0)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_addreadconnection, 0, 0, 1)
+	ZEND_ARG_INFO(0, connection)
+	ZEND_ARG_INFO(0, weight)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_addwriteconnection, 0, 0, 1)
+	ZEND_ARG_INFO(0, connection)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_getreadconnection, 0, 0, 0)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_getwriteconnection, 0, 0, 0)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_markunhealthy, 0, 0, 1)
+	ZEND_ARG_INFO(0, connection)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_setreplicationlag, 0, 0, 2)
+	ZEND_ARG_INFO(0, connection)
+	ZEND_ARG_INFO(0, seconds)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_pin, 0, 0, 0)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_pool_ispinned, 0, 0, 0)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+static const zend_function_entry phalcon_db_pool_method_entry[] = {
+	PHP_ME(Phalcon_Db_Pool, __construct, arginfo_phalcon_db_pool___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
+	PHP_ME(Phalcon_Db_Pool, addReadConnection, arginfo_phalcon_db_pool_addreadconnection, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, addWriteConnection, arginfo_phalcon_db_pool_addwriteconnection, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, getReadConnection, arginfo_phalcon_db_pool_getreadconnection, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, getWriteConnection, arginfo_phalcon_db_pool_getwriteconnection, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, markUnhealthy, arginfo_phalcon_db_pool_markunhealthy, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, setReplicationLag, arginfo_phalcon_db_pool_setreplicationlag, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, pin, arginfo_phalcon_db_pool_pin, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, isPinned, arginfo_phalcon_db_pool_ispinned, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Pool, unpin, NULL, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+/**
+ * Phalcon\Db\Pool initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Db_Pool){
+
+	PHALCON_REGISTER_CLASS(Phalcon\\Db, Pool, db_pool, phalcon_db_pool_method_entry, 0);
+
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readConnections"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readWeights"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readCurrentWeights"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readCounts"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readDownUntil"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_readLag"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_writeConnections"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_writeDownUntil"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_pinned"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_db_pool_ce, SL("_pinnedAll"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_pool_ce, SL("_strategy"), PHALCON_DB_POOL_STRATEGY_ROUND_ROBIN, ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_pool_ce, SL("_cooldown"), 30, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_pool_ce, SL("_maxLag"), ZEND_ACC_PROTECTED);
+
+	zend_declare_class_constant_long(phalcon_db_pool_ce, SL("STRATEGY_ROUND_ROBIN"), PHALCON_DB_POOL_STRATEGY_ROUND_ROBIN);
+	zend_declare_class_constant_long(phalcon_db_pool_ce, SL("STRATEGY_LEAST_OUTSTANDING"), PHALCON_DB_POOL_STRATEGY_LEAST_OUTSTANDING);
+
+	return SUCCESS;
+}
+
+/**
+ * Returns the adapter of a node, creating it the first time if it was added as a callable
+ */
+static int phalcon_db_pool_resolve(zval *return_value, zval *object, const char *property, uint32_t property_length, zval *index)
+{
+	zval connection = {};
+
+	phalcon_read_property_array(&connection, object, property, property_length, index, PH_READONLY);
+	if (Z_TYPE(connection) == IS_OBJECT && instanceof_function(Z_OBJCE(connection), phalcon_db_adapterinterface_ce)) {
+		ZVAL_COPY(return_value, &connection);
+		return SUCCESS;
+	}
+
+	if (phalcon_call_user_func_args(return_value, &connection, NULL, 0) == FAILURE) {
+		return FAILURE;
+	}
+
+	if (Z_TYPE_P(return_value) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(return_value), phalcon_db_adapterinterface_ce)) {
+		zval_ptr_dtor(return_value);
+		ZVAL_NULL(return_value);
+		return FAILURE;
+	}
+
+	phalcon_update_property_array(object, property, property_length, index, return_value);
+	return SUCCESS;
+}
+
+/**
+ * Leaves a node out of the selection until the cooldown expires
+ */
+static void phalcon_db_pool_mark_down(zval *object, const char *property, uint32_t property_length, zval *index)
+{
+	zval cooldown = {}, down_until = {};
+	zend_long seconds;
+
+	phalcon_read_property(&cooldown, object, SL("_cooldown"), PH_NOISY|PH_READONLY);
+
+	seconds = phalcon_get_intval(&cooldown);
+	ZVAL_LONG(&down_until, (zend_long)time(NULL) + (seconds > 0 ? seconds : 1));
+	phalcon_update_property_array(object, property, property_length, index, &down_until);
+}
+
+/**
+ * Picks a healthy replica, returns SUCCESS without a connection when there is none
+ */
+static int phalcon_db_pool_select_read(zval *return_value, zval *object)
+{
+	zval weights = {}, down_until = {}, lags = {}, current_weights = {}, counts = {}, strategy = {}, max_lag = {}, *weight;
+	zend_long now = (zend_long)time(NULL), total, best_value, best_weight;
+	ulong idx, best;
+	int found;
+
+	phalcon_read_property(&strategy, object, SL("_strategy"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&max_lag, object, SL("_maxLag"), PH_NOISY|PH_READONLY);
+
+	ZVAL_NULL(return_value);
+
+	while (1) {
+		zval updated = {}, *value, index = {}, count = {};
+
+		phalcon_read_property(&weights, object, SL("_readWeights"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&down_until, object, SL("_readDownUntil"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&lags, object, SL("_readLag"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&current_weights, object, SL("_readCurrentWeights"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&counts, object, SL("_readCounts"), PH_NOISY|PH_READONLY);
+
+		if (Z_TYPE(weights) != IS_ARRAY) {
+			return SUCCESS;
+		}
+
+		array_init(&updated);
+
+		found = 0;
+		total = 0;
+		best = 0;
+		best_value = 0;
+		best_weight = 1;
+
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(weights), idx, weight) {
+			zval down = {}, lag = {}, current = {};
+			zend_long w = phalcon_get_intval(weight), c;
+
+			if (phalcon_array_isset_fetch_long(&down, &down_until, idx, PH_READONLY) && phalcon_get_intval(&down) > now) {
+				continue;
+			}
+
+			if (Z_TYPE(max_lag) != IS_NULL && phalcon_array_isset_fetch_long(&lag, &lags, idx, PH_READONLY)) {
+				if (Z_TYPE(lag) != IS_NULL && phalcon_get_intval(&lag) > phalcon_get_intval(&max_lag)) {
+					continue;
+				}
+			}
+
+			total += w;
+
+			if (phalcon_get_intval(&strategy) == PHALCON_DB_POOL_STRATEGY_LEAST_OUTSTANDING) {
+				/**
+				 * The replica with less statements sent relative to its weight
+				 */
+				phalcon_array_fetch_long(&current, &counts, idx, PH_NOISY|PH_READONLY);
+				c = phalcon_get_intval(&current);
+				if (!found || c * best_weight < best_value * w) {
+					best = idx;
+					best_value = c;
+					best_weight = w;
+				}
+			} else {
+				/**
+				 * Smooth weighted round-robin, the replica with the highest current weight is used
+				 */
+				phalcon_array_fetch_long(&current, &current_weights, idx, PH_NOISY|PH_READONLY);
+				c = phalcon_get_intval(&current) + w;
+				add_index_long(&updated, idx, c);
+				if (!found || c > best_value) {
+					best = idx;
+					best_value = c;
+				}
+			}
+
+			found = 1;
+		} ZEND_HASH_FOREACH_END();
+
+		if (!found) {
+			zval_ptr_dtor(&updated);
+			return SUCCESS;
+		}
+
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(updated), idx, value) {
+			if (idx == best) {
+				ZVAL_LONG(value, Z_LVAL_P(value) - total);
+			}
+			ZVAL_LONG(&index, idx);
+			phalcon_update_property_array(object, SL("_readCurrentWeights"), &index, value);
+		} ZEND_HASH_FOREACH_END();
+		zval_ptr_dtor(&updated);
+
+		ZVAL_LONG(&index, best);
+
+		if (phalcon_db_pool_resolve(return_value, object, SL("_readConnections"), &index) == SUCCESS) {
+			phalcon_read_property_array(&count, object, SL("_readCounts"), &index, PH_READONLY);
+			ZVAL_LONG(&count, phalcon_get_intval(&count) + 1);
+			phalcon_update_property_array(object, SL("_readCounts"), &index, &count);
+			return SUCCESS;
+		}
+
+		/**
+		 * The replica can't be reached, try with the next one
+		 */
+		if (EG(exception)) {
+			zend_clear_exception();
+		}
+
+		phalcon_db_pool_mark_down(object, SL("_readDownUntil"), &index);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Picks the first healthy primary, so all the writes of a request go to the same one
+ */
+static int phalcon_db_pool_select_write(zval *return_value, zval *object)
+{
+	zval connections = {}, down_until = {}, index = {};
+	zend_long now = (zend_long)time(NULL);
+	ulong count, i;
+
+	phalcon_read_property(&connections, object, SL("_writeConnections"), PH_NOISY|PH_READONLY);
+
+	count = Z_TYPE(connections) == IS_ARRAY ? zend_hash_num_elements(Z_ARRVAL(connections)) : 0;
+
+	for (i = 0; i < count; i++) {
+		zval down = {};
+
+		phalcon_read_property(&down_until, object, SL("_writeDownUntil"), PH_NOISY|PH_READONLY);
+		if (phalcon_array_isset_fetch_long(&down, &down_until, i, PH_READONLY) && phalcon_get_intval(&down) > now) {
+			continue;
+		}
+
+		ZVAL_LONG(&index, i);
+		if (phalcon_db_pool_resolve(return_value, object, SL("_writeConnections"), &index) == SUCCESS) {
+			return SUCCESS;
+		}
+
+		if (EG(exception)) {
+			zend_clear_exception();
+		}
+
+		phalcon_db_pool_mark_down(object, SL("_writeDownUntil"), &index);
+	}
+
+	PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "There are no healthy write connections in the pool");
+	return FAILURE;
+}
+
+/**
+ * Looks for the node that holds the connection, returns 1 if it was found
+ */
+static int phalcon_db_pool_find(zval *index, zval *object, const char *property, uint32_t property_length, zval *connection)
+{
+	zval connections = {}, *node;
+	ulong idx;
+
+	phalcon_read_property(&connections, object, property, property_length, PH_NOISY|PH_READONLY);
+	if (Z_TYPE(connections) != IS_ARRAY) {
+		return 0;
+	}
+
+	ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(connections), idx, node) {
+		if (Z_TYPE_P(node) == IS_OBJECT && Z_OBJ_P(node) == Z_OBJ_P(connection)) {
+			ZVAL_LONG(index, idx);
+			return 1;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return 0;
+}
+
+/**
+ * Phalcon\Db\Pool constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Db_Pool, __construct){
+
+	zval *options = NULL, strategy = {}, cooldown = {}, max_lag = {};
+
+	phalcon_fetch_params(0, 0, 1, &options);
+
+	if (options && Z_TYPE_P(options) == IS_ARRAY) {
+		if (phalcon_array_isset_fetch_str(&strategy, options, SL("strategy"), PH_READONLY)) {
+			phalcon_update_property_long(getThis(), SL("_strategy"), phalcon_get_intval(&strategy));
+		}
+
+		if (phalcon_array_isset_fetch_str(&cooldown, options, SL("cooldown"), PH_READONLY)) {
+			phalcon_update_property_long(getThis(), SL("_cooldown"), phalcon_get_intval(&cooldown));
+		}
+
+		if (phalcon_array_isset_fetch_str(&max_lag, options, SL("maxLag"), PH_READONLY) && Z_TYPE(max_lag) != IS_NULL) {
+			phalcon_update_property_long(getThis(), SL("_maxLag"), phalcon_get_intval(&max_lag));
+		}
+	}
+
+	phalcon_update_property_empty_array(getThis(), SL("_readConnections"));
+	phalcon_update_property_empty_array(getThis(), SL("_readWeights"));
+	phalcon_update_property_empty_array(getThis(), SL("_readCurrentWeights"));
+	phalcon_update_property_empty_array(getThis(), SL("_readCounts"));
+	phalcon_update_property_empty_array(getThis(), SL("_readDownUntil"));
+	phalcon_update_property_empty_array(getThis(), SL("_readLag"));
+	phalcon_update_property_empty_array(getThis(), SL("_writeConnections"));
+	phalcon_update_property_empty_array(getThis(), SL("_writeDownUntil"));
+	phalcon_update_property_empty_array(getThis(), SL("_pinned"));
+}
+
+/**
+ * Adds a read replica, the connection can be an adapter or a callable that creates it when it is used the first time
+ *
+ * @param Phalcon\Db\AdapterInterface|callable $connection
+ * @param int $weight
+ * @return Phalcon\Db\Pool
+ */
+PHP_METHOD(Phalcon_Db_Pool, addReadConnection){
+
+	zval *connection, *weight = NULL, node_weight = {}, zero = {};
+
+	phalcon_fetch_params(0, 1, 1, &connection, &weight);
+
+	if ((Z_TYPE_P(connection) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(connection), phalcon_db_adapterinterface_ce))
+		&& !zend_is_callable(connection, 0, NULL)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The connection must be an adapter or a callable that returns one");
+		return;
+	}
+
+	ZVAL_LONG(&node_weight, weight ? phalcon_get_intval(weight) : 1);
+	if (Z_LVAL(node_weight) < 1) {
+		ZVAL_LONG(&node_weight, 1);
+	}
+
+	ZVAL_LONG(&zero, 0);
+
+	phalcon_update_property_array_append(getThis(), SL("_readConnections"), connection);
+	phalcon_update_property_array_append(getThis(), SL("_readWeights"), &node_weight);
+	phalcon_update_property_array_append(getThis(), SL("_readCurrentWeights"), &zero);
+	phalcon_update_property_array_append(getThis(), SL("_readCounts"), &zero);
+	phalcon_update_property_array_append(getThis(), SL("_readDownUntil"), &zero);
+	phalcon_update_property_array_append(getThis(), SL("_readLag"), &PHALCON_GLOBAL(z_null));
+
+	RETURN_THIS();
+}
+
+/**
+ * Adds a primary connection, the primaries are used in the order they were added
+ *
+ * @param Phalcon\Db\AdapterInterface|callable $connection
+ * @return Phalcon\Db\Pool
+ */
+PHP_METHOD(Phalcon_Db_Pool, addWriteConnection){
+
+	zval *connection, zero = {};
+
+	phalcon_fetch_params(0, 1, 0, &connection);
+
+	if ((Z_TYPE_P(connection) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(connection), phalcon_db_adapterinterface_ce))
+		&& !zend_is_callable(connection, 0, NULL)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "The connection must be an adapter or a callable that returns one");
+		return;
+	}
+
+	ZVAL_LONG(&zero, 0);
+
+	phalcon_update_property_array_append(getThis(), SL("_writeConnections"), connection);
+	phalcon_update_property_array_append(getThis(), SL("_writeDownUntil"), &zero);
+
+	RETURN_THIS();
+}
+
+/**
+ * Returns a connection to read data, the primary is returned if the key is pinned or no replica is available
+ *
+ * @param string $key
+ * @return Phalcon\Db\AdapterInterface
+ */
+PHP_METHOD(Phalcon_Db_Pool, getReadConnection){
+
+	zval *key = NULL, pinned = {};
+
+	phalcon_fetch_params(0, 0, 1, &key);
+
+	if (!key) {
+		key = &PHALCON_GLOBAL(z_null);
+	}
+
+	PHALCON_CALL_METHOD(&pinned, getThis(), "ispinned", key);
+	if (!zend_is_true(&pinned)) {
+		RETURN_ON_FAILURE(phalcon_db_pool_select_read(return_value, getThis()));
+		if (Z_TYPE_P(return_value) == IS_OBJECT) {
+			return;
+		}
+	}
+
+	phalcon_db_pool_select_write(return_value, getThis());
+}
+
+/**
+ * Returns the connection to write data, the reads of the key are sent to the primary from now on
+ *
+ * @param string $key
+ * @return Phalcon\Db\AdapterInterface
+ */
+PHP_METHOD(Phalcon_Db_Pool, getWriteConnection){
+
+	zval *key = NULL;
+
+	phalcon_fetch_params(0, 0, 1, &key);
+
+	RETURN_ON_FAILURE(phalcon_db_pool_select_write(return_value, getThis()));
+
+	if (key && Z_TYPE_P(key) != IS_NULL) {
+		phalcon_update_property_array(getThis(), SL("_pinned"), key, &PHALCON_GLOBAL(z_true));
+	}
+}
+
+/**
+ * Leaves a connection out of the pool until the cooldown expires
+ *
+ *<code>
+ *	try {
+ *		$connection->query($sql);
+ *	} catch (PDOException $e) {
+ *		$pool->markUnhealthy($connection);
+ *	}
+ *</code>
+ *
+ * @param Phalcon\Db\AdapterInterface $connection
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Pool, markUnhealthy){
+
+	zval *connection, index = {};
+
+	phalcon_fetch_params(0, 1, 0, &connection);
+
+	if (Z_TYPE_P(connection) != IS_OBJECT) {
+		RETURN_FALSE;
+	}
+
+	if (phalcon_db_pool_find(&index, getThis(), SL("_readConnections"), connection)) {
+		phalcon_db_pool_mark_down(getThis(), SL("_readDownUntil"), &index);
+		RETURN_TRUE;
+	}
+
+	if (phalcon_db_pool_find(&index, getThis(), SL("_writeConnections"), connection)) {
+		phalcon_db_pool_mark_down(getThis(), SL("_writeDownUntil"), &index);
+		RETURN_TRUE;
+	}
+
+	RETURN_FALSE;
+}
+
+/**
+ * Sets the replication lag measured for a replica, replicas behind the 'maxLag' option are not used
+ *
+ * @param Phalcon\Db\AdapterInterface $connection
+ * @param int $seconds
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Pool, setReplicationLag){
+
+	zval *connection, *seconds, index = {};
+
+	phalcon_fetch_params(0, 2, 0, &connection, &seconds);
+
+	if (Z_TYPE_P(connection) != IS_OBJECT || !phalcon_db_pool_find(&index, getThis(), SL("_readConnections"), connection)) {
+		RETURN_FALSE;
+	}
+
+	phalcon_update_property_array(getThis(), SL("_readLag"), &index, seconds);
+	RETURN_TRUE;
+}
+
+/**
+ * Sends the reads of the key to the primary, all the reads are pinned when no key is passed
+ *
+ * @param string $key
+ * @return Phalcon\Db\Pool
+ */
+PHP_METHOD(Phalcon_Db_Pool, pin){
+
+	zval *key = NULL;
+
+	phalcon_fetch_params(0, 0, 1, &key);
+
+	if (!key || Z_TYPE_P(key) == IS_NULL) {
+		phalcon_update_property_bool(getThis(), SL("_pinnedAll"), 1);
+	} else {
+		phalcon_update_property_array(getThis(), SL("_pinned"), key, &PHALCON_GLOBAL(z_true));
+	}
+
+	RETURN_THIS();
+}
+
+/**
+ * Checks if the reads of the key are sent to the primary
+ *
+ * @param string $key
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Pool, isPinned){
+
+	zval *key = NULL, pinned_all = {};
+
+	phalcon_fetch_params(0, 0, 1, &key);
+
+	phalcon_read_property(&pinned_all, getThis(), SL("_pinnedAll"), PH_NOISY|PH_READONLY);
+	if (zend_is_true(&pinned_all)) {
+		RETURN_TRUE;
+	}
+
+	if (key && Z_TYPE_P(key) != IS_NULL && phalcon_isset_property_array(getThis(), SL("_pinned"), key)) {
+		RETURN_TRUE;
+	}
+
+	RETURN_FALSE;
+}
+
+/**
+ * Sends the reads to the replicas again, long running processes should call it when a request ends
+ *
+ * @return Phalcon\Db\Pool
+ */
+PHP_METHOD(Phalcon_Db_Pool, unpin){
+
+	phalcon_update_property_bool(getThis(), SL("_pinnedAll"), 0);
+	phalcon_update_property_empty_array(getThis(), SL("_pinned"));
+
+	RETURN_THIS();
+}
@@ -62,6 +62,10 @@
  *	echo "Final Time: ", $profile->getFinalTime(), "\n";
  *	echo "Total Elapsed Time: ", $profile->getTotalElapsedSeconds(), "\n";
  *
+ *	//Prepared statements reused by the connection
+ *	echo "Statement cache hits: ", $profiler->getStatementCacheHits(), "\n";
+ *	echo "Statement cache misses: ", $profiler->getStatementCacheMisses(), "\n";
+ *
  *</code>
  *
  */
@@ -69,10 +73,16 @@ zend_class_entry *phalcon_db_profiler_ce;
 
 PHP_METHOD(Phalcon_Db_Profiler, startProfile);
 PHP_METHOD(Phalcon_Db_Profiler, getNumberTotalStatements);
+PHP_METHOD(Phalcon_Db_Profiler, getStatementCacheHits);
+PHP_METHOD(Phalcon_Db_Profiler, getStatementCacheMisses);
+PHP_METHOD(Phalcon_Db_Profiler, reset);
 
 static const zend_function_entry phalcon_db_profiler_method_entry[] = {
 	PHP_ME(Phalcon_Db_Profiler, startProfile, arginfo_phalcon_profilerinterface_startprofile, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Profiler, getNumberTotalStatements, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Profiler, getStatementCacheHits, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Profiler, getStatementCacheMisses, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Profiler, reset, NULL, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -83,6 +93,9 @@ PHALCON_INIT_CLASS(Phalcon_Db_Profiler){
 
 	PHALCON_REGISTER_CLASS_EX(Phalcon\\Db, Profiler, db_profiler, phalcon_profiler_ce, phalcon_db_profiler_method_entry, 0);
 
+	zend_declare_property_long(phalcon_db_profiler_ce, SL("_statementCacheHits"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_db_profiler_ce, SL("_statementCacheMisses"), 0, ZEND_ACC_PROTECTED);
+
 	return SUCCESS;
 }
 
@@ -159,3 +172,39 @@ PHP_METHOD(Phalcon_Db_Profiler, getNumberTotalStatements){
 	phalcon_read_property(&all_profiles, getThis(), SL("_allProfiles"), PH_NOISY|PH_READONLY);
 	phalcon_fast_count(return_value, &all_profiles);
 }
+
+/**
+ * Returns the number of SQL statements that reused a prepared statement kept by the connection
+ *
+ * @return integer
+ */
+PHP_METHOD(Phalcon_Db_Profiler, getStatementCacheHits){
+
+
+	RETURN_MEMBER(getThis(), "_statementCacheHits");
+}
+
+/**
+ * Returns the number of SQL statements that had to be prepared while the statement cache was enabled
+ *
+ * @return integer
+ */
+PHP_METHOD(Phalcon_Db_Profiler, getStatementCacheMisses){
+
+
+	RETURN_MEMBER(getThis(), "_statementCacheMisses");
+}
+
+/**
+ * Resets the profiler, cleaning up all the profiles and the statement cache counters
+ *
+ * @return Phalcon\Db\Profiler
+ */
+PHP_METHOD(Phalcon_Db_Profiler, reset){
+
+	phalcon_update_property_long(getThis(), SL("_statementCacheHits"), 0);
+	phalcon_update_property_long(getThis(), SL("_statementCacheMisses"), 0);
+
+	PHALCON_CALL_PARENT(NULL, phalcon_db_profiler_ce, getThis(), "reset");
+	RETURN_THIS();
+}
@@ -46,9 +46,104 @@
  *		print_r($robot);
  *	}
  * </code>
+ *
+ * Results returned by Phalcon\Db\Adapter\Pdo::stream() are forward only, when they are bound to a
+ * server side cursor every time the current batch is exhausted the next one is fetched from the cursor
  */
 zend_class_entry *phalcon_db_result_pdo_ce;
 
+/**
+ * Closes the server side cursor and commits the transaction opened for it
+ */
+static int phalcon_db_result_pdo_close_cursor(zval *object)
+{
+	zval cursor = {}, connection = {}, pdo = {}, sql = {}, own_transaction = {};
+	int flag;
+
+	phalcon_read_property(&cursor, object, SL("_cursor"), PH_READONLY);
+	if (Z_TYPE(cursor) != IS_STRING) {
+		return SUCCESS;
+	}
+
+	PHALCON_CONCAT_SV(&sql, "CLOSE ", &cursor);
+	phalcon_update_property_null(object, SL("_cursor"));
+
+	phalcon_read_property(&connection, object, SL("_connection"), PH_NOISY|PH_READONLY);
+	PHALCON_CALL_METHOD_FLAG(flag, &pdo, &connection, "getinternalhandler");
+	if (flag == SUCCESS && Z_TYPE(pdo) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &pdo, "exec", &sql);
+	}
+	zval_ptr_dtor(&pdo);
+	zval_ptr_dtor(&sql);
+
+	phalcon_read_property(&own_transaction, object, SL("_cursorTransaction"), PH_READONLY);
+	if (flag == SUCCESS && zend_is_true(&own_transaction)) {
+		phalcon_update_property_bool(object, SL("_cursorTransaction"), 0);
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &connection, "commit");
+	}
+
+	return flag;
+}
+
+/**
+ * Closes the cursor of the statement so it can be executed again by the statement cache of the
+ * connection, the driver is called directly as no method can be called with a pending exception
+ */
+static void phalcon_db_result_pdo_release_statement(zval *object)
+{
+	zval pdo_statement = {};
+	zend_class_entry *statement_ce;
+	pdo_stmt_t *stmt;
+
+	phalcon_read_property(&pdo_statement, object, SL("_pdoStatement"), PH_READONLY);
+	if (Z_TYPE(pdo_statement) != IS_OBJECT) {
+		return;
+	}
+
+	statement_ce = zend_hash_str_find_ptr(CG(class_table), SL("pdostatement"));
+	if (!statement_ce || !instanceof_function(Z_OBJCE(pdo_statement), statement_ce)) {
+		return;
+	}
+
+	stmt = Z_PDO_STMT_P(&pdo_statement);
+	if (stmt->dbh && stmt->executed && stmt->methods->cursor_closer) {
+		stmt->methods->cursor_closer(stmt);
+		stmt->executed = 0;
+	}
+}
+
+/**
+ * Fetches the next batch of rows from the server side cursor, returns FAILURE once the cursor is exhausted
+ */
+static int phalcon_db_result_pdo_next_batch(zval *object)
+{
+	zval cursor = {}, pdo_statement = {}, row_count = {};
+	int flag;
+
+	phalcon_read_property(&cursor, object, SL("_cursor"), PH_READONLY);
+	if (Z_TYPE(cursor) != IS_STRING) {
+		return FAILURE;
+	}
+
+	phalcon_read_property(&pdo_statement, object, SL("_pdoStatement"), PH_NOISY|PH_READONLY);
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, &pdo_statement, "execute");
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &row_count, &pdo_statement, "rowcount");
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	if (phalcon_get_intval(&row_count) > 0) {
+		return SUCCESS;
+	}
+
+	phalcon_db_result_pdo_close_cursor(object);
+	return FAILURE;
+}
+
 PHP_METHOD(Phalcon_Db_Result_Pdo, __construct);
 PHP_METHOD(Phalcon_Db_Result_Pdo, execute);
 PHP_METHOD(Phalcon_Db_Result_Pdo, fetch);
@@ -59,6 +154,8 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek);
 PHP_METHOD(Phalcon_Db_Result_Pdo, setFetchMode);
 PHP_METHOD(Phalcon_Db_Result_Pdo, getInternalResult);
 PHP_METHOD(Phalcon_Db_Result_Pdo, nextRowset);
+PHP_METHOD(Phalcon_Db_Result_Pdo, isStreaming);
+PHP_METHOD(Phalcon_Db_Result_Pdo, __destruct);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_db_result___construct, 0, 0, 2)
 	ZEND_ARG_INFO(0, connection)
@@ -79,6 +176,8 @@ static const zend_function_entry phalcon_db_result_pdo_method_entry[] = {
 	PHP_ME(Phalcon_Db_Result_Pdo, setFetchMode, arginfo_phalcon_db_resultinterface_setfetchmode, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Result_Pdo, getInternalResult, arginfo_phalcon_db_resultinterface_getinternalresult, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Db_Result_Pdo, nextRowset, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Result_Pdo, isStreaming, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Db_Result_Pdo, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR)
 	PHP_FE_END
 };
 
@@ -97,6 +196,9 @@ PHALCON_INIT_CLASS(Phalcon_Db_Result_Pdo){
 	zend_declare_property_null(phalcon_db_result_pdo_ce, SL("_bindParams"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_db_result_pdo_ce, SL("_bindTypes"), ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_db_result_pdo_ce, SL("_rowCount"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_db_result_pdo_ce, SL("_streaming"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_db_result_pdo_ce, SL("_cursor"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_db_result_pdo_ce, SL("_cursorTransaction"), 0, ZEND_ACC_PROTECTED);
 
 	return SUCCESS;
 }
@@ -193,19 +295,21 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetch){
 	}
 
 	phalcon_read_property(&pdo_statement, getThis(), SL("_pdoStatement"), PH_NOISY|PH_READONLY);
-	if (Z_TYPE_P(fetch_style) != IS_NULL) {
-		if (Z_TYPE_P(cursor_orientation) != IS_NULL) {
-			if (Z_TYPE_P(cursor_offset) != IS_NULL) {
-				PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style, cursor_orientation, cursor_offset);
+	do {
+		if (Z_TYPE_P(fetch_style) != IS_NULL) {
+			if (Z_TYPE_P(cursor_orientation) != IS_NULL) {
+				if (Z_TYPE_P(cursor_offset) != IS_NULL) {
+					PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style, cursor_orientation, cursor_offset);
+				} else {
+					PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style, cursor_orientation);
+				}
 			} else {
-				PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style, cursor_orientation);
+				PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style);
 			}
 		} else {
-			PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch", fetch_style);
+			PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch");
 		}
-	} else {
-		PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch");
-	}
+	} while (PHALCON_IS_FALSE(return_value) && phalcon_db_result_pdo_next_batch(getThis()) == SUCCESS);
 }
 
 /**
@@ -226,7 +330,9 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetchArray){
 
 	zval pdo_statement = {};
 	phalcon_read_property(&pdo_statement, getThis(), SL("_pdoStatement"), PH_NOISY|PH_READONLY);
-	PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch");
+	do {
+		PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetch");
+	} while (PHALCON_IS_FALSE(return_value) && phalcon_db_result_pdo_next_batch(getThis()) == SUCCESS);
 }
 
 /**
@@ -245,7 +351,7 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetchArray){
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, fetchAll){
 
-	zval *fetch_mode = NULL, *fetch_argument = NULL, *ctor_args = NULL, pdo_statement = {};
+	zval *fetch_mode = NULL, *fetch_argument = NULL, *ctor_args = NULL, pdo_statement = {}, cursor = {}, rows = {}, batch = {}, *row;
 
 	phalcon_fetch_params(0, 0, 3, &fetch_mode, &fetch_argument, &ctor_args);
 
@@ -275,6 +381,42 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetchAll){
 	} else {
 		PHALCON_RETURN_CALL_METHOD(&pdo_statement, "fetchall");
 	}
+
+	/**
+	 * Rows from a server side cursor are appended batch by batch until it is exhausted
+	 */
+	phalcon_read_property(&cursor, getThis(), SL("_cursor"), PH_READONLY);
+	if (Z_TYPE(cursor) != IS_STRING || Z_TYPE_P(return_value) != IS_ARRAY) {
+		return;
+	}
+
+	ZVAL_COPY_VALUE(&rows, return_value);
+	ZVAL_NULL(return_value);
+
+	while (phalcon_db_result_pdo_next_batch(getThis()) == SUCCESS) {
+		if (PHALCON_IS_NOT_TYPE(fetch_mode, IS_NULL)) {
+			if (PHALCON_IS_NOT_TYPE(fetch_argument, IS_NULL)) {
+				if (PHALCON_IS_NOT_TYPE(ctor_args, IS_NULL)) {
+					PHALCON_CALL_METHOD(&batch, &pdo_statement, "fetchall", fetch_mode, fetch_argument, ctor_args);
+				} else {
+					PHALCON_CALL_METHOD(&batch, &pdo_statement, "fetchall", fetch_mode, fetch_argument);
+				}
+			} else {
+				PHALCON_CALL_METHOD(&batch, &pdo_statement, "fetchall", fetch_mode);
+			}
+		} else {
+			PHALCON_CALL_METHOD(&batch, &pdo_statement, "fetchall");
+		}
+
+		if (Z_TYPE(batch) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(batch), row) {
+				phalcon_array_append(&rows, row, PH_COPY);
+			} ZEND_HASH_FOREACH_END();
+		}
+		zval_ptr_dtor(&batch);
+	}
+
+	RETVAL_ZVAL(&rows, 0, 0);
 }
 
 /**
@@ -289,20 +431,21 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, fetchAll){
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, numRows){
 
-	zval row_count = {}, connection = {}, type = {}, pdo_statement = {}, sql_statement = {}, bind_params = {}, bind_types = {};
+	zval row_count = {}, connection = {}, streaming = {}, type = {}, pdo_statement = {}, sql_statement = {}, bind_params = {}, bind_types = {};
 	zval matches = {}, pattern = {}, match = {}, else_clauses = {}, sql = {}, result = {}, row = {};
 
 	phalcon_read_property(&row_count, getThis(), SL("_rowCount"), PH_READONLY);
 
 	if (PHALCON_IS_FALSE(&row_count)) {
 		phalcon_read_property(&connection, getThis(), SL("_connection"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&streaming, getThis(), SL("_streaming"), PH_READONLY);
 
 		PHALCON_CALL_METHOD(&type, &connection, "gettype");
 
 		/**
-		 * MySQL/PostgreSQL library property returns the number of records
+		 * MySQL/PostgreSQL library property returns the number of records, unless the rows are streamed
 		 */
-		if (PHALCON_IS_STRING(&type, "mysql") || PHALCON_IS_STRING(&type, "pgsql")) {
+		if (!zend_is_true(&streaming) && (PHALCON_IS_STRING(&type, "mysql") || PHALCON_IS_STRING(&type, "pgsql"))) {
 			phalcon_read_property(&pdo_statement, getThis(), SL("_pdoStatement"), PH_NOISY|PH_READONLY);
 			PHALCON_CALL_METHOD(&row_count, &pdo_statement, "rowcount");
 		}
@@ -375,12 +518,18 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, numRows){
  */
 PHP_METHOD(Phalcon_Db_Result_Pdo, dataSeek){
 
-	zval *num, connection = {}, pdo = {}, sql_statement = {}, bind_params = {}, bind_types = {}, statement = {}, temp_statement = {};
+	zval *num, streaming = {}, connection = {}, pdo = {}, sql_statement = {}, bind_params = {}, bind_types = {}, statement = {}, temp_statement = {};
 	pdo_stmt_t *stmt;
 	long number = 0, n;
 
 	phalcon_fetch_params(0, 1, 0, &num);
 
+	phalcon_read_property(&streaming, getThis(), SL("_streaming"), PH_READONLY);
+	if (zend_is_true(&streaming)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_db_exception_ce, "Streamed results are forward only and can't be seeked");
+		return;
+	}
+
 	number = phalcon_get_intval(num);
 	phalcon_read_property(&connection, getThis(), SL("_connection"), PH_NOISY|PH_READONLY);
 
@@ -504,3 +653,27 @@ PHP_METHOD(Phalcon_Db_Result_Pdo, nextRowset){
 	phalcon_read_property(&pdo_statement, getThis(), SL("_pdoStatement"), PH_NOISY|PH_READONLY);
 	PHALCON_RETURN_CALL_METHOD(&pdo_statement, "nextrowset");
 }
+
+/**
+ * Checks whether the rows are streamed from the server instead of being buffered by the client
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Db_Result_Pdo, isStreaming){
+
+
+	RETURN_MEMBER(getThis(), "_streaming");
+}
+
+/**
+ * Releases the server side cursor if the result wasn't traversed until the end and closes the
+ * cursor of the statement before it returns to the statement cache
+ */
+PHP_METHOD(Phalcon_Db_Result_Pdo, __destruct){
+
+	if (!EG(exception)) {
+		phalcon_db_result_pdo_close_cursor(getThis());
+	}
+
+	phalcon_db_result_pdo_release_statement(getThis());
+}
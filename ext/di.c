@@ -27,6 +27,7 @@
 #include "di/serviceinterface.h"
 #include "di/factorydefault.h"
 #include "events/managerinterface.h"
+#include "events/manager.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -443,8 +444,9 @@ PHP_METHOD(Phalcon_Di, get){
 		noerror = &PHALCON_GLOBAL(z_false);
 	}
 
+	/* The event data is only built when somebody listens to it */
 	phalcon_read_property(&events_manager, getThis(), SL("_eventsManager"), PH_READONLY);
-	if (Z_TYPE(events_manager) == IS_OBJECT) {
+	if (phalcon_events_manager_has_listeners(&events_manager, SL("di:beforeServiceResolve"))) {
 		PHALCON_MM_ZVAL_STRING(&event_name, "di:beforeServiceResolve");
 
 		array_init(&event_data);
@@ -456,7 +458,17 @@ PHP_METHOD(Phalcon_Di, get){
 	}
 
 	if (phalcon_property_array_isset_fetch(&service, getThis(), SL("_services"), name, PH_READONLY)) {
-		PHALCON_MM_CALL_METHOD(return_value, &service, "resolve", parameters, getThis());
+		if (Z_TYPE(service) == IS_OBJECT && Z_OBJCE(service) == phalcon_di_service_ce) {
+			/* Plain services are resolved without a method call */
+			Z_ADDREF(service);
+			phalcon_di_service_resolve(return_value, &service, parameters, getThis());
+			zval_ptr_dtor(&service);
+			if (EG(exception)) {
+				RETURN_MM();
+			}
+		} else {
+			PHALCON_MM_CALL_METHOD(return_value, &service, "resolve", parameters, getThis());
+		}
 		ce = (Z_TYPE_P(return_value) == IS_OBJECT) ? Z_OBJCE_P(return_value) : NULL;
 	} else {
 		/* The DI also acts as builder for any class even if it isn't defined in the DI */
@@ -477,7 +489,7 @@ PHP_METHOD(Phalcon_Di, get){
 		PHALCON_MM_CALL_METHOD(NULL, return_value, "setdi", getThis());
 	}
 
-	if (Z_TYPE(events_manager) == IS_OBJECT) {
+	if (phalcon_events_manager_has_listeners(&events_manager, SL("di:afterServiceResolve"))) {
 		PHALCON_MM_ZVAL_STRING(&event_name, "di:afterServiceResolve");
 
 		array_init(&event_data);
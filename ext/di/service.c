@@ -50,6 +50,154 @@
  */
 zend_class_entry *phalcon_di_service_ce;
 
+zend_object_handlers phalcon_di_service_object_handlers;
+
+static void phalcon_di_service_reset_plan(phalcon_di_service_object *intern)
+{
+	if (intern->class_name) {
+		zend_string_release(intern->class_name);
+		intern->class_name = NULL;
+	}
+	intern->ce = NULL;
+}
+
+zend_object* phalcon_di_service_object_create_handler(zend_class_entry *ce)
+{
+	phalcon_di_service_object *intern = ecalloc(1, sizeof(phalcon_di_service_object) + zend_object_properties_size(ce));
+	intern->std.ce = ce;
+
+	zend_object_std_init(&intern->std, ce);
+	object_properties_init(&intern->std, ce);
+	intern->std.handlers = &phalcon_di_service_object_handlers;
+
+	return &intern->std;
+}
+
+static zend_object* phalcon_di_service_object_clone_handler(zval *object)
+{
+	zend_object *old_object = Z_OBJ_P(object), *new_object;
+
+	new_object = phalcon_di_service_object_create_handler(old_object->ce);
+	zend_objects_clone_members(new_object, old_object);
+
+	return new_object;
+}
+
+void phalcon_di_service_object_free_handler(zend_object *object)
+{
+	phalcon_di_service_object *intern = phalcon_di_service_object_from_obj(object);
+
+	phalcon_di_service_reset_plan(intern);
+	zval_ptr_dtor(&intern->builder);
+
+	zend_object_std_dtor(object);
+}
+
+/**
+ * Binds a closure definition to the container, same as Closure::bind($definition, $dependencyInjector)
+ */
+static int phalcon_di_service_bind_closure(zval *closure, zval *definition, zval *dependency_injector)
+{
+	zend_function *func = (zend_function*)zend_get_closure_method_def(definition);
+	int flag = SUCCESS;
+
+	/**
+	 * Closure::bind() validates the binding, it's only skipped for plain user closures. Static
+	 * closures, closures created from methods and closures scoped to internal classes can be
+	 * rejected and the engine reports them
+	 */
+	if (func->type != ZEND_USER_FUNCTION || (func->common.fn_flags & ZEND_ACC_STATIC)
+#ifdef ZEND_ACC_FAKE_CLOSURE
+		|| (func->common.fn_flags & ZEND_ACC_FAKE_CLOSURE)
+#endif
+		|| (func->common.scope && func->common.scope->type == ZEND_INTERNAL_CLASS)) {
+		PHALCON_CALL_CE_STATIC_FLAG(flag, closure, zend_ce_closure, "bind", definition, dependency_injector);
+		return flag;
+	}
+
+	zend_create_closure(closure, func, func->common.scope, Z_OBJCE_P(dependency_injector), dependency_injector);
+	return SUCCESS;
+}
+
+/**
+ * Resolves a service, the class of string definitions and the builder of array definitions
+ * are looked up once and kept in the service
+ */
+void phalcon_di_service_resolve(zval *return_value, zval *service, zval *parameters, zval *dependency_injector)
+{
+	phalcon_di_service_object *intern = phalcon_di_service_object_from_obj(Z_OBJ_P(service));
+	zval name = {}, shared = {}, shared_instance = {}, definition = {};
+	int found = 0, ishared = 0;
+
+	phalcon_read_property(&shared, service, SL("_shared"), PH_READONLY);
+	ishared = zend_is_true(&shared);
+
+	/* Check if the service is shared */
+	if (ishared) {
+		phalcon_read_property(&shared_instance, service, SL("_sharedInstance"), PH_READONLY);
+		if (Z_TYPE(shared_instance) != IS_NULL) {
+			ZVAL_COPY(return_value, &shared_instance);
+			return;
+		}
+	}
+
+	phalcon_read_property(&definition, service, SL("_definition"), PH_READONLY);
+
+	if (Z_TYPE(definition) == IS_STRING) {
+		/* String definitions can be class names without implicit parameters */
+		if (intern->class_name != Z_STR(definition)) {
+			phalcon_di_service_reset_plan(intern);
+			if ((intern->ce = phalcon_class_exists(&definition, 1)) != NULL) {
+				intern->class_name = zend_string_copy(Z_STR(definition));
+			}
+		}
+		if (intern->ce) {
+			found = 1;
+			RETURN_ON_FAILURE(phalcon_create_instance_params_ce(return_value, intern->ce, parameters));
+		}
+	} else if (likely(Z_TYPE(definition) == IS_OBJECT)) {
+		/* Object definitions can be a Closure or an already resolved instance */
+		found = 1;
+		if (instanceof_function_ex(Z_OBJCE(definition), zend_ce_closure, 0)) {
+			zval closure = {};
+			if (likely(Z_TYPE_P(dependency_injector) == IS_OBJECT)) {
+				RETURN_ON_FAILURE(phalcon_di_service_bind_closure(&closure, &definition, dependency_injector));
+			} else {
+				ZVAL_COPY(&closure, &definition);
+			}
+			if (Z_TYPE_P(parameters) == IS_ARRAY) {
+				PHALCON_CALL_USER_FUNC_ARRAY(return_value, &closure, parameters);
+			} else {
+				PHALCON_CALL_USER_FUNC(return_value, &closure);
+			}
+			zval_ptr_dtor(&closure);
+		} else {
+			ZVAL_COPY(return_value, &definition);
+		}
+	} else if (Z_TYPE(definition) == IS_ARRAY) {
+		found = 1;
+		/* Array definitions require a 'className' parameter */
+		if (Z_TYPE(intern->builder) != IS_OBJECT) {
+			object_init_ex(&intern->builder, phalcon_di_service_builder_ce);
+		}
+
+		PHALCON_CALL_METHOD(return_value, &intern->builder, "build", dependency_injector, &definition, parameters);
+	}
+
+	if (!EG(exception)) {
+		if (found) {
+			if (ishared) {
+				phalcon_update_property(service, SL("_sharedInstance"), return_value);
+			}
+			/* Update the shared instance if the service is shared */
+			phalcon_update_property_bool(service, SL("_resolved"), 1);
+		} else {
+			phalcon_read_property(&name, service, SL("_name"), PH_READONLY);
+			PHALCON_THROW_EXCEPTION_FORMAT(phalcon_di_exception_ce, "Service '%s' cannot be resolved", Z_STRVAL(name));
+		}
+	}
+}
+
 PHP_METHOD(Phalcon_Di_Service, __construct);
 PHP_METHOD(Phalcon_Di_Service, getName);
 PHP_METHOD(Phalcon_Di_Service, setShared);
@@ -90,7 +238,9 @@ static const zend_function_entry phalcon_di_service_method_entry[] = {
  */
 PHALCON_INIT_CLASS(Phalcon_Di_Service){
 
-	PHALCON_REGISTER_CLASS(Phalcon\\Di, Service, di_service, phalcon_di_service_method_entry, 0);
+	PHALCON_REGISTER_CLASS_CREATE_OBJECT(Phalcon\\Di, Service, di_service, phalcon_di_service_method_entry, 0);
+
+	phalcon_di_service_object_handlers.clone_obj = phalcon_di_service_object_clone_handler;
 
 	zend_declare_property_null(phalcon_di_service_ce, SL("_name"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_di_service_ce, SL("_definition"), ZEND_ACC_PROTECTED);
@@ -198,8 +348,7 @@ PHP_METHOD(Phalcon_Di_Service, getDefinition)
  */
 PHP_METHOD(Phalcon_Di_Service, resolve){
 
-	zval *parameters = NULL, *dependency_injector = NULL, name = {}, shared = {}, shared_instance = {}, definition = {}, builder = {};
-	int found = 0, ishared = 0;
+	zval *parameters = NULL, *dependency_injector = NULL;
 
 	phalcon_fetch_params(0, 0, 2, &parameters, &dependency_injector);
 
@@ -211,67 +360,7 @@ PHP_METHOD(Phalcon_Di_Service, resolve){
 		dependency_injector = &PHALCON_GLOBAL(z_null);
 	}
 
-	phalcon_read_property(&shared, getThis(), SL("_shared"), PH_READONLY);
-	phalcon_read_property(&shared_instance, getThis(), SL("_sharedInstance"), PH_READONLY);
-
-	ishared = zend_is_true(&shared);
-
-	/* Check if the service is shared */
-	if (ishared && Z_TYPE(shared_instance) != IS_NULL) {
-		RETURN_CTOR(&shared_instance);
-	}
-
-	phalcon_read_property(&definition, getThis(), SL("_definition"), PH_READONLY);
-
-	if (Z_TYPE(definition) == IS_STRING) {
-		/* String definitions can be class names without implicit parameters */
-		if (phalcon_class_exists(&definition, 1) != NULL) {
-			found = 1;
-			if (Z_TYPE_P(parameters) == IS_ARRAY) {
-				RETURN_ON_FAILURE(phalcon_create_instance_params(return_value, &definition, parameters));
-			} else {
-				RETURN_ON_FAILURE(phalcon_create_instance(return_value, &definition));
-			}
-		}
-	} else if (likely(Z_TYPE(definition) == IS_OBJECT)) {
-		/* Object definitions can be a Closure or an already resolved instance */
-		found = 1;
-		if (instanceof_function_ex(Z_OBJCE(definition), zend_ce_closure, 0)) {
-			zval closure = {};
-			if (likely(Z_TYPE_P(dependency_injector) == IS_OBJECT)) {
-				PHALCON_CALL_CE_STATIC(&closure, zend_ce_closure, "bind", &definition, dependency_injector);
-			} else {
-				ZVAL_COPY(&closure, &definition);
-			}
-			if (Z_TYPE_P(parameters) == IS_ARRAY) {
-				PHALCON_CALL_USER_FUNC_ARRAY(return_value, &closure, parameters);
-			} else {
-				PHALCON_CALL_USER_FUNC(return_value, &closure);
-			}
-			zval_ptr_dtor(&closure);
-		} else {
-			ZVAL_COPY(return_value, &definition);
-		}
-	} else if (Z_TYPE(definition) == IS_ARRAY) {
-		found = 1;
-		/* Array definitions require a 'className' parameter */
-		object_init_ex(&builder, phalcon_di_service_builder_ce);
-
-		PHALCON_CALL_METHOD(return_value, &builder, "build", dependency_injector, &definition, parameters);
-	}
-
-	if (!EG(exception)) {
-		if (found) {
-			if (ishared) {
-				phalcon_update_property(getThis(), SL("_sharedInstance"), return_value);
-			}
-			/* Update the shared instance if the service is shared */
-			phalcon_update_property_bool(getThis(), SL("_resolved"), 1);
-		} else {
-			phalcon_read_property(&name, getThis(), SL("_name"), PH_READONLY);
-			PHALCON_THROW_EXCEPTION_FORMAT(phalcon_di_exception_ce, "Service '%s' cannot be resolved", Z_STRVAL(name));
-		}
-	}
+	phalcon_di_service_resolve(return_value, getThis(), parameters, dependency_injector);
 }
 
 /**
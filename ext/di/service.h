@@ -22,8 +22,21 @@
 
 #include "php_phalcon.h"
 
+typedef struct _phalcon_di_service_object {
+	zend_string *class_name;
+	zend_class_entry *ce;
+	zval builder;
+	zend_object std;
+} phalcon_di_service_object;
+
+static inline phalcon_di_service_object *phalcon_di_service_object_from_obj(zend_object *obj) {
+	return (phalcon_di_service_object*)((char*)(obj) - XtOffsetOf(phalcon_di_service_object, std));
+}
+
 extern zend_class_entry *phalcon_di_service_ce;
 
+void phalcon_di_service_resolve(zval *return_value, zval *service, zval *parameters, zval *dependency_injector);
+
 PHALCON_INIT_CLASS(Phalcon_Di_Service);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_di_service_setsharedinstance, 0, 0, 1)
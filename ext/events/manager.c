@@ -118,12 +118,147 @@ PHALCON_INIT_CLASS(Phalcon_Events_Manager){
 	zend_declare_property_bool(phalcon_events_manager_ce, SL("_collect"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_events_manager_ce, SL("_enablePriorities"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_events_manager_ce, SL("_responses"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_events_manager_ce, SL("_dispatchTable"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_events_manager_ce, 1, phalcon_events_managerinterface_ce);
 
 	return SUCCESS;
 }
 
+/**
+ * Copies the listeners of a queue into a flat array, SplPriorityQueues come out sorted by priority
+ */
+static int phalcon_events_manager_flatten_queue(zval *return_value, zval *queue)
+{
+	zval iterator = {};
+	int flag = SUCCESS;
+
+	if (Z_TYPE_P(queue) == IS_ARRAY) {
+		ZVAL_COPY(return_value, queue);
+		return SUCCESS;
+	}
+
+	array_init(return_value);
+
+	if (Z_TYPE_P(queue) != IS_OBJECT || phalcon_clone(&iterator, queue) == FAILURE) {
+		return FAILURE;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, &iterator, "top");
+
+	while (flag == SUCCESS) {
+		zval valid = {}, listener = {};
+
+		PHALCON_CALL_METHOD_FLAG(flag, &valid, &iterator, "valid");
+		if (flag == FAILURE || !zend_is_true(&valid)) {
+			break;
+		}
+
+		PHALCON_CALL_METHOD_FLAG(flag, &listener, &iterator, "current");
+		if (flag == SUCCESS) {
+			phalcon_array_append(return_value, &listener, 0);
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &iterator, "next");
+		}
+	}
+	zval_ptr_dtor(&iterator);
+
+	return flag;
+}
+
+/**
+ * Returns the queues fire() has to run for an event type: the '*' listeners, the listeners of
+ * the event name and the listeners of the full type, in that order. Entries are built once and
+ * kept until the listeners change, an empty entry means there is nothing to notify
+ */
+static zval *phalcon_events_manager_get_dispatch(zval *manager, zend_string *event_type)
+{
+	zval events = {}, dispatch_table = {}, entry = {}, *queue, *cached;
+	const char *colon;
+	int i;
+
+	phalcon_read_property(&events, manager, SL("_events"), PH_READONLY);
+	if (Z_TYPE(events) != IS_ARRAY) {
+		return NULL;
+	}
+
+	phalcon_read_property(&dispatch_table, manager, SL("_dispatchTable"), PH_READONLY);
+	if (Z_TYPE(dispatch_table) == IS_ARRAY && (cached = zend_symtable_find(Z_ARRVAL(dispatch_table), event_type)) != NULL) {
+		return cached;
+	}
+
+	array_init(&entry);
+
+	colon = memchr(ZSTR_VAL(event_type), ':', ZSTR_LEN(event_type));
+
+	for (i = 0; i < 3; i++) {
+		zval listeners = {};
+
+		switch (i) {
+			case 0:
+				queue = zend_hash_str_find(Z_ARRVAL(events), SL("*"));
+				break;
+			case 1:
+				queue = colon ? zend_symtable_str_find(Z_ARRVAL(events), ZSTR_VAL(event_type), colon - ZSTR_VAL(event_type)) : NULL;
+				break;
+			default:
+				queue = zend_symtable_find(Z_ARRVAL(events), event_type);
+				break;
+		}
+
+		if (!queue || (Z_TYPE_P(queue) != IS_ARRAY && Z_TYPE_P(queue) != IS_OBJECT)) {
+			continue;
+		}
+
+		if (phalcon_events_manager_flatten_queue(&listeners, queue) == FAILURE) {
+			zval_ptr_dtor(&listeners);
+			zval_ptr_dtor(&entry);
+			return NULL;
+		}
+
+		if (zend_hash_num_elements(Z_ARRVAL(listeners))) {
+			phalcon_array_append(&entry, &listeners, 0);
+		} else {
+			zval_ptr_dtor(&listeners);
+		}
+	}
+
+	phalcon_update_property_array_string(manager, SL("_dispatchTable"), event_type, &entry);
+	zval_ptr_dtor(&entry);
+
+	phalcon_read_property(&dispatch_table, manager, SL("_dispatchTable"), PH_READONLY);
+	return zend_symtable_find(Z_ARRVAL(dispatch_table), event_type);
+}
+
+/**
+ * Checks if fire() would notify any listener about an event type, managers overriding fire()
+ * are always considered to be listening
+ */
+int phalcon_events_manager_has_listeners(zval *manager, const char *event_type, size_t event_type_length)
+{
+	zend_function *fire;
+	zend_string *type;
+	zval *dispatch;
+
+	if (Z_TYPE_P(manager) != IS_OBJECT) {
+		return 0;
+	}
+
+	if (!instanceof_function(Z_OBJCE_P(manager), phalcon_events_manager_ce)) {
+		return 1;
+	}
+
+	fire = zend_hash_str_find_ptr(&Z_OBJCE_P(manager)->function_table, SL("fire"));
+	if (!fire || fire->common.scope != phalcon_events_manager_ce) {
+		return 1;
+	}
+
+	type = zend_string_init(event_type, event_type_length, 0);
+	dispatch = phalcon_events_manager_get_dispatch(manager, type);
+	zend_string_release(type);
+
+	return dispatch && Z_TYPE_P(dispatch) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL_P(dispatch));
+}
+
 /**
  * Attach a listener to the events manager
  *
@@ -197,6 +332,7 @@ PHP_METHOD(Phalcon_Events_Manager, attach){
 	 */
 	phalcon_array_update(&events, event_type, &priority_queue, 0);
 	phalcon_update_property(getThis(), SL("_events"), &events);
+	phalcon_update_property_null(getThis(), SL("_dispatchTable"));
 	zval_ptr_dtor(&events);
 }
 
@@ -212,6 +348,7 @@ PHP_METHOD(Phalcon_Events_Manager, enablePriorities){
 	phalcon_fetch_params(0, 1, 0, &enable_priorities);
 
 	phalcon_update_property(getThis(), SL("_enablePriorities"), enable_priorities);
+	phalcon_update_property_null(getThis(), SL("_dispatchTable"));
 
 }
 
@@ -339,6 +476,7 @@ PHP_METHOD(Phalcon_Events_Manager, detach){
 	}
 
 	phalcon_array_update(&events, type, &priority_queue, 0);
+	phalcon_update_property_null(getThis(), SL("_dispatchTable"));
 }
 
 /**
@@ -360,6 +498,7 @@ PHP_METHOD(Phalcon_Events_Manager, detachAll){
 	if (Z_TYPE_P(type) != IS_NULL && phalcon_array_isset(&events, type)) {
 		phalcon_array_unset(&events, type, 0);
 	}
+	phalcon_update_property_null(getThis(), SL("_dispatchTable"));
 }
 
 /**
@@ -758,8 +897,9 @@ PHP_METHOD(Phalcon_Events_Manager, createEvent){
  */
 PHP_METHOD(Phalcon_Events_Manager, fire){
 
-	zval *_event_type, *source, *data = NULL, *cancelable = NULL, *flag = NULL, debug_message = {};
-	zval event_type = {}, events = {}, name = {}, type = {}, status = {}, collect = {}, any_type = {}, event = {}, fire_events = {};
+	zval *_event_type, *source, *data = NULL, *cancelable = NULL, *flag = NULL, debug_message = {}, *dispatch, *queue;
+	zval event_type = {}, name = {}, type = {}, status = {}, collect = {}, event = {}, queues = {};
+	int flag_status = SUCCESS;
 
 	phalcon_fetch_params(0, 2, 3, &_event_type, &source, &data, &cancelable, &flag);
 
@@ -769,6 +909,21 @@ PHP_METHOD(Phalcon_Events_Manager, fire){
 		zval_ptr_dtor(&debug_message);
 	}
 
+	/**
+	 * Nothing is listening, leave before creating the event object
+	 */
+	if (likely(Z_TYPE_P(_event_type) == IS_STRING) && memchr(Z_STRVAL_P(_event_type), ':', Z_STRLEN_P(_event_type))) {
+		dispatch = phalcon_events_manager_get_dispatch(getThis(), Z_STR_P(_event_type));
+		if (!dispatch || !zend_hash_num_elements(Z_ARRVAL_P(dispatch))) {
+			phalcon_update_property_null(getThis(), SL("_currentEvent"));
+			phalcon_read_property(&collect, getThis(), SL("_collect"), PH_READONLY);
+			if (zend_is_true(&collect)) {
+				phalcon_update_property_null(getThis(), SL("_responses"));
+			}
+			RETURN_NULL();
+		}
+	}
+
 	if (!data) {
 		data = &PHALCON_GLOBAL(z_null);
 	}
@@ -792,22 +947,28 @@ PHP_METHOD(Phalcon_Events_Manager, fire){
 			PHALCON_CALL_METHOD(&type, &event, "gettype");
 			PHALCON_CONCAT_VSV(&event_type, &name, ":", &type);
 			zval_ptr_dtor(&type);
+			zval_ptr_dtor(&name);
 		}
 	} else {
 		ZVAL_COPY(&event_type, _event_type);
 		PHALCON_CALL_METHOD(&event, getThis(), "createevent", &event_type, source, data, cancelable, flag);
-		PHALCON_CALL_METHOD(&name, &event, "getname");
 	}
 
 	phalcon_update_property(getThis(), SL("_currentEvent"), &event);
 
-	phalcon_read_property(&events, getThis(), SL("_events"), PH_READONLY);
-	if (Z_TYPE(events) != IS_ARRAY) {
+	dispatch = phalcon_events_manager_get_dispatch(getThis(), Z_STR(event_type));
+	zval_ptr_dtor(&event_type);
+
+	if (!dispatch) {
 		zval_ptr_dtor(&event);
-		zval_ptr_dtor(&name);
 		RETURN_NULL();
 	}
 
+	/**
+	 * Listeners may attach or detach while they run, keep the queues alive until we are done
+	 */
+	ZVAL_COPY(&queues, dispatch);
+
 	ZVAL_NULL(&status);
 
 	/**
@@ -819,60 +980,27 @@ PHP_METHOD(Phalcon_Events_Manager, fire){
 	}
 
 	/**
-	 * Check if there are listeners for the all event type
+	 * Call the '*', name and type queues, each one starts without previous data
 	 */
-	ZVAL_STRING(&any_type, "*");
-	if (phalcon_array_isset_fetch(&fire_events, &events, &any_type, PH_READONLY)) {
-		if (Z_TYPE(fire_events) == IS_ARRAY || Z_TYPE(fire_events) == IS_OBJECT) {
-			/**
-			 * Call the events queue
-			 */
-			PHALCON_CALL_METHOD(&status, getThis(), "firequeue", &fire_events, &event);
-			if (zend_is_true(flag) && PHALCON_IS_FALSE(&status)) {
-				zval_ptr_dtor(&any_type);
-				zval_ptr_dtor(&type);
-				RETURN_FALSE;
-			}
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(queues), queue) {
+		zval_ptr_dtor(&status);
+		PHALCON_CALL_METHOD_FLAG(flag_status, &status, getThis(), "firequeue", queue, &event);
+		if (flag_status == FAILURE) {
+			break;
 		}
-	}
-	zval_ptr_dtor(&any_type);
-
-	/**
-	 * Check if events are grouped by name
-	 */
-	if (phalcon_array_isset_fetch(&fire_events, &events, &name, PH_READONLY)) {
-		if (Z_TYPE(fire_events) == IS_ARRAY || Z_TYPE(fire_events) == IS_OBJECT) {
-			zval prev_data = {};
-			/**
-			 * Call the events queue
-			 */
-			PHALCON_CALL_METHOD(&status, getThis(), "firequeue", &fire_events, &event, &prev_data);
-			zval_ptr_dtor(&prev_data);
-			if (zend_is_true(flag) && PHALCON_IS_FALSE(&status)) {
-				zval_ptr_dtor(&name);
-				RETURN_FALSE;
-			}
+		if (zend_is_true(flag) && PHALCON_IS_FALSE(&status)) {
+			break;
 		}
-	}
-	zval_ptr_dtor(&name);
+	} ZEND_HASH_FOREACH_END();
 
-	/**
-	 * Check if there are listeners for the event type itself
-	 */
-	if (phalcon_array_isset_fetch(&fire_events, &events, &event_type, PH_READONLY)) {
-		if (Z_TYPE(fire_events) == IS_ARRAY || Z_TYPE(fire_events) == IS_OBJECT) {
-			zval prev_data = {};
-			/**
-			 * Call the events queue
-			 */
-			PHALCON_CALL_METHOD(&status, getThis(), "firequeue", &fire_events, &event, &prev_data);
-			zval_ptr_dtor(&prev_data);
-			if (zend_is_true(flag) && PHALCON_IS_FALSE(&status)) {
-				RETURN_FALSE;
-			}
-		}
-	}
+	zval_ptr_dtor(&queues);
 	zval_ptr_dtor(&event);
+
+	if (flag_status == FAILURE) {
+		zval_ptr_dtor(&status);
+		return;
+	}
+
 	RETURN_NCTOR(&status);
 }
 
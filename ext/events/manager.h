@@ -24,6 +24,8 @@
 
 extern zend_class_entry *phalcon_events_manager_ce;
 
+int phalcon_events_manager_has_listeners(zval *manager, const char *event_type, size_t event_type_length);
+
 PHALCON_INIT_CLASS(Phalcon_Events_Manager);
 
 #endif /* PHALCON_EVENTS_MANAGER_H */
@@ -64,6 +64,24 @@
  */
 zend_class_entry *phalcon_http_request_ce;
 
+/**
+ * Returns the request data for one of the superglobals, embedded servers attach their own
+ * per-request arrays to the object instead of overwriting the process wide ones
+ */
+static zval *phalcon_http_request_get_global(zval *object, const char *global, uint32_t global_length)
+{
+	zval globals = {}, *value;
+
+	if (object) {
+		phalcon_read_property(&globals, object, SL("_globals"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(globals) == IS_ARRAY && (value = zend_hash_str_find(Z_ARRVAL(globals), global, global_length)) != NULL) {
+			return value;
+		}
+	}
+
+	return phalcon_get_global_str(global, global_length);
+}
+
 PHP_METHOD(Phalcon_Http_Request, __construct);
 PHP_METHOD(Phalcon_Http_Request, _get);
 PHP_METHOD(Phalcon_Http_Request, get);
@@ -194,6 +212,7 @@ PHALCON_INIT_CLASS(Phalcon_Http_Request){
 	zend_declare_property_null(phalcon_http_request_ce, SL("_rawBody"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_http_request_ce, SL("_put"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_http_request_ce, SL("_data"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_http_request_ce, SL("_globals"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_http_request_ce, 1, phalcon_http_requestinterface_ce);
 
@@ -317,7 +336,7 @@ PHP_METHOD(Phalcon_Http_Request, get)
 		recursive_level = zend_is_true(name) ? &PHALCON_GLOBAL(z_false) : &PHALCON_GLOBAL(z_true);
 	}
 
-	request = phalcon_get_global_str(SL("_REQUEST"));
+	request = phalcon_http_request_get_global(getThis(), SL("_REQUEST"));
 
 	PHALCON_CALL_METHOD(&put, getThis(), "getput");
 
@@ -378,7 +397,7 @@ PHP_METHOD(Phalcon_Http_Request, getPost)
 		recursive_level = zend_is_true(name) ? &PHALCON_GLOBAL(z_false) : &PHALCON_GLOBAL(z_true);
 	}
 
-	post = phalcon_get_global_str(SL("_POST"));
+	post = phalcon_http_request_get_global(getThis(), SL("_POST"));
 	PHALCON_RETURN_CALL_SELF("_get", post, name, filters, default_value, not_allow_empty, recursive_level);
 }
 
@@ -501,7 +520,7 @@ PHP_METHOD(Phalcon_Http_Request, getQuery){
 		recursive_level = zend_is_true(name) ? &PHALCON_GLOBAL(z_false) : &PHALCON_GLOBAL(z_true);
 	}
 
-	get = phalcon_get_global_str(SL("_GET"));
+	get = phalcon_http_request_get_global(getThis(), SL("_GET"));
 
 	PHALCON_RETURN_CALL_SELF("_get", get, name, filters, default_value, not_allow_empty, recursive_level);
 }
@@ -518,7 +537,7 @@ PHP_METHOD(Phalcon_Http_Request, getServer){
 
 	phalcon_fetch_params(0, 1, 0, &name);
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (!phalcon_array_isset_fetch(return_value, _SERVER, name, PH_COPY)) {
 		RETURN_NULL();
 	}
@@ -586,7 +605,7 @@ PHP_METHOD(Phalcon_Http_Request, has){
 
 	phalcon_fetch_params(0, 1, 0, &name);
 
-	_REQUEST = phalcon_get_global_str(SL("_REQUEST"));
+	_REQUEST = phalcon_http_request_get_global(getThis(), SL("_REQUEST"));
 	RETURN_BOOL(phalcon_array_isset(_REQUEST, name));
 }
 
@@ -602,7 +621,7 @@ PHP_METHOD(Phalcon_Http_Request, hasPost){
 
 	phalcon_fetch_params(0, 1, 0, &name);
 
-	_POST = phalcon_get_global_str(SL("_POST"));
+	_POST = phalcon_http_request_get_global(getThis(), SL("_POST"));
 	RETURN_BOOL(phalcon_array_isset(_POST, name));
 }
 
@@ -655,7 +674,7 @@ PHP_METHOD(Phalcon_Http_Request, hasQuery){
 
 	phalcon_fetch_params(0, 1, 0, &name);
 
-	_GET = phalcon_get_global_str(SL("_GET"));
+	_GET = phalcon_http_request_get_global(getThis(), SL("_GET"));
 	RETURN_BOOL(phalcon_array_isset(_GET, name));
 }
 
@@ -671,7 +690,7 @@ PHP_METHOD(Phalcon_Http_Request, hasServer){
 
 	phalcon_fetch_params(0, 1, 0, &name);
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	RETURN_BOOL(phalcon_array_isset(_SERVER, name));
 }
 
@@ -687,7 +706,7 @@ PHP_METHOD(Phalcon_Http_Request, hasHeader){
 
 	phalcon_fetch_params(0, 1, 0, &header);
 
-	_SERVER = phalcon_get_global_str(SS("_SERVER") TSRMLS_CC);
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset(_SERVER, header)) {
 		RETURN_TRUE;
 	}
@@ -712,7 +731,7 @@ PHP_METHOD(Phalcon_Http_Request, getHeader)
 
 	phalcon_fetch_params(0, 1, 0, &header);
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (!phalcon_array_isset_fetch(return_value, _SERVER, header, PH_COPY)) {
 		PHALCON_CONCAT_SV(&key, "HTTP_", header);
 		if (phalcon_array_isset_fetch(return_value, _SERVER, &key, PH_COPY)) {
@@ -775,7 +794,7 @@ PHP_METHOD(Phalcon_Http_Request, isSoapRequested)
 {
 	zval *server, content_type = {};
 
-	server = phalcon_get_global_str(SL("_SERVER"));
+	server = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset_str(server, SL("HTTP_SOAPACTION"))) {
 		RETURN_TRUE;
 	}
@@ -889,7 +908,7 @@ PHP_METHOD(Phalcon_Http_Request, getServerAddress){
 
 	zval *server, server_addr = {};
 
-	server = phalcon_get_global_str(SL("_SERVER"));
+	server = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset_fetch_str(&server_addr, server, SL("SERVER_ADDR"), PH_READONLY)) {
 		RETURN_CTOR(&server_addr);
 	}
@@ -906,7 +925,7 @@ PHP_METHOD(Phalcon_Http_Request, getServerName){
 
 	zval *server, server_name = {};
 
-	server = phalcon_get_global_str(SL("_SERVER"));
+	server = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset_fetch_str(&server_name, server, SL("SERVER_NAME"), PH_READONLY)) {
 		RETURN_CTOR(&server_name);
 	}
@@ -1034,7 +1053,7 @@ PHP_METHOD(Phalcon_Http_Request, getClientAddress){
 		trust_forwarded_header = &PHALCON_GLOBAL(z_false);
 	}
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 
 	/**
 	 * Proxies use this IP
@@ -1068,15 +1087,17 @@ PHP_METHOD(Phalcon_Http_Request, getClientAddress){
 	RETURN_NULL();
 }
 
-static const char* phalcon_http_request_getmethod_helper()
+static const char* phalcon_http_request_getmethod_helper(zval *object)
 {
-	zval *value, *_SERVER, key = {};
+	zval *value, *_SERVER, globals = {}, key = {};
 	const char *method = SG(request_info).request_method;
 
-	if (unlikely(!method)) {
+	/* Requests built by an embedded server don't share the SAPI request info */
+	phalcon_read_property(&globals, object, SL("_globals"), PH_NOISY|PH_READONLY);
+	if (unlikely(!method) || Z_TYPE(globals) == IS_ARRAY) {
 		ZVAL_STRING(&key, "REQUEST_METHOD");
 
-		_SERVER = phalcon_get_global_str(SL("_SERVER"));
+		_SERVER = phalcon_http_request_get_global(object, SL("_SERVER"));
 		if (Z_TYPE_P(_SERVER) == IS_ARRAY) {
 			value = phalcon_hash_get(Z_ARRVAL_P(_SERVER), &key, BP_VAR_UNSET);
 			zval_ptr_dtor(&key);
@@ -1114,7 +1135,7 @@ PHP_METHOD(Phalcon_Http_Request, getMethod){
 		zval_ptr_dtor(&options);
 	}
 
-	const char *m = phalcon_http_request_getmethod_helper();
+	const char *m = phalcon_http_request_getmethod_helper(getThis());
 	if (m) {
 		RETURN_STRING(m);
 	}
@@ -1133,7 +1154,7 @@ PHP_METHOD(Phalcon_Http_Request, getURI){
 
 	ZVAL_STRING(&key, "REQUEST_URI");
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	value = (Z_TYPE_P(_SERVER) == IS_ARRAY) ? phalcon_hash_get(Z_ARRVAL_P(_SERVER), &key, BP_VAR_UNSET) : NULL;
 	if (value && Z_TYPE_P(value) == IS_STRING) {
 		RETURN_ZVAL(value, 1, 0);
@@ -1153,7 +1174,7 @@ PHP_METHOD(Phalcon_Http_Request, getQueryString){
 
 	ZVAL_STRING(&key, "QUERY_STRING");
 
-	_SERVER = phalcon_get_global_str(SS("_SERVER") TSRMLS_CC);
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	value = (Z_TYPE_P(_SERVER) == IS_ARRAY) ? phalcon_hash_get(Z_ARRVAL_P(_SERVER), &key, BP_VAR_UNSET) : NULL;
 	if (value && Z_TYPE_P(value) == IS_STRING) {
 		RETURN_ZVAL(value, 1, 0);
@@ -1171,7 +1192,7 @@ PHP_METHOD(Phalcon_Http_Request, getUserAgent){
 
 	zval *server, user_agent = {};
 
-	server = phalcon_get_global_str(SL("_SERVER"));
+	server = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset_fetch_str(&user_agent, server, SL("HTTP_USER_AGENT"), PH_READONLY)) {
 		RETURN_CTOR(&user_agent);
 	}
@@ -1220,7 +1241,7 @@ PHP_METHOD(Phalcon_Http_Request, isPost){
 	zval post = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "POST"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "POST"));
 	}
 
 	ZVAL_STR(&post, IS(POST));
@@ -1240,7 +1261,7 @@ PHP_METHOD(Phalcon_Http_Request, isGet){
 	zval get = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "GET"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "GET"));
 	}
 
 	ZVAL_STR(&get, IS(GET));
@@ -1260,7 +1281,7 @@ PHP_METHOD(Phalcon_Http_Request, isPut){
 	zval put = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "PUT"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "PUT"));
 	}
 
 	ZVAL_STR(&put, IS(PUT));
@@ -1280,7 +1301,7 @@ PHP_METHOD(Phalcon_Http_Request, isPatch){
 	zval patch = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "PATCH"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "PATCH"));
 	}
 
 	ZVAL_STR(&patch, IS(PATCH));
@@ -1300,7 +1321,7 @@ PHP_METHOD(Phalcon_Http_Request, isHead){
 	zval head = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "HEAD"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "HEAD"));
 	}
 
 	ZVAL_STR(&head, IS(HEAD));
@@ -1320,7 +1341,7 @@ PHP_METHOD(Phalcon_Http_Request, isDelete){
 	zval delete = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "DELETE"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "DELETE"));
 	}
 
 	ZVAL_STR(&delete, IS(DELETE));
@@ -1340,7 +1361,7 @@ PHP_METHOD(Phalcon_Http_Request, isOptions){
 	zval options = {}, method = {};
 
 	if (Z_OBJCE_P(getThis()) == phalcon_http_request_ce) {
-		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(), "OPTIONS"));
+		RETURN_BOOL(!strcmp(phalcon_http_request_getmethod_helper(getThis()), "OPTIONS"));
 	}
 
 	PHALCON_CALL_METHOD(&method, getThis(), "getmethod");
@@ -1383,7 +1404,7 @@ PHP_METHOD(Phalcon_Http_Request, hasFiles){
 
 	only_successful = not_errored ? phalcon_get_intval(not_errored) : 1;
 
-	_FILES = phalcon_get_global_str(SL("_FILES"));
+	_FILES = phalcon_http_request_get_global(getThis(), SL("_FILES"));
 	if (unlikely(Z_TYPE_P(_FILES) != IS_ARRAY)) {
 		RETURN_LONG(0);
 	}
@@ -1505,7 +1526,7 @@ PHP_METHOD(Phalcon_Http_Request, getUploadedFiles){
 
 	array_init(return_value);
 
-	_FILES = phalcon_get_global_str(SL("_FILES"));
+	_FILES = phalcon_http_request_get_global(getThis(), SL("_FILES"));
 	if (Z_TYPE_P(_FILES) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL_P(_FILES))) {
 		return;
 	}
@@ -1562,7 +1583,7 @@ PHP_METHOD(Phalcon_Http_Request, getHeaders){
 	zend_string *str_key;
 
 	array_init(return_value);
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (unlikely(Z_TYPE_P(_SERVER) != IS_ARRAY)) {
 		return;
 	}
@@ -1586,7 +1607,7 @@ PHP_METHOD(Phalcon_Http_Request, getHTTPReferer){
 
 	zval *_SERVER, http_referer = {};
 
-	_SERVER = phalcon_get_global_str(SL("_SERVER"));
+	_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 	if (phalcon_array_isset_fetch_str(&http_referer, _SERVER, SL("HTTP_REFERER"), PH_READONLY)) {
 		RETURN_CTOR(&http_referer);
 	}
@@ -1785,7 +1806,7 @@ PHP_METHOD(Phalcon_Http_Request, getBasicAuth)
 	char *auth_password = SG(request_info).auth_password;
 
 	if (unlikely(!auth_user)) {
-		_SERVER = phalcon_get_global_str(SL("_SERVER"));
+		_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 		if (Z_TYPE_P(_SERVER) == IS_ARRAY) {
 			ZVAL_STRING(&key, "PHP_AUTH_USER");
 
@@ -1829,7 +1850,7 @@ PHP_METHOD(Phalcon_Http_Request, getDigestAuth){
 	const char *auth_digest = SG(request_info).auth_digest;
 
 	if (unlikely(!auth_digest)) {
-		_SERVER = phalcon_get_global_str(SL("_SERVER"));
+		_SERVER = phalcon_http_request_get_global(getThis(), SL("_SERVER"));
 		if (Z_TYPE_P(_SERVER) == IS_ARRAY) {
 			ZVAL_STRING(&key, "PHP_AUTH_DIGEST");
 
@@ -609,13 +609,13 @@ PHP_METHOD(Phalcon_Http_Response, redirect){
 }
 
 /**
- * Sets HTTP response body
+ * Sets HTTP response body, an array of fragments is sent one after another without being joined
  *
  *<code>
  *	$response->setContent("<h1>Hello!</h1>");
  *</code>
  *
- * @param string $content
+ * @param string|array $content
  * @return Phalcon\Http\ResponseInterface
  */
 PHP_METHOD(Phalcon_Http_Response, setContent){
@@ -693,10 +693,15 @@ PHP_METHOD(Phalcon_Http_Response, appendContent){
 	phalcon_fetch_params(0, 1, 0, &_content);
 
 	phalcon_read_property(&content, getThis(), SL("_content"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(content) == IS_ARRAY) {
+		phalcon_update_property_array_append(getThis(), SL("_content"), _content);
+		RETURN_THIS();
+	}
 
 	concat_function(&temp_content, &content, _content);
 
 	phalcon_update_property(getThis(), SL("_content"), &temp_content);
+	zval_ptr_dtor(&temp_content);
 	RETURN_THIS();
 }
 
@@ -707,8 +712,16 @@ PHP_METHOD(Phalcon_Http_Response, appendContent){
  */
 PHP_METHOD(Phalcon_Http_Response, getContent){
 
+	zval content = {};
+
+	phalcon_read_property(&content, getThis(), SL("_content"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(content) == IS_ARRAY) {
+		phalcon_fast_join_str(return_value, SL(""), &content);
+		phalcon_update_property(getThis(), SL("_content"), return_value);
+		return;
+	}
 
-	RETURN_MEMBER(getThis(), "_content");
+	RETURN_CTOR(&content);
 }
 
 /**
@@ -772,7 +785,14 @@ PHP_METHOD(Phalcon_Http_Response, send){
 		if (Z_TYPE(content) != IS_NULL) {
 			PHALCON_CALL_METHOD(NULL, getThis(), "sendheaders");
 			PHALCON_CALL_METHOD(NULL, getThis(), "sendcookies");
-			zend_print_zval(&content, 0);
+			if (Z_TYPE(content) == IS_ARRAY) {
+				zval *chunk;
+				ZEND_HASH_FOREACH_VAL(Z_ARRVAL(content), chunk) {
+					zend_print_zval(chunk, 0);
+				} ZEND_HASH_FOREACH_END();
+			} else {
+				zend_print_zval(&content, 0);
+			}
 			goto gotoend;
 		}
 
@@ -24,9 +24,15 @@
 #include "kernel/string.h"
 #include "kernel/concat.h"
 #include "kernel/array.h"
+#include "kernel/variables.h"
 
 #include <Zend/zend_smart_str.h>
 
+#ifdef PHALCON_CACHE_YAC
+#include <time.h>
+#include "cache/yac/storage.h"
+#endif
+
 /**
  * Destroyes the prepared ASTs
  */
@@ -39,6 +45,12 @@ void phalcon_orm_destroy_cache() {
 		FREE_HASHTABLE(phalcon_globals_ptr->orm.ast_cache);
 		phalcon_globals_ptr->orm.ast_cache = NULL;
 	}
+
+	if (phalcon_globals_ptr->orm.plan_cache != NULL) {
+		zend_hash_destroy(phalcon_globals_ptr->orm.plan_cache);
+		FREE_HASHTABLE(phalcon_globals_ptr->orm.plan_cache);
+		phalcon_globals_ptr->orm.plan_cache = NULL;
+	}
 }
 
 /**
@@ -87,6 +99,134 @@ void phalcon_orm_set_prepared_ast(zval *unique_id, zval *prepared_ast) {
 
 }
 
+/**
+ * Obtains a compiled query plan in the phalcon's superglobals
+ */
+void phalcon_orm_get_plan(zval *return_value, zval *key) {
+
+	zend_phalcon_globals *phalcon_globals_ptr = PHALCON_VGLOBAL;
+	zval *plan;
+
+	if (Z_TYPE_P(key) == IS_STRING && phalcon_globals_ptr->orm.enable_plan_cache && phalcon_globals_ptr->orm.cache_level >= 1) {
+		if (phalcon_globals_ptr->orm.plan_cache != NULL) {
+			if ((plan = zend_hash_find(phalcon_globals_ptr->orm.plan_cache, Z_STR_P(key))) != NULL) {
+				ZVAL_COPY(return_value, plan);
+			}
+		}
+	}
+}
+
+/**
+ * Stores a compiled query plan in the phalcon's superglobals, plans only hold arrays and scalars.
+ * The oldest plan is dropped when the cache is full
+ */
+void phalcon_orm_set_plan(zval *key, zval *plan) {
+
+	zend_phalcon_globals *phalcon_globals_ptr = PHALCON_VGLOBAL;
+	zend_string *oldest;
+	zend_ulong idx;
+
+	if (Z_TYPE_P(key) == IS_STRING && Z_TYPE_P(plan) == IS_ARRAY && phalcon_globals_ptr->orm.enable_plan_cache && phalcon_globals_ptr->orm.cache_level >= 1) {
+
+		if (!phalcon_globals_ptr->orm.plan_cache) {
+			ALLOC_HASHTABLE(phalcon_globals_ptr->orm.plan_cache);
+			zend_hash_init(phalcon_globals_ptr->orm.plan_cache, 0, NULL, ZVAL_PTR_DTOR, 0);
+		} else if (zend_hash_num_elements(phalcon_globals_ptr->orm.plan_cache) >= PHALCON_ORM_PLAN_CACHE_SIZE && !zend_hash_exists(phalcon_globals_ptr->orm.plan_cache, Z_STR_P(key))) {
+			zend_hash_internal_pointer_reset(phalcon_globals_ptr->orm.plan_cache);
+			if (zend_hash_get_current_key(phalcon_globals_ptr->orm.plan_cache, &oldest, &idx) == HASH_KEY_IS_STRING) {
+				zend_hash_del(phalcon_globals_ptr->orm.plan_cache, oldest);
+			}
+		}
+
+		Z_TRY_ADDREF_P(plan);
+		zend_hash_update(phalcon_globals_ptr->orm.plan_cache, Z_STR_P(key), plan);
+	}
+}
+
+#ifdef PHALCON_CACHE_YAC
+
+static int phalcon_orm_shared_ast_key(char *key, size_t size, zval *unique_id, size_t phql_length) {
+
+	return snprintf(key, size, "phalcon_phql_%lx_%lx", (unsigned long)Z_LVAL_P(unique_id), (unsigned long)phql_length);
+}
+
+#endif
+
+/**
+ * Obtains a prepared ast from the shared memory cache, the original PHQL is stored next to
+ * the ast and compared on every hit to rule out hash collisions
+ */
+int phalcon_orm_get_shared_ast(zval *return_value, zval *unique_id, const char *phql, size_t phql_length) {
+
+#ifdef PHALCON_CACHE_YAC
+	char key[PHALCON_CACHE_YAC_STORAGE_MAX_KEY_LEN], *data = NULL;
+	const char *p, *end;
+	unsigned int size = 0, flag = 0;
+	uint32_t len;
+	int key_len, status = FAILURE;
+	zval ast = {};
+
+	if (!PHALCON_GLOBAL(orm).enable_shared_ast_cache || !PHALCON_GLOBAL(cache).enable_yac || Z_TYPE_P(unique_id) != IS_LONG) {
+		return FAILURE;
+	}
+
+	key_len = phalcon_orm_shared_ast_key(key, sizeof(key), unique_id, phql_length);
+	if (!phalcon_cache_yac_storage_find(key, key_len, &data, &size, &flag, (unsigned long)time(NULL))) {
+		return FAILURE;
+	}
+
+	p   = data;
+	end = data + size;
+
+	if (phalcon_binary_read(&len, sizeof(uint32_t), &p, end) == SUCCESS && len == phql_length && (size_t)(end - p) >= len && !memcmp(p, phql, len)) {
+		p += len;
+		if (phalcon_binary_unpack(&ast, &p, end) == SUCCESS && p == end && Z_TYPE(ast) == IS_ARRAY) {
+			ZVAL_COPY_VALUE(return_value, &ast);
+			status = SUCCESS;
+		} else {
+			zval_ptr_dtor(&ast);
+		}
+	}
+
+	efree(data);
+	return status;
+#else
+	return FAILURE;
+#endif
+}
+
+/**
+ * Stores a prepared ast in the shared memory cache
+ */
+void phalcon_orm_set_shared_ast(zval *unique_id, const char *phql, size_t phql_length, zval *prepared_ast) {
+
+#ifdef PHALCON_CACHE_YAC
+	char key[PHALCON_CACHE_YAC_STORAGE_MAX_KEY_LEN];
+	smart_str buf = {0};
+	uint32_t len;
+	int key_len;
+
+	if (!PHALCON_GLOBAL(orm).enable_shared_ast_cache || !PHALCON_GLOBAL(cache).enable_yac || Z_TYPE_P(unique_id) != IS_LONG) {
+		return;
+	}
+
+	if (Z_TYPE_P(prepared_ast) != IS_ARRAY || phql_length > PHALCON_CACHE_YAC_STORAGE_MAX_ENTRY_LEN) {
+		return;
+	}
+
+	len = (uint32_t)phql_length;
+	smart_str_appendl(&buf, (const char *)&len, sizeof(uint32_t));
+	smart_str_appendl(&buf, phql, len);
+
+	if (phalcon_binary_pack(&buf, prepared_ast) == SUCCESS && ZSTR_LEN(buf.s) <= PHALCON_CACHE_YAC_STORAGE_MAX_ENTRY_LEN) {
+		key_len = phalcon_orm_shared_ast_key(key, sizeof(key), unique_id, phql_length);
+		phalcon_cache_yac_storage_update(key, key_len, ZSTR_VAL(buf.s), ZSTR_LEN(buf.s), IS_STRING, 0, 0, (unsigned long)time(NULL));
+	}
+
+	smart_str_free(&buf);
+#endif
+}
+
 /**
  * Escapes single quotes into database single quotes
  */
@@ -17,9 +17,15 @@
   +------------------------------------------------------------------------+
 */
 
+#define PHALCON_ORM_PLAN_CACHE_SIZE 1024
+
 void phalcon_orm_destroy_cache();
 void phalcon_orm_get_prepared_ast(zval *return_value, zval *unique_id);
 void phalcon_orm_set_prepared_ast(zval *unique_id, zval *prepared_ast);
+void phalcon_orm_get_plan(zval *return_value, zval *key);
+void phalcon_orm_set_plan(zval *key, zval *plan);
+int phalcon_orm_get_shared_ast(zval *return_value, zval *unique_id, const char *phql, size_t phql_length);
+void phalcon_orm_set_shared_ast(zval *unique_id, const char *phql, size_t phql_length, zval *prepared_ast);
 void phalcon_orm_singlequotes(zval *return_value, zval *str);
 
 void phalcon_orm_phql_build_group(zval *return_value, zval *group);
@@ -427,3 +427,154 @@ void phalcon_extract_named_params(zval *return_value, zval *str, zval *matches)
 	}
 
 }
+
+/**
+ * Checks whether a regular expression has an alternation outside of any group, every
+ * branch of it can start differently
+ */
+static int phalcon_regex_has_alternation(const char *cursor, const char *end)
+{
+	int depth = 0;
+
+	for (; cursor < end; cursor++) {
+		switch (*cursor) {
+			case '\\':
+				cursor++;
+				break;
+
+			case '[':
+				/* Character classes can hold any of the meta characters, a leading ']' is literal */
+				cursor++;
+				if (cursor < end && *cursor == '^') {
+					cursor++;
+				}
+				if (cursor < end && *cursor == ']') {
+					cursor++;
+				}
+				while (cursor < end && *cursor != ']') {
+					if (*cursor == '\\') {
+						cursor++;
+					}
+					cursor++;
+				}
+				break;
+
+			case '(':
+				depth++;
+				break;
+
+			case ')':
+				if (depth) {
+					depth--;
+				}
+				break;
+
+			case '|':
+				if (!depth) {
+					return 1;
+				}
+				break;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Extracts the static path segments a compiled route pattern starts with
+ *
+ * Regular expressions only contribute the segments that are complete before the
+ * first meta character, plain patterns contribute every segment
+ */
+void phalcon_extract_static_segments(zval *return_value, zval *pattern)
+{
+	const char *cursor, *end, *delimiter, *start;
+	smart_str literal = {0};
+	int is_regex = 0, complete = 1;
+	char ch;
+
+	array_init(return_value);
+
+	if (Z_TYPE_P(pattern) != IS_STRING || !Z_STRLEN_P(pattern)) {
+		return;
+	}
+
+	cursor = Z_STRVAL_P(pattern);
+	end = cursor + Z_STRLEN_P(pattern);
+
+	if (*cursor == '#') {
+		/* Case insensitive or extended expressions cannot be indexed by their literals */
+		delimiter = end - 1;
+		while (delimiter > cursor && *delimiter != '#') {
+			if (*delimiter == 'i' || *delimiter == 'x') {
+				return;
+			}
+			delimiter--;
+		}
+
+		if (delimiter - cursor < 2 || cursor[1] != '^') {
+			return;
+		}
+
+		end = delimiter;
+		cursor += 2;
+		is_regex = 1;
+
+		/* The branches of a top level alternation don't share the literals of the first one */
+		if (phalcon_regex_has_alternation(cursor, end)) {
+			return;
+		}
+	}
+
+	if (cursor >= end || *cursor != '/') {
+		return;
+	}
+	cursor++;
+
+	while (cursor < end) {
+		ch = *cursor;
+		if (is_regex) {
+			if (ch == '\\') {
+				if (cursor + 1 < end && strchr("/.-_#~", cursor[1])) {
+					ch = *(++cursor);
+				} else {
+					complete = 0;
+					break;
+				}
+			} else if (ch == '$' && cursor + 1 == end) {
+				break;
+			} else if (strchr(".()[]{}|^$*+?", ch)) {
+				complete = 0;
+				break;
+			}
+
+			/* The character is quantified, it can't be part of the literal */
+			if (cursor + 1 < end && strchr("?*+{", cursor[1])) {
+				complete = 0;
+				break;
+			}
+		}
+		smart_str_appendc(&literal, ch);
+		cursor++;
+	}
+	smart_str_0(&literal);
+
+	start = literal.s ? ZSTR_VAL(literal.s) : "";
+	end = start + (literal.s ? ZSTR_LEN(literal.s) : 0);
+	cursor = start;
+
+	while (1) {
+		delimiter = memchr(cursor, '/', end - cursor);
+		if (!delimiter) {
+			/* The last piece is only a full segment when the pattern is fully static */
+			if (complete) {
+				add_next_index_stringl(return_value, cursor, end - cursor);
+			}
+			break;
+		}
+		add_next_index_stringl(return_value, cursor, delimiter - cursor);
+		cursor = delimiter + 1;
+	}
+
+	smart_str_free(&literal);
+}
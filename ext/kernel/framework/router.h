@@ -25,5 +25,6 @@
 /* Extract named parameters */
 void phalcon_extract_named_params(zval *return_value, zval *str, zval *matches);
 void phalcon_replace_paths(zval *return_value, zval *pattern, zval *paths, zval *uri);
+void phalcon_extract_static_segments(zval *return_value, zval *pattern);
 
 #endif /* PHALCON_KERNEL_FRAMEWORK_ROUTER_H */
@@ -49,10 +49,15 @@ void php_phalcon_init_globals(zend_phalcon_globals *phalcon_globals) {
 	phalcon_globals->orm.enable_literals = 1;
 	phalcon_globals->orm.cache_level = 3;
 	phalcon_globals->orm.ast_cache = NULL;
+	phalcon_globals->orm.plan_cache = NULL;
+	phalcon_globals->orm.plan_id = 0;
+	phalcon_globals->orm.enable_shared_ast_cache = 0;
 	phalcon_globals->orm.enable_property_method = 1;
 	phalcon_globals->orm.enable_auto_convert = 1;
 	phalcon_globals->orm.allow_update_primary = 0;
 	phalcon_globals->orm.enable_strict = 0;
+	phalcon_globals->orm.enable_snapshots = 1;
+	phalcon_globals->orm.enable_plan_cache = 1;
 
 	/* Security options */
 	phalcon_globals->security.crypt_std_des_supported  = zend_hash_str_exists(constants, SL("CRYPT_STD_DES"));
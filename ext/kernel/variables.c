@@ -102,3 +102,230 @@ void phalcon_var_export_ex(zval *return_value, zval *var) {
 void phalcon_var_dump(zval *var) {
     php_var_dump(var, 1);
 }
+
+/**
+ * Tags of the binary format written by phalcon_binary_pack
+ */
+#define PHALCON_BINARY_NULL       'N'
+#define PHALCON_BINARY_TRUE       'T'
+#define PHALCON_BINARY_FALSE      'F'
+#define PHALCON_BINARY_LONG       'L'
+#define PHALCON_BINARY_DOUBLE     'D'
+#define PHALCON_BINARY_STRING     'S'
+#define PHALCON_BINARY_ARRAY      'A'
+#define PHALCON_BINARY_KEY_INDEX  'i'
+#define PHALCON_BINARY_KEY_STRING 's'
+#define PHALCON_BINARY_MAX_DEPTH  256
+
+/**
+ * Writes scalars and arrays in a compact binary form, integers are stored in native byte order
+ * and no pointers are kept, so the result can be mapped back by any worker process
+ */
+static int phalcon_binary_pack_ex(smart_str *buf, zval *value, int depth) {
+
+	zend_string *str_key;
+	zend_ulong idx;
+	zval *item;
+	uint32_t len;
+
+	if (depth > PHALCON_BINARY_MAX_DEPTH) {
+		return FAILURE;
+	}
+
+	ZVAL_DEREF(value);
+
+	switch (Z_TYPE_P(value)) {
+
+		case IS_NULL:
+			smart_str_appendc(buf, PHALCON_BINARY_NULL);
+			break;
+
+		case IS_TRUE:
+			smart_str_appendc(buf, PHALCON_BINARY_TRUE);
+			break;
+
+		case IS_FALSE:
+			smart_str_appendc(buf, PHALCON_BINARY_FALSE);
+			break;
+
+		case IS_LONG:
+			smart_str_appendc(buf, PHALCON_BINARY_LONG);
+			smart_str_appendl(buf, (const char *)&Z_LVAL_P(value), sizeof(zend_long));
+			break;
+
+		case IS_DOUBLE:
+			smart_str_appendc(buf, PHALCON_BINARY_DOUBLE);
+			smart_str_appendl(buf, (const char *)&Z_DVAL_P(value), sizeof(double));
+			break;
+
+		case IS_STRING:
+			len = (uint32_t)Z_STRLEN_P(value);
+			smart_str_appendc(buf, PHALCON_BINARY_STRING);
+			smart_str_appendl(buf, (const char *)&len, sizeof(uint32_t));
+			smart_str_appendl(buf, Z_STRVAL_P(value), len);
+			break;
+
+		case IS_ARRAY:
+			len = zend_hash_num_elements(Z_ARRVAL_P(value));
+			smart_str_appendc(buf, PHALCON_BINARY_ARRAY);
+			smart_str_appendl(buf, (const char *)&len, sizeof(uint32_t));
+
+			ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(value), idx, str_key, item) {
+				if (str_key) {
+					len = (uint32_t)ZSTR_LEN(str_key);
+					smart_str_appendc(buf, PHALCON_BINARY_KEY_STRING);
+					smart_str_appendl(buf, (const char *)&len, sizeof(uint32_t));
+					smart_str_appendl(buf, ZSTR_VAL(str_key), len);
+				} else {
+					smart_str_appendc(buf, PHALCON_BINARY_KEY_INDEX);
+					smart_str_appendl(buf, (const char *)&idx, sizeof(zend_ulong));
+				}
+				if (phalcon_binary_pack_ex(buf, item, depth + 1) == FAILURE) {
+					return FAILURE;
+				}
+			} ZEND_HASH_FOREACH_END();
+			break;
+
+		default:
+			return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Copies the next size bytes of a packed buffer, failing instead of reading past its end
+ */
+int phalcon_binary_read(void *dest, size_t size, const char **p, const char *end) {
+
+	if ((size_t)(end - *p) < size) {
+		return FAILURE;
+	}
+
+	memcpy(dest, *p, size);
+	*p += size;
+	return SUCCESS;
+}
+
+/**
+ * Maps back a value written by phalcon_binary_pack, on failure return_value is left as NULL
+ */
+static int phalcon_binary_unpack_ex(zval *return_value, const char **p, const char *end, int depth) {
+
+	zend_string *str_key;
+	zend_ulong idx;
+	zend_long lval;
+	double dval;
+	uint32_t len, i;
+	char tag;
+
+	ZVAL_NULL(return_value);
+
+	if (depth > PHALCON_BINARY_MAX_DEPTH || phalcon_binary_read(&tag, 1, p, end) == FAILURE) {
+		return FAILURE;
+	}
+
+	switch (tag) {
+
+		case PHALCON_BINARY_NULL:
+			break;
+
+		case PHALCON_BINARY_TRUE:
+			ZVAL_TRUE(return_value);
+			break;
+
+		case PHALCON_BINARY_FALSE:
+			ZVAL_FALSE(return_value);
+			break;
+
+		case PHALCON_BINARY_LONG:
+			if (phalcon_binary_read(&lval, sizeof(zend_long), p, end) == FAILURE) {
+				return FAILURE;
+			}
+			ZVAL_LONG(return_value, lval);
+			break;
+
+		case PHALCON_BINARY_DOUBLE:
+			if (phalcon_binary_read(&dval, sizeof(double), p, end) == FAILURE) {
+				return FAILURE;
+			}
+			ZVAL_DOUBLE(return_value, dval);
+			break;
+
+		case PHALCON_BINARY_STRING:
+			if (phalcon_binary_read(&len, sizeof(uint32_t), p, end) == FAILURE || (size_t)(end - *p) < len) {
+				return FAILURE;
+			}
+			ZVAL_STRINGL(return_value, *p, len);
+			*p += len;
+			break;
+
+		case PHALCON_BINARY_ARRAY:
+			if (phalcon_binary_read(&len, sizeof(uint32_t), p, end) == FAILURE) {
+				return FAILURE;
+			}
+
+			array_init_size(return_value, len);
+
+			for (i = 0; i < len; i++) {
+				zval item = {};
+
+				str_key = NULL;
+				if (phalcon_binary_read(&tag, 1, p, end) == FAILURE) {
+					goto array_failure;
+				}
+
+				if (tag == PHALCON_BINARY_KEY_STRING) {
+					uint32_t key_len;
+					if (phalcon_binary_read(&key_len, sizeof(uint32_t), p, end) == FAILURE || (size_t)(end - *p) < key_len) {
+						goto array_failure;
+					}
+					str_key = zend_string_init(*p, key_len, 0);
+					*p += key_len;
+				} else if (tag != PHALCON_BINARY_KEY_INDEX || phalcon_binary_read(&idx, sizeof(zend_ulong), p, end) == FAILURE) {
+					goto array_failure;
+				}
+
+				if (phalcon_binary_unpack_ex(&item, p, end, depth + 1) == FAILURE) {
+					if (str_key) {
+						zend_string_release(str_key);
+					}
+					goto array_failure;
+				}
+
+				if (str_key) {
+					zend_hash_update(Z_ARRVAL_P(return_value), str_key, &item);
+					zend_string_release(str_key);
+				} else {
+					zend_hash_index_update(Z_ARRVAL_P(return_value), idx, &item);
+				}
+			}
+			break;
+
+array_failure:
+			zval_ptr_dtor(return_value);
+			ZVAL_NULL(return_value);
+			return FAILURE;
+
+		default:
+			return FAILURE;
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Appends the binary form of a value to buf, fails on objects and resources
+ */
+int phalcon_binary_pack(smart_str *buf, zval *value) {
+
+	return phalcon_binary_pack_ex(buf, value, 0);
+}
+
+/**
+ * Reads one value from *p and advances it past the value
+ */
+int phalcon_binary_unpack(zval *return_value, const char **p, const char *end) {
+
+	return phalcon_binary_unpack_ex(return_value, p, end, 0);
+}
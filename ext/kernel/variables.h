@@ -22,6 +22,8 @@
 
 #include "php_phalcon.h"
 
+#include <Zend/zend_smart_str.h>
+
 void phalcon_serialize(zval *return_value, zval *var );
 void phalcon_unserialize(zval *return_value, zval *var);
 
@@ -30,4 +32,8 @@ void phalcon_var_export_ex(zval *return_value, zval *var);
 
 void phalcon_var_dump(zval *var);
 
+int phalcon_binary_pack(smart_str *buf, zval *value);
+int phalcon_binary_unpack(zval *return_value, const char **p, const char *end);
+int phalcon_binary_read(void *dest, size_t size, const char **p, const char *end);
+
 #endif
\ No newline at end of file
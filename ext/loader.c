@@ -36,6 +36,9 @@
 #include "kernel/concat.h"
 #include "kernel/debug.h"
 
+#include <Zend/zend_smart_str.h>
+#include <ext/standard/php_var.h>
+
 #include "interned-strings.h"
 
 /**
@@ -81,6 +84,8 @@ PHP_METHOD(Phalcon_Loader, autoLoad);
 PHP_METHOD(Phalcon_Loader, getFoundPath);
 PHP_METHOD(Phalcon_Loader, getCheckedPath);
 PHP_METHOD(Phalcon_Loader, getDefault);
+PHP_METHOD(Phalcon_Loader, dumpClassMap);
+PHP_METHOD(Phalcon_Loader, loadClassMap);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_setextensions, 0, 0, 1)
 	ZEND_ARG_TYPE_INFO(0, extensions, IS_ARRAY, 0)
@@ -117,6 +122,15 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_autoload, 0, 0, 1)
 	ZEND_ARG_TYPE_INFO(0, className, IS_STRING, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_dumpclassmap, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, file, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_loader_loadclassmap, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, file, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, authoritative, _IS_BOOL, 1)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_loader_method_entry[] = {
 	PHP_ME(Phalcon_Loader, __construct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Loader, setExtensions, arginfo_phalcon_loader_setextensions, ZEND_ACC_PUBLIC)
@@ -136,9 +150,167 @@ static const zend_function_entry phalcon_loader_method_entry[] = {
 	PHP_ME(Phalcon_Loader, getFoundPath, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Loader, getCheckedPath, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Loader, getDefault, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	PHP_ME(Phalcon_Loader, dumpClassMap, arginfo_phalcon_loader_dumpclassmap, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Loader, loadClassMap, arginfo_phalcon_loader_loadclassmap, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
+/**
+ * Whether the name of a file or directory can be part of a class name
+ */
+static int phalcon_loader_is_identifier(const char *name, size_t length)
+{
+	size_t i;
+	unsigned char ch;
+
+	if (!length || (name[0] >= '0' && name[0] <= '9')) {
+		return 0;
+	}
+
+	for (i = 0; i < length; i++) {
+		ch = name[i];
+		if (!(ch == '_' || (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch >= 0x80)) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * Walks a directory and adds every class it would resolve to the class-map, classes already
+ * in the class-map keep their path just like the first match wins in autoLoad()
+ */
+static int phalcon_loader_scan_directory(zval *class_map, zval *directory, zval *class_prefix, const char *separator, zval *extensions, zval *ds)
+{
+	zval is_dir = {}, entries = {}, *entry, *extension;
+	int flag;
+
+	phalcon_is_dir(&is_dir, directory);
+	if (!zend_is_true(&is_dir)) {
+		return SUCCESS;
+	}
+
+	PHALCON_CALL_FUNCTION_FLAG(flag, &entries, "scandir", directory);
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	if (Z_TYPE(entries) != IS_ARRAY) {
+		zval_ptr_dtor(&entries);
+		return SUCCESS;
+	}
+
+	/**
+	 * Files first, in the same order findFile() tries the extensions
+	 */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(extensions), extension) {
+		if (Z_TYPE_P(extension) != IS_STRING) {
+			continue;
+		}
+
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(entries), entry) {
+			zval file_path = {}, class_name = {};
+			size_t length;
+
+			if (Z_TYPE_P(entry) != IS_STRING || Z_STRLEN_P(entry) <= Z_STRLEN_P(extension) + 1) {
+				continue;
+			}
+
+			length = Z_STRLEN_P(entry) - Z_STRLEN_P(extension) - 1;
+			if (Z_STRVAL_P(entry)[length] != '.' || memcmp(Z_STRVAL_P(entry) + length + 1, Z_STRVAL_P(extension), Z_STRLEN_P(extension))) {
+				continue;
+			}
+
+			if (!phalcon_loader_is_identifier(Z_STRVAL_P(entry), length)) {
+				continue;
+			}
+
+			PHALCON_CONCAT_VV(&file_path, directory, entry);
+
+			phalcon_is_dir(&is_dir, &file_path);
+			if (!zend_is_true(&is_dir)) {
+				ZVAL_STR(&class_name, strpprintf(0, "%s%.*s", Z_STRVAL_P(class_prefix), (int)length, Z_STRVAL_P(entry)));
+				if (!phalcon_array_isset(class_map, &class_name)) {
+					phalcon_array_update(class_map, &class_name, &file_path, PH_COPY);
+				}
+				zval_ptr_dtor(&class_name);
+			}
+			zval_ptr_dtor(&file_path);
+		} ZEND_HASH_FOREACH_END();
+	} ZEND_HASH_FOREACH_END();
+
+	/**
+	 * Every sub-directory adds a level to the class name
+	 */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(entries), entry) {
+		zval sub_directory = {}, sub_prefix = {};
+
+		if (Z_TYPE_P(entry) != IS_STRING || !phalcon_loader_is_identifier(Z_STRVAL_P(entry), Z_STRLEN_P(entry))) {
+			continue;
+		}
+
+		PHALCON_CONCAT_VVV(&sub_directory, directory, entry, ds);
+		PHALCON_CONCAT_VVS(&sub_prefix, class_prefix, entry, separator);
+
+		flag = phalcon_loader_scan_directory(class_map, &sub_directory, &sub_prefix, separator, extensions, ds);
+		zval_ptr_dtor(&sub_prefix);
+
+		/**
+		 * autoLoad() also turns the pseudo-separator '_' into directories, so the deeper levels
+		 * are added with it too, e.g. Foo/Bar.php is 'Foo\Bar' and 'Foo_Bar'
+		 */
+		if (flag == SUCCESS && *separator != '_') {
+			PHALCON_CONCAT_VVS(&sub_prefix, class_prefix, entry, "_");
+			flag = phalcon_loader_scan_directory(class_map, &sub_directory, &sub_prefix, "_", extensions, ds);
+			zval_ptr_dtor(&sub_prefix);
+		}
+
+		zval_ptr_dtor(&sub_directory);
+		if (flag == FAILURE) {
+			zval_ptr_dtor(&entries);
+			return FAILURE;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&entries);
+	return SUCCESS;
+}
+
+/**
+ * Scans one or many directories registered for the same namespace, prefix or as plain directories
+ */
+static int phalcon_loader_scan(zval *class_map, zval *directory, zval *class_prefix, const char *separator, zval *extensions, zval *ds)
+{
+	zval directories = {}, *dir;
+	int status = SUCCESS;
+
+	if (Z_TYPE_P(directory) != IS_ARRAY) {
+		array_init(&directories);
+		phalcon_array_append(&directories, directory, PH_COPY);
+	} else {
+		ZVAL_COPY(&directories, directory);
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(directories), dir) {
+		zval dir_name = {}, fixed_dir = {};
+
+		ZVAL_COPY(&dir_name, dir);
+		convert_to_string(&dir_name);
+		phalcon_fix_path(&fixed_dir, &dir_name, ds);
+		zval_ptr_dtor(&dir_name);
+
+		status = phalcon_loader_scan_directory(class_map, &fixed_dir, class_prefix, separator, extensions, ds);
+		zval_ptr_dtor(&fixed_dir);
+		if (status == FAILURE) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&directories);
+	return status;
+}
+
 /**
  * Phalcon\Loader initializer
  */
@@ -155,6 +327,8 @@ PHALCON_INIT_CLASS(Phalcon_Loader){
 	zend_declare_property_null(phalcon_loader_ce, SL("_namespaces"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_loader_ce, SL("_directories"), ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_loader_ce, SL("_registered"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_loader_ce, SL("_authoritative"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_loader_ce, SL("_missing"), ZEND_ACC_PROTECTED);
 
 	return SUCCESS;
 }
@@ -192,6 +366,7 @@ PHP_METHOD(Phalcon_Loader, setExtensions){
 	phalcon_fetch_params(0, 1, 0, &extensions);
 
 	phalcon_update_property(getThis(), SL("_extensions"), extensions);
+	phalcon_update_property_null(getThis(), SL("_missing"));
 
 	RETURN_THIS();
 }
@@ -233,6 +408,8 @@ PHP_METHOD(Phalcon_Loader, registerNamespaces){
 		phalcon_update_property(getThis(), SL("_namespaces"), namespaces);
 	}
 
+	phalcon_update_property_null(getThis(), SL("_missing"));
+
 	RETURN_THIS();
 }
 
@@ -273,6 +450,8 @@ PHP_METHOD(Phalcon_Loader, registerPrefixes){
 		phalcon_update_property(getThis(), SL("_prefixes"), prefixes);
 	}
 
+	phalcon_update_property_null(getThis(), SL("_missing"));
+
 	RETURN_THIS();
 }
 
@@ -313,6 +492,8 @@ PHP_METHOD(Phalcon_Loader, registerDirs){
 		phalcon_update_property(getThis(), SL("_directories"), directories);
 	}
 
+	phalcon_update_property_null(getThis(), SL("_missing"));
+
 	RETURN_THIS();
 }
 
@@ -353,6 +534,8 @@ PHP_METHOD(Phalcon_Loader, registerClasses){
 		phalcon_update_property(getThis(), SL("_classes"), classes);
 	}
 
+	phalcon_update_property_null(getThis(), SL("_missing"));
+
 	RETURN_THIS();
 }
 
@@ -531,13 +714,21 @@ PHP_METHOD(Phalcon_Loader, findFile){
 PHP_METHOD(Phalcon_Loader, autoLoad){
 
 	zval *class_name, events_manager = {}, event_name = {}, classes = {}, file_path = {}, found = {}, ds = {}, namespace_separator = {};
-	zval extensions = {}, namespaces = {}, *directory, pseudo_separator = {}, prefixes = {}, directories = {};
+	zval extensions = {}, namespaces = {}, *directory, pseudo_separator = {}, prefixes = {}, directories = {}, missing = {}, authoritative = {};
 	zend_string *str_key;
 	ulong idx;
 	char slash[2] = {DEFAULT_SLASH, 0};
 
 	phalcon_fetch_params(0, 1, 0, &class_name);
 
+	/**
+	 * Classes that were already looked up without success are not probed again
+	 */
+	phalcon_read_property(&missing, getThis(), SL("_missing"), PH_READONLY);
+	if (Z_TYPE(missing) == IS_ARRAY && phalcon_array_isset(&missing, class_name)) {
+		RETURN_FALSE;
+	}
+
 	ZVAL_FALSE(&found);
 
 	phalcon_read_property(&events_manager, getThis(), SL("_eventsManager"), PH_NOISY|PH_READONLY);
@@ -568,6 +759,25 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 		}
 	}
 
+	/**
+	 * An authoritative class-map is complete, the file system is never probed
+	 */
+	phalcon_read_property(&authoritative, getThis(), SL("_authoritative"), PH_READONLY);
+	if (zend_is_true(&authoritative)) {
+		if (Z_TYPE(events_manager) == IS_OBJECT) {
+			ZVAL_STRING(&event_name, "loader:afterCheckClass");
+			PHALCON_CALL_METHOD(NULL, &events_manager, "fire", &event_name, getThis(), class_name);
+			zval_ptr_dtor(&event_name);
+		}
+
+		if (zend_is_true(&found)) {
+			RETURN_TRUE;
+		}
+
+		phalcon_update_property_array(getThis(), SL("_missing"), class_name, &PHALCON_GLOBAL(z_true));
+		RETURN_FALSE;
+	}
+
 	ZVAL_STRING(&ds, slash);
 	ZVAL_STRING(&namespace_separator, "\\");
 	ZVAL_STRING(&pseudo_separator, "_");
@@ -718,8 +928,9 @@ PHP_METHOD(Phalcon_Loader, autoLoad){
 	}
 
 	/**
-	 * Cannot find the class return false
+	 * Cannot find the class return false, remember it for the next lookups
 	 */
+	phalcon_update_property_array(getThis(), SL("_missing"), class_name, &PHALCON_GLOBAL(z_true));
 	RETURN_FALSE;
 }
 
@@ -758,3 +969,185 @@ PHP_METHOD(Phalcon_Loader, getDefault){
 		PHALCON_CALL_METHOD(NULL, return_value, "__construct");
 	}
 }
+
+/**
+ * Scans the registered namespaces, prefixes and directories once and writes every class found
+ * to a class-map file. Classes registered with registerClasses() are kept as they are.
+ * Files below a namespace or a directory are also added with the pseudo-separator '_', the
+ * way autoLoad() resolves PEAR style names.
+ *
+ *<code>
+ * //At deploy time
+ * $loader->registerNamespaces(array(
+ *   'Example\Base' => 'vendor/example/base/',
+ *   'Example' => 'vendor/example/'
+ * ));
+ * $loader->dumpClassMap('app/cache/classmap.php');
+ *
+ * //At runtime, no directory is probed
+ * $loader->loadClassMap('app/cache/classmap.php', true);
+ *</code>
+ *
+ * @param string $file
+ * @return array
+ */
+PHP_METHOD(Phalcon_Loader, dumpClassMap){
+
+	zval *file, classes = {}, extensions = {}, namespaces = {}, prefixes = {}, directories = {}, *directory, class_map = {}, ds = {};
+	zval empty_prefix = {}, php_export = {}, pid = {}, tmp_file = {}, status = {};
+	zend_string *str_key;
+	smart_str exp = { 0 };
+	char slash[2] = {DEFAULT_SLASH, 0};
+	int flag = SUCCESS;
+
+	phalcon_fetch_params(0, 1, 0, &file);
+
+	phalcon_read_property(&classes, getThis(), SL("_classes"), PH_READONLY);
+	if (Z_TYPE(classes) == IS_ARRAY) {
+		ZVAL_DUP(&class_map, &classes);
+	} else {
+		array_init(&class_map);
+	}
+
+	ZVAL_STRING(&ds, slash);
+	phalcon_read_property(&extensions, getThis(), SL("_extensions"), PH_NOISY|PH_READONLY);
+
+	if (Z_TYPE(extensions) == IS_ARRAY) {
+		/**
+		 * Same precedence as autoLoad(): namespaces, prefixes and then directories
+		 */
+		phalcon_read_property(&namespaces, getThis(), SL("_namespaces"), PH_READONLY);
+		if (Z_TYPE(namespaces) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(namespaces), str_key, directory) {
+				zval class_prefix = {};
+				if (!str_key || !ZSTR_LEN(str_key)) {
+					continue;
+				}
+
+				if (ZSTR_VAL(str_key)[ZSTR_LEN(str_key) - 1] == '\\') {
+					ZVAL_STR_COPY(&class_prefix, str_key);
+				} else {
+					ZVAL_STR(&class_prefix, strpprintf(0, "%s\\", ZSTR_VAL(str_key)));
+				}
+
+				flag = phalcon_loader_scan(&class_map, directory, &class_prefix, "\\", &extensions, &ds);
+				zval_ptr_dtor(&class_prefix);
+				if (flag == FAILURE) {
+					break;
+				}
+			} ZEND_HASH_FOREACH_END();
+		}
+
+		phalcon_read_property(&prefixes, getThis(), SL("_prefixes"), PH_READONLY);
+		if (flag == SUCCESS && Z_TYPE(prefixes) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(prefixes), str_key, directory) {
+				zval class_prefix = {};
+				if (!str_key || !ZSTR_LEN(str_key)) {
+					continue;
+				}
+
+				if (ZSTR_VAL(str_key)[ZSTR_LEN(str_key) - 1] == '_') {
+					ZVAL_STR_COPY(&class_prefix, str_key);
+				} else {
+					ZVAL_STR(&class_prefix, strpprintf(0, "%s_", ZSTR_VAL(str_key)));
+				}
+
+				flag = phalcon_loader_scan(&class_map, directory, &class_prefix, "_", &extensions, &ds);
+				zval_ptr_dtor(&class_prefix);
+				if (flag == FAILURE) {
+					break;
+				}
+			} ZEND_HASH_FOREACH_END();
+		}
+
+		phalcon_read_property(&directories, getThis(), SL("_directories"), PH_READONLY);
+		if (flag == SUCCESS && Z_TYPE(directories) == IS_ARRAY) {
+			ZVAL_EMPTY_STRING(&empty_prefix);
+			flag = phalcon_loader_scan(&class_map, &directories, &empty_prefix, "\\", &extensions, &ds);
+			zval_ptr_dtor(&empty_prefix);
+		}
+	}
+	zval_ptr_dtor(&ds);
+
+	if (flag == FAILURE) {
+		zval_ptr_dtor(&class_map);
+		return;
+	}
+
+	smart_str_appends(&exp, "<?php return ");
+	php_var_export_ex(&class_map, 0, &exp);
+	smart_str_appendc(&exp, ';');
+	smart_str_0(&exp);
+
+	ZVAL_STR(&php_export, exp.s);
+
+	/**
+	 * Write to a private file and rename it, workers never see a half written class-map
+	 */
+	PHALCON_CALL_FUNCTION(&pid, "getmypid");
+	PHALCON_CONCAT_VSV(&tmp_file, file, ".", &pid);
+
+	phalcon_file_put_contents(&status, &tmp_file, &php_export);
+	zval_ptr_dtor(&php_export);
+	if (PHALCON_IS_FALSE(&status)) {
+		zval_ptr_dtor(&tmp_file);
+		zval_ptr_dtor(&class_map);
+		PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "The class-map cannot be written");
+		return;
+	}
+
+	PHALCON_CALL_FUNCTION_FLAG(flag, &status, "rename", &tmp_file, file);
+	zval_ptr_dtor(&tmp_file);
+	if (flag == FAILURE || !zend_is_true(&status)) {
+		zval_ptr_dtor(&class_map);
+		if (flag == SUCCESS) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_loader_exception_ce, "The class-map cannot be written");
+		}
+		return;
+	}
+
+	if (phalcon_function_exists_ex(SL("opcache_invalidate")) == SUCCESS) {
+		PHALCON_CALL_FUNCTION(NULL, "opcache_invalidate", file, &PHALCON_GLOBAL(z_true));
+	}
+
+	RETURN_ZVAL(&class_map, 0, 0);
+}
+
+/**
+ * Loads a class-map written by dumpClassMap() and merges it with the registered classes.
+ * An authoritative class-map is trusted to be complete: classes missing from it are not
+ * searched in the namespaces, prefixes or directories.
+ *
+ * @param string $file
+ * @param boolean $authoritative
+ * @return Phalcon\Loader
+ */
+PHP_METHOD(Phalcon_Loader, loadClassMap){
+
+	zval *file, *authoritative = NULL, class_map = {};
+	int flag;
+
+	phalcon_fetch_params(0, 1, 1, &file, &authoritative);
+
+	RETURN_ON_FAILURE(phalcon_require_ret(&class_map, Z_STRVAL_P(file)));
+
+	if (Z_TYPE(class_map) != IS_ARRAY) {
+		zval_ptr_dtor(&class_map);
+		PHALCON_THROW_EXCEPTION_FORMAT(phalcon_loader_exception_ce, "The class-map '%s' must return an array", Z_STRVAL_P(file));
+		return;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, getThis(), "registerclasses", &class_map, &PHALCON_GLOBAL(z_true));
+	zval_ptr_dtor(&class_map);
+	if (flag == FAILURE) {
+		return;
+	}
+
+	if (authoritative && zend_is_true(authoritative)) {
+		phalcon_update_property(getThis(), SL("_authoritative"), &PHALCON_GLOBAL(z_true));
+	} else {
+		phalcon_update_property(getThis(), SL("_authoritative"), &PHALCON_GLOBAL(z_false));
+	}
+
+	RETURN_THIS();
+}
@@ -26,11 +26,13 @@
 #include "mvc/routerinterface.h"
 #include "mvc/moduledefinitioninterface.h"
 #include "mvc/viewinterface.h"
+#include "mvc/view.h"
 #include "mvc/view/modelinterface.h"
 #include "di/injectable.h"
 #include "diinterface.h"
 #include "di.h"
 #include "events/managerinterface.h"
+#include "http/response.h"
 #include "http/responseinterface.h"
 #include "http/request.h"
 
@@ -178,7 +180,7 @@ PHP_METHOD(Phalcon_Mvc_Application, handle){
 
 	zval *uri = NULL, dependency_injector = {}, event_name = {}, status = {}, service = {}, router = {}, module_name = {};
 	zval modules = {}, module = {}, module_namespace = {}, module_class = {}, class_name = {}, path = {}, module_object = {}, module_params = {};
-	zval implicit_view = {}, view = {}, namespace_name = {}, controller_name = {}, action_name = {}, params = {}, exact = {};
+	zval implicit_view = {}, view = {}, streaming = {}, namespace_name = {}, controller_name = {}, action_name = {}, params = {}, exact = {};
 	zval dispatcher = {}, controller = {}, possible_response = {}, returned_response = {}, response = {}, content = {};
 	int f_implicit_view;
 
@@ -576,8 +578,19 @@ PHP_METHOD(Phalcon_Mvc_Application, handle){
 			if (Z_TYPE(controller) == IS_OBJECT && unlikely(phalcon_method_exists_ex(&controller, SL("afterrenderview")) == SUCCESS)) {
 				PHALCON_CALL_METHOD(NULL, &controller, "afterrenderview", &view);
 			}
-			/* The content returned by the view is passed to the response service */
-			PHALCON_CALL_METHOD(&content, &view, "getcontent");
+			/**
+			 * The content returned by the view is passed to the response service, a streaming view hands over
+			 * its fragments only to Phalcon\Http\Response itself, other responses expect the content as a string
+			 */
+			if (Z_TYPE(view) == IS_OBJECT && instanceof_function(Z_OBJCE(view), phalcon_mvc_view_ce)
+				&& Z_TYPE(response) == IS_OBJECT && Z_OBJCE(response) == phalcon_http_response_ce) {
+				phalcon_read_property(&streaming, &view, SL("_streaming"), PH_READONLY);
+			}
+			if (zend_is_true(&streaming)) {
+				PHALCON_CALL_METHOD(&content, &view, "getcontentchunks");
+			} else {
+				PHALCON_CALL_METHOD(&content, &view, "getcontent");
+			}
 			PHALCON_CALL_METHOD(NULL, &response, "setcontent", &content);
 			zval_ptr_dtor(&content);
 		}
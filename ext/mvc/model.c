@@ -494,12 +494,218 @@ static const zend_function_entry phalcon_mvc_model_method_entry[] = {
 	PHP_FE_END
 };
 
+zend_object_handlers phalcon_mvc_model_object_handlers;
+
+/**
+ * Records that an attribute was written, declared properties are tracked in a bitset
+ * indexed by their property slot, dynamic ones by name
+ */
+static void phalcon_mvc_model_mark_dirty(zend_object *obj, zend_string *name)
+{
+	phalcon_mvc_model_object *intern = phalcon_mvc_model_object_from_obj(obj);
+	zend_property_info *property_info;
+	uint32_t slot;
+
+	property_info = zend_hash_find_ptr(&obj->ce->properties_info, name);
+	if (property_info && !(property_info->flags & ZEND_ACC_STATIC)) {
+		/* Internal state of the model is not an attribute */
+		if (property_info->ce == phalcon_mvc_model_ce) {
+			return;
+		}
+
+		if (!intern->dirty) {
+			intern->dirty_size = (obj->ce->default_properties_count + 31) / 32;
+			if (!intern->dirty_size) {
+				return;
+			}
+			intern->dirty = ecalloc(intern->dirty_size, sizeof(uint32_t));
+		}
+
+		slot = OBJ_PROP_TO_NUM(property_info->offset);
+		if (slot < intern->dirty_size * 32) {
+			intern->dirty[slot >> 5] |= 1U << (slot & 31);
+		}
+		return;
+	}
+
+	if (!intern->dirty_dynamic) {
+		ALLOC_HASHTABLE(intern->dirty_dynamic);
+		zend_hash_init(intern->dirty_dynamic, 8, NULL, NULL, 0);
+	}
+	zend_hash_add_empty_element(intern->dirty_dynamic, name);
+}
+
+/**
+ * Checks if an attribute was written since the record was fetched or saved, records
+ * that are not tracked yet report every attribute as dirty
+ */
+static int phalcon_mvc_model_is_dirty(zval *object, zval *attribute)
+{
+	phalcon_mvc_model_object *intern;
+	zend_property_info *property_info;
+	zend_string *name;
+	uint32_t slot;
+	int dirty = 1;
+
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_OBJ_HT_P(object) != &phalcon_mvc_model_object_handlers) {
+		return 1;
+	}
+
+	intern = phalcon_mvc_model_object_from_obj(Z_OBJ_P(object));
+	if (!intern->tracking) {
+		return 1;
+	}
+
+	name = zval_get_string(attribute);
+	property_info = zend_hash_find_ptr(&Z_OBJCE_P(object)->properties_info, name);
+	if (property_info && !(property_info->flags & ZEND_ACC_STATIC)) {
+		slot = OBJ_PROP_TO_NUM(property_info->offset);
+		dirty = intern->dirty && slot < intern->dirty_size * 32 && (intern->dirty[slot >> 5] & (1U << (slot & 31)));
+	} else {
+		dirty = intern->dirty_dynamic && zend_hash_exists(intern->dirty_dynamic, name);
+	}
+	zend_string_release(name);
+
+	return dirty;
+}
+
+/**
+ * Checks if the record is tracking the attributes written to it
+ */
+static int phalcon_mvc_model_is_tracked(zval *object)
+{
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_OBJ_HT_P(object) != &phalcon_mvc_model_object_handlers) {
+		return 0;
+	}
+
+	return phalcon_mvc_model_object_from_obj(Z_OBJ_P(object))->tracking;
+}
+
+/**
+ * Marks every attribute as clean and starts tracking writes
+ */
+void phalcon_mvc_model_reset_dirty(zval *object)
+{
+	phalcon_mvc_model_object *intern;
+
+	if (Z_TYPE_P(object) != IS_OBJECT || Z_OBJ_HT_P(object) != &phalcon_mvc_model_object_handlers) {
+		return;
+	}
+
+	intern = phalcon_mvc_model_object_from_obj(Z_OBJ_P(object));
+	if (intern->dirty) {
+		memset(intern->dirty, 0, intern->dirty_size * sizeof(uint32_t));
+	}
+	if (intern->dirty_dynamic) {
+		zend_hash_clean(intern->dirty_dynamic);
+	}
+	intern->tracking = 1;
+}
+
+static void phalcon_mvc_model_dirty_member(zval *object, zval *member)
+{
+	zend_string *name = zval_get_string(member);
+	phalcon_mvc_model_mark_dirty(Z_OBJ_P(object), name);
+	zend_string_release(name);
+}
+
+/**
+ * The runtime cache slot is never handed to the standard handlers, otherwise the engine
+ * would write cached properties directly and skip the dirty tracking
+ */
+#if PHP_VERSION_ID >= 70400
+static zval *phalcon_mvc_model_write_property(zval *object, zval *member, zval *value, void **cache_slot)
+{
+	zval *retval = zend_std_write_property(object, member, value, NULL);
+	if (!EG(exception)) {
+		phalcon_mvc_model_dirty_member(object, member);
+	}
+	return retval;
+}
+#else
+static void phalcon_mvc_model_write_property(zval *object, zval *member, zval *value, void **cache_slot)
+{
+	zend_std_write_property(object, member, value, NULL);
+	if (!EG(exception)) {
+		phalcon_mvc_model_dirty_member(object, member);
+	}
+}
+#endif
+
+static zval *phalcon_mvc_model_get_property_ptr_ptr(zval *object, zval *member, int type, void **cache_slot)
+{
+	zval *retval = zend_std_get_property_ptr_ptr(object, member, type, NULL);
+	if (retval && type != BP_VAR_R && type != BP_VAR_IS) {
+		phalcon_mvc_model_dirty_member(object, member);
+	}
+	return retval;
+}
+
+zend_object* phalcon_mvc_model_object_create_handler(zend_class_entry *ce)
+{
+	phalcon_mvc_model_object *intern = ecalloc(1, sizeof(phalcon_mvc_model_object) + zend_object_properties_size(ce));
+	intern->std.ce = ce;
+
+	zend_object_std_init(&intern->std, ce);
+	object_properties_init(&intern->std, ce);
+	intern->std.handlers = &phalcon_mvc_model_object_handlers;
+
+	return &intern->std;
+}
+
+static zend_object* phalcon_mvc_model_object_clone_handler(zval *object)
+{
+	zend_object *old_object = Z_OBJ_P(object), *new_object;
+	phalcon_mvc_model_object *old_intern, *new_intern;
+
+	new_object = phalcon_mvc_model_object_create_handler(old_object->ce);
+
+	old_intern = phalcon_mvc_model_object_from_obj(old_object);
+	new_intern = phalcon_mvc_model_object_from_obj(new_object);
+
+	if (old_intern->dirty) {
+		new_intern->dirty_size = old_intern->dirty_size;
+		new_intern->dirty = safe_emalloc(old_intern->dirty_size, sizeof(uint32_t), 0);
+		memcpy(new_intern->dirty, old_intern->dirty, old_intern->dirty_size * sizeof(uint32_t));
+	}
+	if (old_intern->dirty_dynamic) {
+		ALLOC_HASHTABLE(new_intern->dirty_dynamic);
+		zend_hash_init(new_intern->dirty_dynamic, zend_hash_num_elements(old_intern->dirty_dynamic), NULL, NULL, 0);
+		zend_hash_copy(new_intern->dirty_dynamic, old_intern->dirty_dynamic, NULL);
+	}
+	new_intern->tracking = old_intern->tracking;
+
+	zend_objects_clone_members(new_object, old_object);
+
+	return new_object;
+}
+
+void phalcon_mvc_model_object_free_handler(zend_object *object)
+{
+	phalcon_mvc_model_object *intern = phalcon_mvc_model_object_from_obj(object);
+
+	if (intern->dirty) {
+		efree(intern->dirty);
+		intern->dirty = NULL;
+	}
+	if (intern->dirty_dynamic) {
+		zend_hash_destroy(intern->dirty_dynamic);
+		FREE_HASHTABLE(intern->dirty_dynamic);
+		intern->dirty_dynamic = NULL;
+	}
+	zend_object_std_dtor(object);
+}
+
 /**
  * Phalcon\Mvc\Model initializer
  */
 PHALCON_INIT_CLASS(Phalcon_Mvc_Model){
 
-	PHALCON_REGISTER_CLASS_EX(Phalcon\\Mvc, Model, mvc_model, phalcon_di_injectable_ce, phalcon_mvc_model_method_entry, ZEND_ACC_EXPLICIT_ABSTRACT_CLASS);
+	PHALCON_REGISTER_CLASS_CREATE_OBJECT_EX(Phalcon\\Mvc, Model, mvc_model, phalcon_di_injectable_ce, phalcon_mvc_model_method_entry, ZEND_ACC_EXPLICIT_ABSTRACT_CLASS);
+
+	phalcon_mvc_model_object_handlers.write_property = phalcon_mvc_model_write_property;
+	phalcon_mvc_model_object_handlers.get_property_ptr_ptr = phalcon_mvc_model_get_property_ptr_ptr;
+	phalcon_mvc_model_object_handlers.clone_obj = phalcon_mvc_model_object_clone_handler;
 
 	zend_declare_property_null(phalcon_mvc_model_ce, SL("_errorMessages"), ZEND_ACC_PROTECTED);
 	zend_declare_property_long(phalcon_mvc_model_ce, SL("_operationMade"), PHALCON_MODEL_OP_NONE, ZEND_ACC_PROTECTED);
@@ -568,6 +774,23 @@ static int phalcon_mvc_model_get_messages_from_model(zval *this_ptr, zval *model
 	return likely(!EG(exception)) ? SUCCESS : FAILURE;
 }
 
+/**
+ * Removes the record from the identity map when the models manager keeps one
+ */
+static void phalcon_mvc_model_remove_identity(zval *this_ptr)
+{
+	zval models_manager = {}, enabled = {};
+
+	PHALCON_CALL_METHOD(&models_manager, this_ptr, "getmodelsmanager");
+	if (Z_TYPE(models_manager) == IS_OBJECT && instanceof_function(Z_OBJCE(models_manager), phalcon_mvc_model_manager_ce)) {
+		phalcon_read_property(&enabled, &models_manager, SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+		if (zend_is_true(&enabled)) {
+			PHALCON_CALL_METHOD(NULL, &models_manager, "removeidentity", this_ptr);
+		}
+	}
+	zval_ptr_dtor(&models_manager);
+}
+
 /**
  * Phalcon\Mvc\Model constructor
  *
@@ -1699,8 +1922,11 @@ PHP_METHOD(Phalcon_Mvc_Model, cloneResultMap){
 	}
 
 	if (instanceof_function(Z_OBJCE_P(return_value), phalcon_mvc_model_ce)) {
-		PHALCON_CALL_METHOD(NULL, return_value, "setsnapshotdata", data, column_map);
+		if (PHALCON_GLOBAL(orm).enable_snapshots) {
+			PHALCON_CALL_METHOD(NULL, return_value, "setsnapshotdata", data, column_map);
+		}
 		PHALCON_CALL_METHOD(NULL, return_value, "build");
+		phalcon_mvc_model_reset_dirty(return_value);
 	}
 
 	/**
@@ -1868,6 +2094,8 @@ PHP_METHOD(Phalcon_Mvc_Model, cloneResult){
 		phalcon_update_property_string_zval(return_value, str_key, value);
 	} ZEND_HASH_FOREACH_END();
 
+	phalcon_mvc_model_reset_dirty(return_value);
+
 	/**
 	 * Call afterFetch, this allows the developer to execute actions after a record is
 	 * fetched from the database
@@ -2009,6 +2237,8 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 
 	zval *parameters = NULL, *auto_create = NULL, dependency_injector = {}, model_name = {}, service_name = {}, has = {}, manager = {}, model = {};
 	zval identityfield = {}, id_condition = {}, params = {}, builder = {}, query = {}, event_name = {}, hydration = {}, resultset = {};
+	zval identity_map = {}, primary_keys = {}, primary_key = {};
+	int by_identity = 0;
 
 	phalcon_fetch_params(1, 0, 2, &parameters, &auto_create);
 
@@ -2048,6 +2278,33 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 		if (phalcon_is_numeric(parameters)) {
 			zval condition = {};
 			PHALCON_MM_CALL_METHOD(&identityfield, &model, "getidentityfield");
+
+			/**
+			 * Records found by their primary key can be served from the identity map
+			 */
+			if (instanceof_function(Z_OBJCE(manager), phalcon_mvc_model_manager_ce)) {
+				phalcon_read_property(&identity_map, &manager, SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+				if (zend_is_true(&identity_map)) {
+					PHALCON_MM_CALL_METHOD(&primary_keys, &model, "getprimarykeyattributes");
+					PHALCON_MM_ADD_ENTRY(&primary_keys);
+					if (Z_TYPE(primary_keys) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL(primary_keys)) == 1) {
+						phalcon_array_fetch_long(&primary_key, &primary_keys, 0, PH_NOISY|PH_READONLY);
+						by_identity = PHALCON_IS_EQUAL(&primary_key, &identityfield);
+					}
+				}
+			}
+
+			if (by_identity) {
+				PHALCON_MM_CALL_METHOD(return_value, &manager, "getidentity", &model_name, parameters);
+				if (Z_TYPE_P(return_value) == IS_OBJECT) {
+					zval_ptr_dtor(&identityfield);
+					zval_ptr_dtor(&params);
+					RETURN_MM();
+				}
+				zval_ptr_dtor(return_value);
+				ZVAL_NULL(return_value);
+			}
+
 			PHALCON_MM_CALL_METHOD(&id_condition, &model, "getattribute", &identityfield);
 			zval_ptr_dtor(&identityfield);
 
@@ -2118,7 +2375,14 @@ PHP_METHOD(Phalcon_Mvc_Model, findFirst){
 		 */
 		if (phalcon_array_isset_fetch_str(&hydration, &params, SL("hydration"), PH_READONLY)) {
 			PHALCON_MM_CALL_METHOD(NULL, &resultset, "sethydratemode", &hydration);
-		}	
+		}
+
+		/**
+		 * A listener could have asked for some columns only, partial rows are not mapped
+		 */
+		if (by_identity && Z_TYPE(resultset) == IS_OBJECT && instanceof_function(Z_OBJCE(resultset), phalcon_mvc_modelinterface_ce)) {
+			PHALCON_MM_CALL_METHOD(NULL, &manager, "addidentity", &resultset);
+		}
 	}
 	zval_ptr_dtor(return_value);
 	PHALCON_MM_ZVAL_STRING(&event_name, "afterQuery");
@@ -2382,6 +2646,9 @@ PHP_METHOD(Phalcon_Mvc_Model, exists){
 	if (Z_TYPE(model) == IS_OBJECT) {
 		phalcon_update_property_long(getThis(), SL("_dirtyState"), PHALCON_MODEL_DIRTY_STATE_PERSISTEN);
 		PHALCON_CALL_METHOD(&snapshot, &model, "getsnapshotdata");
+		if (Z_TYPE(snapshot) != IS_ARRAY) {
+			PHALCON_CALL_METHOD(&snapshot, &model, "toarray");
+		}
 		PHALCON_CALL_METHOD(NULL, getThis(), "setsnapshotdata", &snapshot);
 		zval_ptr_dtor(&snapshot);
 		RETVAL_TRUE;
@@ -4395,15 +4662,12 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate){
 	PHALCON_CALL_METHOD(&models_manager, getThis(), "getmodelsmanager");
 
 	/**
-	 * Check if the model must use dynamic update
+	 * Check if the model must use dynamic update, records without a snapshot update every field
 	 */
 	PHALCON_CALL_METHOD(&use_dynamic_update, &models_manager, "isusingdynamicupdate", getThis());
 	i_use_dynamic_update = zend_is_true(&use_dynamic_update);
 	if (i_use_dynamic_update) {
 		PHALCON_CALL_METHOD(&snapshot, getThis(), "getsnapshotdata");
-		if (Z_TYPE(snapshot) != IS_ARRAY) {
-			i_use_dynamic_update = 0;
-		}
 	}
 
 	PHALCON_CALL_METHOD(&bind_data_types, getThis(), "getbindtypes");
@@ -4492,9 +4756,11 @@ PHP_METHOD(Phalcon_Mvc_Model, _doLowUpdate){
 					phalcon_array_update(&bind_types, &attribute_field, &bind_type, PH_COPY);
 				} else {
 					/**
-					 * If the field is not part of the snapshot we add them as changed
+					 * The snapshot decides, the engine can write a property without going through
+					 * the write handler so the written attributes alone can't be trusted. Without
+					 * a snapshot every field is updated
 					 */
-					if (!phalcon_array_isset_fetch(&snapshot_value, &snapshot, &attribute_field, PH_READONLY)) {
+					if (Z_TYPE(snapshot) != IS_ARRAY || !phalcon_array_isset_fetch(&snapshot_value, &snapshot, &attribute_field, PH_READONLY)) {
 						ZVAL_TRUE(&changed);
 					} else {
 						if (!PHALCON_IS_EQUAL(&convert_value, &snapshot_value)) {
@@ -4956,6 +5222,11 @@ PHP_METHOD(Phalcon_Mvc_Model, save){
 		ZVAL_COPY_VALUE(&exists, _exists);
 	}
 
+	phalcon_mvc_model_remove_identity(getThis());
+	if (EG(exception)) {
+		return;
+	}
+
 	if (!exists_check) {
 		exists_check = &PHALCON_GLOBAL(z_true);
 	}
@@ -5158,9 +5429,12 @@ PHP_METHOD(Phalcon_Mvc_Model, save){
 	 */
 	if (zend_is_true(&new_success)) {
 		phalcon_update_property_long(getThis(), SL("_dirtyState"), PHALCON_MODEL_DIRTY_STATE_PERSISTEN);
-		PHALCON_CALL_METHOD(&snapshot_data, getThis(), "toarray");
-		PHALCON_CALL_METHOD(NULL, getThis(), "setsnapshotdata", &snapshot_data);
-		zval_ptr_dtor(&snapshot_data);
+		if (PHALCON_GLOBAL(orm).enable_snapshots) {
+			PHALCON_CALL_METHOD(&snapshot_data, getThis(), "toarray");
+			PHALCON_CALL_METHOD(NULL, getThis(), "setsnapshotdata", &snapshot_data);
+			zval_ptr_dtor(&snapshot_data);
+		}
+		phalcon_mvc_model_reset_dirty(getThis());
 
 		if (!zend_is_true(&exists) || PHALCON_GLOBAL(orm).allow_update_primary) {
 				PHALCON_CALL_METHOD(NULL, getThis(), "_rebuild");
@@ -5299,6 +5573,11 @@ PHP_METHOD(Phalcon_Mvc_Model, delete){
 	zval event_name = {}, status = {}, check_foreign_keys = {},  write_connection = {}, unique_key = {}, unique_params = {}, unique_types = {};
 	zval skipped = {}, model_name = {}, phql = {}, models_manager = {}, query = {}, success = {};
 
+	phalcon_mvc_model_remove_identity(getThis());
+	if (EG(exception)) {
+		return;
+	}
+
 	phalcon_update_property_empty_array(getThis(), SL("_errorMessages"));
 
 	/**
@@ -5457,6 +5736,8 @@ PHP_METHOD(Phalcon_Mvc_Model, refresh){
 		return;
 	}
 
+	phalcon_mvc_model_remove_identity(getThis());
+
 	PHALCON_CALL_METHOD(&row, getThis(), "getsnapshotdata");
 
 	/**
@@ -5464,7 +5745,9 @@ PHP_METHOD(Phalcon_Mvc_Model, refresh){
 	 */
 	if (Z_TYPE(row) == IS_ARRAY) {
 		PHALCON_CALL_METHOD(NULL, getThis(), "assign", &row);
+		phalcon_mvc_model_reset_dirty(getThis());
 	}
+	zval_ptr_dtor(&row);
 }
 
 /**
@@ -5986,7 +6269,7 @@ PHP_METHOD(Phalcon_Mvc_Model, getSnapshotData){
 
 /**
  * Check if a specific attribute has changed
- * This only works if the model is keeping data snapshots
+ * Records without a data snapshot report the attributes written since they were fetched or saved
  *
  * @param string $fieldName
  * @return boolean
@@ -6004,7 +6287,7 @@ PHP_METHOD(Phalcon_Mvc_Model, hasChanged){
 	}
 
 	phalcon_read_property(&snapshot, getThis(), SL("_snapshot"), PH_READONLY);
-	if (Z_TYPE(snapshot) != IS_ARRAY) {
+	if (Z_TYPE(snapshot) != IS_ARRAY && !phalcon_mvc_model_is_tracked(getThis())) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The record doesn't have a valid data snapshot");
 		return;
 	}
@@ -6069,6 +6352,10 @@ PHP_METHOD(Phalcon_Mvc_Model, hasChanged){
 			return;
 		}
 
+		if (Z_TYPE(snapshot) != IS_ARRAY) {
+			RETURN_BOOL(phalcon_mvc_model_is_dirty(getThis(), field_name));
+		}
+
 		/**
 		 * The field is not part of the data snapshot, throw exception
 		 */
@@ -6103,6 +6390,13 @@ PHP_METHOD(Phalcon_Mvc_Model, hasChanged){
 			ZVAL_LONG(&name, idx);
 		}
 
+		if (Z_TYPE(snapshot) != IS_ARRAY) {
+			if (phalcon_mvc_model_is_dirty(getThis(), &name)) {
+				RETURN_TRUE;
+			}
+			continue;
+		}
+
 		/**
 		 * If some attribute is not present in the snapshot, we assume the record as
 		 * changed
@@ -6136,6 +6430,7 @@ PHP_METHOD(Phalcon_Mvc_Model, hasChanged){
 
 /**
  * Returns a list of changed values
+ * Records without a data snapshot return the attributes written since they were fetched or saved
  *
  * @return array
  */
@@ -6146,7 +6441,7 @@ PHP_METHOD(Phalcon_Mvc_Model, getChangedFields){
 	ulong idx;
 
 	phalcon_read_property(&snapshot, getThis(), SL("_snapshot"), PH_READONLY);
-	if (Z_TYPE(snapshot) != IS_ARRAY) {
+	if (Z_TYPE(snapshot) != IS_ARRAY && !phalcon_mvc_model_is_tracked(getThis())) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The record doesn't have a valid data snapshot");
 		return;
 	}
@@ -6189,6 +6484,13 @@ PHP_METHOD(Phalcon_Mvc_Model, getChangedFields){
 			ZVAL_LONG(&tmp, idx);
 		}
 
+		if (Z_TYPE(snapshot) != IS_ARRAY) {
+			if (phalcon_mvc_model_is_dirty(getThis(), &tmp)) {
+				phalcon_array_append(&changed, &tmp, PH_COPY);
+			}
+			continue;
+		}
+
 		/**
 		 * If some attribute is not present in the snapshot, we assume the record as
 		 * changed
@@ -7086,13 +7388,16 @@ PHP_METHOD(Phalcon_Mvc_Model, toArray){
  * propertyMethod        — Enables/Disables property method
  * autoConvert           — Enables/Disables auto convert
  * strict                — Enables/Disables strict mode
+ * snapshots             — Enables/Disables keeping a snapshot of the fetched data, without it dynamic updates write every field
+ * planCache             — Enables/Disables reusing the compiled SQL of PHQL SELECT statements
  *
  * @param array $options
  */
 PHP_METHOD(Phalcon_Mvc_Model, setup){
 
 	zval *options, disable_events = {}, virtual_foreign_keys = {}, not_null_validations = {}, length_validations = {}, exception_on_failed_save = {};
-	zval phql_literals = {}, property_method = {}, auto_convert = {}, allow_update_primary = {}, enable_strict = {};
+	zval phql_literals = {}, property_method = {}, auto_convert = {}, allow_update_primary = {}, enable_strict = {}, enable_snapshots = {};
+	zval plan_cache = {};
 
 	phalcon_fetch_params(0, 1, 0, &options);
 
@@ -7170,6 +7475,20 @@ PHP_METHOD(Phalcon_Mvc_Model, setup){
 	if (phalcon_array_isset_fetch_str(&enable_strict, options, SL("strict"), PH_READONLY)) {
 		PHALCON_GLOBAL(orm).enable_strict = zend_is_true(&enable_strict);
 	}
+
+	/**
+	 * Enables/Disables data snapshots
+	 */
+	if (phalcon_array_isset_fetch_str(&enable_snapshots, options, SL("snapshots"), PH_READONLY)) {
+		PHALCON_GLOBAL(orm).enable_snapshots = zend_is_true(&enable_snapshots);
+	}
+
+	/**
+	 * Enables/Disables the PHQL plan cache
+	 */
+	if (phalcon_array_isset_fetch_str(&plan_cache, options, SL("planCache"), PH_READONLY)) {
+		PHALCON_GLOBAL(orm).enable_plan_cache = zend_is_true(&plan_cache);
+	}
 }
 
 /**
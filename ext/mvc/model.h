@@ -31,8 +31,22 @@
 #define PHALCON_MODEL_DIRTY_STATE_TRANSIENT		1
 #define PHALCON_MODEL_DIRTY_STATE_DETACHED		2
 
+typedef struct _phalcon_mvc_model_object {
+	uint32_t *dirty;
+	uint32_t dirty_size;
+	HashTable *dirty_dynamic;
+	zend_bool tracking;
+	zend_object std;
+} phalcon_mvc_model_object;
+
+static inline phalcon_mvc_model_object *phalcon_mvc_model_object_from_obj(zend_object *obj) {
+	return (phalcon_mvc_model_object*)((char*)(obj) - XtOffsetOf(phalcon_mvc_model_object, std));
+}
+
 extern zend_class_entry *phalcon_mvc_model_ce;
 
+void phalcon_mvc_model_reset_dirty(zval *object);
+
 PHALCON_INIT_CLASS(Phalcon_Mvc_Model);
 
 #endif /* PHALCON_MVC_MODEL_H */
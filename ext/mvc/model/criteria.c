@@ -93,6 +93,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, forUpdate);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, setIndex);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, getIndex);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, sharedLock);
+PHP_METHOD(Phalcon_Mvc_Model_Criteria, with);
+PHP_METHOD(Phalcon_Mvc_Model_Criteria, getWith);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, getParams);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, fromInput);
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, groupBy);
@@ -148,6 +150,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_criteria_setindex, 0, 0, 1)
 	ZEND_ARG_TYPE_INFO(0, index, IS_STRING, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_criteria_with, 0, 0, 1)
+	ZEND_ARG_INFO(0, relations)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_mvc_model_criteria_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Criteria, setModelName, arginfo_phalcon_mvc_model_criteriainterface_setmodelname, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, getModelName, NULL, ZEND_ACC_PUBLIC)
@@ -182,6 +188,8 @@ static const zend_function_entry phalcon_mvc_model_criteria_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Criteria, setIndex, arginfo_phalcon_mvc_model_criteria_setindex, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, getIndex, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, sharedLock, arginfo_phalcon_mvc_model_criteriainterface_sharedlock, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Criteria, with, arginfo_phalcon_mvc_model_criteria_with, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Criteria, getWith, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, getParams, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, fromInput, arginfo_phalcon_mvc_model_criteriainterface_frominput, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
 	PHP_ME(Phalcon_Mvc_Model_Criteria, groupBy, arginfo_phalcon_mvc_model_criteria_groupby, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
@@ -226,6 +234,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Criteria) {
 	zend_declare_property_null(phalcon_mvc_model_criteria_ce, SL("_group"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_criteria_ce, SL("_having"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_criteria_ce, SL("_uniqueRow"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_criteria_ce, SL("_with"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_mvc_model_criteria_ce, 1, phalcon_mvc_model_criteriainterface_ce);
 
@@ -1178,6 +1187,37 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, sharedLock) {
 	RETURN_THIS();
 }
 
+/**
+ * Sets the relations to eager load with the records found
+ *
+ *<code>
+ * $robots = Robots::query()->with(array('robotsParts', 'robotsParts.parts'))->execute();
+ *</code>
+ *
+ * @param string|array $relations
+ * @return Phalcon\Mvc\Model\CriteriaInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Criteria, with) {
+
+	zval *relations;
+
+	phalcon_fetch_params(0, 1, 0, &relations);
+
+	phalcon_update_property(getThis(), SL("_with"), relations);
+	RETURN_THIS();
+}
+
+/**
+ * Returns the relations to eager load
+ *
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Criteria, getWith) {
+
+
+	RETURN_MEMBER(getThis(), "_with");
+}
+
 /**
  * Returns the conditions parameter in the criteria
  *
@@ -1239,7 +1279,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, getOrder) {
  */
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, getParams) {
 
-	zval params = {}, conditions = {}, bind_params = {}, bind_types = {}, order = {}, limit = {}, offset = {}, cache = {};
+	zval params = {}, conditions = {}, bind_params = {}, bind_types = {}, order = {}, limit = {}, offset = {}, cache = {}, with = {};
 
 	array_init(&params);
 
@@ -1278,6 +1318,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, getParams) {
 		phalcon_array_update_str(&params, SL("cache"), &cache, PH_COPY);
 	}
 
+	phalcon_read_property(&with, getThis(), SL("_with"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(with) != IS_NULL) {
+		phalcon_array_update_str(&params, SL("with"), &with, PH_COPY);
+	}
+
 	RETVAL_ZVAL(&params, 0, 0);
 }
 
@@ -1424,7 +1469,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, having) {
  */
 PHP_METHOD(Phalcon_Mvc_Model_Criteria, execute) {
 
-	zval phql = {}, dependency_injector = {}, cache_options = {}, unique_row = {}, index = {};
+	zval phql = {}, dependency_injector = {}, cache_options = {}, unique_row = {}, index = {}, with = {};
 	zval query = {}, bind_params = {}, bind_types = {};
 
 	PHALCON_CALL_SELF(&phql, "getphql");
@@ -1450,6 +1495,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Criteria, execute) {
 		PHALCON_CALL_METHOD(NULL, &query, "setindex", &index);
 	}
 
+	phalcon_read_property(&with, getThis(), SL("_with"), PH_NOISY|PH_READONLY);
+	if (PHALCON_IS_NOT_EMPTY(&with)) {
+		PHALCON_CALL_METHOD(NULL, &query, "setwith", &with);
+	}
+
 	phalcon_read_property(&bind_params, getThis(), SL("_bindParams"), PH_NOISY|PH_READONLY);
 	phalcon_read_property(&bind_types, getThis(), SL("_bindTypes"), PH_NOISY|PH_READONLY);
 
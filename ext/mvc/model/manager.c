@@ -24,9 +24,18 @@
 #include "mvc/model/query.h"
 #include "mvc/model/query/builder.h"
 #include "mvc/model/relation.h"
+#include "mvc/model/resultset.h"
+#include "mvc/model/resultsetinterface.h"
+#include "mvc/model/resultset/simple.h"
+#include "mvc/model.h"
+#include "mvc/modelinterface.h"
 #include "diinterface.h"
 #include "di/injectable.h"
+#include "db/adapter.h"
 #include "db/adapterinterface.h"
+#include "db/column.h"
+#include "db/rawvalue.h"
+#include "db/pool.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -43,6 +52,11 @@
 #include "kernel/debug.h"
 
 #include "interned-strings.h"
+#include <ext/pdo/php_pdo_driver.h>
+
+#if PHP_VERSION_ID >= 70400
+#include <Zend/zend_weakrefs.h>
+#endif
 
 /**
  * Phalcon\Mvc\Model\Manager
@@ -98,9 +112,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, existsHasOne);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, existsHasManyToMany);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationByAlias);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, eagerLoad);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getReusableRecords);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, setReusableRecords);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, clearReusableObjects);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, useIdentityMap);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, isUsingIdentityMap);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getIdentity);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addIdentity);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, removeIdentity);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearIdentityMap);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getBelongsToRecords);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasManyRecords);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getHasOneRecords);
@@ -118,8 +139,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getLastQuery);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, registerNamespaceAlias);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getNamespaceAlias);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getNamespaceAliases);
+PHP_METHOD(Phalcon_Mvc_Model_Manager, saveBatch);
 PHP_METHOD(Phalcon_Mvc_Model_Manager, __destruct);
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_savebatch, 0, 0, 1)
+	ZEND_ARG_ARRAY_INFO(0, models, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_setcustomeventsmanager, 0, 0, 2)
 	ZEND_ARG_INFO(0, model)
 	ZEND_ARG_INFO(0, eventsManager)
@@ -223,6 +249,28 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_getrelationrecords, 0,
 	ZEND_ARG_INFO(0, parameters)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_eagerload, 0, 0, 2)
+	ZEND_ARG_INFO(0, records)
+	ZEND_ARG_INFO(0, relations)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_useidentitymap, 0, 0, 1)
+	ZEND_ARG_INFO(0, identityMap)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_getidentity, 0, 0, 2)
+	ZEND_ARG_INFO(0, modelName)
+	ZEND_ARG_INFO(0, key)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_addidentity, 0, 0, 1)
+	ZEND_ARG_INFO(0, model)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_removeidentity, 0, 0, 1)
+	ZEND_ARG_INFO(0, model)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_manager_getreusablerecords, 0, 0, 2)
 	ZEND_ARG_INFO(0, modelName)
 	ZEND_ARG_INFO(0, key)
@@ -282,9 +330,16 @@ static const zend_function_entry phalcon_mvc_model_manager_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Manager, existsHasManyToMany, arginfo_phalcon_mvc_model_manager_existshasmanytomany, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getRelationByAlias, arginfo_phalcon_mvc_model_manager_getrelationbyalias, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getRelationRecords, arginfo_phalcon_mvc_model_manager_getrelationrecords, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, eagerLoad, arginfo_phalcon_mvc_model_manager_eagerload, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getReusableRecords, arginfo_phalcon_mvc_model_manager_getreusablerecords, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, setReusableRecords, arginfo_phalcon_mvc_model_manager_setreusablerecords, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, clearReusableObjects, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, useIdentityMap, arginfo_phalcon_mvc_model_manager_useidentitymap, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, isUsingIdentityMap, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, getIdentity, arginfo_phalcon_mvc_model_manager_getidentity, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, addIdentity, arginfo_phalcon_mvc_model_manager_addidentity, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, removeIdentity, arginfo_phalcon_mvc_model_manager_removeidentity, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, clearIdentityMap, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getBelongsToRecords, arginfo_phalcon_mvc_model_managerinterface_getbelongstorecords, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getHasManyRecords, arginfo_phalcon_mvc_model_managerinterface_gethasmanyrecords, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getHasOneRecords, arginfo_phalcon_mvc_model_managerinterface_gethasonerecords, ZEND_ACC_PUBLIC)
@@ -302,6 +357,7 @@ static const zend_function_entry phalcon_mvc_model_manager_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Manager, registerNamespaceAlias, arginfo_phalcon_mvc_model_manager_registernamespacealias, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getNamespaceAlias, arginfo_phalcon_mvc_model_manager_getnamespacealias, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, getNamespaceAliases, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Manager, saveBatch, arginfo_phalcon_mvc_model_manager_savebatch, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Manager, __destruct, NULL, ZEND_ACC_PUBLIC|ZEND_ACC_DTOR)
 	PHP_FE_END
 };
@@ -334,8 +390,11 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Manager){
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_lastInitialized"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_lastQuery"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_reusable"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_model_manager_ce, SL("_identityMapEnabled"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_identityMap"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_dynamicUpdate"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_namespaceAliases"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_manager_ce, SL("_planId"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_mvc_model_manager_ce, 1, phalcon_mvc_model_managerinterface_ce);
 
@@ -547,6 +606,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setModelSource){
 	phalcon_get_class(&entity_name, model, 1);
 	phalcon_update_property_array(getThis(), SL("_sources"), &entity_name, source);
 	zval_ptr_dtor(&entity_name);
+
+	/* Query plans resolved with the previous source are not reused */
+	phalcon_update_property_null(getThis(), SL("_planId"));
 }
 
 /**
@@ -610,6 +672,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setModelSchema){
 	phalcon_get_class(&entity_name, model, 1);
 	phalcon_update_property_array(getThis(), SL("_schemas"), &entity_name, schema);
 	zval_ptr_dtor(&entity_name);
+
+	/* Query plans resolved with the previous schema are not reused */
+	phalcon_update_property_null(getThis(), SL("_planId"));
 }
 
 /**
@@ -736,14 +801,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, setDefaultReadConnectionService){
 }
 
 /**
- * Returns the connection to write data related to a model
+ * Returns the connection to write data related to a model. If the service is a Phalcon\Db\Pool
+ * the primary is returned and the next reads of the model are sent to it
  *
  * @param Phalcon\Mvc\ModelInterface $model
  * @return Phalcon\Db\AdapterInterface
  */
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getWriteConnection){
 
-	zval *model, service = {}, dependency_injector = {};
+	zval *model, service = {}, dependency_injector = {}, pool = {}, entity_name = {};
+	int flag;
 
 	phalcon_fetch_params(0, 1, 0, &model);
 
@@ -767,18 +834,31 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getWriteConnection){
 		return;
 	}
 
+	if (instanceof_function(Z_OBJCE_P(return_value), phalcon_db_pool_ce)) {
+		ZVAL_COPY_VALUE(&pool, return_value);
+		phalcon_get_class(&entity_name, model, 1);
+		PHALCON_CALL_METHOD_FLAG(flag, return_value, &pool, "getwriteconnection", &entity_name);
+		zval_ptr_dtor(&entity_name);
+		zval_ptr_dtor(&pool);
+		if (flag == FAILURE) {
+			return;
+		}
+	}
+
 	PHALCON_VERIFY_INTERFACE(return_value, phalcon_db_adapterinterface_ce);
 }
 
 /**
- * Returns the connection to read data related to a model
+ * Returns the connection to read data related to a model. If the service is a Phalcon\Db\Pool
+ * a replica is picked unless the model was pinned to the primary
  *
  * @param Phalcon\Mvc\ModelInterface $model
  * @return Phalcon\Db\AdapterInterface
  */
 PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnection){
 
-	zval *model, service = {}, dependency_injector = {};
+	zval *model, service = {}, dependency_injector = {}, pool = {}, entity_name = {};
+	int flag;
 
 	phalcon_fetch_params(0, 1, 0, &model);
 
@@ -801,6 +881,17 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getReadConnection){
 		return;
 	}
 
+	if (instanceof_function(Z_OBJCE_P(return_value), phalcon_db_pool_ce)) {
+		ZVAL_COPY_VALUE(&pool, return_value);
+		phalcon_get_class(&entity_name, model, 1);
+		PHALCON_CALL_METHOD_FLAG(flag, return_value, &pool, "getreadconnection", &entity_name);
+		zval_ptr_dtor(&entity_name);
+		zval_ptr_dtor(&pool);
+		if (flag == FAILURE) {
+			return;
+		}
+	}
+
 	PHALCON_VERIFY_INTERFACE(return_value, phalcon_db_adapterinterface_ce);
 }
 
@@ -1696,9 +1787,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	zval intermediate_model = {}, intermediate_fields = {}, fields = {}, value = {}, condition = {}, join_conditions = {}, referenced_fields = {}, joined_join_conditions = {};
 	zval joined_conditions = {}, builder = {}, query = {}, referenced_field = {}, *field, dependency_injector = {}, find_params = {}, find_arguments = {}, arguments = {};
 	zval type = {}, retrieve_method = {}, reusable = {}, unique_key = {}, records = {}, referenced_entity = {}, call_object = {};
+	zval identity_value = {}, identity_field = {}, identity_map = {}, primary_keys = {}, primary_key = {};
 	zend_string *str_key;
 	ulong idx;
-	int f_reusable;
+	int f_reusable, by_identity = 0;
 
 	phalcon_fetch_params(0, 3, 1, &relation, &method, &record, &p);
 
@@ -1848,8 +1940,9 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 
 		PHALCON_CONCAT_SVS(&condition, "[", &referenced_field, "] = ?0");
 		phalcon_array_append(&conditions, &condition, 0);
+		ZVAL_COPY(&identity_value, &value);
 		phalcon_array_append(&placeholders, &value, 0);
-		zval_ptr_dtor(&referenced_field);
+		ZVAL_COPY_VALUE(&identity_field, &referenced_field);
 	} else {
 		/**
 		 * Compound relation
@@ -1929,6 +2022,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 		ZVAL_COPY(&retrieve_method, method);
 	}
 
+	/**
+	 * belongsTo records referenced by their primary key can be served from the identity map,
+	 * any extra parameter (conditions, columns, for_update...) needs the query to run
+	 */
+	if (PHALCON_IS_LONG(&type, 0) && Z_TYPE(identity_value) > IS_NULL && (!p || !zend_is_true(p))) {
+		phalcon_read_property(&identity_map, getThis(), SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+		if (zend_is_true(&identity_map)) {
+			PHALCON_CALL_METHOD(&referenced_entity, getThis(), "load", &referenced_model);
+			PHALCON_CALL_METHOD(&primary_keys, &referenced_entity, "getprimarykeyattributes");
+			zval_ptr_dtor(&referenced_entity);
+			ZVAL_UNDEF(&referenced_entity);
+
+			if (Z_TYPE(primary_keys) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL(primary_keys)) == 1) {
+				phalcon_array_fetch_long(&primary_key, &primary_keys, 0, PH_NOISY|PH_READONLY);
+				by_identity = PHALCON_IS_EQUAL(&primary_key, &identity_field);
+			}
+			zval_ptr_dtor(&primary_keys);
+
+			if (by_identity) {
+				PHALCON_CALL_METHOD(&records, getThis(), "getidentity", &referenced_model, &identity_value);
+				if (Z_TYPE(records) == IS_OBJECT) {
+					RETVAL_ZVAL(&records, 0, 0);
+					zval_ptr_dtor(&arguments);
+					zval_ptr_dtor(&referenced_model);
+					zval_ptr_dtor(&retrieve_method);
+					zval_ptr_dtor(&identity_value);
+					zval_ptr_dtor(&identity_field);
+					return;
+				}
+				zval_ptr_dtor(&records);
+				ZVAL_UNDEF(&records);
+			}
+		}
+	}
+	zval_ptr_dtor(&identity_value);
+	zval_ptr_dtor(&identity_field);
+
 	/**
 	 * Find first results could be reusable
 	 */
@@ -1979,9 +2109,519 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getRelationRecords){
 	}
 	zval_ptr_dtor(&referenced_model);
 
+	if (by_identity && Z_TYPE(records) == IS_OBJECT) {
+		PHALCON_CALL_METHOD(NULL, getThis(), "addidentity", &records);
+	}
+
 	RETVAL_ZVAL(&records, 0, 0);
 }
 
+/**
+ * Runs the query of an eager loaded relation, the records found and the raw rows
+ * they were hydrated from are returned in the same order. The keys are split so a
+ * query never binds more parameters than the connection accepts
+ */
+static void phalcon_mvc_model_manager_eager_find(zval *resultset, zval *records, zval *rows, zval *manager, zval *model_name, zval *field, zval *keys, zval *dependency_injector)
+{
+	zval entity = {}, connection = {}, max_parameters = {}, conditions = {}, chunk = {}, *key;
+	zend_long chunk_size, number_keys, position = 0;
+
+	array_init(records);
+	array_init(rows);
+	ZVAL_NULL(resultset);
+
+	number_keys = zend_hash_num_elements(Z_ARRVAL_P(keys));
+	if (!number_keys) {
+		return;
+	}
+
+	PHALCON_CALL_METHOD(&entity, manager, "load", model_name);
+	PHALCON_CALL_METHOD(&connection, &entity, "getreadconnection");
+
+	chunk_size = number_keys;
+	if (Z_TYPE(connection) == IS_OBJECT && instanceof_function(Z_OBJCE(connection), phalcon_db_adapter_ce)) {
+		phalcon_read_property(&max_parameters, &connection, SL("_maxBindParameters"), PH_READONLY);
+		if (Z_TYPE(max_parameters) == IS_LONG && Z_LVAL(max_parameters) > 0 && Z_LVAL(max_parameters) < chunk_size) {
+			chunk_size = Z_LVAL(max_parameters);
+		}
+	}
+	zval_ptr_dtor(&connection);
+
+	PHALCON_CONCAT_SVS(&conditions, "[", field, "] IN ({eagerKeys:array})");
+
+	array_init_size(&chunk, chunk_size);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key) {
+		zval chunk_resultset = {}, bind = {}, params = {}, arguments = {}, call_object = {}, chunk_rows = {};
+		zend_long first_record, i;
+		int flag;
+
+		phalcon_array_append(&chunk, key, PH_COPY);
+		if (++position % chunk_size && position < number_keys) {
+			continue;
+		}
+
+		array_init_size(&bind, 1);
+		phalcon_array_update_str(&bind, SL("eagerKeys"), &chunk, 0);
+		array_init_size(&chunk, chunk_size);
+
+		array_init_size(&params, 3);
+		phalcon_array_append(&params, &conditions, PH_COPY);
+		phalcon_array_update_str(&params, SL("bind"), &bind, 0);
+		phalcon_array_update_str(&params, SL("di"), dependency_injector, PH_COPY);
+
+		array_init_size(&arguments, 1);
+		phalcon_array_append(&arguments, &params, 0);
+
+		array_init_size(&call_object, 2);
+		phalcon_array_append(&call_object, &entity, PH_COPY);
+		add_next_index_stringl(&call_object, SL("find"));
+
+		flag = phalcon_call_user_func_array(&chunk_resultset, &call_object, &arguments);
+		zval_ptr_dtor(&call_object);
+		zval_ptr_dtor(&arguments);
+
+		if (Z_TYPE(chunk_resultset) != IS_OBJECT) {
+			zval_ptr_dtor(&chunk_resultset);
+			if (EG(exception)) {
+				break;
+			}
+			continue;
+		}
+
+		/**
+		 * Keep the rows buffered so the hydrated records can be replayed by other resultsets
+		 */
+		if (instanceof_function(Z_OBJCE(chunk_resultset), phalcon_mvc_model_resultset_simple_ce)) {
+			phalcon_update_property_long(&chunk_resultset, SL("_type"), 0);
+		}
+
+		first_record = zend_hash_num_elements(Z_ARRVAL_P(records));
+
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &chunk_resultset, "rewind");
+
+		while (flag == SUCCESS) {
+			zval valid = {}, current = {};
+
+			PHALCON_CALL_METHOD_FLAG(flag, &valid, &chunk_resultset, "valid");
+			if (flag == FAILURE || !zend_is_true(&valid)) {
+				break;
+			}
+
+			PHALCON_CALL_METHOD_FLAG(flag, &current, &chunk_resultset, "current");
+			if (flag == FAILURE) {
+				break;
+			}
+			phalcon_array_append(records, &current, 0);
+
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &chunk_resultset, "next");
+		}
+
+		/**
+		 * Raw rows are kept in the order of the records of every chunk
+		 */
+		phalcon_read_property(&chunk_rows, &chunk_resultset, SL("_rows"), PH_READONLY);
+		for (i = 0; i < (zend_long)zend_hash_num_elements(Z_ARRVAL_P(records)) - first_record; i++) {
+			zval row = {};
+			if (Z_TYPE(chunk_rows) != IS_ARRAY || !phalcon_array_isset_fetch_long(&row, &chunk_rows, i, PH_READONLY)) {
+				ZVAL_NULL(&row);
+			}
+			phalcon_array_append(rows, &row, PH_COPY);
+		}
+
+		if (Z_TYPE_P(resultset) == IS_OBJECT) {
+			zval_ptr_dtor(&chunk_resultset);
+		} else {
+			ZVAL_COPY_VALUE(resultset, &chunk_resultset);
+		}
+
+		if (EG(exception)) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&chunk);
+	zval_ptr_dtor(&conditions);
+	zval_ptr_dtor(&entity);
+}
+
+/**
+ * Builds the resultset returned by a "many" relation from records that were already hydrated
+ */
+static void phalcon_mvc_model_manager_eager_resultset(zval *resultset, zval *source, zval *entity, zval *rows, zval *records)
+{
+	zval column_map = {}, model = {}, source_model = {};
+
+	if (Z_TYPE_P(source) == IS_OBJECT) {
+		phalcon_read_property(&column_map, source, SL("_columnMap"), PH_READONLY);
+		phalcon_read_property(&model, source, SL("_model"), PH_READONLY);
+		phalcon_read_property(&source_model, source, SL("_sourceModel"), PH_READONLY);
+	} else {
+		ZVAL_NULL(&column_map);
+		ZVAL_COPY_VALUE(&model, entity);
+		ZVAL_NULL(&source_model);
+	}
+
+	object_init_ex(resultset, phalcon_mvc_model_resultset_simple_ce);
+	PHALCON_CALL_METHOD(NULL, resultset, "__construct", &column_map, &model, &PHALCON_GLOBAL(z_false), &PHALCON_GLOBAL(z_null), &source_model);
+
+	phalcon_update_property_long(resultset, SL("_type"), 0);
+	phalcon_update_property(resultset, SL("_rows"), rows);
+	phalcon_update_property(resultset, SL("_rowsModels"), records);
+	phalcon_update_property_long(resultset, SL("_count"), zend_hash_num_elements(Z_ARRVAL_P(records)));
+}
+
+/**
+ * Loads one relation of a set of records of the same model and stores the related
+ * records found in each one of them
+ */
+static void phalcon_mvc_model_manager_eager_relation(zval *loaded, zval *manager, zval *relation, zval *alias, zval *models, zval *dependency_injector)
+{
+	zval fields = {}, referenced_fields = {}, referenced_model = {}, type = {}, is_through = {}, keys = {}, links = {};
+	zval intermediate_model = {}, intermediate_fields = {}, intermediate_referenced_fields = {}, intermediate_resultset = {}, intermediates = {}, intermediate_rows = {};
+	zval resultset = {}, entity = {}, raw_rows = {}, grouped_rows = {}, grouped_records = {}, *model, *record;
+	zend_ulong idx;
+	int many;
+
+	array_init(loaded);
+
+	PHALCON_CALL_METHOD(&fields, relation, "getfields");
+	PHALCON_CALL_METHOD(&referenced_fields, relation, "getreferencedfields");
+	if (Z_TYPE(fields) == IS_ARRAY || Z_TYPE(referenced_fields) == IS_ARRAY) {
+		PHALCON_THROW_EXCEPTION_FORMAT(phalcon_mvc_model_exception_ce, "Relation \"%s\" can't be eager loaded because it's defined on compound fields", Z_STRVAL_P(alias));
+		return;
+	}
+
+	PHALCON_CALL_METHOD(&referenced_model, relation, "getreferencedmodel");
+	PHALCON_CALL_METHOD(&type, relation, "gettype");
+	PHALCON_CALL_METHOD(&is_through, relation, "isthrough");
+
+	/**
+	 * Distinct values of the relation field in the parent records
+	 */
+	array_init(&keys);
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(models), model) {
+		zval value = {};
+		PHALCON_CALL_METHOD(&value, model, "readattribute", &fields);
+		if (Z_TYPE(value) > IS_NULL) {
+			phalcon_array_update(&keys, &value, &value, PH_COPY);
+		}
+		zval_ptr_dtor(&value);
+	} ZEND_HASH_FOREACH_END();
+
+	/**
+	 * Relations through an intermediate model need an extra query to link both sides
+	 */
+	array_init(&links);
+	if (zend_is_true(&is_through)) {
+		zval targets = {};
+
+		PHALCON_CALL_METHOD(&intermediate_model, relation, "getintermediatemodel");
+		PHALCON_CALL_METHOD(&intermediate_fields, relation, "getintermediatefields");
+		PHALCON_CALL_METHOD(&intermediate_referenced_fields, relation, "getintermediatereferencedfields");
+		if (Z_TYPE(intermediate_fields) == IS_ARRAY || Z_TYPE(intermediate_referenced_fields) == IS_ARRAY) {
+			PHALCON_THROW_EXCEPTION_FORMAT(phalcon_mvc_model_exception_ce, "Relation \"%s\" can't be eager loaded because it's defined on compound fields", Z_STRVAL_P(alias));
+			return;
+		}
+
+		phalcon_mvc_model_manager_eager_find(&intermediate_resultset, &intermediates, &intermediate_rows, manager, &intermediate_model, &intermediate_fields, &keys, dependency_injector);
+		zval_ptr_dtor(&intermediate_rows);
+		if (EG(exception)) {
+			return;
+		}
+
+		array_init(&targets);
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(intermediates), record) {
+			zval parent_value = {}, target_value = {};
+
+			PHALCON_CALL_METHOD(&parent_value, record, "readattribute", &intermediate_fields);
+			PHALCON_CALL_METHOD(&target_value, record, "readattribute", &intermediate_referenced_fields);
+
+			if (Z_TYPE(target_value) > IS_NULL) {
+				phalcon_array_append_multi_2(&links, &parent_value, &target_value, PH_COPY);
+				phalcon_array_update(&targets, &target_value, &target_value, PH_COPY);
+			}
+			zval_ptr_dtor(&parent_value);
+			zval_ptr_dtor(&target_value);
+		} ZEND_HASH_FOREACH_END();
+
+		zval_ptr_dtor(&intermediates);
+		zval_ptr_dtor(&intermediate_resultset);
+		zval_ptr_dtor(&intermediate_model);
+		zval_ptr_dtor(&intermediate_fields);
+		zval_ptr_dtor(&intermediate_referenced_fields);
+		zval_ptr_dtor(&keys);
+		ZVAL_COPY_VALUE(&keys, &targets);
+	}
+
+	/**
+	 * One query for all the parent records, split when there are more keys than bind parameters
+	 */
+	phalcon_mvc_model_manager_eager_find(&resultset, loaded, &raw_rows, manager, &referenced_model, &referenced_fields, &keys, dependency_injector);
+	zval_ptr_dtor(&keys);
+	if (EG(exception)) {
+		zval_ptr_dtor(&raw_rows);
+		return;
+	}
+
+	/**
+	 * Group the related records by the value of the referenced field
+	 */
+	array_init(&grouped_rows);
+	array_init(&grouped_records);
+	ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL_P(loaded), idx, record) {
+		zval value = {}, row = {};
+
+		PHALCON_CALL_METHOD(&value, record, "readattribute", &referenced_fields);
+
+		if (!phalcon_array_isset_fetch_long(&row, &raw_rows, idx, PH_READONLY)) {
+			ZVAL_NULL(&row);
+		}
+
+		phalcon_array_append_multi_2(&grouped_records, &value, record, PH_COPY);
+		phalcon_array_append_multi_2(&grouped_rows, &value, &row, PH_COPY);
+		zval_ptr_dtor(&value);
+	} ZEND_HASH_FOREACH_END();
+
+	many = zend_is_true(&is_through) || PHALCON_IS_LONG(&type, 2);
+	if (many && Z_TYPE(resultset) != IS_OBJECT) {
+		PHALCON_CALL_METHOD(&entity, manager, "load", &referenced_model);
+	}
+
+	/**
+	 * Store the related records in every parent record
+	 */
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(models), model) {
+		zval value = {}, records = {}, rows = {}, related = {}, *target;
+
+		PHALCON_CALL_METHOD(&value, model, "readattribute", &fields);
+
+		array_init(&records);
+		array_init(&rows);
+		if (Z_TYPE(value) > IS_NULL) {
+			if (zend_is_true(&is_through)) {
+				zval targets = {};
+				if (phalcon_array_isset_fetch(&targets, &links, &value, PH_READONLY)) {
+					ZEND_HASH_FOREACH_VAL(Z_ARRVAL(targets), target) {
+						zval group = {}, *item;
+						if (phalcon_array_isset_fetch(&group, &grouped_records, target, PH_READONLY)) {
+							ZEND_HASH_FOREACH_VAL(Z_ARRVAL(group), item) {
+								phalcon_array_append(&records, item, PH_COPY);
+							} ZEND_HASH_FOREACH_END();
+						}
+						if (phalcon_array_isset_fetch(&group, &grouped_rows, target, PH_READONLY)) {
+							ZEND_HASH_FOREACH_VAL(Z_ARRVAL(group), item) {
+								phalcon_array_append(&rows, item, PH_COPY);
+							} ZEND_HASH_FOREACH_END();
+						}
+					} ZEND_HASH_FOREACH_END();
+				}
+			} else {
+				zval group = {};
+				if (phalcon_array_isset_fetch(&group, &grouped_records, &value, PH_READONLY)) {
+					zval_ptr_dtor(&records);
+					ZVAL_COPY(&records, &group);
+				}
+				if (phalcon_array_isset_fetch(&group, &grouped_rows, &value, PH_READONLY)) {
+					zval_ptr_dtor(&rows);
+					ZVAL_COPY(&rows, &group);
+				}
+			}
+		}
+		zval_ptr_dtor(&value);
+
+		if (many) {
+			phalcon_mvc_model_manager_eager_resultset(&related, &resultset, &entity, &rows, &records);
+		} else if (!phalcon_array_isset_fetch_long(&related, &records, 0, PH_COPY)) {
+			ZVAL_FALSE(&related);
+		}
+		zval_ptr_dtor(&records);
+		zval_ptr_dtor(&rows);
+
+		phalcon_update_property_array(model, SL("_relatedResult"), alias, &related);
+		zval_ptr_dtor(&related);
+		if (EG(exception)) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&entity);
+	zval_ptr_dtor(&resultset);
+	zval_ptr_dtor(&raw_rows);
+	zval_ptr_dtor(&grouped_records);
+	zval_ptr_dtor(&grouped_rows);
+	zval_ptr_dtor(&links);
+	zval_ptr_dtor(&referenced_model);
+}
+
+/**
+ * Loads relations of a set of records issuing one query per relation instead of one per record,
+ * nested relations are separated by dots. The related records are stored in every record so
+ * accessing the relation later doesn't hit the database. A relation is split in several queries
+ * when the records have more keys than the connection can bind, streaming resultsets are rejected
+ *
+ *<code>
+ * $robots = Robots::find();
+ * $manager->eagerLoad($robots, array('robotsParts', 'robotsParts.parts'));
+ *</code>
+ *
+ * @param Phalcon\Mvc\Model\ResultsetInterface|array $records
+ * @param string|array $relations
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, eagerLoad){
+
+	zval *records, *relations, models = {}, paths = {}, tree = {}, first = {}, model_name = {}, dependency_injector = {}, *record, *path, *nested;
+	zend_string *str_key;
+
+	phalcon_fetch_params(0, 2, 0, &records, &relations);
+
+	/**
+	 * Only full records can hold related records
+	 */
+	array_init(&models);
+	if (Z_TYPE_P(records) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(records), record) {
+			if (Z_TYPE_P(record) == IS_OBJECT && instanceof_function(Z_OBJCE_P(record), phalcon_mvc_model_ce)) {
+				phalcon_array_append(&models, record, PH_COPY);
+			}
+		} ZEND_HASH_FOREACH_END();
+	} else if (Z_TYPE_P(records) == IS_OBJECT) {
+		if (instanceof_function(Z_OBJCE_P(records), phalcon_mvc_model_ce)) {
+			phalcon_array_append(&models, records, PH_COPY);
+		} else if (instanceof_function_ex(Z_OBJCE_P(records), phalcon_mvc_model_resultsetinterface_ce, 1)) {
+			zval type = {};
+
+			/**
+			 * Streamed rows can't be traversed again, loading their relations would buffer them all
+			 */
+			if (instanceof_function(Z_OBJCE_P(records), phalcon_mvc_model_resultset_ce)) {
+				phalcon_read_property(&type, records, SL("_type"), PH_READONLY);
+				if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+					zval_ptr_dtor(&models);
+					PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Relations can't be eager loaded on streaming resultsets");
+					return;
+				}
+			}
+
+			/**
+			 * Buffer the rows, the records hydrated here are the ones returned by later traversals
+			 */
+			if (instanceof_function(Z_OBJCE_P(records), phalcon_mvc_model_resultset_simple_ce)) {
+				phalcon_update_property_long(records, SL("_type"), 0);
+			}
+
+			PHALCON_CALL_METHOD(NULL, records, "rewind");
+
+			while (1) {
+				zval valid = {}, current = {};
+
+				PHALCON_CALL_METHOD(&valid, records, "valid");
+				if (!zend_is_true(&valid)) {
+					break;
+				}
+
+				PHALCON_CALL_METHOD(&current, records, "current");
+				if (Z_TYPE(current) == IS_OBJECT && instanceof_function(Z_OBJCE(current), phalcon_mvc_model_ce)) {
+					phalcon_array_append(&models, &current, 0);
+				} else {
+					zval_ptr_dtor(&current);
+				}
+
+				PHALCON_CALL_METHOD(NULL, records, "next");
+			}
+
+			PHALCON_CALL_METHOD(NULL, records, "rewind");
+		}
+	}
+
+	if (!zend_hash_num_elements(Z_ARRVAL(models))) {
+		zval_ptr_dtor(&models);
+		return;
+	}
+
+	if (Z_TYPE_P(relations) == IS_ARRAY) {
+		ZVAL_COPY(&paths, relations);
+	} else {
+		array_init_size(&paths, 1);
+		phalcon_array_append(&paths, relations, PH_COPY);
+	}
+
+	/**
+	 * Group the paths by their first relation, the rest of the path is loaded from the related records
+	 */
+	array_init(&tree);
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(paths), path) {
+		zval name = {}, alias = {}, rest = {};
+		const char *dot;
+
+		if (Z_TYPE_P(path) != IS_STRING || !Z_STRLEN_P(path)) {
+			zval_ptr_dtor(&tree);
+			zval_ptr_dtor(&paths);
+			zval_ptr_dtor(&models);
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Relations to eager load must be strings");
+			return;
+		}
+
+		if ((dot = memchr(Z_STRVAL_P(path), '.', Z_STRLEN_P(path))) != NULL) {
+			ZVAL_STRINGL(&name, Z_STRVAL_P(path), dot - Z_STRVAL_P(path));
+			ZVAL_STRINGL(&rest, dot + 1, Z_STRLEN_P(path) - (dot - Z_STRVAL_P(path)) - 1);
+		} else {
+			ZVAL_COPY(&name, path);
+		}
+
+		phalcon_fast_strtolower(&alias, &name);
+		zval_ptr_dtor(&name);
+
+		if (!phalcon_array_isset(&tree, &alias)) {
+			phalcon_array_update(&tree, &alias, &PHALCON_GLOBAL(z_null), PH_COPY);
+		}
+
+		if (Z_TYPE(rest) == IS_STRING && Z_STRLEN(rest)) {
+			phalcon_array_append_multi_2(&tree, &alias, &rest, PH_COPY);
+		}
+		zval_ptr_dtor(&rest);
+		zval_ptr_dtor(&alias);
+	} ZEND_HASH_FOREACH_END();
+	zval_ptr_dtor(&paths);
+
+	phalcon_array_fetch_long(&first, &models, 0, PH_NOISY|PH_READONLY);
+	phalcon_get_class(&model_name, &first, 0);
+	PHALCON_CALL_METHOD(&dependency_injector, &first, "getdi");
+
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(tree), str_key, nested) {
+		zval alias = {}, relation = {}, loaded = {};
+
+		if (!str_key) {
+			continue;
+		}
+
+		ZVAL_STR(&alias, str_key);
+
+		PHALCON_CALL_METHOD(&relation, getThis(), "getrelationbyalias", &model_name, &alias);
+		if (Z_TYPE(relation) != IS_OBJECT) {
+			PHALCON_THROW_EXCEPTION_FORMAT(phalcon_mvc_model_exception_ce, "There is no defined relation \"%s\" for the model \"%s\"", ZSTR_VAL(str_key), Z_STRVAL(model_name));
+			break;
+		}
+
+		phalcon_mvc_model_manager_eager_relation(&loaded, getThis(), &relation, &alias, &models, &dependency_injector);
+		zval_ptr_dtor(&relation);
+
+		if (!EG(exception) && Z_TYPE_P(nested) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL(loaded))) {
+			PHALCON_CALL_METHOD(NULL, getThis(), "eagerload", &loaded, nested);
+		}
+		zval_ptr_dtor(&loaded);
+
+		if (EG(exception)) {
+			break;
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&dependency_injector);
+	zval_ptr_dtor(&model_name);
+	zval_ptr_dtor(&tree);
+	zval_ptr_dtor(&models);
+}
+
 /**
  * Returns a reusable object from the internal list
  *
@@ -2032,6 +2672,226 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, clearReusableObjects){
 
 }
 
+/**
+ * Builds the key of a record in the identity map from its class and the values of its primary key
+ */
+static int phalcon_mvc_model_manager_identity_key(zval *key, zval *model)
+{
+	zval entity_name = {}, primary_keys = {}, column_map = {}, values = {}, value = {}, id = {}, *field;
+	int flag;
+
+	/* Partial rows (Phalcon\Mvc\Model\Row) don't have a primary key */
+	if (Z_TYPE_P(model) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(model), phalcon_mvc_modelinterface_ce)) {
+		return FAILURE;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &primary_keys, model, "getprimarykeyattributes");
+	if (flag == FAILURE || Z_TYPE(primary_keys) != IS_ARRAY || !zend_hash_num_elements(Z_ARRVAL(primary_keys))) {
+		zval_ptr_dtor(&primary_keys);
+		return FAILURE;
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &column_map, model, "getcolumnmap");
+	if (flag == FAILURE) {
+		zval_ptr_dtor(&primary_keys);
+		return FAILURE;
+	}
+
+	array_init(&values);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(primary_keys), field) {
+		zval attribute = {};
+
+		if (Z_TYPE(column_map) != IS_ARRAY || !phalcon_array_isset_fetch(&attribute, &column_map, field, PH_READONLY)) {
+			ZVAL_COPY_VALUE(&attribute, field);
+		}
+
+		if (!phalcon_property_isset_fetch_zval(&value, model, &attribute, PH_READONLY) || Z_TYPE(value) == IS_NULL) {
+			flag = FAILURE;
+			break;
+		}
+
+		phalcon_array_append(&values, &value, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&primary_keys);
+	zval_ptr_dtor(&column_map);
+
+	if (flag == SUCCESS) {
+		/**
+		 * Compound keys are encoded so values with separators can't collide
+		 */
+		if (zend_hash_num_elements(Z_ARRVAL(values)) == 1) {
+			phalcon_array_fetch_long(&value, &values, 0, PH_NOISY|PH_READONLY);
+			ZVAL_COPY(&id, &value);
+		} else {
+			flag = phalcon_json_encode(&id, &values, 0);
+		}
+	}
+	zval_ptr_dtor(&values);
+
+	if (flag == SUCCESS) {
+		phalcon_get_class(&entity_name, model, 1);
+		PHALCON_CONCAT_VSV(key, &entity_name, "#", &id);
+		zval_ptr_dtor(&entity_name);
+	}
+	zval_ptr_dtor(&id);
+
+	return flag;
+}
+
+/**
+ * Enables the identity map. Records found by primary key and the records found through belongsTo
+ * relations are kept, the next lookups of the same primary key in the request return them
+ * without querying the database
+ *
+ *<code>
+ * $modelsManager->useIdentityMap(true);
+ *
+ * $robot = Robots::findFirst(1);
+ * var_dump($robot === Robots::findFirst(1)); // true
+ *</code>
+ *
+ * @param boolean $identityMap
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, useIdentityMap){
+
+	zval *identity_map;
+
+	phalcon_fetch_params(0, 1, 0, &identity_map);
+
+	phalcon_update_property_bool(getThis(), SL("_identityMapEnabled"), zend_is_true(identity_map));
+	if (!zend_is_true(identity_map)) {
+		phalcon_update_property_null(getThis(), SL("_identityMap"));
+	}
+}
+
+/**
+ * Checks if the identity map is enabled
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, isUsingIdentityMap){
+
+
+	RETURN_MEMBER(getThis(), "_identityMapEnabled");
+}
+
+/**
+ * Returns the record of a model with the primary key from the identity map
+ *
+ * @param string $modelName
+ * @param mixed $key
+ * @return Phalcon\Mvc\ModelInterface
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, getIdentity){
+
+	zval *model_name, *key, enabled = {}, entity_name = {}, map_key = {}, record = {};
+
+	phalcon_fetch_params(0, 2, 0, &model_name, &key);
+
+	phalcon_read_property(&enabled, getThis(), SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+	if (!zend_is_true(&enabled)) {
+		RETURN_NULL();
+	}
+
+	phalcon_fast_strtolower(&entity_name, model_name);
+	PHALCON_CONCAT_VSV(&map_key, &entity_name, "#", key);
+	zval_ptr_dtor(&entity_name);
+
+	if (!phalcon_read_property_array(&record, getThis(), SL("_identityMap"), &map_key, PH_READONLY)) {
+		zval_ptr_dtor(&map_key);
+		RETURN_NULL();
+	}
+
+#if PHP_VERSION_ID >= 70400
+	/**
+	 * The map only keeps weak references, the record could be already destroyed
+	 */
+	if (Z_TYPE(record) == IS_OBJECT && instanceof_function(Z_OBJCE(record), zend_ce_weakref)) {
+		PHALCON_CALL_METHOD(return_value, &record, "get");
+		if (Z_TYPE_P(return_value) != IS_OBJECT) {
+			phalcon_unset_property_array(getThis(), SL("_identityMap"), &map_key);
+		}
+		zval_ptr_dtor(&map_key);
+		return;
+	}
+#endif
+
+	zval_ptr_dtor(&map_key);
+	RETURN_CTOR(&record);
+}
+
+/**
+ * Stores a record in the identity map
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, addIdentity){
+
+	zval *model, enabled = {}, map_key = {}, record = {};
+
+	phalcon_fetch_params(0, 1, 0, &model);
+
+	phalcon_read_property(&enabled, getThis(), SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+	if (!zend_is_true(&enabled) || Z_TYPE_P(model) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(model), phalcon_mvc_modelinterface_ce)) {
+		RETURN_FALSE;
+	}
+
+	if (phalcon_mvc_model_manager_identity_key(&map_key, model) == FAILURE) {
+		RETURN_FALSE;
+	}
+
+#if PHP_VERSION_ID >= 70400
+	PHALCON_CALL_CE_STATIC(&record, zend_ce_weakref, "create", model);
+#else
+	ZVAL_COPY(&record, model);
+#endif
+
+	phalcon_update_property_array(getThis(), SL("_identityMap"), &map_key, &record);
+	zval_ptr_dtor(&record);
+	zval_ptr_dtor(&map_key);
+
+	RETURN_TRUE;
+}
+
+/**
+ * Removes a record from the identity map, it's called when the record is saved, deleted or refreshed
+ *
+ * @param Phalcon\Mvc\ModelInterface $model
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, removeIdentity){
+
+	zval *model, enabled = {}, map_key = {};
+
+	phalcon_fetch_params(0, 1, 0, &model);
+
+	phalcon_read_property(&enabled, getThis(), SL("_identityMapEnabled"), PH_NOISY|PH_READONLY);
+	if (!zend_is_true(&enabled) || Z_TYPE_P(model) != IS_OBJECT) {
+		RETURN_FALSE;
+	}
+
+	if (phalcon_mvc_model_manager_identity_key(&map_key, model) == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	phalcon_unset_property_array(getThis(), SL("_identityMap"), &map_key);
+	zval_ptr_dtor(&map_key);
+
+	RETURN_TRUE;
+}
+
+/**
+ * Clears the identity map, long running processes should call it when a request ends
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, clearIdentityMap){
+
+
+	phalcon_update_property_null(getThis(), SL("_identityMap"));
+}
+
 /**
  * Gets belongsTo related records from a model
  *
@@ -2599,6 +3459,524 @@ PHP_METHOD(Phalcon_Mvc_Model_Manager, getNamespaceAliases){
 	RETURN_MEMBER(getThis(), "_namespaceAliases");
 }
 
+/**
+ * Collects the metadata shared by every row saved in the same batch
+ */
+static void phalcon_mvc_model_manager_batch_group(zval *group, zval *model, zval *connection, zval *table, int upsert, int generated)
+{
+	zval attributes = {}, automatic_attributes = {}, column_map = {}, identity_field = {}, primary_keys = {}, bind_types = {}, data_types = {};
+	zval default_id = {}, fields = {}, properties = {}, field_types = {}, conflict_fields = {}, update_fields = {}, rows = {}, models = {};
+	zval identity_property = {}, exception_message = {}, *field;
+
+	PHALCON_CALL_METHOD(&attributes, model, "getattributes");
+	PHALCON_CALL_METHOD(&automatic_attributes, model, "getautomaticcreateattributes");
+	PHALCON_CALL_METHOD(&column_map, model, "getcolumnmap");
+	PHALCON_CALL_METHOD(&identity_field, model, "getidentityfield");
+	PHALCON_CALL_METHOD(&primary_keys, model, "getprimarykeyattributes");
+	PHALCON_CALL_METHOD(&bind_types, model, "getbindtypes");
+	PHALCON_CALL_METHOD(&data_types, model, "getdatatypes");
+	PHALCON_CALL_METHOD(&default_id, connection, "getdefaultidvalue");
+
+	array_init(&fields);
+	array_init(&properties);
+	array_init(&field_types);
+	array_init(&conflict_fields);
+	array_init(&update_fields);
+	array_init(&rows);
+	array_init(&models);
+	ZVAL_NULL(&identity_property);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(attributes), field) {
+		zval attribute = {}, field_type = {};
+
+		if (Z_TYPE(automatic_attributes) == IS_ARRAY && phalcon_array_isset(&automatic_attributes, field)) {
+			continue;
+		}
+
+		if (Z_TYPE(column_map) == IS_ARRAY) {
+			if (!phalcon_array_isset_fetch(&attribute, &column_map, field, PH_READONLY)) {
+				PHALCON_CONCAT_SVS(&exception_message, "Column '", field, "' isn't part of the column map");
+				PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, &exception_message);
+				break;
+			}
+		} else {
+			ZVAL_COPY_VALUE(&attribute, field);
+		}
+
+		if (!phalcon_array_isset_fetch(&field_type, &data_types, field, PH_READONLY)) {
+			ZVAL_NULL(&field_type);
+		}
+
+		phalcon_array_append(&fields, field, PH_COPY);
+		phalcon_array_append(&properties, &attribute, PH_COPY);
+		phalcon_array_append(&field_types, &field_type, PH_COPY);
+
+		if (Z_TYPE(identity_field) == IS_STRING && PHALCON_IS_EQUAL(field, &identity_field)) {
+			ZVAL_COPY(&identity_property, &attribute);
+		}
+
+		if (Z_TYPE(primary_keys) == IS_ARRAY && phalcon_fast_in_array(field, &primary_keys)) {
+			phalcon_array_append(&conflict_fields, field, PH_COPY);
+		} else {
+			phalcon_array_append(&update_fields, field, PH_COPY);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	array_init_size(group, 14);
+	phalcon_array_update_str(group, SL("connection"), connection, PH_COPY);
+	phalcon_array_update_str(group, SL("table"), table, PH_COPY);
+	phalcon_array_update_str(group, SL("fields"), &fields, 0);
+	phalcon_array_update_str(group, SL("properties"), &properties, 0);
+	phalcon_array_update_str(group, SL("fieldTypes"), &field_types, 0);
+	phalcon_array_update_str(group, SL("bindTypes"), &bind_types, 0);
+	phalcon_array_update_str(group, SL("conflictFields"), &conflict_fields, 0);
+	phalcon_array_update_str(group, SL("updateFields"), &update_fields, 0);
+	phalcon_array_update_str(group, SL("identityField"), &identity_field, 0);
+	phalcon_array_update_str(group, SL("defaultId"), &default_id, 0);
+	phalcon_array_update_str(group, SL("identityProperty"), &identity_property, 0);
+	phalcon_array_update_str_bool(group, SL("upsert"), upsert, 0);
+	phalcon_array_update_str_bool(group, SL("generated"), generated, 0);
+	phalcon_array_update_str(group, SL("rows"), &rows, 0);
+	phalcon_array_update_str(group, SL("models"), &models, 0);
+
+	zval_ptr_dtor(&attributes);
+	zval_ptr_dtor(&automatic_attributes);
+	zval_ptr_dtor(&column_map);
+	zval_ptr_dtor(&primary_keys);
+	zval_ptr_dtor(&data_types);
+}
+
+/**
+ * Reads the values of a model in the order of the fields of its batch
+ */
+static void phalcon_mvc_model_manager_batch_row(zval *row, zval *group, zval *model)
+{
+	zval fields = {}, properties = {}, field_types = {}, identity_field = {}, default_id = {}, connection = {}, *property;
+	ulong idx;
+
+	phalcon_array_fetch_str(&fields, group, SL("fields"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&properties, group, SL("properties"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&field_types, group, SL("fieldTypes"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&identity_field, group, SL("identityField"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&default_id, group, SL("defaultId"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&connection, group, SL("connection"), PH_NOISY|PH_READONLY);
+
+	array_init_size(row, zend_hash_num_elements(Z_ARRVAL(properties)));
+
+	ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(properties), idx, property) {
+		zval field = {}, field_type = {}, value = {}, convert_value = {};
+
+		phalcon_array_fetch_long(&field, &fields, idx, PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_long(&field_type, &field_types, idx, PH_NOISY|PH_READONLY);
+
+		if (!phalcon_property_isset_fetch_zval(&value, model, property, PH_READONLY)) {
+			ZVAL_NULL(&value);
+		}
+
+		/**
+		 * Identity columns without a value use "null" or "default" as in a normal insert
+		 */
+		if (Z_TYPE(identity_field) == IS_STRING && PHALCON_IS_EQUAL(&field, &identity_field) && PHALCON_IS_EMPTY(&value)) {
+			phalcon_array_append(row, &default_id, PH_COPY);
+			continue;
+		}
+
+		if (Z_TYPE(value) != IS_NULL && PHALCON_GLOBAL(orm).enable_auto_convert && Z_TYPE(field_type) == IS_LONG
+			&& (Z_TYPE(value) != IS_OBJECT || !instanceof_function(Z_OBJCE(value), phalcon_db_rawvalue_ce))) {
+			switch (Z_LVAL(field_type)) {
+				case PHALCON_DB_COLUMN_TYPE_JSON:
+					RETURN_ON_FAILURE(phalcon_json_encode(&convert_value, &value, 0));
+					phalcon_array_append(row, &convert_value, 0);
+					continue;
+				case PHALCON_DB_COLUMN_TYPE_BYTEA:
+					PHALCON_CALL_METHOD(&convert_value, &connection, "escapebytea", &value);
+					phalcon_array_append(row, &convert_value, 0);
+					continue;
+				case PHALCON_DB_COLUMN_TYPE_ARRAY:
+				case PHALCON_DB_COLUMN_TYPE_INT_ARRAY:
+					PHALCON_CALL_METHOD(&convert_value, &connection, "escapearray", &value, &field_type);
+					phalcon_array_append(row, &convert_value, 0);
+					continue;
+				default:
+					break;
+			}
+		}
+
+		phalcon_array_append(row, &value, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Inserts the rows of a batch whose identity is generated by the database and assigns the
+ * generated values back to their models. MySQL (with consecutive auto-increment locks) and
+ * SQLite number the rows of a multi-row INSERT consecutively, so the identities are derived
+ * from the last insert id of every statement, other databases insert the rows one by one
+ */
+static int phalcon_mvc_model_manager_batch_insert_generated(zval *group)
+{
+	zval connection = {}, table = {}, rows = {}, fields = {}, bind_types = {}, models = {}, identity_field = {}, identity_property = {};
+	zval type = {}, support_sequences = {}, sequence_name = {}, max_parameters = {}, chunk_rows = {}, chunk_models = {}, *row;
+	zend_long chunk_size = 1, step = 1, number_fields;
+	ulong idx;
+	int flag = SUCCESS, from_last = 0;
+
+	phalcon_array_fetch_str(&connection, group, SL("connection"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&table, group, SL("table"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&rows, group, SL("rows"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&fields, group, SL("fields"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&bind_types, group, SL("bindTypes"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&models, group, SL("models"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&identity_field, group, SL("identityField"), PH_NOISY|PH_READONLY);
+	phalcon_array_fetch_str(&identity_property, group, SL("identityProperty"), PH_NOISY|PH_READONLY);
+
+	PHALCON_CALL_METHOD_FLAG(flag, &type, &connection, "gettype");
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	if (PHALCON_IS_STRING(&type, "mysql")) {
+		zval sql = {}, fetch_num = {}, settings = {}, lock_mode = {}, increment = {};
+
+		ZVAL_STRING(&sql, "SELECT @@innodb_autoinc_lock_mode, @@auto_increment_increment");
+		ZVAL_LONG(&fetch_num, PDO_FETCH_NUM);
+		PHALCON_CALL_METHOD_FLAG(flag, &settings, &connection, "fetchone", &sql, &fetch_num);
+		zval_ptr_dtor(&sql);
+		if (flag == FAILURE) {
+			zval_ptr_dtor(&type);
+			return FAILURE;
+		}
+
+		/**
+		 * The interleaved lock mode doesn't guarantee consecutive values in a statement
+		 */
+		if (phalcon_array_isset_fetch_long(&lock_mode, &settings, 0, PH_READONLY) && phalcon_get_intval(&lock_mode) < 2) {
+			phalcon_read_property(&max_parameters, &connection, SL("_maxBindParameters"), PH_READONLY);
+			if (phalcon_array_isset_fetch_long(&increment, &settings, 1, PH_READONLY) && phalcon_get_intval(&increment) > 0) {
+				step = phalcon_get_intval(&increment);
+			}
+		}
+		zval_ptr_dtor(&settings);
+	} else if (PHALCON_IS_STRING(&type, "sqlite")) {
+		phalcon_read_property(&max_parameters, &connection, SL("_maxBindParameters"), PH_READONLY);
+		from_last = 1;
+	}
+	zval_ptr_dtor(&type);
+
+	/**
+	 * Chunks are sized as Db\Adapter::insertMultiple() does, so every chunk is a single statement
+	 */
+	number_fields = zend_hash_num_elements(Z_ARRVAL(fields));
+	if (Z_TYPE(max_parameters) > IS_NULL && number_fields) {
+		chunk_size = phalcon_get_intval(&max_parameters) / number_fields;
+		if (chunk_size < 1) {
+			chunk_size = 1;
+		}
+	}
+
+	PHALCON_CALL_METHOD_FLAG(flag, &support_sequences, &connection, "supportsequences");
+	if (flag == FAILURE) {
+		return FAILURE;
+	}
+
+	if (zend_is_true(&support_sequences)) {
+		zval model = {}, schema = {}, source = {};
+		phalcon_array_fetch_long(&model, &models, 0, PH_NOISY|PH_READONLY);
+		if (phalcon_method_exists_ex(&model, SL("getsequencename")) == SUCCESS) {
+			PHALCON_CALL_METHOD_FLAG(flag, &sequence_name, &model, "getsequencename");
+		} else if (Z_TYPE(table) == IS_ARRAY) {
+			phalcon_array_fetch_long(&schema, &table, 0, PH_NOISY|PH_READONLY);
+			phalcon_array_fetch_long(&source, &table, 1, PH_NOISY|PH_READONLY);
+			PHALCON_CONCAT_VSVSVS(&sequence_name, &schema, ".", &source, "_", &identity_field, "_seq");
+		} else {
+			PHALCON_CONCAT_VSVS(&sequence_name, &table, "_", &identity_field, "_seq");
+		}
+		if (flag == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	array_init(&chunk_rows);
+	array_init(&chunk_models);
+
+	ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(rows), idx, row) {
+		zval model = {}, status = {}, last_id = {}, *chunk_model;
+		zend_long first_id, position = 0, number_rows;
+
+		phalcon_array_fetch_long(&model, &models, idx, PH_NOISY|PH_READONLY);
+		phalcon_array_append(&chunk_rows, row, PH_COPY);
+		phalcon_array_append(&chunk_models, &model, PH_COPY);
+
+		number_rows = zend_hash_num_elements(Z_ARRVAL(chunk_rows));
+		if (number_rows < chunk_size && idx + 1 < zend_hash_num_elements(Z_ARRVAL(rows))) {
+			continue;
+		}
+
+		PHALCON_CALL_METHOD_FLAG(flag, &status, &connection, "insertmultiple", &table, &chunk_rows, &fields, &bind_types);
+		if (flag == FAILURE || !zend_is_true(&status)) {
+			flag = FAILURE;
+			break;
+		}
+
+		PHALCON_CALL_METHOD_FLAG(flag, &last_id, &connection, "lastinsertid", &sequence_name);
+		if (flag == FAILURE) {
+			break;
+		}
+
+		/**
+		 * MySQL returns the identity of the first row of the statement, SQLite the last one
+		 */
+		if (from_last) {
+			first_id = phalcon_get_intval(&last_id) - (number_rows - 1) * step;
+		} else {
+			first_id = phalcon_get_intval(&last_id);
+		}
+		zval_ptr_dtor(&last_id);
+
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(chunk_models), chunk_model) {
+			zval id = {};
+			ZVAL_LONG(&id, first_id + position * step);
+			phalcon_update_property_zval_zval(chunk_model, &identity_property, &id);
+			position++;
+		} ZEND_HASH_FOREACH_END();
+
+		zend_hash_clean(Z_ARRVAL(chunk_rows));
+		zend_hash_clean(Z_ARRVAL(chunk_models));
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&chunk_rows);
+	zval_ptr_dtor(&chunk_models);
+	zval_ptr_dtor(&support_sequences);
+	zval_ptr_dtor(&sequence_name);
+
+	return flag;
+}
+
+/**
+ * Saves several models with multi-row statements. New models are grouped by connection
+ * and source table and inserted with insertMultiple, persistent models with changes are
+ * written with upsertMultiple using their primary key. Every group runs in a transaction
+ * unless the connection already has one.
+ *
+ * Saved models become persistent and take a snapshot as after save(). Identities generated
+ * by the database are assigned back to the new models, on MySQL this requires consecutive
+ * auto-increment locks (innodb_autoinc_lock_mode 0 or 1), otherwise they are inserted one by one.
+ * Events, validations and related records are not processed
+ *
+ *<code>
+ * $robots = array();
+ * foreach ($data as $item) {
+ *     $robot = new Robots();
+ *     $robot->assign($item);
+ *     $robots[] = $robot;
+ * }
+ * $modelsManager->saveBatch($robots);
+ *</code>
+ *
+ * @param Phalcon\Mvc\ModelInterface[] $models
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Manager, saveBatch){
+
+	zval *models, groups = {}, *model, *group;
+	int success = 1;
+
+	phalcon_fetch_params(0, 1, 0, &models);
+
+	array_init(&groups);
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(models), model) {
+		zval dirty_state = {}, has_snapshot = {}, changed = {}, connection = {}, connection_id = {}, source = {}, schema = {}, table = {};
+		zval key = {}, new_group = {}, row = {}, identity_property = {}, identity_value = {}, *rows, *group_models;
+		int upsert;
+
+		if (Z_TYPE_P(model) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(model), phalcon_mvc_modelinterface_ce)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Only models can be saved in a batch");
+			zval_ptr_dtor(&groups);
+			return;
+		}
+
+		PHALCON_CALL_METHOD(&dirty_state, model, "getdirtystate");
+
+		switch (phalcon_get_intval(&dirty_state)) {
+			case PHALCON_MODEL_DIRTY_STATE_TRANSIENT:
+				upsert = 0;
+				break;
+
+			case PHALCON_MODEL_DIRTY_STATE_PERSISTEN:
+				/**
+				 * Persistent records are only written if something changed
+				 */
+				PHALCON_CALL_METHOD(&has_snapshot, model, "hassnapshotdata");
+				if (zend_is_true(&has_snapshot)) {
+					PHALCON_CALL_METHOD(&changed, model, "haschanged");
+					if (!zend_is_true(&changed)) {
+						continue;
+					}
+				}
+				upsert = 1;
+				break;
+
+			default:
+				continue;
+		}
+
+		PHALCON_CALL_METHOD(&connection, model, "getwriteconnection");
+		PHALCON_CALL_METHOD(&connection_id, &connection, "getconnectionid");
+		PHALCON_CALL_METHOD(&source, model, "getsource");
+		PHALCON_CALL_METHOD(&schema, model, "getschema");
+
+		if (PHALCON_IS_NOT_EMPTY(&schema)) {
+			array_init_size(&table, 2);
+			phalcon_array_append(&table, &schema, PH_COPY);
+			phalcon_array_append(&table, &source, PH_COPY);
+		} else {
+			ZVAL_COPY(&table, &source);
+		}
+
+		if (upsert) {
+			PHALCON_CONCAT_VSVSVS(&key, &connection_id, ":", &schema, ".", &source, ":upsert");
+		} else {
+			PHALCON_CONCAT_VSVSVS(&key, &connection_id, ":", &schema, ".", &source, ":insert");
+		}
+
+		if ((group = zend_hash_find(Z_ARRVAL(groups), Z_STR(key))) == NULL) {
+			phalcon_mvc_model_manager_batch_group(&new_group, model, &connection, &table, upsert, 0);
+			if (EG(exception)) {
+				zval_ptr_dtor(&new_group);
+				zval_ptr_dtor(&groups);
+				return;
+			}
+
+			group = zend_hash_update(Z_ARRVAL(groups), Z_STR(key), &new_group);
+		}
+
+		/**
+		 * New records without an identity get it from the database, they are inserted apart
+		 * so the generated values can be assigned back to them
+		 */
+		if (!upsert) {
+			phalcon_array_fetch_str(&identity_property, group, SL("identityProperty"), PH_NOISY|PH_READONLY);
+			if (Z_TYPE(identity_property) == IS_STRING) {
+				if (!phalcon_property_isset_fetch_zval(&identity_value, model, &identity_property, PH_READONLY)) {
+					ZVAL_NULL(&identity_value);
+				}
+				if (PHALCON_IS_EMPTY(&identity_value)) {
+					phalcon_concat_self_str(&key, SL(":generated"));
+					if ((group = zend_hash_find(Z_ARRVAL(groups), Z_STR(key))) == NULL) {
+						phalcon_mvc_model_manager_batch_group(&new_group, model, &connection, &table, upsert, 1);
+						if (EG(exception)) {
+							zval_ptr_dtor(&new_group);
+							zval_ptr_dtor(&groups);
+							return;
+						}
+
+						group = zend_hash_update(Z_ARRVAL(groups), Z_STR(key), &new_group);
+					}
+				}
+			}
+		}
+
+		zval_ptr_dtor(&key);
+		zval_ptr_dtor(&connection);
+		zval_ptr_dtor(&connection_id);
+		zval_ptr_dtor(&source);
+		zval_ptr_dtor(&schema);
+		zval_ptr_dtor(&table);
+
+		phalcon_mvc_model_manager_batch_row(&row, group, model);
+		if (EG(exception)) {
+			zval_ptr_dtor(&row);
+			zval_ptr_dtor(&groups);
+			return;
+		}
+
+		rows = zend_hash_str_find(Z_ARRVAL_P(group), SL("rows"));
+		phalcon_array_append(rows, &row, 0);
+
+		group_models = zend_hash_str_find(Z_ARRVAL_P(group), SL("models"));
+		phalcon_array_append(group_models, model, PH_COPY);
+	} ZEND_HASH_FOREACH_END();
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(groups), group) {
+		zval connection = {}, table = {}, rows = {}, fields = {}, bind_types = {}, update_fields = {}, conflict_fields = {}, upsert = {};
+		zval generated = {}, group_models = {}, under_transaction = {}, status = {}, *group_model;
+		zend_object *exception;
+		int flag, own_transaction;
+
+		phalcon_array_fetch_str(&connection, group, SL("connection"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&table, group, SL("table"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&rows, group, SL("rows"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&fields, group, SL("fields"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&bind_types, group, SL("bindTypes"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&update_fields, group, SL("updateFields"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&conflict_fields, group, SL("conflictFields"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&upsert, group, SL("upsert"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&generated, group, SL("generated"), PH_NOISY|PH_READONLY);
+		phalcon_array_fetch_str(&group_models, group, SL("models"), PH_NOISY|PH_READONLY);
+
+		PHALCON_CALL_METHOD(&under_transaction, &connection, "isundertransaction");
+		own_transaction = !zend_is_true(&under_transaction);
+		if (own_transaction) {
+			PHALCON_CALL_METHOD(NULL, &connection, "begin");
+		}
+
+		if (zend_is_true(&upsert)) {
+			PHALCON_CALL_METHOD_FLAG(flag, &status, &connection, "upsertmultiple", &table, &rows, &fields, &bind_types, &update_fields, &conflict_fields);
+		} else if (zend_is_true(&generated)) {
+			flag = phalcon_mvc_model_manager_batch_insert_generated(group);
+			ZVAL_BOOL(&status, flag == SUCCESS);
+		} else {
+			PHALCON_CALL_METHOD_FLAG(flag, &status, &connection, "insertmultiple", &table, &rows, &fields, &bind_types);
+		}
+
+		if (flag == SUCCESS && zend_is_true(&status)) {
+			if (own_transaction) {
+				PHALCON_CALL_METHOD(NULL, &connection, "commit");
+			}
+
+			/**
+			 * The saved records become persistent as after a normal save
+			 */
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(group_models), group_model) {
+				zval snapshot = {};
+
+				phalcon_update_property_long(group_model, SL("_dirtyState"), PHALCON_MODEL_DIRTY_STATE_PERSISTEN);
+				if (PHALCON_GLOBAL(orm).enable_snapshots) {
+					PHALCON_CALL_METHOD(&snapshot, group_model, "toarray");
+					PHALCON_CALL_METHOD(NULL, group_model, "setsnapshotdata", &snapshot);
+					zval_ptr_dtor(&snapshot);
+				}
+				phalcon_mvc_model_reset_dirty(group_model);
+			} ZEND_HASH_FOREACH_END();
+			continue;
+		}
+
+		success = 0;
+
+		if (own_transaction) {
+			/**
+			 * Keep the original exception while the transaction is rolled back
+			 */
+			exception = EG(exception);
+			EG(exception) = NULL;
+
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &connection, "rollback");
+			if (EG(exception)) {
+				zend_clear_exception();
+			}
+
+			EG(exception) = exception;
+		}
+		break;
+	} ZEND_HASH_FOREACH_END();
+
+	zval_ptr_dtor(&groups);
+
+	if (!EG(exception)) {
+		RETURN_BOOL(success);
+	}
+}
+
 /**
  * Destroys the PHQL cache
  */
@@ -0,0 +1,253 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2014 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "mvc/model/metadata/snapshot.h"
+#include "mvc/model/metadata.h"
+#include "mvc/model/metadatainterface.h"
+#include "mvc/model/exception.h"
+
+#include <Zend/zend_smart_str.h>
+#include <ext/standard/php_var.h>
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+#include "kernel/array.h"
+#include "kernel/object.h"
+#include "kernel/fcall.h"
+#include "kernel/file.h"
+#include "kernel/concat.h"
+#include "kernel/require.h"
+#include "kernel/operators.h"
+#include "kernel/exception.h"
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Snapshot
+ *
+ * Stores the meta-data of every model in a single compiled PHP file. The file is loaded
+ * once when the adapter is created, so readMetaData/getDataTypes/getColumnMap never hit the
+ * adapter again. With opcache enabled the snapshot is an immutable array in shared memory,
+ * every worker attaches to the same copy without unserializing it.
+ *
+ * Compile the snapshot at deploy time:
+ *
+ *<code>
+ * $metaData = new \Phalcon\Mvc\Model\Metadata\Snapshot(array(
+ *    'snapshotFile' => 'app/cache/metadata.php'
+ * ));
+ *
+ * $metaData->compile(array('Robots', 'RobotsParts', 'Parts'));
+ *</code>
+ */
+zend_class_entry *phalcon_mvc_model_metadata_snapshot_ce;
+
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, __construct);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, read);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, write);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, compile);
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, reset);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_snapshot___construct, 0, 0, 1)
+	ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_metadata_snapshot_compile, 0, 0, 0)
+	ZEND_ARG_TYPE_INFO(0, models, IS_ARRAY, 1)
+ZEND_END_ARG_INFO()
+
+static const zend_function_entry phalcon_mvc_model_metadata_snapshot_method_entry[] = {
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Snapshot, __construct, arginfo_phalcon_mvc_model_metadata_snapshot___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Snapshot, read, arginfo_phalcon_mvc_model_metadatainterface_read, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Snapshot, write, arginfo_phalcon_mvc_model_metadatainterface_write, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Snapshot, compile, arginfo_phalcon_mvc_model_metadata_snapshot_compile, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_MetaData_Snapshot, reset, arginfo_phalcon_mvc_model_metadatainterface_reset, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Snapshot initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Mvc_Model_MetaData_Snapshot){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Mvc\\Model\\MetaData, Snapshot, mvc_model_metadata_snapshot, phalcon_mvc_model_metadata_ce, phalcon_mvc_model_metadata_snapshot_method_entry, 0);
+
+	zend_declare_property_null(phalcon_mvc_model_metadata_snapshot_ce, SL("_snapshotFile"), ZEND_ACC_PROTECTED);
+
+	zend_class_implements(phalcon_mvc_model_metadata_snapshot_ce, 1, phalcon_mvc_model_metadatainterface_ce);
+
+	return SUCCESS;
+}
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Snapshot constructor
+ *
+ * @param array $options
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, __construct){
+
+	zval *options, snapshot_file = {}, snapshot = {}, meta_data = {}, column_map = {};
+
+	phalcon_fetch_params(0, 1, 0, &options);
+
+	if (Z_TYPE_P(options) != IS_ARRAY || !phalcon_array_isset_fetch_str(&snapshot_file, options, SL("snapshotFile"), PH_READONLY)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The option 'snapshotFile' is required");
+		return;
+	}
+	PHALCON_ENSURE_IS_STRING(&snapshot_file);
+
+	phalcon_update_property(getThis(), SL("_snapshotFile"), &snapshot_file);
+
+	/**
+	 * Attach to the compiled snapshot, both tables are used as they are
+	 */
+	if (phalcon_file_exists(&snapshot_file) == SUCCESS) {
+		RETURN_ON_FAILURE(phalcon_require_ret(&snapshot, Z_STRVAL(snapshot_file)));
+		if (Z_TYPE(snapshot) == IS_ARRAY
+			&& phalcon_array_isset_fetch_str(&meta_data, &snapshot, SL("meta"), PH_READONLY) && Z_TYPE(meta_data) == IS_ARRAY
+			&& phalcon_array_isset_fetch_str(&column_map, &snapshot, SL("map"), PH_READONLY) && Z_TYPE(column_map) == IS_ARRAY) {
+			phalcon_update_property(getThis(), SL("_metaData"), &meta_data);
+			phalcon_update_property(getThis(), SL("_columnMap"), &column_map);
+			zval_ptr_dtor(&snapshot);
+			return;
+		}
+		zval_ptr_dtor(&snapshot);
+	}
+
+	phalcon_update_property_empty_array(getThis(), SL("_metaData"));
+	phalcon_update_property_empty_array(getThis(), SL("_columnMap"));
+}
+
+/**
+ * Everything compiled is already loaded, models missing from the snapshot are introspected
+ *
+ * @param string $key
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, read){
+
+	zval *key;
+
+	phalcon_fetch_params(0, 1, 0, &key);
+
+	RETURN_NULL();
+}
+
+/**
+ * Meta-data is kept in memory until compile() writes the snapshot
+ *
+ * @param string $key
+ * @param array $data
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, write){
+
+	zval *key, *data;
+
+	phalcon_fetch_params(0, 2, 0, &key, &data);
+}
+
+/**
+ * Initializes the meta-data of the given models and writes the snapshot with every model known to the adapter
+ *
+ *<code>
+ *	$metaData->compile(array('Robots', 'Parts'));
+ *</code>
+ *
+ * @param array $models
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, compile){
+
+	zval *models = NULL, *model_name, snapshot_file = {}, meta_data = {}, column_map = {}, snapshot = {}, php_export = {}, pid = {}, tmp_file = {}, status = {};
+	smart_str exp = { 0 };
+
+	phalcon_fetch_params(0, 0, 1, &models);
+
+	if (models && Z_TYPE_P(models) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(models), model_name) {
+			zval model = {};
+			int flag;
+
+			if (phalcon_create_instance(&model, model_name) == FAILURE) {
+				return;
+			}
+
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, getThis(), "readmetadata", &model);
+			zval_ptr_dtor(&model);
+			if (flag == FAILURE) {
+				return;
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	phalcon_read_property(&snapshot_file, getThis(), SL("_snapshotFile"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&meta_data, getThis(), SL("_metaData"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&column_map, getThis(), SL("_columnMap"), PH_NOISY|PH_READONLY);
+
+	array_init_size(&snapshot, 2);
+	phalcon_array_update_str(&snapshot, SL("meta"), &meta_data, PH_COPY);
+	phalcon_array_update_str(&snapshot, SL("map"), &column_map, PH_COPY);
+
+	smart_str_appends(&exp, "<?php return ");
+	php_var_export_ex(&snapshot, 0, &exp);
+	smart_str_appendc(&exp, ';');
+	smart_str_0(&exp);
+	zval_ptr_dtor(&snapshot);
+
+	ZVAL_STR(&php_export, exp.s);
+
+	/**
+	 * Write to a private file and rename it, workers never see a half written snapshot
+	 */
+	PHALCON_CALL_FUNCTION(&pid, "getmypid");
+	PHALCON_CONCAT_VSV(&tmp_file, &snapshot_file, ".", &pid);
+
+	phalcon_file_put_contents(&status, &tmp_file, &php_export);
+	zval_ptr_dtor(&php_export);
+	if (PHALCON_IS_FALSE(&status)) {
+		zval_ptr_dtor(&tmp_file);
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Meta-Data snapshot cannot be written");
+		return;
+	}
+
+	PHALCON_CALL_FUNCTION(&status, "rename", &tmp_file, &snapshot_file);
+	zval_ptr_dtor(&tmp_file);
+	if (!zend_is_true(&status)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Meta-Data snapshot cannot be written");
+		return;
+	}
+
+	if (phalcon_function_exists_ex(SL("opcache_invalidate")) == SUCCESS) {
+		PHALCON_CALL_FUNCTION(NULL, "opcache_invalidate", &snapshot_file, &PHALCON_GLOBAL(z_true));
+	}
+
+	RETURN_TRUE;
+}
+
+/**
+ * Removes the snapshot and the meta-data held in memory
+ */
+PHP_METHOD(Phalcon_Mvc_Model_MetaData_Snapshot, reset){
+
+	zval snapshot_file = {}, dummy = {};
+
+	phalcon_read_property(&snapshot_file, getThis(), SL("_snapshotFile"), PH_NOISY|PH_READONLY);
+	if (phalcon_file_exists(&snapshot_file) == SUCCESS) {
+		phalcon_unlink(&dummy, &snapshot_file);
+	}
+
+	PHALCON_CALL_PARENT(NULL, phalcon_mvc_model_metadata_snapshot_ce, getThis(), "reset");
+}
@@ -37,6 +37,7 @@
 #include "diinterface.h"
 #include "di/injectable.h"
 #include "db/rawvalue.h"
+#include "db/dialect.h"
 #include "db/column.h"
 #include "debug.h"
 
@@ -136,6 +137,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, getModels);
 PHP_METHOD(Phalcon_Mvc_Model_Query, setConnection);
 PHP_METHOD(Phalcon_Mvc_Model_Query, getConnection);
 PHP_METHOD(Phalcon_Mvc_Model_Query, setConflict);
+PHP_METHOD(Phalcon_Mvc_Model_Query, setWith);
+PHP_METHOD(Phalcon_Mvc_Model_Query, getWith);
+PHP_METHOD(Phalcon_Mvc_Model_Query, setStreaming);
+PHP_METHOD(Phalcon_Mvc_Model_Query, getStreaming);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query___construct, 0, 0, 1)
 	ZEND_ARG_INFO(0, phql)
@@ -203,6 +208,14 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setconflict, 0, 0, 1)
 	ZEND_ARG_INFO(0, conflict)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setwith, 0, 0, 1)
+	ZEND_ARG_INFO(0, relations)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_setstreaming, 0, 0, 1)
+	ZEND_ARG_INFO(0, prefetch)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_mvc_model_query_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Query, __construct, arginfo_phalcon_mvc_model_query___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Mvc_Model_Query, setPhql, arginfo_phalcon_mvc_model_query_setphql, ZEND_ACC_PUBLIC)
@@ -260,6 +273,10 @@ static const zend_function_entry phalcon_mvc_model_query_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Query, setConnection, arginfo_phalcon_mvc_model_query_setconnection, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Query, getConnection, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Query, setConflict, arginfo_phalcon_mvc_model_query_setconflict, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query, setWith, arginfo_phalcon_mvc_model_query_setwith, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query, getWith, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query, setStreaming, arginfo_phalcon_mvc_model_query_setstreaming, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query, getStreaming, NULL, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -293,6 +310,10 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Query){
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_mergeBindParams"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_mergeBindTypes"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_index"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_with"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_model_query_ce, SL("_streaming"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_query_ce, SL("_planKey"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_model_query_ce, SL("_planSkip"), 0, ZEND_ACC_PROTECTED);
 
 	zend_declare_class_constant_long(phalcon_mvc_model_query_ce, SL("TYPE_SELECT"), PHQL_T_SELECT);
 	zend_declare_class_constant_long(phalcon_mvc_model_query_ce, SL("TYPE_INSERT"), PHQL_T_INSERT);
@@ -1448,6 +1469,30 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _getSelectColumn){
 	PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_query_exception_ce, &exception_message);
 }
 
+/**
+ * Models choosing their source or schema for every query can't share a query plan
+ */
+static void phalcon_mvc_model_query_plan_source(zval *query, zval *model)
+{
+	zend_class_entry *ce;
+	zend_function *method;
+
+	if (Z_TYPE_P(model) != IS_OBJECT) {
+		return;
+	}
+
+	ce = Z_OBJCE_P(model);
+	if (zend_hash_str_exists(&ce->function_table, SL("selectsource")) || zend_hash_str_exists(&ce->function_table, SL("selectschema"))) {
+		phalcon_update_property_bool(query, SL("_planSkip"), 1);
+		return;
+	}
+
+	if (((method = zend_hash_str_find_ptr(&ce->function_table, SL("getsource"))) != NULL && method->type == ZEND_USER_FUNCTION)
+		|| ((method = zend_hash_str_find_ptr(&ce->function_table, SL("getschema"))) != NULL && method->type == ZEND_USER_FUNCTION)) {
+		phalcon_update_property_bool(query, SL("_planSkip"), 1);
+	}
+}
+
 /**
  * Resolves a table in a SELECT statement checking if the model exists
  *
@@ -1463,6 +1508,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _getTable){
 
 	if (phalcon_array_isset_fetch_str(&model_name, qualified_name, SL("name"), PH_READONLY)) {
 		PHALCON_CALL_METHOD(&model, manager, "load", &model_name);
+		phalcon_mvc_model_query_plan_source(getThis(), &model);
 		PHALCON_CALL_METHOD(&source, &model, "getsource", getThis());
 		PHALCON_CALL_METHOD(&schema, &model, "getschema", getThis());
 		zval_ptr_dtor(&model);
@@ -1497,6 +1543,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _getJoin){
 			phalcon_array_fetch_string(&model_name, &qualified, IS(name), PH_NOISY|PH_READONLY);
 
 			PHALCON_CALL_METHOD(&model, manager, "load", &model_name);
+			phalcon_mvc_model_query_plan_source(getThis(), &model);
 			PHALCON_CALL_METHOD(&source, &model, "getsource", getThis());
 			PHALCON_CALL_METHOD(&schema, &model, "getschema", getThis());
 
@@ -1736,6 +1783,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _getMultiJoin){
 	 */
 	PHALCON_CALL_METHOD(&intermediate_model, &manager, "load", &intermediate_model_name);
 	zval_ptr_dtor(&manager);
+	phalcon_mvc_model_query_plan_source(getThis(), &intermediate_model);
 
 	/**
 	 * Source of the related model
@@ -2500,6 +2548,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _prepareSelect){
 		 * Load a model instance from the models manager
 		 */
 		PHALCON_CALL_METHOD(&model, &manager, "load", &real_model_name);
+		phalcon_mvc_model_query_plan_source(getThis(), &model);
 
 		/**
 		 * Define a complete schema/source
@@ -3225,6 +3274,64 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _prepareDelete){
 	zval_ptr_dtor(&event_name);
 }
 
+/**
+ * Appends to the key of a query plan the number of values bound to every array parameter,
+ * the generated placeholders depend on them. Raw values are copied into the SQL so plans
+ * are never built for them
+ */
+static int phalcon_mvc_model_query_plan_shape(zval *key, zval *bind_params)
+{
+	zval *value;
+	zend_string *str_key;
+	ulong idx;
+
+	if (Z_TYPE_P(bind_params) != IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(bind_params), idx, str_key, value) {
+		zval wildcard = {}, count = {};
+		if (Z_TYPE_P(value) == IS_OBJECT && instanceof_function(Z_OBJCE_P(value), phalcon_db_rawvalue_ce)) {
+			return FAILURE;
+		}
+
+		if (Z_TYPE_P(value) == IS_ARRAY) {
+			if (str_key) {
+				ZVAL_STR(&wildcard, str_key);
+			} else {
+				ZVAL_LONG(&wildcard, idx);
+			}
+
+			ZVAL_LONG(&count, zend_hash_num_elements(Z_ARRVAL_P(value)));
+			PHALCON_SCONCAT_SVSV(key, "|", &wildcard, ":", &count);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	return SUCCESS;
+}
+
+/**
+ * Appends to the key of a query plan the identity of the models manager or dialect the plan
+ * was resolved with, every instance is numbered once per process so numbers are never reused
+ */
+static int phalcon_mvc_model_query_plan_identity(zval *key, zval *object, zend_class_entry *ce)
+{
+	zval id = {};
+
+	if (Z_TYPE_P(object) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(object), ce)) {
+		return FAILURE;
+	}
+
+	phalcon_read_property(&id, object, SL("_planId"), PH_READONLY);
+	if (Z_TYPE(id) != IS_LONG) {
+		ZVAL_LONG(&id, ++PHALCON_GLOBAL(orm).plan_id);
+		phalcon_update_property(object, SL("_planId"), &id);
+	}
+
+	PHALCON_SCONCAT_SV(key, "|", &id);
+	return SUCCESS;
+}
+
 /**
  * Parses the intermediate code produced by Phalcon\Mvc\Model\Query\Lang generating another
  * intermediate representation that could be executed by Phalcon\Mvc\Model\Query
@@ -3234,7 +3341,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _prepareDelete){
 PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 
 	zval *_phql = NULL, event_name = {}, intermediate, phql = {}, ast = {}, type = {}, ir_phql = {};
-	zval exception_message = {}, debug_message = {};
+	zval exception_message = {}, debug_message = {}, class_name = {}, plan_key = {}, plan = {}, models = {};
+	zval bind_params = {}, bind_types = {}, plan_bind_types = {}, manager = {}, plan_skip = {}, *value;
+	zend_string *str_key;
+	ulong idx;
 
 	phalcon_fetch_params(0, 0, 1, &_phql);
 
@@ -3255,6 +3365,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 	zval_ptr_dtor(&event_name);
 
 	if (Z_TYPE(intermediate) == IS_ARRAY) {
+		phalcon_update_property_null(getThis(), SL("_planKey"));
 		RETURN_ZVAL(&intermediate, 0, 0);
 	}
 	zval_ptr_dtor(&intermediate);
@@ -3266,10 +3377,59 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 		}
 	}
 
+	/**
+	 * SELECT statements already prepared in this process are taken from the plan cache
+	 */
+	phalcon_update_property_bool(getThis(), SL("_planSkip"), 0);
+	if (Z_TYPE(phql) == IS_STRING && PHALCON_GLOBAL(orm).enable_plan_cache) {
+		/**
+		 * Sources, schemas and meta-data are resolved through the models manager of the query
+		 */
+		PHALCON_CALL_SELF(&manager, "getmodelsmanager");
+
+		ZVAL_STR(&class_name, Z_OBJCE_P(getThis())->name);
+		PHALCON_CONCAT_VSV(&plan_key, &class_name, ":", &phql);
+
+		phalcon_read_property(&bind_params, getThis(), SL("_bindParams"), PH_READONLY);
+		if (phalcon_mvc_model_query_plan_identity(&plan_key, &manager, phalcon_mvc_model_manager_ce) == SUCCESS
+			&& phalcon_mvc_model_query_plan_shape(&plan_key, &bind_params) == SUCCESS) {
+			phalcon_orm_get_plan(&plan, &plan_key);
+		} else {
+			zval_ptr_dtor(&plan_key);
+			ZVAL_NULL(&plan_key);
+		}
+		zval_ptr_dtor(&manager);
+	}
+
+	if (Z_TYPE(plan) == IS_ARRAY) {
+		phalcon_array_fetch_str(&ir_phql, &plan, SL("intermediate"), PH_NOISY|PH_COPY);
+		phalcon_array_fetch_str(&models, &plan, SL("models"), PH_NOISY|PH_READONLY);
+		phalcon_update_property_long(getThis(), SL("_type"), PHQL_T_SELECT);
+		phalcon_update_property(getThis(), SL("_models"), &models);
+
+		/**
+		 * Typed placeholders set their bind types while the statement is prepared
+		 */
+		phalcon_array_fetch_str(&plan_bind_types, &plan, SL("bindTypes"), PH_NOISY|PH_READONLY);
+		ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(plan_bind_types), idx, str_key, value) {
+			zval name = {};
+			if (str_key) {
+				ZVAL_STR(&name, str_key);
+			} else {
+				ZVAL_LONG(&name, idx);
+			}
+			phalcon_update_property_array(getThis(), SL("_bindTypes"), &name, value);
+		} ZEND_HASH_FOREACH_END();
+
+		zval_ptr_dtor(&plan);
+		goto after_parse;
+	}
+
 	/**
 	 * This function parses the PHQL statement
 	 */
 	if (phql_parse_phql(&ast, &phql) == FAILURE) {
+		zval_ptr_dtor(&plan_key);
 		return;
 	}
 
@@ -3278,6 +3438,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 	 */
 	if (Z_TYPE(ast) != IS_ARRAY || !phalcon_array_isset_fetch_string(&type, &ast, IS(type), PH_READONLY)) {
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "Corrupted AST");
+		zval_ptr_dtor(&plan_key);
 		zval_ptr_dtor(&ast);
 		return;
 	}
@@ -3286,6 +3447,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 	phalcon_update_property(getThis(), SL("_type"), &type);
 	zval_ptr_dtor(&ast);
 
+	phalcon_read_property(&bind_types, getThis(), SL("_bindTypes"), PH_COPY);
+
 	switch (phalcon_get_intval(&type)) {
 
 		case PHQL_T_SELECT:
@@ -3305,28 +3468,76 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, parse){
 			break;
 
 		default:
+			zval_ptr_dtor(&plan_key);
 			PHALCON_CONCAT_SVSV(&exception_message, "Unknown statement ", &type, ", when preparing: ", &phql);
 			PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_query_exception_ce, &exception_message);
 			return;
 	}
 
 	if (Z_TYPE(ir_phql) != IS_ARRAY) {
+		zval_ptr_dtor(&plan_key);
 		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "Corrupted AST");
 		return;
 	}
 
+	/**
+	 * Only SELECTs are kept, other statements are executed once per query object. Models
+	 * choosing their source for every query are resolved again next time
+	 */
+	phalcon_read_property(&plan_skip, getThis(), SL("_planSkip"), PH_READONLY);
+	if (phalcon_get_intval(&type) == PHQL_T_SELECT && !zend_is_true(&plan_skip)) {
+		if (Z_TYPE(plan_key) == IS_STRING) {
+			zval new_bind_types = {};
+			array_init_size(&plan, 3);
+			phalcon_array_update_str(&plan, SL("intermediate"), &ir_phql, PH_COPY);
+			phalcon_read_property(&models, getThis(), SL("_models"), PH_READONLY);
+			phalcon_array_update_str(&plan, SL("models"), &models, PH_COPY);
+
+			array_init(&plan_bind_types);
+			phalcon_read_property(&new_bind_types, getThis(), SL("_bindTypes"), PH_READONLY);
+			if (Z_TYPE(new_bind_types) == IS_ARRAY) {
+				ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(new_bind_types), idx, str_key, value) {
+					zval name = {}, old_value = {};
+					if (str_key) {
+						ZVAL_STR(&name, str_key);
+					} else {
+						ZVAL_LONG(&name, idx);
+					}
+					if (!phalcon_array_isset_fetch(&old_value, &bind_types, &name, PH_READONLY) || !PHALCON_IS_IDENTICAL(&old_value, value)) {
+						phalcon_array_update(&plan_bind_types, &name, value, PH_COPY);
+					}
+				} ZEND_HASH_FOREACH_END();
+			}
+			phalcon_array_update_str(&plan, SL("bindTypes"), &plan_bind_types, 0);
+
+			phalcon_orm_set_plan(&plan_key, &plan);
+			zval_ptr_dtor(&plan);
+		}
+	} else {
+		zval_ptr_dtor(&plan_key);
+		ZVAL_NULL(&plan_key);
+	}
+	zval_ptr_dtor(&bind_types);
+
+after_parse:
 	ZVAL_STRING(&event_name, "query:afterParse");
 	PHALCON_CALL_METHOD(return_value, getThis(), "fireevent", &event_name, &ir_phql);
 	zval_ptr_dtor(&event_name);
 
+	/**
+	 * The generated SQL can be reused as long as nobody replaced the intermediate representation
+	 */
 	if (Z_TYPE_P(return_value) == IS_ARRAY) {
 		zval_ptr_dtor(&ir_phql);
 		phalcon_update_property(getThis(), SL("_intermediate"), return_value);
+		phalcon_update_property_null(getThis(), SL("_planKey"));
 	} else {
 		zval_ptr_dtor(return_value);
 		phalcon_update_property(getThis(), SL("_intermediate"), &ir_phql);
+		phalcon_update_property(getThis(), SL("_planKey"), &plan_key);
 		RETVAL_ZVAL(&ir_phql, 0, 0);
 	}
+	zval_ptr_dtor(&plan_key);
 }
 
 /**
@@ -3412,11 +3623,11 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	zval event_name = {}, intermediate = {}, bind_params = {}, bind_types = {}, manager = {}, models = {}, number_models = {}, models_instances = {};
 	zval model_name = {}, model = {}, instance = {}, connection = {}, *model_name2, columns = {}, *column, select_columns = {};
 	zval simple_column_map = {}, dialect = {}, sql_select = {}, processed = {}, *value = NULL, processed_types = {}, tmp = {};
-	zval result = {}, count = {}, result_data = {}, dependency_injector = {}, cache = {};
-	zval service_name = {}, has = {}, service_params = {};
+	zval streaming = {}, result = {}, count = {}, result_data = {}, dependency_injector = {}, cache = {};
+	zval service_name = {}, has = {}, service_params = {}, index = {}, plan_key = {}, statement_key = {}, plan = {}, dialect_sql = {};
 	zend_string *str_key;
 	ulong idx;
-	int have_scalars = 0, have_objects = 0, is_complex = 0, is_simple_std = 0;
+	int have_scalars = 0, have_objects = 0, is_complex = 0, is_simple_std = 0, from_plan = 0, replace_placeholders = 1;
 	size_t number_objects = 0;
 
 	ZVAL_STRING(&event_name, "query:beforeExecuteSelect");
@@ -3476,7 +3687,90 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 		} ZEND_HASH_FOREACH_END();
 	}
 
-	phalcon_array_fetch_str(&columns, &intermediate, SL("columns"), PH_NOISY|PH_READONLY);
+	PHALCON_CALL_METHOD(&dialect, &connection, "getdialect");
+	PHALCON_CALL_METHOD(&index, getThis(), "getindex");
+
+	/**
+	 * Statements prepared from PHQL reuse the SQL generated by a previous execution
+	 */
+	phalcon_read_property(&plan_key, getThis(), SL("_planKey"), PH_READONLY);
+	if (Z_TYPE(plan_key) == IS_STRING && Z_TYPE(dialect) == IS_OBJECT && (Z_TYPE(index) == IS_NULL || Z_TYPE(index) == IS_STRING)) {
+		ZVAL_STR(&tmp, Z_OBJCE(dialect)->name);
+		PHALCON_CONCAT_SVSVSV(&statement_key, "sql:", &plan_key, "|", &tmp, "|", &index);
+		ZVAL_NULL(&tmp);
+
+		/**
+		 * The dialect of every connection is numbered, custom functions are registered per dialect
+		 */
+		if (phalcon_mvc_model_query_plan_identity(&statement_key, &dialect, phalcon_db_dialect_ce) == SUCCESS
+			&& phalcon_mvc_model_query_plan_shape(&statement_key, &bind_params) == SUCCESS) {
+			phalcon_orm_get_plan(&plan, &statement_key);
+		} else {
+			zval_ptr_dtor(&statement_key);
+			ZVAL_NULL(&statement_key);
+		}
+	}
+
+	if (Z_TYPE(plan) == IS_ARRAY) {
+		zval plan_columns = {};
+		from_plan = 1;
+
+		phalcon_array_fetch_str(&tmp, &plan, SL("complex"), PH_NOISY|PH_READONLY);
+		is_complex = zend_is_true(&tmp);
+		phalcon_array_fetch_str(&tmp, &plan, SL("simpleStd"), PH_NOISY|PH_READONLY);
+		is_simple_std = zend_is_true(&tmp);
+		ZVAL_NULL(&tmp);
+
+		phalcon_array_fetch_str(&simple_column_map, &plan, SL("columnMap"), PH_NOISY|PH_COPY);
+		phalcon_array_fetch_str(&dialect_sql, &plan, SL("dialectSql"), PH_NOISY|PH_COPY);
+		phalcon_array_fetch_str(&sql_select, &plan, SL("sql"), PH_NOISY|PH_COPY);
+
+		/**
+		 * Cached columns don't keep the model instances
+		 */
+		phalcon_array_fetch_str(&plan_columns, &plan, SL("columns"), PH_NOISY|PH_READONLY);
+		array_init_size(&columns, zend_hash_num_elements(Z_ARRVAL(plan_columns)));
+
+		ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(plan_columns), idx, str_key, column) {
+			zval key = {}, type = {}, model_name = {}, model2 = {}, column_copy = {};
+			if (str_key) {
+				ZVAL_STR(&key, str_key);
+			} else {
+				ZVAL_LONG(&key, idx);
+			}
+
+			phalcon_array_fetch_string(&type, column, IS(type), PH_NOISY|PH_READONLY);
+			if (PHALCON_IS_STRING(&type, "object")) {
+				phalcon_array_fetch_str(&model_name, column, SL("model"), PH_NOISY|PH_READONLY);
+				if (!phalcon_array_isset_fetch(&model2, &models_instances, &model_name, PH_READONLY)) {
+					PHALCON_CALL_METHOD(&model2, &manager, "load", &model_name);
+					phalcon_array_update(&models_instances, &model_name, &model2, 0);
+				}
+
+				if (Z_TYPE(instance) != IS_OBJECT) {
+					ZVAL_COPY(&instance, &model2);
+				}
+
+				if (is_complex) {
+					PHALCON_ZVAL_DUP(&column_copy, column);
+					phalcon_array_update_str(&column_copy, SL("instance"), &model2, PH_COPY);
+					phalcon_array_update(&columns, &key, &column_copy, 0);
+					continue;
+				}
+			}
+
+			phalcon_array_update(&columns, &key, column, PH_COPY);
+		} ZEND_HASH_FOREACH_END();
+
+		zval_ptr_dtor(&plan);
+		goto generate_sql;
+	}
+
+	/**
+	 * The columns get the meta-data of the models, the intermediate may be shared with the plan cache
+	 */
+	phalcon_array_fetch_str(&columns, &intermediate, SL("columns"), PH_NOISY|PH_COPY);
+	PHALCON_SEPARATE(&columns);
 
 	/**
 	 * Check if the resultset have objects and how many of them have
@@ -3621,17 +3915,17 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 			}
 		}
 	} ZEND_HASH_FOREACH_END();
-	zval_ptr_dtor(&manager);
 
 	phalcon_array_update_str(&intermediate, SL("columns"), &select_columns, PH_COPY);
 	zval_ptr_dtor(&select_columns);
 
-	PHALCON_CALL_METHOD(&tmp, getThis(), "getindex");
-	if (Z_TYPE(tmp) > IS_NULL) {
-		phalcon_array_update_str(&intermediate, SL("index"), &tmp, PH_COPY);
-		zval_ptr_dtor(&tmp);
+	if (Z_TYPE(index) > IS_NULL) {
+		phalcon_array_update_str(&intermediate, SL("index"), &index, PH_COPY);
 	}
 
+generate_sql:
+	zval_ptr_dtor(&manager);
+
 	ZVAL_STRING(&event_name, "query:beforeGenerateSQLStatement");
 	PHALCON_CALL_METHOD(NULL, getThis(), "fireevent", &event_name);
 	zval_ptr_dtor(&event_name);
@@ -3640,18 +3934,29 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	 * The corresponding SQL dialect generates the SQL statement based accordingly with
 	 * the database system
 	 */
-	PHALCON_CALL_METHOD(&dialect, &connection, "getdialect");
-	PHALCON_CALL_METHOD(&sql_select, &dialect, "select", &intermediate);
+	if (!from_plan) {
+		PHALCON_CALL_METHOD(&dialect_sql, &dialect, "select", &intermediate);
+	}
 	zval_ptr_dtor(&dialect);
 	zval_ptr_dtor(&intermediate);
+	zval_ptr_dtor(&index);
 
 	ZVAL_STRING(&event_name, "query:afterGenerateSQLStatement");
-	PHALCON_CALL_METHOD(&tmp, getThis(), "fireevent", &event_name, &sql_select);
+	PHALCON_CALL_METHOD(&tmp, getThis(), "fireevent", &event_name, &dialect_sql);
 	zval_ptr_dtor(&event_name);
 
+	/**
+	 * A statement changed by a listener has to be processed again and is not cached
+	 */
 	if (Z_TYPE(tmp) == IS_STRING) {
 		zval_ptr_dtor(&sql_select);
 		ZVAL_COPY(&sql_select, &tmp);
+		zval_ptr_dtor(&statement_key);
+		ZVAL_NULL(&statement_key);
+	} else if (!from_plan) {
+		ZVAL_COPY(&sql_select, &dialect_sql);
+	} else {
+		replace_placeholders = 0;
 	}
 	zval_ptr_dtor(&tmp);
 
@@ -3693,10 +3998,12 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 					phalcon_increment(&hidden_param);
 				} ZEND_HASH_FOREACH_END();
 
-				phalcon_fast_join_str(&joined_keys, SL(", "), &bind_keys);
+				if (replace_placeholders) {
+					phalcon_fast_join_str(&joined_keys, SL(", "), &bind_keys);
+					phalcon_query_sql_replace(&sql_select, &wildcard, &joined_keys);
+					zval_ptr_dtor(&joined_keys);
+				}
 				zval_ptr_dtor(&bind_keys);
-				phalcon_query_sql_replace(&sql_select, &wildcard, &joined_keys);
-				zval_ptr_dtor(&joined_keys);
 				phalcon_array_unset(&bind_types, &wildcard, 0);
 			} else if (Z_TYPE(wildcard) == IS_LONG) {
 				zval string_wildcard = {};
@@ -3713,6 +4020,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	}
 	zval_ptr_dtor(&bind_params);
 
+	/**
+	 * Keep the generated SQL for the next execution of the same statement
+	 */
+	if (!from_plan && Z_TYPE(statement_key) == IS_STRING) {
+		zval plan_columns = {};
+		array_init_size(&plan, 6);
+		phalcon_array_update_str_bool(&plan, SL("complex"), is_complex, 0);
+		phalcon_array_update_str_bool(&plan, SL("simpleStd"), is_simple_std, 0);
+		phalcon_array_update_str(&plan, SL("columnMap"), &simple_column_map, PH_COPY);
+		phalcon_array_update_str(&plan, SL("dialectSql"), &dialect_sql, PH_COPY);
+		phalcon_array_update_str(&plan, SL("sql"), &sql_select, PH_COPY);
+
+		array_init_size(&plan_columns, zend_hash_num_elements(Z_ARRVAL(columns)));
+		ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL(columns), idx, str_key, column) {
+			zval key = {}, column_copy = {};
+			if (str_key) {
+				ZVAL_STR(&key, str_key);
+			} else {
+				ZVAL_LONG(&key, idx);
+			}
+
+			if (phalcon_array_isset_str(column, SL("instance"))) {
+				PHALCON_ZVAL_DUP(&column_copy, column);
+				phalcon_array_unset_str(&column_copy, SL("instance"), 0);
+				phalcon_array_update(&plan_columns, &key, &column_copy, 0);
+			} else {
+				phalcon_array_update(&plan_columns, &key, column, PH_COPY);
+			}
+		} ZEND_HASH_FOREACH_END();
+		phalcon_array_update_str(&plan, SL("columns"), &plan_columns, 0);
+
+		phalcon_orm_set_plan(&statement_key, &plan);
+		zval_ptr_dtor(&plan);
+	}
+	zval_ptr_dtor(&statement_key);
+	zval_ptr_dtor(&dialect_sql);
+
 	/**
 	 * Replace the bind Types
 	 */
@@ -3743,7 +4087,25 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	/**
 	 * Execute the query
 	 */
-	PHALCON_CALL_METHOD(&result, &connection, "query", &sql_select, &processed, &processed_types);
+	phalcon_read_property(&streaming, getThis(), SL("_streaming"), PH_READONLY);
+	if (zend_is_true(&streaming)) {
+		if (phalcon_method_exists_ex(&connection, SL("stream")) != SUCCESS) {
+			zval_ptr_dtor(&connection);
+			zval_ptr_dtor(&processed_types);
+			zval_ptr_dtor(&processed);
+			zval_ptr_dtor(&sql_select);
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "The connection doesn't support streaming resultsets");
+			return;
+		}
+
+		if (Z_TYPE(streaming) == IS_LONG) {
+			PHALCON_CALL_METHOD(&result, &connection, "stream", &sql_select, &processed, &processed_types, &streaming);
+		} else {
+			PHALCON_CALL_METHOD(&result, &connection, "stream", &sql_select, &processed, &processed_types);
+		}
+	} else {
+		PHALCON_CALL_METHOD(&result, &connection, "query", &sql_select, &processed, &processed_types);
+	}
 
 	zval_ptr_dtor(&connection);
 	zval_ptr_dtor(&processed_types);
@@ -3751,16 +4113,24 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	zval_ptr_dtor(&sql_select);
 
 	/**
-	 * Check if the query has data
+	 * Check if the query has data, streamed rows are not counted in advance
 	 */
-	PHALCON_CALL_METHOD(&count, &result, "numrows");
-	if (zend_is_true(&count)) {
-		ZVAL_COPY(&result_data, &result);
+	if (zend_is_true(&streaming)) {
+		if (Z_TYPE(result) == IS_OBJECT) {
+			ZVAL_COPY(&result_data, &result);
+		} else {
+			ZVAL_BOOL(&result_data, 0);
+		}
 	} else {
-		ZVAL_BOOL(&result_data, 0);
+		PHALCON_CALL_METHOD(&count, &result, "numrows");
+		if (zend_is_true(&count)) {
+			ZVAL_COPY(&result_data, &result);
+		} else {
+			ZVAL_BOOL(&result_data, 0);
+		}
+		zval_ptr_dtor(&count);
 	}
 	zval_ptr_dtor(&result);
-	zval_ptr_dtor(&count);
 
 	PHALCON_CALL_METHOD(&dependency_injector, getThis(), "getdi");
 
@@ -3849,6 +4219,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeSelect){
 	zval_ptr_dtor(&models_instances);
 	zval_ptr_dtor(&model);
 	zval_ptr_dtor(&instance);
+	zval_ptr_dtor(&columns);
 
 	ZVAL_STRING(&event_name, "query:afterExecuteSelect");
 	PHALCON_CALL_METHOD(NULL, getThis(), "fireevent", &event_name);
@@ -4356,6 +4727,23 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeDelete){
 	zval_ptr_dtor(&event_name);
 }
 
+/**
+ * Eager loads the relations requested for the records returned by a SELECT
+ */
+static void phalcon_mvc_model_query_eager_load(zval *object, zval *result)
+{
+	zval with = {}, models_manager = {};
+
+	phalcon_read_property(&with, object, SL("_with"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE_P(result) != IS_OBJECT || !PHALCON_IS_NOT_EMPTY(&with)) {
+		return;
+	}
+
+	PHALCON_CALL_METHOD(&models_manager, object, "getmodelsmanager");
+	PHALCON_CALL_METHOD(NULL, &models_manager, "eagerload", result, &with);
+	zval_ptr_dtor(&models_manager);
+}
+
 /**
  * Executes a parsed PHQL statement
  *
@@ -4365,7 +4753,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, _executeDelete){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 
-	zval *bind_params = NULL, *bind_types = NULL, event_name = {}, unique_row = {}, type = {}, debug_message = {};
+	zval *bind_params = NULL, *bind_types = NULL, event_name = {}, unique_row = {}, type = {}, streaming = {}, with = {}, debug_message = {};
 	zval cache_options = {}, cache_key = {}, lifetime = {}, cache_service = {}, cache = {}, frontend = {}, result = {}, is_fresh = {};
 	zval default_bind_params = {}, merged_params = {}, default_bind_types = {}, merged_types = {}, exception_message = {}, *value;
 	zend_string *str_key;
@@ -4405,6 +4793,23 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 	phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
 	ZVAL_NULL(&cache);
 	if (phalcon_get_intval(&type) == PHQL_T_SELECT) {
+		phalcon_read_property(&streaming, getThis(), SL("_streaming"), PH_NOISY|PH_READONLY);
+		if (zend_is_true(&streaming)) {
+			/**
+			 * Caching or eager loading would keep every streamed row in memory
+			 */
+			if (cache_options_is_not_null) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "Streaming resultsets can't be cached");
+				return;
+			}
+
+			phalcon_read_property(&with, getThis(), SL("_with"), PH_NOISY|PH_READONLY);
+			if (PHALCON_IS_NOT_EMPTY(&with)) {
+				PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "Relations can't be eager loaded on streaming resultsets");
+				return;
+			}
+		}
+
 		if (cache_options_is_not_null) {
 			zval dependency_injector = {};
 			if (Z_TYPE(cache_options) != IS_ARRAY) {
@@ -4468,6 +4873,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 				ZVAL_BOOL(&is_fresh, 0);
 				PHALCON_CALL_METHOD(NULL, &result, "setisfresh", &is_fresh);
 
+				phalcon_mvc_model_query_eager_load(getThis(), &result);
+				if (EG(exception)) {
+					zval_ptr_dtor(&result);
+					zval_ptr_dtor(&cache);
+					return;
+				}
+
 				/**
 				 * Check if only the first row must be returned
 				 */
@@ -4594,6 +5006,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, execute){
 				PHALCON_CALL_METHOD(NULL, &cache, "save", &cache_key, &result, &lifetime);
 			}
 		}
+
+		/**
+		 * Load the requested relations with one query per relation
+		 */
+		phalcon_mvc_model_query_eager_load(getThis(), &result);
+		if (EG(exception)) {
+			zval_ptr_dtor(&result);
+			zval_ptr_dtor(&cache);
+			return;
+		}
 	}
 	zval_ptr_dtor(&cache);
 
@@ -4888,6 +5310,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, setIntermediate){
 	phalcon_fetch_params(0, 1, 0, &intermediate);
 
 	phalcon_update_property(getThis(), SL("_intermediate"), intermediate);
+	phalcon_update_property_null(getThis(), SL("_planKey"));
 	RETURN_THIS();
 }
 
@@ -5091,3 +5514,75 @@ PHP_METHOD(Phalcon_Mvc_Model_Query, setConflict){
 	phalcon_update_property(getThis(), SL("_conflict"), conflict);
 	RETURN_THIS();
 }
+
+/**
+ * Sets the relations to eager load for the records returned by the query
+ *
+ * @param string|array $relations
+ * @return Phalcon\Mvc\Model\Query
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, setWith){
+
+	zval *relations;
+
+	phalcon_fetch_params(0, 1, 0, &relations);
+
+	phalcon_update_property(getThis(), SL("_with"), relations);
+	RETURN_THIS();
+}
+
+/**
+ * Returns the relations to eager load
+ *
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getWith){
+
+
+	RETURN_MEMBER(getThis(), "_with");
+}
+
+/**
+ * Streams the rows of a SELECT from the database instead of buffering them, the resultset
+ * can be traversed only once and it's counted only after being traversed.
+ * Pass the number of rows to prefetch on every round trip or true to use the connection's default
+ *
+ *<code>
+ * $robots = $this->modelsManager->createQuery('SELECT * FROM Robots')->setStreaming(500)->execute();
+ * foreach ($robots as $robot) {
+ *     echo $robot->name, PHP_EOL;
+ * }
+ *</code>
+ *
+ * @param boolean|int $prefetch
+ * @return Phalcon\Mvc\Model\Query
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, setStreaming){
+
+	zval *prefetch;
+
+	phalcon_fetch_params(0, 1, 0, &prefetch);
+
+	if (Z_TYPE_P(prefetch) == IS_LONG) {
+		if (Z_LVAL_P(prefetch) <= 0) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_query_exception_ce, "The number of rows to prefetch must be greater than zero");
+			return;
+		}
+		phalcon_update_property(getThis(), SL("_streaming"), prefetch);
+	} else {
+		phalcon_update_property_bool(getThis(), SL("_streaming"), zend_is_true(prefetch));
+	}
+
+	RETURN_THIS();
+}
+
+/**
+ * Returns the streaming option
+ *
+ * @return boolean|int
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query, getStreaming){
+
+
+	RETURN_MEMBER(getThis(), "_streaming");
+}
@@ -553,7 +553,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder, getPhql){
 PHP_METHOD(Phalcon_Mvc_Model_Query_Builder, getQuery){
 
 	zval phql = {}, bind_params = {}, bind_types = {}, index = {}, dependency_injector = {}, service_name = {};
-	zval cache = {}, has = {}, args = {};
+	zval cache = {}, with = {}, has = {}, args = {};
 
 	/**
 	 * Process the PHQL
@@ -587,6 +587,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder, getQuery){
 		PHALCON_CALL_METHOD(NULL, return_value, "cache", &cache);
 	}
 
+	if (phalcon_property_isset_fetch(&with, getThis(), SL("_with"), PH_READONLY) && PHALCON_IS_NOT_EMPTY(&with)) {
+		PHALCON_CALL_METHOD(NULL, return_value, "setwith", &with);
+	}
+
 	/**
 	 * Set default bind params
 	 */
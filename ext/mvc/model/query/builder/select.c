@@ -79,6 +79,8 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, offset);
 PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, getOffset);
 PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, groupBy);
 PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, getGroupBy);
+PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, with);
+PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, getWith);
 PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, _compile);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_builder_select___construct, 0, 0, 0)
@@ -125,6 +127,10 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_builder_select_groupby, 0
 	ZEND_ARG_INFO(0, group)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_query_builder_select_with, 0, 0, 1)
+	ZEND_ARG_INFO(0, relations)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_mvc_model_query_builder_select_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, __construct, arginfo_phalcon_mvc_model_query_builder_select___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, distinct, arginfo_phalcon_mvc_model_query_builder_select_distinct, ZEND_ACC_PUBLIC)
@@ -144,6 +150,8 @@ static const zend_function_entry phalcon_mvc_model_query_builder_select_method_e
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, getOffset, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, groupBy, arginfo_phalcon_mvc_model_query_builder_select_groupby, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, getGroupBy, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, with, arginfo_phalcon_mvc_model_query_builder_select_with, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, getWith, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Query_Builder_Select, _compile, NULL, ZEND_ACC_PROTECTED)
 	PHP_FE_END
 };
@@ -167,6 +175,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Query_Builder_Select){
 	zend_declare_property_null(phalcon_mvc_model_query_builder_select_ce, SL("_sharedLock"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_query_builder_select_ce, SL("_distinct"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_query_builder_select_ce, SL("_cache"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_query_builder_select_ce, SL("_with"), ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_mvc_model_query_builder_select_ce, 1, phalcon_mvc_model_query_builderinterface_ce);
 
@@ -194,6 +203,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Query_Builder_Select){
  *    'limit'      => 20,
  *    'offset'     => 20,
  *    // or 'limit' => array(20, 20),
+ *    'with'       => array('robotsParts', 'robotsParts.parts'),
  * );
  * $queryBuilder = new Phalcon\Mvc\Model\Query\Builder\Select($params);
  *</code>
@@ -217,6 +227,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, __construct){
 	if (params && Z_TYPE_P(params) == IS_ARRAY) {
 		zval cache = {}, conditions = {}, bind_params = {}, bind_types = {}, models = {}, index = {}, columns = {}, group_clause = {}, joins = {};
 		zval having_clause = {}, order_clause = {}, limit_clause = {}, offset_clause = {}, limit = {}, offset = {}, for_update = {}, shared_lock = {};
+		zval with = {};
 
 		if (phalcon_array_isset_fetch_str(&cache, params, SL("cache"), PH_READONLY)) {
 			phalcon_update_property(getThis(), SL("_cache"), &cache);
@@ -325,6 +336,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, __construct){
 		} else if (phalcon_array_isset_fetch_str(&shared_lock, params, SL("sharedLock"), PH_READONLY)) {
 			phalcon_update_property(getThis(), SL("_sharedLock"), &shared_lock);
 		}
+
+		/**
+		 * Assign the relations to eager load
+		 */
+		if (phalcon_array_isset_fetch_str(&with, params, SL("with"), PH_READONLY)) {
+			phalcon_update_property(getThis(), SL("_with"), &with);
+		}
 	}
 }
 
@@ -636,6 +654,38 @@ PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, getGroupBy){
 	RETURN_MEMBER(getThis(), "_group");
 }
 
+/**
+ * Sets the relations to eager load once the query is executed, nested relations
+ * are separated by dots
+ *
+ *<code>
+ *	$builder->with(array('robotsParts', 'robotsParts.parts'));
+ *</code>
+ *
+ * @param string|array $relations
+ * @return Phalcon\Mvc\Model\Query\Builder\Select
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, with){
+
+	zval *relations;
+
+	phalcon_fetch_params(0, 1, 0, &relations);
+
+	phalcon_update_property(getThis(), SL("_with"), relations);
+	RETURN_THIS();
+}
+
+/**
+ * Returns the relations to eager load
+ *
+ * @return string|array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Query_Builder_Select, getWith){
+
+
+	RETURN_MEMBER(getThis(), "_with");
+}
+
 /**
  * Returns a PHQL statement built based on the builder parameters
  *
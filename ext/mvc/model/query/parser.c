@@ -3493,6 +3493,14 @@ int phql_internal_parse_phql(zval *result, char *phql, unsigned int phql_length,
 		return SUCCESS;
 	}
 
+	/**
+	 * Try the cache shared between processes before running the parser
+	 */
+	if (phalcon_orm_get_shared_ast(result, &unique_id, phql, phql_length) == SUCCESS) {
+		phalcon_orm_set_prepared_ast(&unique_id, result);
+		return SUCCESS;
+	}
+
 	phql_parser = phql_Alloc(phql_wrapper_alloc);
 	if (unlikely(!phql_parser)) {
 		ZVAL_STRING(error_msg, "Memory allocation error");
@@ -3873,6 +3881,7 @@ int phql_internal_parse_phql(zval *result, char *phql, unsigned int phql_length,
 				 * Store the parsed definition in the cache
 				 */
 				phalcon_orm_set_prepared_ast(&unique_id, result);
+				phalcon_orm_set_shared_ast(&unique_id, phql, phql_length, result);
 
 			} else {
 				array_init(result);
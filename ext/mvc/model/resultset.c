@@ -153,9 +153,11 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset){
 
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_FULL"),    PHALCON_MVC_MODEL_RESULTSET_TYPE_FULL);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_PARTIAL"), PHALCON_MVC_MODEL_RESULTSET_TYPE_PARTIAL);
+	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("TYPE_RESULT_STREAM"),  PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_RECORDS"), 0);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_OBJECTS"), 2);
 	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_ARRAYS"), 1);
+	zend_declare_class_constant_long(phalcon_mvc_model_resultset_ce, SL("HYDRATE_COLUMNAR"), PHALCON_MVC_MODEL_RESULTSET_HYDRATE_COLUMNAR);
 
 	zend_class_implements(phalcon_mvc_model_resultset_ce, 6, phalcon_mvc_model_resultsetinterface_ce, zend_ce_iterator, spl_ce_SeekableIterator, spl_ce_Countable, zend_ce_arrayaccess, zend_ce_serializable);
 
@@ -196,7 +198,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, rewind){
 	zval type = {}, result = {}, active_row = {}, rows = {}, r = {};
 
 	phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
-	if (zend_is_true(&type)) {
+	if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+		/**
+		 * Streamed rows are gone once they are fetched, only the first traversal is possible
+		 */
+		phalcon_read_property(&active_row, getThis(), SL("_activeRow"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(active_row) != IS_NULL) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets can only be traversed once");
+			return;
+		}
+	} else if (zend_is_true(&type)) {
 
 		/**
 		 * Here, the resultset act as a result that is fetched one by one
@@ -255,7 +266,10 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, seek){
 	if (PHALCON_IS_TRUE(&is_different)) {
 
 		phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
-		if (zend_is_true(&type)) {
+		if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets can't be seeked");
+			return;
+		} else if (zend_is_true(&type)) {
 			/**
 			 * Here, the resultset is fetched one by one because is large
 			 */
@@ -320,7 +334,13 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, count){
 		ZVAL_LONG(&count, 0);
 
 		phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
-		if (zend_is_true(&type)) {
+		if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+			/**
+			 * The number of streamed rows is only known after the traversal, count them with a separate query instead
+			 */
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The number of rows of a streaming resultset is only known once it has been traversed, use the model's count() to compute it separately");
+			return;
+		} else if (zend_is_true(&type)) {
 			/**
 			 * Here, the resultset act as a result that is fetched one by one
 			 */
@@ -535,17 +555,25 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset, isFresh){
 }
 
 /**
- * Sets the hydration mode in the resultset
+ * Sets the hydration mode in the resultset, streaming resultsets can't use the columnar hydration
  *
  * @param int $hydrateMode
  * @return Phalcon\Mvc\Model\Resultset
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset, setHydrateMode){
 
-	zval *hydrate_mode;
+	zval *hydrate_mode, type = {};
 
 	phalcon_fetch_params(0, 1, 0, &hydrate_mode);
 
+	if (PHALCON_IS_LONG(hydrate_mode, PHALCON_MVC_MODEL_RESULTSET_HYDRATE_COLUMNAR)) {
+		phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
+		if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+			PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets can't be read by columns");
+			return;
+		}
+	}
+
 	phalcon_update_property(getThis(), SL("_hydrateMode"), hydrate_mode);
 	RETURN_THIS();
 }
@@ -23,6 +23,7 @@
 #include "mvc/model/row.h"
 #include "mvc/model/exception.h"
 #include "mvc/model.h"
+#include "db/result/pdo.h"
 
 #include <ext/pdo/php_pdo_driver.h>
 
@@ -95,7 +96,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset_Complex){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, __construct){
 
-	zval *columns_types, *result, *cache = NULL, *source_model = NULL, fetch_assoc = {};
+	zval *columns_types, *result, *cache = NULL, *source_model = NULL, fetch_assoc = {}, streaming = {};
 
 	phalcon_fetch_params(0, 2, 2, &columns_types, &result, &cache, &source_model);
 
@@ -138,6 +139,16 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, __construct){
 	if (Z_TYPE_P(result) == IS_OBJECT) {
 		ZVAL_LONG(&fetch_assoc, PDO_FETCH_ASSOC);
 		PHALCON_CALL_METHOD(NULL, result, "setfetchmode", &fetch_assoc);
+
+		/**
+		 * Streamed results can't be rewound nor counted before they are traversed
+		 */
+		if (instanceof_function(Z_OBJCE_P(result), phalcon_db_result_pdo_ce)) {
+			PHALCON_CALL_METHOD(&streaming, result, "isstreaming");
+			if (zend_is_true(&streaming)) {
+				phalcon_update_property_long(getThis(), SL("_type"), PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM);
+			}
+		}
 	}
 }
 
@@ -158,7 +169,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, valid){
 	phalcon_read_property(&source_model, getThis(), SL("_sourceModel"), PH_NOISY|PH_READONLY);
 	phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
 	i_type = (Z_TYPE(type) == IS_LONG) ? Z_LVAL(type) : phalcon_get_intval(&type);
-	is_partial = (i_type == PHALCON_MVC_MODEL_RESULTSET_TYPE_PARTIAL);
+	is_partial = (i_type == PHALCON_MVC_MODEL_RESULTSET_TYPE_PARTIAL || i_type == PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM);
 
 	if (Z_TYPE(source_model) == IS_OBJECT) {
 		ce = Z_OBJCE(source_model);
@@ -384,6 +395,15 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Complex, valid){
 	}
 	zval_ptr_dtor(&row);
 
+	/**
+	 * Once a stream is exhausted the number of rows is known
+	 */
+	if (i_type == PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM) {
+		zval pointer = {};
+		phalcon_read_property(&pointer, getThis(), SL("_pointer"), PH_NOISY|PH_READONLY);
+		phalcon_update_property(getThis(), SL("_count"), &pointer);
+	}
+
 	/**
 	 * There are no results to retrieve so we update this_ptr->activeRow as false
 	 */
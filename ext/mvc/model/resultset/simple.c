@@ -20,7 +20,10 @@
 #include "mvc/model/resultset.h"
 #include "mvc/model/resultsetinterface.h"
 #include "mvc/model/exception.h"
+#include "mvc/model/row/columnar.h"
 #include "mvc/model.h"
+#include "db/column.h"
+#include "db/result/pdo.h"
 
 #include <ext/pdo/php_pdo_driver.h>
 
@@ -50,6 +53,7 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, toArray);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, serialize);
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, unserialize);
+PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, column);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_resultset_simple___construct, 0, 0, 3)
 	ZEND_ARG_INFO(0, columnMap)
@@ -64,12 +68,17 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_resultset_simple_toarray, 0, 0,
 	ZEND_ARG_INFO(0, renameColumns)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_resultset_simple_column, 0, 0, 1)
+	ZEND_ARG_INFO(0, name)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_mvc_model_resultset_simple_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, __construct, arginfo_phalcon_mvc_model_resultset_simple___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, valid, arginfo_iterator_valid, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, toArray, arginfo_phalcon_mvc_model_resultset_simple_toarray, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, serialize, arginfo_serializable_serialize, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, unserialize, arginfo_serializable_unserialize, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Resultset_Simple, column, arginfo_phalcon_mvc_model_resultset_simple_column, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -85,7 +94,263 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset_Simple){
 	zend_declare_property_null(phalcon_mvc_model_resultset_simple_ce, SL("_columnMap"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_resultset_simple_ce, SL("_rowsModels"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_model_resultset_simple_ce, SL("_rowsObjects"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_resultset_simple_ce, SL("_columns"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_resultset_simple_ce, SL("_columnTypes"), ZEND_ACC_PROTECTED);
+
+	return SUCCESS;
+}
+
+/**
+ * Packs a raw value according to the type of its column, integers and floats are
+ * stored unboxed so the vectors don't keep a string per cell
+ */
+static void phalcon_mvc_model_resultset_simple_pack(zval *packed, zval *value, zval *field_type)
+{
+	zend_long lval;
+	double dval;
+	zend_uchar type;
+
+	if (Z_TYPE_P(value) == IS_STRING && field_type && Z_TYPE_P(field_type) == IS_LONG) {
+		switch (Z_LVAL_P(field_type)) {
+			case PHALCON_DB_COLUMN_TYPE_INTEGER:
+			case PHALCON_DB_COLUMN_TYPE_BIGINTEGER:
+				if (is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &lval, &dval, 0) == IS_LONG) {
+					ZVAL_LONG(packed, lval);
+					return;
+				}
+				break;
+
+			case PHALCON_DB_COLUMN_TYPE_FLOAT:
+			case PHALCON_DB_COLUMN_TYPE_DOUBLE:
+				type = is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &lval, &dval, 0);
+				if (type == IS_DOUBLE) {
+					ZVAL_DOUBLE(packed, dval);
+					return;
+				}
+				if (type == IS_LONG) {
+					ZVAL_DOUBLE(packed, (double)lval);
+					return;
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	ZVAL_COPY(packed, value);
+}
+
+/**
+ * Appends the fields of a row to the packed vector of every attribute
+ */
+static int phalcon_mvc_model_resultset_simple_columnize_row(zval *columns, zval *column_types, zval *row, zval *column_map, zval *data_types, uint32_t size)
+{
+	zval exception_message = {}, *value;
+	zend_string *str_key;
+
+	if (Z_TYPE_P(row) != IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(row), str_key, value) {
+		zval key = {}, attribute = {}, vector = {}, packed = {}, *field_type = NULL, *column;
+
+		if (!str_key) {
+			continue;
+		}
+
+		ZVAL_STR(&key, str_key);
+
+		if (Z_TYPE_P(column_map) == IS_ARRAY) {
+			/**
+			 * Every field must be part of the column map
+			 */
+			if (!phalcon_array_isset_fetch(&attribute, column_map, &key, PH_READONLY) || Z_TYPE(attribute) != IS_STRING) {
+				PHALCON_CONCAT_SVS(&exception_message, "Column \"", &key, "\" doesn't make part of the column map");
+				PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, &exception_message);
+				zval_ptr_dtor(&exception_message);
+				return FAILURE;
+			}
+		} else {
+			ZVAL_COPY_VALUE(&attribute, &key);
+		}
+
+		if (Z_TYPE_P(data_types) == IS_ARRAY) {
+			field_type = zend_symtable_find(Z_ARRVAL_P(data_types), str_key);
+		}
+
+		column = zend_symtable_find(Z_ARRVAL_P(columns), Z_STR(attribute));
+		if (!column) {
+			array_init_size(&vector, size);
+			column = zend_symtable_update(Z_ARRVAL_P(columns), Z_STR(attribute), &vector);
+
+			/**
+			 * Remember the columns that must be converted when they are read
+			 */
+			if (field_type && Z_TYPE_P(field_type) == IS_LONG) {
+				switch (Z_LVAL_P(field_type)) {
+					case PHALCON_DB_COLUMN_TYPE_JSON:
+					case PHALCON_DB_COLUMN_TYPE_BYTEA:
+					case PHALCON_DB_COLUMN_TYPE_ARRAY:
+					case PHALCON_DB_COLUMN_TYPE_INT_ARRAY:
+						phalcon_array_update(column_types, &attribute, field_type, PH_COPY);
+						break;
+					default:
+						break;
+				}
+			}
+		}
+
+		phalcon_mvc_model_resultset_simple_pack(&packed, value, field_type);
+		zend_hash_next_index_insert(Z_ARRVAL_P(column), &packed);
+	} ZEND_HASH_FOREACH_END();
+
+	return SUCCESS;
+}
+
+/**
+ * Turns the fetched rows into one packed vector per attribute, the vectors are built once
+ * and shared by every row returned in the columnar hydration. In the columnar hydration the
+ * rows are packed while they are fetched, so they are never held next to the vectors
+ */
+static int phalcon_mvc_model_resultset_simple_columnize(zval *object, zval *columns)
+{
+	zval rows = {}, result = {}, column_map = {}, source_model = {}, data_types = {}, column_types = {}, hydrate_mode = {};
+	zval pointer = {}, active_row = {}, type = {}, *row;
+	uint32_t num_rows = 0;
+	zend_long skip;
+	int flag = SUCCESS, columnar;
+
+	phalcon_read_property(columns, object, SL("_columns"), PH_READONLY);
+	if (Z_TYPE_P(columns) == IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	/**
+	 * The vectors are built from the first row, streamed rows can't be read again
+	 */
+	phalcon_read_property(&type, object, SL("_type"), PH_NOISY|PH_READONLY);
+	if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "Streaming resultsets can't be read by columns");
+		return FAILURE;
+	}
+
+	phalcon_read_property(&hydrate_mode, object, SL("_hydrateMode"), PH_NOISY|PH_READONLY);
+	columnar = PHALCON_IS_LONG(&hydrate_mode, PHALCON_MVC_MODEL_RESULTSET_HYDRATE_COLUMNAR);
+
+	phalcon_read_property(&column_map, object, SL("_columnMap"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&source_model, object, SL("_sourceModel"), PH_NOISY|PH_READONLY);
+
+	if (Z_TYPE(source_model) == IS_OBJECT) {
+		PHALCON_CALL_METHOD_FLAG(flag, &data_types, &source_model, "getdatatypes");
+		if (flag == FAILURE) {
+			return FAILURE;
+		}
+	}
+
+	array_init(columns);
+	array_init(&column_types);
+
+	phalcon_read_property(&rows, object, SL("_rows"), PH_COPY);
+	if (Z_TYPE(rows) != IS_ARRAY) {
+		zval_ptr_dtor(&rows);
+		ZVAL_NULL(&rows);
+
+		phalcon_read_property(&result, object, SL("_result"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(result) == IS_OBJECT) {
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &result, "dataseek", &PHALCON_GLOBAL(z_zero));
+
+			if (flag == SUCCESS && columnar) {
+				/**
+				 * Every row is packed as soon as it's fetched and released right after
+				 */
+				while (1) {
+					zval fetched = {};
+
+					PHALCON_CALL_METHOD_FLAG(flag, &fetched, &result, "fetch");
+					if (flag == FAILURE || Z_TYPE(fetched) != IS_ARRAY) {
+						zval_ptr_dtor(&fetched);
+						break;
+					}
+
+					flag = phalcon_mvc_model_resultset_simple_columnize_row(columns, &column_types, &fetched, &column_map, &data_types, 0);
+					zval_ptr_dtor(&fetched);
+					if (flag == FAILURE) {
+						break;
+					}
+
+					num_rows++;
+				}
+			} else if (flag == SUCCESS) {
+				PHALCON_CALL_METHOD_FLAG(flag, &rows, &result, "fetchall");
+			}
+		}
+
+		if (Z_TYPE(rows) != IS_ARRAY) {
+			zval_ptr_dtor(&rows);
+			array_init(&rows);
+		}
+	}
+
+	if (flag == SUCCESS && zend_hash_num_elements(Z_ARRVAL(rows))) {
+		num_rows = zend_hash_num_elements(Z_ARRVAL(rows));
+
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(rows), row) {
+			if ((flag = phalcon_mvc_model_resultset_simple_columnize_row(columns, &column_types, row, &column_map, &data_types, num_rows)) == FAILURE) {
+				break;
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	zval_ptr_dtor(&data_types);
+
+	if (flag == FAILURE) {
+		zval_ptr_dtor(columns);
+		zval_ptr_dtor(&column_types);
+		zval_ptr_dtor(&rows);
+		ZVAL_NULL(columns);
+		return FAILURE;
+	}
+
+	phalcon_update_property(object, SL("_columns"), columns);
+	zval_ptr_dtor(columns);
+
+	if (zend_hash_num_elements(Z_ARRVAL(column_types))) {
+		phalcon_update_property(object, SL("_columnTypes"), &column_types);
+	}
+	zval_ptr_dtor(&column_types);
+
+	if (columnar) {
+		/**
+		 * The vectors replace the rows, the base resultset keeps working on an empty array
+		 */
+		phalcon_update_property_empty_array(object, SL("_rows"));
+	} else {
+		/**
+		 * Other hydrations keep iterating the fetched rows from where the cursor was
+		 */
+		phalcon_read_property(&pointer, object, SL("_pointer"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&active_row, object, SL("_activeRow"), PH_NOISY|PH_READONLY);
+
+		zend_hash_internal_pointer_reset(Z_ARRVAL(rows));
+		skip = phalcon_get_intval(&pointer);
+		if (Z_TYPE(active_row) == IS_OBJECT || Z_TYPE(active_row) == IS_ARRAY) {
+			skip++;
+		}
+
+		while (skip-- > 0) {
+			zend_hash_move_forward(Z_ARRVAL(rows));
+		}
 
+		phalcon_update_property(object, SL("_rows"), &rows);
+	}
+	zval_ptr_dtor(&rows);
+
+	phalcon_update_property_long(object, SL("_type"), 0);
+	phalcon_update_property_long(object, SL("_count"), num_rows);
+
+	phalcon_read_property(columns, object, SL("_columns"), PH_READONLY);
 	return SUCCESS;
 }
 
@@ -99,7 +364,7 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Resultset_Simple){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 
-	zval *column_map, *model, *result, *cache = NULL, *source_model = NULL, fetch_assoc = {}, limit = {}, row_count = {}, big_resultset = {};
+	zval *column_map, *model, *result, *cache = NULL, *source_model = NULL, fetch_assoc = {}, streaming = {}, limit = {}, row_count = {}, big_resultset = {};
 
 	phalcon_fetch_params(0, 3, 3, &column_map, &model, &result, &cache, &source_model);
 
@@ -127,6 +392,19 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 	ZVAL_LONG(&fetch_assoc, PDO_FETCH_ASSOC);
 	PHALCON_CALL_METHOD(NULL, result, "setfetchmode", &fetch_assoc);
 
+	/**
+	 * Streamed results are traversed one by one without counting them first
+	 */
+	if (instanceof_function(Z_OBJCE_P(result), phalcon_db_result_pdo_ce)) {
+		PHALCON_CALL_METHOD(&streaming, result, "isstreaming");
+		if (zend_is_true(&streaming)) {
+			phalcon_update_property_long(getThis(), SL("_type"), PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM);
+			phalcon_update_property_empty_array(getThis(), SL("_models"));
+			phalcon_update_property_empty_array(getThis(), SL("_others"));
+			return;
+		}
+	}
+
 	ZVAL_LONG(&limit, 32);
 
 	PHALCON_CALL_METHOD(&row_count, result, "numrows");
@@ -158,9 +436,43 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, __construct){
 PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 
 	zval type = {}, result = {}, row = {}, rows = {}, dirty_state = {}, hydrate_mode = {}, column_map = {}, key = {};
-	zval source_model = {}, model = {}, active_row = {}, rows_objects = {};
+	zval source_model = {}, model = {}, active_row = {}, rows_objects = {}, columns = {}, column_types = {}, pointer = {}, count = {};
+	zend_long index;
 	zend_class_entry *ce;
 
+	/**
+	 * Get current hydration mode
+	 */
+	phalcon_read_property(&hydrate_mode, getThis(), SL("_hydrateMode"), PH_NOISY|PH_READONLY);
+
+	if (PHALCON_IS_LONG(&hydrate_mode, PHALCON_MVC_MODEL_RESULTSET_HYDRATE_COLUMNAR)) {
+		if (phalcon_mvc_model_resultset_simple_columnize(getThis(), &columns) == FAILURE) {
+			return;
+		}
+
+		phalcon_read_property(&pointer, getThis(), SL("_pointer"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&count, getThis(), SL("_count"), PH_NOISY|PH_READONLY);
+
+		index = phalcon_get_intval(&pointer);
+		if (index < 0 || index >= phalcon_get_intval(&count)) {
+			phalcon_update_property_bool(getThis(), SL("_activeRow"), 0);
+			RETURN_FALSE;
+		}
+
+		phalcon_read_property(&column_types, getThis(), SL("_columnTypes"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&source_model, getThis(), SL("_sourceModel"), PH_NOISY|PH_READONLY);
+
+		/**
+		 * Rows only hold a reference to the shared vectors and their position
+		 */
+		object_init_ex(&active_row, phalcon_mvc_model_row_columnar_ce);
+		PHALCON_CALL_METHOD(NULL, &active_row, "__construct", &columns, &pointer, &column_types, &source_model);
+
+		phalcon_update_property(getThis(), SL("_activeRow"), &active_row);
+		zval_ptr_dtor(&active_row);
+		RETURN_TRUE;
+	}
+
 	phalcon_read_property(&type, getThis(), SL("_type"), PH_NOISY|PH_READONLY);
 	if (zend_is_true(&type)) {
 		phalcon_read_property(&result, getThis(), SL("_result"), PH_NOISY|PH_READONLY);
@@ -191,6 +503,14 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 	}
 
 	if (Z_TYPE(row) != IS_ARRAY) {
+		/**
+		 * Once a stream is exhausted the number of rows is known
+		 */
+		if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+			phalcon_read_property(&pointer, getThis(), SL("_pointer"), PH_NOISY|PH_READONLY);
+			phalcon_update_property(getThis(), SL("_count"), &pointer);
+		}
+
 		phalcon_update_property_bool(getThis(), SL("_activeRow"), 0);
 		RETURN_FALSE;
 	}
@@ -200,11 +520,6 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 	 */
 	ZVAL_LONG(&dirty_state, 0);
 
-	/**
-	 * Get current hydration mode
-	 */
-	phalcon_read_property(&hydrate_mode, getThis(), SL("_hydrateMode"), PH_NOISY|PH_READONLY);
-
 	/**
 	 * Get the resultset column map
 	 */
@@ -220,6 +535,24 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, valid){
 		ce = phalcon_mvc_model_ce;
 	}
 
+	/**
+	 * Streamed rows are hydrated without keeping them in the resultset
+	 */
+	if (PHALCON_IS_LONG(&type, PHALCON_MVC_MODEL_RESULTSET_TYPE_STREAM)) {
+		if (PHALCON_IS_LONG(&hydrate_mode, 0)) {
+			phalcon_read_property(&model, getThis(), SL("_model"), PH_NOISY|PH_READONLY);
+			PHALCON_CALL_CE_STATIC(&active_row, ce, "cloneresultmap", &model, &row, &column_map, &dirty_state, &source_model);
+		} else {
+			PHALCON_CALL_CE_STATIC(&active_row, ce, "cloneresultmaphydrate", &row, &column_map, &hydrate_mode, &source_model);
+		}
+		zval_ptr_dtor(&row);
+		zval_ptr_dtor(&key);
+
+		phalcon_update_property(getThis(), SL("_activeRow"), &active_row);
+		zval_ptr_dtor(&active_row);
+		RETURN_TRUE;
+	}
+
 	/**
 	 * Hydrate based on the current hydration
 	 */
@@ -379,3 +712,50 @@ PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, unserialize){
 	phalcon_update_property(getThis(), SL("_hydrateMode"), &hydrate_mode);
 	zval_ptr_dtor(&resultset);
 }
+
+/**
+ * Returns every value of a column as a packed array, without building a row per record
+ *
+ *<code>
+ * $ids = Robots::find()->column('id');
+ *</code>
+ *
+ * @param string $name
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Resultset_Simple, column){
+
+	zval *name, columns = {}, vector = {}, column_types = {}, field_type = {}, source_model = {}, exception_message = {}, *value;
+
+	phalcon_fetch_params(0, 1, 0, &name);
+
+	if (phalcon_mvc_model_resultset_simple_columnize(getThis(), &columns) == FAILURE) {
+		return;
+	}
+
+	if (!phalcon_array_isset_fetch(&vector, &columns, name, PH_READONLY)) {
+		PHALCON_CONCAT_SVS(&exception_message, "Column \"", name, "\" doesn't make part of the resultset");
+		PHALCON_THROW_EXCEPTION_ZVAL(phalcon_mvc_model_exception_ce, &exception_message);
+		zval_ptr_dtor(&exception_message);
+		return;
+	}
+
+	phalcon_read_property(&column_types, getThis(), SL("_columnTypes"), PH_NOISY|PH_READONLY);
+	if (!PHALCON_GLOBAL(orm).enable_auto_convert || Z_TYPE(column_types) != IS_ARRAY || !phalcon_array_isset_fetch(&field_type, &column_types, name, PH_READONLY)) {
+		/**
+		 * The vector is shared with the resultset, it is only separated if it is written
+		 */
+		RETURN_CTOR(&vector);
+	}
+
+	phalcon_read_property(&source_model, getThis(), SL("_sourceModel"), PH_NOISY|PH_READONLY);
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL(vector)));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL(vector), value) {
+		zval convert_value = {};
+		if (phalcon_mvc_model_row_columnar_convert(&convert_value, value, &field_type, &source_model) == FAILURE) {
+			return;
+		}
+		phalcon_array_append(return_value, &convert_value, 0);
+	} ZEND_HASH_FOREACH_END();
+}
@@ -0,0 +1,325 @@
+
+/*
+  +------------------------------------------------------------------------+
+  | Phalcon Framework                                                      |
+  +------------------------------------------------------------------------+
+  | Copyright (c) 2011-2014 Phalcon Team (http://www.phalconphp.com)       |
+  +------------------------------------------------------------------------+
+  | This source file is subject to the New BSD License that is bundled     |
+  | with this package in the file docs/LICENSE.txt.                        |
+  |                                                                        |
+  | If you did not receive a copy of the license and are unable to         |
+  | obtain it through the world-wide-web, please send an email             |
+  | to license@phalconphp.com so we can send you a copy immediately.       |
+  +------------------------------------------------------------------------+
+  | Authors: Andres Gutierrez <andres@phalconphp.com>                      |
+  |          Eduar Carvajal <eduar@phalconphp.com>                         |
+  +------------------------------------------------------------------------+
+*/
+
+#include "mvc/model/row/columnar.h"
+#include "mvc/model/row.h"
+#include "mvc/model/exception.h"
+#include "db/column.h"
+
+#include "kernel/main.h"
+#include "kernel/memory.h"
+#include "kernel/fcall.h"
+#include "kernel/array.h"
+#include "kernel/object.h"
+#include "kernel/string.h"
+#include "kernel/exception.h"
+
+#include "internal/arginfo.h"
+
+/**
+ * Phalcon\Mvc\Model\Row\Columnar
+ *
+ * Row returned by resultsets hydrated with Resultset::HYDRATE_COLUMNAR. It shares the
+ * column vectors of the resultset and only copies a field into the row the first time it is read
+ *
+ *<code>
+ * $robots = Robots::find();
+ * $robots->setHydrateMode(Phalcon\Mvc\Model\Resultset::HYDRATE_COLUMNAR);
+ * foreach ($robots as $robot) {
+ *     echo $robot->name, PHP_EOL;
+ * }
+ *</code>
+ */
+zend_class_entry *phalcon_mvc_model_row_columnar_ce;
+
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __construct);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __get);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __isset);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, offsetExists);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, offsetGet);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, toArray);
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, count);
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_model_row_columnar___construct, 0, 0, 2)
+	ZEND_ARG_INFO(0, columns)
+	ZEND_ARG_INFO(0, index)
+	ZEND_ARG_INFO(0, columnTypes)
+	ZEND_ARG_INFO(0, sourceModel)
+ZEND_END_ARG_INFO()
+
+static const zend_function_entry phalcon_mvc_model_row_columnar_method_entry[] = {
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, __construct, arginfo_phalcon_mvc_model_row_columnar___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, __get, arginfo___get, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, __isset, arginfo___isset, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, offsetExists, arginfo_arrayaccess_offsetexists, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, offsetGet, arginfo_arrayaccess_offsetget, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, toArray, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Model_Row_Columnar, count, arginfo_countable_count, ZEND_ACC_PUBLIC)
+	PHP_FE_END
+};
+
+/**
+ * Phalcon\Mvc\Model\Row\Columnar initializer
+ */
+PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Row_Columnar){
+
+	PHALCON_REGISTER_CLASS_EX(Phalcon\\Mvc\\Model\\Row, Columnar, mvc_model_row_columnar, phalcon_mvc_model_row_ce, phalcon_mvc_model_row_columnar_method_entry, 0);
+
+	zend_declare_property_null(phalcon_mvc_model_row_columnar_ce, SL("_columns"), ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_mvc_model_row_columnar_ce, SL("_index"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_row_columnar_ce, SL("_columnTypes"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_model_row_columnar_ce, SL("_sourceModel"), ZEND_ACC_PROTECTED);
+
+	return SUCCESS;
+}
+
+/**
+ * Applies the automatic conversion of the ORM to a value taken from a column vector
+ */
+int phalcon_mvc_model_row_columnar_convert(zval *return_value, zval *value, zval *field_type, zval *source_model)
+{
+	zval connection = {};
+	int flag = SUCCESS;
+
+	if (!PHALCON_GLOBAL(orm).enable_auto_convert || Z_TYPE_P(field_type) != IS_LONG || Z_TYPE_P(value) == IS_NULL) {
+		ZVAL_COPY(return_value, value);
+		return SUCCESS;
+	}
+
+	switch (Z_LVAL_P(field_type)) {
+		case PHALCON_DB_COLUMN_TYPE_JSON:
+			return phalcon_json_decode(return_value, value, 1);
+
+		case PHALCON_DB_COLUMN_TYPE_BYTEA:
+		case PHALCON_DB_COLUMN_TYPE_ARRAY:
+		case PHALCON_DB_COLUMN_TYPE_INT_ARRAY:
+			if (Z_TYPE_P(source_model) != IS_OBJECT) {
+				break;
+			}
+
+			PHALCON_CALL_METHOD_FLAG(flag, &connection, source_model, "getreadconnection");
+			if (flag == FAILURE) {
+				return FAILURE;
+			}
+
+			if (Z_LVAL_P(field_type) == PHALCON_DB_COLUMN_TYPE_BYTEA) {
+				PHALCON_CALL_METHOD_FLAG(flag, return_value, &connection, "unescapebytea", value);
+			} else {
+				PHALCON_CALL_METHOD_FLAG(flag, return_value, &connection, "unescapearray", value, field_type);
+			}
+			zval_ptr_dtor(&connection);
+			return flag;
+
+		default:
+			break;
+	}
+
+	ZVAL_COPY(return_value, value);
+	return SUCCESS;
+}
+
+/**
+ * Reads a field of the row, converting it the first time and keeping it as a property afterwards
+ */
+static int phalcon_mvc_model_row_columnar_fetch(zval *return_value, zval *object, zval *name)
+{
+	zval columns = {}, vector = {}, index = {}, value = {}, column_types = {}, field_type = {}, source_model = {};
+
+	phalcon_read_property(&columns, object, SL("_columns"), PH_NOISY|PH_READONLY);
+	if (!phalcon_array_isset_fetch(&vector, &columns, name, PH_READONLY)) {
+		return FAILURE;
+	}
+
+	/**
+	 * Fields already read were stored as regular properties
+	 */
+	if (phalcon_property_isset_fetch_zval(return_value, object, name, PH_COPY)) {
+		return SUCCESS;
+	}
+
+	phalcon_read_property(&index, object, SL("_index"), PH_NOISY|PH_READONLY);
+	if (!phalcon_array_isset_fetch(&value, &vector, &index, PH_READONLY)) {
+		ZVAL_NULL(return_value);
+		return SUCCESS;
+	}
+
+	phalcon_read_property(&column_types, object, SL("_columnTypes"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(column_types) == IS_ARRAY && phalcon_array_isset_fetch(&field_type, &column_types, name, PH_READONLY)) {
+		phalcon_read_property(&source_model, object, SL("_sourceModel"), PH_NOISY|PH_READONLY);
+		if (phalcon_mvc_model_row_columnar_convert(return_value, &value, &field_type, &source_model) == FAILURE) {
+			return FAILURE;
+		}
+	} else {
+		ZVAL_COPY(return_value, &value);
+	}
+
+	phalcon_update_property_zval_zval(object, name, return_value);
+	return SUCCESS;
+}
+
+/**
+ * Phalcon\Mvc\Model\Row\Columnar constructor
+ *
+ * @param array $columns
+ * @param int $index
+ * @param array $columnTypes
+ * @param Phalcon\Mvc\ModelInterface $sourceModel
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __construct){
+
+	zval *columns, *index, *column_types = NULL, *source_model = NULL;
+
+	phalcon_fetch_params(0, 2, 2, &columns, &index, &column_types, &source_model);
+
+	phalcon_update_property(getThis(), SL("_columns"), columns);
+	phalcon_update_property(getThis(), SL("_index"), index);
+
+	if (column_types && Z_TYPE_P(column_types) == IS_ARRAY) {
+		phalcon_update_property(getThis(), SL("_columnTypes"), column_types);
+	}
+
+	if (source_model && Z_TYPE_P(source_model) == IS_OBJECT) {
+		phalcon_update_property(getThis(), SL("_sourceModel"), source_model);
+	}
+}
+
+/**
+ * Hydrates a field the first time it is read
+ *
+ * @param string $property
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __get){
+
+	zval *property;
+
+	phalcon_fetch_params(0, 1, 0, &property);
+
+	if (phalcon_mvc_model_row_columnar_fetch(return_value, getThis(), property) == FAILURE && !EG(exception)) {
+		RETURN_NULL();
+	}
+}
+
+/**
+ * Checks whether the row has a field
+ *
+ * @param string $property
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, __isset){
+
+	zval *property, columns = {}, vector = {}, index = {}, value = {};
+
+	phalcon_fetch_params(0, 1, 0, &property);
+
+	phalcon_read_property(&columns, getThis(), SL("_columns"), PH_NOISY|PH_READONLY);
+	if (!phalcon_array_isset_fetch(&vector, &columns, property, PH_READONLY)) {
+		RETURN_FALSE;
+	}
+
+	phalcon_read_property(&index, getThis(), SL("_index"), PH_NOISY|PH_READONLY);
+	if (!phalcon_array_isset_fetch(&value, &vector, &index, PH_READONLY)) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(Z_TYPE(value) != IS_NULL);
+}
+
+/**
+ * Checks whether offset exists in the row
+ *
+ * @param string $index
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, offsetExists){
+
+	zval *index, columns = {};
+
+	phalcon_fetch_params(0, 1, 0, &index);
+
+	phalcon_read_property(&columns, getThis(), SL("_columns"), PH_NOISY|PH_READONLY);
+	RETURN_BOOL(phalcon_array_isset(&columns, index));
+}
+
+/**
+ * Gets a field of the row, hydrating it if it was not read before
+ *
+ * @param string $index
+ * @return mixed
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, offsetGet){
+
+	zval *index;
+
+	phalcon_fetch_params(0, 1, 0, &index);
+
+	if (phalcon_mvc_model_row_columnar_fetch(return_value, getThis(), index) == FAILURE && !EG(exception)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_model_exception_ce, "The index does not exist in the row");
+	}
+}
+
+/**
+ * Returns the instance as an array representation, hydrating every field
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, toArray){
+
+	zval columns = {};
+	zend_string *str_key;
+
+	phalcon_read_property(&columns, getThis(), SL("_columns"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(columns) != IS_ARRAY) {
+		array_init(return_value);
+		return;
+	}
+
+	array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL(columns)));
+
+	ZEND_HASH_FOREACH_STR_KEY(Z_ARRVAL(columns), str_key) {
+		zval name = {}, value = {};
+		if (!str_key) {
+			continue;
+		}
+
+		ZVAL_STR(&name, str_key);
+		if (phalcon_mvc_model_row_columnar_fetch(&value, getThis(), &name) == FAILURE) {
+			return;
+		}
+
+		phalcon_array_update(return_value, &name, &value, 0);
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Counts how many fields the row has
+ *
+ * @return int
+ */
+PHP_METHOD(Phalcon_Mvc_Model_Row_Columnar, count){
+
+	zval columns = {};
+
+	phalcon_read_property(&columns, getThis(), SL("_columns"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(columns) == IS_ARRAY) {
+		RETURN_LONG(zend_hash_num_elements(Z_ARRVAL(columns)));
+	}
+
+	RETURN_LONG(0);
+}
@@ -22,6 +22,7 @@
 #include "mvc/model/transaction/exception.h"
 #include "mvc/model/transaction/failed.h"
 #include "mvc/model/transaction/managerinterface.h"
+#include "db/pool.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -135,7 +136,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Model_Transaction){
  */
 PHP_METHOD(Phalcon_Mvc_Model_Transaction, __construct){
 
-	zval *dependency_injector, *auto_begin = NULL, *s = NULL, service = {}, connection = {};
+	zval *dependency_injector, *auto_begin = NULL, *s = NULL, service = {}, connection = {}, pool = {};
+	int flag;
 
 	phalcon_fetch_params(0, 1, 2, &dependency_injector, &auto_begin, &s);
 
@@ -157,6 +159,21 @@ PHP_METHOD(Phalcon_Mvc_Model_Transaction, __construct){
 	PHALCON_CALL_METHOD(&connection, dependency_injector, "get", &service);
 	zval_ptr_dtor(&service);
 
+	/**
+	 * Transactions run on the primary and the reads that follow are sent there too
+	 */
+	if (Z_TYPE(connection) == IS_OBJECT && instanceof_function(Z_OBJCE(connection), phalcon_db_pool_ce)) {
+		ZVAL_COPY_VALUE(&pool, &connection);
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &pool, "pin");
+		if (flag == SUCCESS) {
+			PHALCON_CALL_METHOD_FLAG(flag, &connection, &pool, "getwriteconnection");
+		}
+		zval_ptr_dtor(&pool);
+		if (flag == FAILURE) {
+			return;
+		}
+	}
+
 	phalcon_update_property(getThis(), SL("_connection"), &connection);
 	if (zend_is_true(auto_begin)) {
 		PHALCON_CALL_METHOD(NULL, &connection, "begin");
@@ -43,6 +43,11 @@
 #include "kernel/file.h"
 #include "kernel/hash.h"
 #include "kernel/debug.h"
+#include "kernel/framework/router.h"
+#include "kernel/variables.h"
+
+#include <Zend/zend_smart_str.h>
+#include <ext/standard/php_var.h>
 
 #include "interned-strings.h"
 
@@ -103,6 +108,10 @@ PHP_METHOD(Phalcon_Mvc_Router, setDefaultController);
 PHP_METHOD(Phalcon_Mvc_Router, getDefaultController);
 PHP_METHOD(Phalcon_Mvc_Router, setControllerName);
 PHP_METHOD(Phalcon_Mvc_Router, getControllerName);
+PHP_METHOD(Phalcon_Mvc_Router, compile);
+PHP_METHOD(Phalcon_Mvc_Router, setAutoCompile);
+PHP_METHOD(Phalcon_Mvc_Router, export);
+PHP_METHOD(Phalcon_Mvc_Router, fromCache);
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router___construct, 0, 0, 0)
 	ZEND_ARG_TYPE_INFO(0, defaultRoutes, _IS_BOOL, 1)
@@ -124,6 +133,18 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_notfound, 0, 0, 1)
 	ZEND_ARG_TYPE_INFO(0, paths, IS_ARRAY, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_setautocompile, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, autoCompile, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_export, 0, 0, 0)
+	ZEND_ARG_TYPE_INFO(0, file, IS_STRING, 1)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_phalcon_mvc_router_fromcache, 0, 0, 1)
+	ZEND_ARG_INFO(0, data)
+ZEND_END_ARG_INFO()
+
 static const zend_function_entry phalcon_mvc_router_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Router, __construct, arginfo_phalcon_mvc_router___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Mvc_Router, getRewriteUri, NULL, ZEND_ACC_PUBLIC)
@@ -154,6 +175,10 @@ static const zend_function_entry phalcon_mvc_router_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_Router, getDefaultController, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Router, setControllerName, arginfo_phalcon_routerinterface_sethandlername, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_Router, getControllerName, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Router, compile, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Router, setAutoCompile, arginfo_phalcon_mvc_router_setautocompile, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Router, export, arginfo_phalcon_mvc_router_export, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_Router, fromCache, arginfo_phalcon_mvc_router_fromcache, ZEND_ACC_PUBLIC)
 	PHP_FE_END
 };
 
@@ -173,6 +198,10 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Router){
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_removeExtraSlashes"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_router_ce, SL("_notFoundPaths"), ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_mvc_router_ce, SL("_isExactControllerName"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_router_ce, SL("_autoCompile"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_compiledTree"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_compiledMethods"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_router_ce, SL("_cachedRoutes"), ZEND_ACC_PROTECTED);
 
 	zend_declare_class_constant_long(phalcon_mvc_router_ce, SL("URI_SOURCE_GET_URL"), 0);
 	zend_declare_class_constant_long(phalcon_mvc_router_ce, SL("URI_SOURCE_SERVER_REQUEST_URI"), 1);
@@ -182,6 +211,224 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_Router){
 	return SUCCESS;
 }
 
+static zend_long phalcon_mvc_router_method_bit(zval *method)
+{
+	if (Z_TYPE_P(method) != IS_STRING) {
+		return PHALCON_MVC_ROUTER_METHOD_OTHER;
+	}
+
+	if (zend_string_equals(Z_STR_P(method), IS(GET))) {
+		return PHALCON_MVC_ROUTER_METHOD_GET;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(POST))) {
+		return PHALCON_MVC_ROUTER_METHOD_POST;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(PUT))) {
+		return PHALCON_MVC_ROUTER_METHOD_PUT;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(PATCH))) {
+		return PHALCON_MVC_ROUTER_METHOD_PATCH;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(DELETE))) {
+		return PHALCON_MVC_ROUTER_METHOD_DELETE;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(OPTIONS))) {
+		return PHALCON_MVC_ROUTER_METHOD_OPTIONS;
+	}
+	if (zend_string_equals(Z_STR_P(method), IS(HEAD))) {
+		return PHALCON_MVC_ROUTER_METHOD_HEAD;
+	}
+
+	return PHALCON_MVC_ROUTER_METHOD_OTHER;
+}
+
+static zend_long phalcon_mvc_router_methods_mask(zval *methods)
+{
+	zval *method;
+	zend_long mask = 0;
+
+	if (Z_TYPE_P(methods) == IS_NULL) {
+		return PHALCON_MVC_ROUTER_METHOD_ANY;
+	}
+
+	if (Z_TYPE_P(methods) != IS_ARRAY) {
+		return phalcon_mvc_router_method_bit(methods);
+	}
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(methods), method) {
+		mask |= phalcon_mvc_router_method_bit(method);
+	} ZEND_HASH_FOREACH_END();
+
+	return mask;
+}
+
+static void phalcon_mvc_router_trie_node(zval *node)
+{
+	zval routes = {}, children = {};
+
+	array_init_size(node, 3);
+	phalcon_array_update_str_long(node, SL("methods"), 0, 0);
+
+	array_init(&routes);
+	phalcon_array_update_str(node, SL("routes"), &routes, 0);
+
+	array_init(&children);
+	phalcon_array_update_str(node, SL("children"), &children, 0);
+}
+
+static void phalcon_mvc_router_trie_insert(zval *node, zval *segments, zend_long position, zend_long mask)
+{
+	zval *methods, *children, *child, *segment, tmp = {};
+
+	methods = zend_hash_str_find(Z_ARRVAL_P(node), SL("methods"));
+	Z_LVAL_P(methods) |= mask;
+
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(segments), segment) {
+		children = zend_hash_str_find(Z_ARRVAL_P(node), SL("children"));
+		child = zend_symtable_str_find(Z_ARRVAL_P(children), Z_STRVAL_P(segment), Z_STRLEN_P(segment));
+		if (!child) {
+			phalcon_mvc_router_trie_node(&tmp);
+			child = zend_symtable_str_update(Z_ARRVAL_P(children), Z_STRVAL_P(segment), Z_STRLEN_P(segment), &tmp);
+		}
+
+		node = child;
+		methods = zend_hash_str_find(Z_ARRVAL_P(node), SL("methods"));
+		Z_LVAL_P(methods) |= mask;
+	} ZEND_HASH_FOREACH_END();
+
+	add_next_index_long(zend_hash_str_find(Z_ARRVAL_P(node), SL("routes")), position);
+}
+
+static void phalcon_mvc_router_trie_collect(zval *candidates, zval *node, zval *routes)
+{
+	zval *positions, *position, *route;
+
+	positions = zend_hash_str_find(Z_ARRVAL_P(node), SL("routes"));
+	ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(positions), position) {
+		if ((route = zend_hash_index_find(Z_ARRVAL_P(routes), Z_LVAL_P(position))) != NULL) {
+			Z_TRY_ADDREF_P(route);
+			zend_hash_index_update(Z_ARRVAL_P(candidates), Z_LVAL_P(position), route);
+		}
+	} ZEND_HASH_FOREACH_END();
+}
+
+/**
+ * Walks the compiled tree with the segments of the uri and returns the routes that can match it,
+ * keyed by their position in the routes table
+ */
+static void phalcon_mvc_router_trie_lookup(zval *candidates, zval *tree, zval *routes, zval *uri, zend_long method)
+{
+	zval *node = tree, *children, *child, *methods;
+	const char *cursor, *end, *delimiter;
+
+	array_init(candidates);
+
+	methods = zend_hash_str_find(Z_ARRVAL_P(node), SL("methods"));
+	if (!(Z_LVAL_P(methods) & method)) {
+		return;
+	}
+
+	phalcon_mvc_router_trie_collect(candidates, node, routes);
+
+	if (Z_TYPE_P(uri) == IS_STRING && Z_STRLEN_P(uri) && Z_STRVAL_P(uri)[0] == '/') {
+		cursor = Z_STRVAL_P(uri) + 1;
+		end = Z_STRVAL_P(uri) + Z_STRLEN_P(uri);
+
+		while (1) {
+			delimiter = memchr(cursor, '/', end - cursor);
+			if (!delimiter) {
+				delimiter = end;
+			}
+
+			children = zend_hash_str_find(Z_ARRVAL_P(node), SL("children"));
+			child = zend_symtable_str_find(Z_ARRVAL_P(children), cursor, delimiter - cursor);
+			if (!child) {
+				break;
+			}
+
+			methods = zend_hash_str_find(Z_ARRVAL_P(child), SL("methods"));
+			if (!(Z_LVAL_P(methods) & method)) {
+				break;
+			}
+
+			node = child;
+			phalcon_mvc_router_trie_collect(candidates, node, routes);
+
+			if (delimiter == end) {
+				break;
+			}
+			cursor = delimiter + 1;
+		}
+	}
+
+	/* Routes are checked in the same order they were added */
+	phalcon_array_ksort(candidates, 0);
+}
+
+/**
+ * Route properties kept by Phalcon\Mvc\Router::export()
+ */
+static const char *phalcon_mvc_router_exported_properties[] = {
+	"_pattern", "_compiledPattern", "_paths", "_methods", "_prefix", "_hostname", "_id", "_name",
+	"_defaultNamespace", "_defaultModule", "_defaultController", "_defaultAction", "_defaultParams",
+	"_caseSensitive", "_mode", NULL
+};
+
+/**
+ * Creates the route at the position of the routes table from the data attached by fromCache(),
+ * the route is built without calling its constructor so the pattern isn't compiled again
+ */
+static void phalcon_mvc_router_load_route(zval *return_value, zval *router, zend_ulong position)
+{
+	zval cached_routes = {}, data = {}, index = {}, *value;
+	zend_string *key;
+
+	ZVAL_NULL(return_value);
+
+	phalcon_read_property(&cached_routes, router, SL("_cachedRoutes"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(cached_routes) != IS_ARRAY || !phalcon_array_isset_fetch_long(&data, &cached_routes, position, PH_READONLY)) {
+		return;
+	}
+
+	object_init_ex(return_value, phalcon_mvc_router_route_ce);
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(data), key, value) {
+		if (key) {
+			phalcon_update_property_string_zval(return_value, key, value);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	ZVAL_LONG(&index, position);
+	phalcon_update_property_array(router, SL("_routes"), &index, return_value);
+}
+
+/**
+ * Creates all the routes still pending from fromCache()
+ */
+static void phalcon_mvc_router_load_routes(zval *router)
+{
+	zval cached_routes = {}, routes = {}, *route;
+	zend_ulong idx;
+
+	phalcon_read_property(&cached_routes, router, SL("_cachedRoutes"), PH_NOISY|PH_READONLY);
+	if (Z_TYPE(cached_routes) != IS_ARRAY) {
+		return;
+	}
+
+	phalcon_read_property(&routes, router, SL("_routes"), PH_NOISY|PH_COPY);
+	if (Z_TYPE(routes) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(routes), idx, route) {
+			if (Z_TYPE_P(route) == IS_NULL) {
+				zval loaded_route = {};
+				phalcon_mvc_router_load_route(&loaded_route, router, idx);
+				zval_ptr_dtor(&loaded_route);
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+	zval_ptr_dtor(&routes);
+
+	phalcon_update_property_null(router, SL("_cachedRoutes"));
+}
+
 /**
  * Phalcon\Mvc\Router constructor
  *
@@ -435,10 +682,13 @@ PHP_METHOD(Phalcon_Mvc_Router, getDefaults){
 PHP_METHOD(Phalcon_Mvc_Router, handle){
 
 	zval *uri = NULL, real_uri = {}, status = {}, removeextraslashes = {}, handled_uri = {}, route_found = {}, params = {}, service = {}, dependency_injector = {}, request = {}, debug_message = {}, event_name = {};
-	zval all_case_sensitive = {}, current_host_name = {}, routes = {}, *route, matches = {}, parts = {}, namespace_name = {}, default_namespace = {}, module = {}, default_module = {}, exact = {};
+	zval all_case_sensitive = {}, current_host_name = {}, routes = {}, *route = NULL, matches = {}, parts = {}, namespace_name = {}, default_namespace = {}, module = {}, default_module = {}, exact = {};
 	zval controller = {}, default_handler = {}, action = {}, default_action = {}, mode = {}, http_method = {}, action_name = {}, params_str = {}, str_params = {}, params_merge = {}, default_params = {};
-	zend_string *str_key;
-	ulong idx;
+	zval auto_compile = {}, compiled_tree = {}, compiled_methods = {}, candidates = {}, *route_mask;
+	zend_string *str_key, *route_key;
+	ulong idx, route_idx;
+	zend_long method_bit = PHALCON_MVC_ROUTER_METHOD_ANY;
+	int flag;
 
 	phalcon_fetch_params(0, 0, 1, &uri);
 
@@ -502,13 +752,46 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 	PHALCON_CALL_METHOD(&http_method, &request, "getmethod");
 
 	/**
-	 * Routes are traversed in reversed order
+	 * The compiled tree narrows the routes down to the ones sharing the static segments of the URI
 	 */
-	phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&auto_compile, getThis(), SL("_autoCompile"), PH_NOISY|PH_READONLY);
+	if (zend_is_true(&auto_compile)) {
+		phalcon_read_property(&compiled_tree, getThis(), SL("_compiledTree"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(compiled_tree) != IS_ARRAY) {
+			PHALCON_CALL_METHOD(NULL, getThis(), "compile");
+			phalcon_read_property(&compiled_tree, getThis(), SL("_compiledTree"), PH_NOISY|PH_READONLY);
+		}
+		phalcon_read_property(&compiled_methods, getThis(), SL("_compiledMethods"), PH_NOISY|PH_READONLY);
+		phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
+
+		method_bit = phalcon_mvc_router_method_bit(&http_method);
+		phalcon_mvc_router_trie_lookup(&candidates, &compiled_tree, &routes, &handled_uri, method_bit);
+
+		/**
+		 * Routes attached from the cache are only created when they are candidates
+		 */
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(candidates), route_idx, route) {
+			if (Z_TYPE_P(route) == IS_NULL) {
+				phalcon_mvc_router_load_route(route, getThis(), route_idx);
+			}
+		} ZEND_HASH_FOREACH_END();
+		route = NULL;
+	} else {
+		phalcon_mvc_router_load_routes(getThis());
+		phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(routes) == IS_ARRAY) {
+			ZVAL_COPY(&candidates, &routes);
+		} else {
+			array_init(&candidates);
+		}
+	}
 
 	PHALCON_CALL_METHOD(&all_case_sensitive, getThis(), "getcasesensitive");
 
-	ZEND_HASH_REVERSE_FOREACH_VAL(Z_ARRVAL(routes), route) {
+	/**
+	 * Candidates are traversed in reversed order, so the last added route wins
+	 */
+	ZEND_HASH_REVERSE_FOREACH_KEY_VAL(Z_ARRVAL(candidates), route_idx, route_key, route) {
 		zval case_sensitive = {}, methods = {}, match_method = {}, hostname = {}, prefix = {}, regex_host_name = {}, matched = {};
 		zval pattern = {}, case_pattern = {}, before_match = {}, before_match_params = {}, paths = {};
 		zval converters = {}, *position;
@@ -521,18 +804,29 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		/**
 		 * Look for HTTP method constraints
 		 */
-		PHALCON_CALL_METHOD(&methods, route, "gethttpmethods");
-		if (Z_TYPE(methods) != IS_NULL) {
+		if (Z_TYPE(compiled_methods) == IS_ARRAY && !route_key
+			&& (route_mask = zend_hash_index_find(Z_ARRVAL(compiled_methods), route_idx)) != NULL
+			&& (Z_LVAL_P(route_mask) == PHALCON_MVC_ROUTER_METHOD_ANY || !(Z_LVAL_P(route_mask) & PHALCON_MVC_ROUTER_METHOD_OTHER))) {
 			/**
-			 * Check if the current method is allowed by the route
+			 * The constraints were resolved to a bitmask when the routes were compiled
 			 */
-			PHALCON_CALL_METHOD(&match_method, &request, "ismethod", &methods);
-			if (PHALCON_IS_FALSE(&match_method)) {
-				zval_ptr_dtor(&methods);
+			if (!(Z_LVAL_P(route_mask) & method_bit)) {
 				continue;
 			}
+		} else {
+			PHALCON_CALL_METHOD(&methods, route, "gethttpmethods");
+			if (Z_TYPE(methods) != IS_NULL) {
+				/**
+				 * Check if the current method is allowed by the route
+				 */
+				PHALCON_CALL_METHOD(&match_method, &request, "ismethod", &methods);
+				if (PHALCON_IS_FALSE(&match_method)) {
+					zval_ptr_dtor(&methods);
+					continue;
+				}
+			}
+			zval_ptr_dtor(&methods);
 		}
-		zval_ptr_dtor(&methods);
 
 		/**
 		 * Look for hostname constraints
@@ -558,8 +852,13 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 					ZVAL_COPY(&regex_host_name, &hostname);
 				}
 
-				RETURN_ON_FAILURE(phalcon_preg_match(&matched, &regex_host_name, &current_host_name, NULL));
+				flag = phalcon_preg_match(&matched, &regex_host_name, &current_host_name, NULL);
 				zval_ptr_dtor(&regex_host_name);
+				if (flag == FAILURE) {
+					zval_ptr_dtor(&hostname);
+					zval_ptr_dtor(&candidates);
+					return;
+				}
 
 				if (!zend_is_true(&matched)) {
 					zval_ptr_dtor(&hostname);
@@ -609,13 +908,25 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 			if (zend_is_true(&case_sensitive)) {
 				PHALCON_CONCAT_VS(&case_pattern, &pattern, "i");
 				ZVAL_MAKE_REF(&matches);
-				RETURN_ON_FAILURE(phalcon_preg_match(&route_found, &case_pattern, &handled_uri, &matches));
+				flag = phalcon_preg_match(&route_found, &case_pattern, &handled_uri, &matches);
 				ZVAL_UNREF(&matches);
 				zval_ptr_dtor(&case_pattern);
+				if (flag == FAILURE) {
+					zval_ptr_dtor(&matches);
+					zval_ptr_dtor(&pattern);
+					zval_ptr_dtor(&candidates);
+					return;
+				}
 			} else {
 				ZVAL_MAKE_REF(&matches);
-				RETURN_ON_FAILURE(phalcon_preg_match(&route_found, &pattern, &handled_uri, &matches));
+				flag = phalcon_preg_match(&route_found, &pattern, &handled_uri, &matches);
 				ZVAL_UNREF(&matches);
+				if (flag == FAILURE) {
+					zval_ptr_dtor(&matches);
+					zval_ptr_dtor(&pattern);
+					zval_ptr_dtor(&candidates);
+					return;
+				}
 			}
 		} else {
 			ZVAL_BOOL(&route_found, phalcon_comparestr(&pattern, &handled_uri, &case_sensitive));
@@ -638,6 +949,7 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 					PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_router_exception_ce, "Before-Match callback is not callable in matched route");
 					zval_ptr_dtor(&before_match);
 					zval_ptr_dtor(&pattern);
+					zval_ptr_dtor(&candidates);
 					return;
 				}
 
@@ -808,7 +1120,9 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 			PHALCON_CALL_METHOD(NULL, getThis(), "setnamespacename", &namespace_name);
 			phalcon_array_unset_str(&parts, SL("namespace"), 0);
 		} else {
-			PHALCON_CALL_METHOD(&default_namespace, route, "getdefaultnamespace");
+			if (route) {
+				PHALCON_CALL_METHOD(&default_namespace, route, "getdefaultnamespace");
+			}
 			if (Z_TYPE(default_namespace) == IS_NULL) {
 				phalcon_read_property(&default_namespace, getThis(), SL("_defaultNamespace"), PH_COPY);
 			}
@@ -823,7 +1137,9 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 			PHALCON_CALL_METHOD(NULL, getThis(), "setmodulename", &module);
 			phalcon_array_unset_str(&parts, SL("module"), 0);
 		} else {
-			PHALCON_CALL_METHOD(&default_module, route, "getdefaultmodule");
+			if (route) {
+				PHALCON_CALL_METHOD(&default_module, route, "getdefaultmodule");
+			}
 			if (Z_TYPE(default_module) == IS_NULL) {
 				phalcon_read_property(&default_module, getThis(), SL("_defaultModule"), PH_COPY);
 			}
@@ -846,7 +1162,9 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 			PHALCON_CALL_METHOD(NULL, getThis(), "setcontrollername", &controller);
 			phalcon_array_unset_str(&parts, SL("controller"), 0);
 		} else {
-			PHALCON_CALL_METHOD(&default_handler, route, "getdefaultcontroller");
+			if (route) {
+				PHALCON_CALL_METHOD(&default_handler, route, "getdefaultcontroller");
+			}
 			if (Z_TYPE(default_handler) == IS_NULL) {
 				phalcon_read_property(&default_handler, getThis(), SL("_defaultHandler"), PH_COPY);
 			}
@@ -860,14 +1178,18 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		if (phalcon_array_isset_fetch_str(&action, &parts, SL("action"), PH_COPY)) {
 			phalcon_array_unset_str(&parts, SL("action"), 0);
 		} else {
-			PHALCON_CALL_METHOD(&action, route, "getdefaultaction");
+			if (route) {
+				PHALCON_CALL_METHOD(&action, route, "getdefaultaction");
+			}
 			if (Z_TYPE(action) == IS_NULL) {
 				phalcon_read_property(&action, getThis(), SL("_defaultAction"), PH_COPY);
 			}
 		}
 
-		PHALCON_CALL_METHOD(&mode, route, "getmode");
-		if (Z_LVAL(mode) <= PHALCON_ROUTER_MODE_DEFAULT) {
+		if (route) {
+			PHALCON_CALL_METHOD(&mode, route, "getmode");
+		}
+		if (Z_TYPE(mode) != IS_LONG || Z_LVAL(mode) <= PHALCON_ROUTER_MODE_DEFAULT) {
 			PHALCON_CALL_METHOD(&mode, getThis(), "getmode");
 		}
 		if (unlikely(Z_LVAL(mode) == PHALCON_ROUTER_MODE_REST)) {
@@ -923,7 +1245,9 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		zval_ptr_dtor(&params);
 
 		if (PHALCON_IS_EMPTY(&params_merge)) {
-			PHALCON_CALL_METHOD(&default_params, route, "getdefaultparams");
+			if (route) {
+				PHALCON_CALL_METHOD(&default_params, route, "getdefaultparams");
+			}
 
 			if (Z_TYPE(default_params) == IS_NULL) {
 				phalcon_read_property(&default_params, getThis(), SL("_defaultParams"), PH_COPY);
@@ -971,6 +1295,7 @@ PHP_METHOD(Phalcon_Mvc_Router, handle){
 		PHALCON_CALL_METHOD(NULL, getThis(), "setparams", &default_params);
 	}
 	zval_ptr_dtor(&http_method);
+	zval_ptr_dtor(&candidates);
 
 	ZVAL_STRING(&event_name, "router:afterCheckRoutes");
 	PHALCON_CALL_METHOD(NULL, getThis(), "fireevent", &event_name);
@@ -1025,6 +1350,7 @@ PHP_METHOD(Phalcon_Mvc_Router, add){
 	PHALCON_CALL_METHOD(NULL, return_value, "__construct", pattern, paths, http_methods, regex);
 
 	phalcon_update_property_array_append(getThis(), SL("_routes"), return_value);
+	phalcon_update_property_null(getThis(), SL("_compiledTree"));
 }
 
 static void phalcon_mvc_router_add_helper(INTERNAL_FUNCTION_PARAMETERS, zend_string *method)
@@ -1220,6 +1546,8 @@ PHP_METHOD(Phalcon_Mvc_Router, mount){
 	zval_ptr_dtor(&prefix);
 	zval_ptr_dtor(&converters);
 
+	phalcon_update_property_null(getThis(), SL("_compiledTree"));
+
 	RETURN_THIS();
 }
 
@@ -1253,7 +1581,9 @@ PHP_METHOD(Phalcon_Mvc_Router, clear){
 
 	phalcon_update_property_empty_array(getThis(), SL("_routes"));
 	phalcon_update_property_empty_array(getThis(), SL("_routesNameLookup"));
-
+	phalcon_update_property_null(getThis(), SL("_compiledTree"));
+	phalcon_update_property_null(getThis(), SL("_compiledMethods"));
+	phalcon_update_property_null(getThis(), SL("_cachedRoutes"));
 }
 
 /**
@@ -1296,6 +1626,7 @@ PHP_METHOD(Phalcon_Mvc_Router, wasMatched){
  */
 PHP_METHOD(Phalcon_Mvc_Router, getRoutes){
 
+	phalcon_mvc_router_load_routes(getThis());
 
 	RETURN_MEMBER(getThis(), "_routes");
 }
@@ -1312,6 +1643,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteById){
 
 	phalcon_fetch_params(0, 1, 0, &id);
 
+	phalcon_mvc_router_load_routes(getThis());
 	phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
 	if (Z_TYPE(routes) == IS_ARRAY) {
 		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(routes), route) {
@@ -1347,6 +1679,7 @@ PHP_METHOD(Phalcon_Mvc_Router, getRouteByName){
 		RETURN_CTOR(route);
 	}
 
+	phalcon_mvc_router_load_routes(getThis());
 	phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
 	if (Z_TYPE(routes) == IS_ARRAY) {
 		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(routes), route) {
@@ -1424,3 +1757,301 @@ PHP_METHOD(Phalcon_Mvc_Router, getControllerName){
 
 	RETURN_MEMBER(getThis(), "_handler");
 }
+
+/**
+ * Compiles the routes into a tree indexed by their static path segments, routes are then
+ * only checked against the URIs sharing those segments. The tree is rebuilt on the next
+ * handle() after routes are added, mounted or cleared, routes changed in place after
+ * compiling must be compiled again
+ *
+ *<code>
+ * $router->add('/products/{id:[0-9]+}', 'Products::show')->via('GET');
+ * $router->compile();
+ *</code>
+ *
+ * @return Phalcon\Mvc\Router
+ */
+PHP_METHOD(Phalcon_Mvc_Router, compile){
+
+	zval routes = {}, all_case_sensitive = {}, tree = {}, masks = {}, *route;
+	ulong idx;
+
+	phalcon_mvc_router_load_routes(getThis());
+	phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
+
+	PHALCON_CALL_METHOD(&all_case_sensitive, getThis(), "getcasesensitive");
+
+	phalcon_mvc_router_trie_node(&tree);
+	array_init(&masks);
+
+	if (Z_TYPE(routes) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(routes), idx, route) {
+			zval case_sensitive = {}, methods = {}, pattern = {}, segments = {};
+			zend_long mask;
+
+			PHALCON_CALL_METHOD(&methods, route, "gethttpmethods");
+			mask = phalcon_mvc_router_methods_mask(&methods);
+			zval_ptr_dtor(&methods);
+
+			PHALCON_CALL_METHOD(&case_sensitive, route, "getcasesensitive");
+			if (Z_TYPE(case_sensitive) == IS_NULL) {
+				ZVAL_COPY(&case_sensitive, &all_case_sensitive);
+			}
+
+			/**
+			 * Case insensitive routes stay in the root node
+			 */
+			if (zend_is_true(&case_sensitive)) {
+				array_init(&segments);
+			} else {
+				PHALCON_CALL_METHOD(&pattern, route, "getcompiledpattern");
+				phalcon_extract_static_segments(&segments, &pattern);
+				zval_ptr_dtor(&pattern);
+			}
+			zval_ptr_dtor(&case_sensitive);
+
+			phalcon_mvc_router_trie_insert(&tree, &segments, idx, mask);
+			phalcon_array_update_long_long(&masks, idx, mask, 0);
+			zval_ptr_dtor(&segments);
+		} ZEND_HASH_FOREACH_END();
+	}
+	zval_ptr_dtor(&all_case_sensitive);
+
+	phalcon_update_property_bool(getThis(), SL("_autoCompile"), 1);
+	phalcon_update_property(getThis(), SL("_compiledTree"), &tree);
+	phalcon_update_property(getThis(), SL("_compiledMethods"), &masks);
+	zval_ptr_dtor(&tree);
+	zval_ptr_dtor(&masks);
+
+	RETURN_THIS();
+}
+
+/**
+ * Sets whether handle() compiles the routes on its first call
+ *
+ * @param boolean $autoCompile
+ * @return Phalcon\Mvc\Router
+ */
+PHP_METHOD(Phalcon_Mvc_Router, setAutoCompile){
+
+	zval *auto_compile;
+
+	phalcon_fetch_params(0, 1, 0, &auto_compile);
+
+	phalcon_update_property_bool(getThis(), SL("_autoCompile"), zend_is_true(auto_compile));
+	if (!zend_is_true(auto_compile)) {
+		phalcon_update_property_null(getThis(), SL("_compiledTree"));
+		phalcon_update_property_null(getThis(), SL("_compiledMethods"));
+	}
+
+	RETURN_THIS();
+}
+
+/**
+ * Exports the compiled route table as a string that can be kept in a shared cache and attached
+ * later with fromCache(). Routes using closures (before-match callbacks, converters or url
+ * generators) can't be exported
+ *
+ * When a file is given the table is written as a PHP file returning an array instead. With
+ * opcache the array returned by that file is immutable: fromCache() attaches it without
+ * unserializing or copying anything, which is the cheapest way to share the table between
+ * requests. The string form is unserialized on every fromCache() call, its cost grows with
+ * the number of routes
+ *
+ *<code>
+ * //At deploy time
+ * $router->add('/products/{id:[0-9]+}', 'Products::show');
+ * $router->export('app/cache/routes.php');
+ *
+ * //On every request
+ * $router->fromCache(require 'app/cache/routes.php');
+ *
+ * //Or in a shared cache
+ * $yac = new Phalcon\Cache\Yac('router_');
+ * $data = $yac->get('routes');
+ * if (!$data) {
+ *     $router->add('/products/{id:[0-9]+}', 'Products::show');
+ *     $yac->set('routes', $router->export());
+ * } else {
+ *     $router->fromCache($data);
+ * }
+ *</code>
+ *
+ * @param string $file
+ * @return string|boolean
+ */
+PHP_METHOD(Phalcon_Mvc_Router, export){
+
+	zval *file = NULL, routes = {}, *route, exported_routes = {}, compiled_tree = {}, compiled_methods = {}, table = {};
+	zval php_export = {}, pid = {}, tmp_file = {}, status = {};
+	smart_str exp = { 0 };
+	const char **property;
+	ulong idx;
+	int flag;
+
+	phalcon_fetch_params(0, 0, 1, &file);
+
+	PHALCON_CALL_METHOD(NULL, getThis(), "compile");
+
+	phalcon_read_property(&routes, getThis(), SL("_routes"), PH_NOISY|PH_READONLY);
+
+	array_init(&exported_routes);
+	if (Z_TYPE(routes) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(routes), idx, route) {
+			zval closure = {}, pattern = {}, exported_route = {};
+
+			PHALCON_CALL_METHOD(&closure, route, "getbeforematch");
+			if (Z_TYPE(closure) == IS_NULL) {
+				PHALCON_CALL_METHOD(&closure, route, "geturlgenerator");
+			}
+			if (Z_TYPE(closure) == IS_NULL) {
+				PHALCON_CALL_METHOD(&closure, route, "getconverters");
+				if (PHALCON_IS_EMPTY_ARR(&closure)) {
+					zval_ptr_dtor(&closure);
+					ZVAL_NULL(&closure);
+				}
+			}
+
+			if (Z_TYPE(closure) != IS_NULL) {
+				zval_ptr_dtor(&closure);
+				zval_ptr_dtor(&exported_routes);
+				PHALCON_CALL_METHOD(&pattern, route, "getpattern");
+				PHALCON_THROW_EXCEPTION_FORMAT(phalcon_mvc_router_exception_ce, "The route '%s' uses closures and can't be exported", Z_TYPE(pattern) == IS_STRING ? Z_STRVAL(pattern) : "");
+				zval_ptr_dtor(&pattern);
+				return;
+			}
+
+			array_init(&exported_route);
+			for (property = phalcon_mvc_router_exported_properties; *property; property++) {
+				zval value = {};
+				phalcon_read_property(&value, route, *property, strlen(*property), PH_NOISY|PH_READONLY);
+				if (Z_TYPE(value) != IS_NULL) {
+					phalcon_array_update_str(&exported_route, *property, strlen(*property), &value, PH_COPY);
+				}
+			}
+
+			phalcon_array_update_long(&exported_routes, idx, &exported_route, 0);
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	phalcon_read_property(&compiled_tree, getThis(), SL("_compiledTree"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&compiled_methods, getThis(), SL("_compiledMethods"), PH_NOISY|PH_READONLY);
+
+	array_init_size(&table, 4);
+	phalcon_array_update_str_str(&table, SL("version"), SL(PHP_PHALCON_VERSION), 0);
+	phalcon_array_update_str(&table, SL("routes"), &exported_routes, 0);
+	phalcon_array_update_str(&table, SL("tree"), &compiled_tree, PH_COPY);
+	phalcon_array_update_str(&table, SL("methods"), &compiled_methods, PH_COPY);
+
+	if (!file || Z_TYPE_P(file) == IS_NULL) {
+		phalcon_serialize(return_value, &table);
+		zval_ptr_dtor(&table);
+		return;
+	}
+
+	smart_str_appends(&exp, "<?php return ");
+	php_var_export_ex(&table, 0, &exp);
+	smart_str_appendc(&exp, ';');
+	smart_str_0(&exp);
+	zval_ptr_dtor(&table);
+
+	ZVAL_STR(&php_export, exp.s);
+
+	/**
+	 * Write to a private file and rename it, workers never see a half written table
+	 */
+	PHALCON_CALL_FUNCTION(&pid, "getmypid");
+	PHALCON_CONCAT_VSV(&tmp_file, file, ".", &pid);
+
+	phalcon_file_put_contents(&status, &tmp_file, &php_export);
+	zval_ptr_dtor(&php_export);
+	if (PHALCON_IS_FALSE(&status)) {
+		zval_ptr_dtor(&tmp_file);
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_router_exception_ce, "The route table cannot be written");
+		return;
+	}
+
+	PHALCON_CALL_FUNCTION_FLAG(flag, &status, "rename", &tmp_file, file);
+	zval_ptr_dtor(&tmp_file);
+	if (flag == FAILURE) {
+		return;
+	}
+
+	if (!zend_is_true(&status)) {
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_router_exception_ce, "The route table cannot be written");
+		return;
+	}
+
+	if (phalcon_function_exists_ex(SL("opcache_invalidate")) == SUCCESS) {
+		PHALCON_CALL_FUNCTION(NULL, "opcache_invalidate", file, &PHALCON_GLOBAL(z_true));
+	}
+
+	RETURN_TRUE;
+}
+
+/**
+ * Attaches a route table exported by export(), the routes are only created when
+ * they are candidates to match the handled URI. The array returned by a file written with
+ * export($file) is attached as it is, strings are unserialized first
+ *
+ * @param string|array $data
+ * @return Phalcon\Mvc\Router
+ */
+PHP_METHOD(Phalcon_Mvc_Router, fromCache){
+
+	zval *data, table = {}, version = {}, exported_routes = {}, compiled_tree = {}, compiled_methods = {}, routes = {}, *exported_route;
+	zval unique_id = {}, route_id = {};
+	zend_long max_id = -1;
+	ulong idx;
+
+	phalcon_fetch_params(0, 1, 0, &data);
+
+	if (Z_TYPE_P(data) == IS_STRING) {
+		phalcon_unserialize(&table, data);
+	} else {
+		ZVAL_COPY(&table, data);
+	}
+
+	if (Z_TYPE(table) != IS_ARRAY
+		|| !phalcon_array_isset_fetch_str(&version, &table, SL("version"), PH_READONLY)
+		|| !PHALCON_IS_STRING(&version, PHP_PHALCON_VERSION)
+		|| !phalcon_array_isset_fetch_str(&exported_routes, &table, SL("routes"), PH_READONLY)
+		|| !phalcon_array_isset_fetch_str(&compiled_tree, &table, SL("tree"), PH_READONLY)
+		|| !phalcon_array_isset_fetch_str(&compiled_methods, &table, SL("methods"), PH_READONLY)
+		|| Z_TYPE(exported_routes) != IS_ARRAY || Z_TYPE(compiled_tree) != IS_ARRAY) {
+		zval_ptr_dtor(&table);
+		PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_router_exception_ce, "The cached route table is not valid");
+		return;
+	}
+
+	/**
+	 * Only placeholders are created here, the routes are loaded on demand
+	 */
+	array_init_size(&routes, zend_hash_num_elements(Z_ARRVAL(exported_routes)));
+	ZEND_HASH_FOREACH_NUM_KEY_VAL(Z_ARRVAL(exported_routes), idx, exported_route) {
+		phalcon_array_update_long(&routes, idx, &PHALCON_GLOBAL(z_null), PH_COPY);
+		if (phalcon_array_isset_fetch_str(&route_id, exported_route, SL("_id"), PH_READONLY) && Z_TYPE(route_id) == IS_LONG && Z_LVAL(route_id) > max_id) {
+			max_id = Z_LVAL(route_id);
+		}
+	} ZEND_HASH_FOREACH_END();
+
+	phalcon_update_property(getThis(), SL("_routes"), &routes);
+	phalcon_update_property_empty_array(getThis(), SL("_routesNameLookup"));
+	phalcon_update_property(getThis(), SL("_cachedRoutes"), &exported_routes);
+	phalcon_update_property(getThis(), SL("_compiledTree"), &compiled_tree);
+	phalcon_update_property(getThis(), SL("_compiledMethods"), &compiled_methods);
+	phalcon_update_property_bool(getThis(), SL("_autoCompile"), 1);
+	zval_ptr_dtor(&routes);
+	zval_ptr_dtor(&table);
+
+	/**
+	 * Routes added later must not reuse the ids of the cached ones
+	 */
+	phalcon_read_static_property_ce(&unique_id, phalcon_mvc_router_route_ce, SL("_uniqueId"), PH_READONLY);
+	if (Z_TYPE(unique_id) != IS_LONG || Z_LVAL(unique_id) <= max_id) {
+		ZVAL_LONG(&unique_id, max_id + 1);
+		phalcon_update_static_property_ce(phalcon_mvc_router_route_ce, SL("_uniqueId"), &unique_id);
+	}
+
+	RETURN_THIS();
+}
@@ -22,6 +22,16 @@
 
 #include "php_phalcon.h"
 
+#define PHALCON_MVC_ROUTER_METHOD_GET		1
+#define PHALCON_MVC_ROUTER_METHOD_POST		2
+#define PHALCON_MVC_ROUTER_METHOD_PUT		4
+#define PHALCON_MVC_ROUTER_METHOD_PATCH		8
+#define PHALCON_MVC_ROUTER_METHOD_DELETE	16
+#define PHALCON_MVC_ROUTER_METHOD_OPTIONS	32
+#define PHALCON_MVC_ROUTER_METHOD_HEAD		64
+#define PHALCON_MVC_ROUTER_METHOD_OTHER		128
+#define PHALCON_MVC_ROUTER_METHOD_ANY		511 /* Routes without method constraints */
+
 extern zend_class_entry *phalcon_mvc_router_ce;
 
 PHALCON_INIT_CLASS(Phalcon_Mvc_Router);
@@ -43,6 +43,7 @@
 #include "kernel/string.h"
 #include "kernel/file.h"
 #include "kernel/debug.h"
+#include "kernel/variables.h"
 
 #include "internal/arginfo.h"
 
@@ -133,6 +134,10 @@ PHP_METHOD(Phalcon_Mvc_View, enableNamespaceView);
 PHP_METHOD(Phalcon_Mvc_View, disableNamespaceView);
 PHP_METHOD(Phalcon_Mvc_View, enableLowerCase);
 PHP_METHOD(Phalcon_Mvc_View, disableLowerCase);
+PHP_METHOD(Phalcon_Mvc_View, enableStreaming);
+PHP_METHOD(Phalcon_Mvc_View, disableStreaming);
+PHP_METHOD(Phalcon_Mvc_View, isStreaming);
+PHP_METHOD(Phalcon_Mvc_View, getContentChunks);
 PHP_METHOD(Phalcon_Mvc_View, setConverter);
 PHP_METHOD(Phalcon_Mvc_View, getConverter);
 PHP_METHOD(Phalcon_Mvc_View, reset);
@@ -209,6 +214,10 @@ static const zend_function_entry phalcon_mvc_view_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_View, disableNamespaceView, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View, enableLowerCase, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View, disableLowerCase, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_View, enableStreaming, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_View, disableStreaming, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_View, isStreaming, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_View, getContentChunks, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View, setConverter, arginfo_phalcon_mvc_viewinterface_setconverter, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View, getConverter, arginfo_phalcon_mvc_viewinterface_getconverter, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View, reset, NULL, ZEND_ACC_PUBLIC)
@@ -258,6 +267,14 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View){
 	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_disabled"), 0, ZEND_ACC_PROTECTED);
 	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_lowerCase"), 1, ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_view_ce, SL("_converters"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_resolvedPaths"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_pathCache"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_pathCacheKey"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_pathCacheLifetime"), ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_pathCacheChanged"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_statPaths"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_bool(phalcon_mvc_view_ce, SL("_streaming"), 0, ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_ce, SL("_contentChunks"), ZEND_ACC_PROTECTED);
 
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_MAIN_LAYOUT"), 6);
 	zend_declare_class_constant_long(phalcon_mvc_view_ce, SL("LEVEL_AFTER_TEMPLATE"), 5);
@@ -279,6 +296,19 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View){
 /**
  * Phalcon\Mvc\View constructor
  *
+ * The 'pathCache' option keeps the file each view resolved to in a cache service, so later
+ * requests don't probe every views directory and engine extension again:
+ *
+ *<code>
+ * $view = new Phalcon\Mvc\View(array(
+ *     'pathCache' => array(
+ *         'service' => 'viewPathsCache',
+ *         'lifetime' => 86400,
+ *         'stat' => true //Re-check resolved files, useful in development
+ *     )
+ * ));
+ *</code>
+ *
  * @param array $options
  */
 PHP_METHOD(Phalcon_Mvc_View, __construct){
@@ -308,6 +338,7 @@ PHP_METHOD(Phalcon_Mvc_View, setViewsDir){
 	phalcon_fetch_params(0, 1, 0, &views_dir);
 	phalcon_add_trailing_slash(views_dir);
 	phalcon_update_property(getThis(), SL("_viewsDir"), views_dir);
+	phalcon_update_property_null(getThis(), SL("_resolvedPaths"));
 
 	RETURN_THIS();
 }
@@ -420,6 +451,7 @@ PHP_METHOD(Phalcon_Mvc_View, setBasePath){
 		phalcon_add_trailing_slash(base_path);
 		phalcon_update_property(getThis(), SL("_basePath"), base_path);
 	}
+	phalcon_update_property_null(getThis(), SL("_resolvedPaths"));
 
 	RETURN_THIS();
 }
@@ -865,6 +897,7 @@ PHP_METHOD(Phalcon_Mvc_View, getNamespaceName){
 PHP_METHOD(Phalcon_Mvc_View, start){
 
 	phalcon_update_property_null(getThis(), SL("_content"));
+	phalcon_update_property_null(getThis(), SL("_contentChunks"));
 	phalcon_ob_start();
 	RETURN_THIS();
 }
@@ -946,6 +979,215 @@ PHP_METHOD(Phalcon_Mvc_View, _loadTemplateEngines){
 	}
 }
 
+/**
+ * Loads the table of resolved view paths, from the 'pathCache' service when one is configured
+ */
+static int phalcon_mvc_view_load_resolved_paths(zval *object, zval *engines)
+{
+	zval resolved_paths = {}, view_options = {}, path_options = {}, stat = {}, service = {}, dependency_injector = {}, cache = {};
+	zval key = {}, prefix = {}, lifetime = {}, state = {}, extensions = {}, serialized = {}, cached_paths = {}, base_path = {}, views_dir = {};
+	int flag;
+
+	phalcon_read_property(&resolved_paths, object, SL("_resolvedPaths"), PH_READONLY);
+	if (Z_TYPE(resolved_paths) == IS_ARRAY) {
+		return SUCCESS;
+	}
+
+	phalcon_update_property_null(object, SL("_pathCache"));
+	phalcon_update_property_bool(object, SL("_pathCacheChanged"), 0);
+	phalcon_update_property_bool(object, SL("_statPaths"), 0);
+
+	phalcon_read_property(&view_options, object, SL("_options"), PH_READONLY);
+	if (Z_TYPE(view_options) == IS_ARRAY && phalcon_array_isset_fetch_str(&path_options, &view_options, SL("pathCache"), PH_READONLY)) {
+		if (Z_TYPE(path_options) == IS_ARRAY) {
+			if (phalcon_array_isset_fetch_str(&stat, &path_options, SL("stat"), PH_READONLY)) {
+				phalcon_update_property_bool(object, SL("_statPaths"), zend_is_true(&stat));
+			}
+
+			if (phalcon_array_isset_fetch_str(&service, &path_options, SL("service"), PH_READONLY)) {
+				PHALCON_CALL_METHOD_FLAG(flag, &dependency_injector, object, "getdi");
+				if (flag == FAILURE) {
+					return FAILURE;
+				}
+
+				if (Z_TYPE(dependency_injector) != IS_OBJECT) {
+					PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "A dependency injector container is required to obtain the view paths cache");
+					return FAILURE;
+				}
+
+				PHALCON_CALL_METHOD_FLAG(flag, &cache, &dependency_injector, "getshared", &service);
+				zval_ptr_dtor(&dependency_injector);
+				if (flag == FAILURE) {
+					return FAILURE;
+				}
+
+				if (Z_TYPE(cache) != IS_OBJECT || !instanceof_function(Z_OBJCE(cache), phalcon_cache_backendinterface_ce)) {
+					zval_ptr_dtor(&cache);
+					PHALCON_THROW_EXCEPTION_STR(phalcon_mvc_view_exception_ce, "The injected view paths cache service is invalid");
+					return FAILURE;
+				}
+
+				/**
+				 * Each combination of base paths, views directories and engines has its own table
+				 */
+				phalcon_read_property(&base_path, object, SL("_basePath"), PH_READONLY);
+				phalcon_read_property(&views_dir, object, SL("_viewsDir"), PH_READONLY);
+				phalcon_array_keys(&extensions, engines);
+
+				array_init_size(&state, 3);
+				phalcon_array_append(&state, &base_path, PH_COPY);
+				phalcon_array_append(&state, &views_dir, PH_COPY);
+				phalcon_array_append(&state, &extensions, 0);
+
+				phalcon_serialize(&serialized, &state);
+				zval_ptr_dtor(&state);
+
+				if (phalcon_array_isset_fetch_str(&prefix, &path_options, SL("key"), PH_READONLY)) {
+					zval hash = {};
+					phalcon_md5(&hash, &serialized);
+					PHALCON_CONCAT_VSV(&key, &prefix, "-", &hash);
+					zval_ptr_dtor(&hash);
+				} else {
+					zval hash = {};
+					phalcon_md5(&hash, &serialized);
+					PHALCON_CONCAT_SV(&key, "view-paths-", &hash);
+					zval_ptr_dtor(&hash);
+				}
+				zval_ptr_dtor(&serialized);
+
+				if (!phalcon_array_isset_fetch_str(&lifetime, &path_options, SL("lifetime"), PH_READONLY)) {
+					ZVAL_NULL(&lifetime);
+				}
+
+				PHALCON_CALL_METHOD_FLAG(flag, &cached_paths, &cache, "get", &key, &lifetime);
+				if (flag == FAILURE) {
+					zval_ptr_dtor(&key);
+					zval_ptr_dtor(&cache);
+					return FAILURE;
+				}
+
+				phalcon_update_property(object, SL("_pathCache"), &cache);
+				phalcon_update_property(object, SL("_pathCacheKey"), &key);
+				phalcon_update_property(object, SL("_pathCacheLifetime"), &lifetime);
+				zval_ptr_dtor(&key);
+				zval_ptr_dtor(&cache);
+
+				if (Z_TYPE(cached_paths) == IS_ARRAY) {
+					phalcon_update_property(object, SL("_resolvedPaths"), &cached_paths);
+					zval_ptr_dtor(&cached_paths);
+					return SUCCESS;
+				}
+				zval_ptr_dtor(&cached_paths);
+			}
+		}
+	}
+
+	phalcon_update_property_empty_array(object, SL("_resolvedPaths"));
+	return SUCCESS;
+}
+
+/**
+ * Remembers where a view was found, or that it does not exist, the table is written back
+ * to the cache once the view is rendered
+ */
+static int phalcon_mvc_view_store_resolved_path(zval *object, zval *key, zval *resolved_path)
+{
+	zval cache = {};
+
+	phalcon_update_property_array(object, SL("_resolvedPaths"), key, resolved_path);
+
+	phalcon_read_property(&cache, object, SL("_pathCache"), PH_READONLY);
+	if (Z_TYPE(cache) == IS_OBJECT) {
+		phalcon_update_property_bool(object, SL("_pathCacheChanged"), 1);
+	}
+
+	return SUCCESS;
+}
+
+/**
+ * Writes the table of resolved view paths to the 'pathCache' service if new paths were resolved,
+ * also while the view that was rendered is throwing an exception
+ */
+static int phalcon_mvc_view_save_resolved_paths(zval *object)
+{
+	zval changed = {}, cache = {}, resolved_paths = {}, cache_key = {}, lifetime = {};
+	int flag = SUCCESS, pending;
+
+	phalcon_read_property(&changed, object, SL("_pathCacheChanged"), PH_READONLY);
+	if (!zend_is_true(&changed)) {
+		return SUCCESS;
+	}
+
+	phalcon_update_property_bool(object, SL("_pathCacheChanged"), 0);
+
+	phalcon_read_property(&cache, object, SL("_pathCache"), PH_READONLY);
+	if (Z_TYPE(cache) == IS_OBJECT) {
+		phalcon_read_property(&resolved_paths, object, SL("_resolvedPaths"), PH_READONLY);
+		phalcon_read_property(&cache_key, object, SL("_pathCacheKey"), PH_READONLY);
+		phalcon_read_property(&lifetime, object, SL("_pathCacheLifetime"), PH_READONLY);
+
+		pending = EG(exception) != NULL;
+		if (pending) {
+			zend_exception_save();
+		}
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &cache, "save", &cache_key, &resolved_paths, &lifetime);
+		if (pending) {
+			zend_exception_restore();
+		}
+	}
+
+	return flag;
+}
+
+/**
+ * Renders a view file with an engine, returns 1 if the file was rendered and 0 if a
+ * beforeRenderView listener skipped it
+ */
+static int phalcon_mvc_view_render_path(zval *object, zval *engine, zval *view_engine_path, zval *view_params, zval *must_clean)
+{
+	zval debug_message = {}, event_name = {}, status = {};
+	int flag;
+
+	phalcon_update_property(object, SL("_activeRenderPath"), view_engine_path);
+	if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
+		PHALCON_CONCAT_SV(&debug_message, "--Found: ", view_engine_path);
+		PHALCON_DEBUG_LOG(&debug_message);
+		zval_ptr_dtor(&debug_message);
+	}
+
+	/**
+	 * Call beforeRenderView if there is a events manager available
+	 */
+	ZVAL_STRING(&event_name, "view:beforeRenderView");
+	PHALCON_CALL_METHOD_FLAG(flag, &status, object, "fireeventcancel", &event_name, view_engine_path);
+	zval_ptr_dtor(&event_name);
+	if (flag == FAILURE) {
+		return -1;
+	}
+
+	if (PHALCON_IS_FALSE(&status)) {
+		return 0;
+	}
+	zval_ptr_dtor(&status);
+
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, engine, "render", view_engine_path, view_params, must_clean);
+	if (flag == FAILURE) {
+		return -1;
+	}
+
+	/**
+	 * Call afterRenderView if there is a events manager available
+	 */
+	ZVAL_STRING(&event_name, "view:afterRenderView");
+	PHALCON_CALL_METHOD_FLAG(flag, NULL, object, "fireevent", &event_name);
+	zval_ptr_dtor(&event_name);
+	if (flag == FAILURE) {
+		return -1;
+	}
+
+	return 1;
+}
+
 /**
  * Checks whether view exists on registered extensions and render it
  *
@@ -959,8 +1201,10 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 	zval *engines, *view_path, *silence, *must_clean, *absolute_path = NULL, debug_message = {}, render_level = {}, cache_level = {};
 	zval cache_mode = {}, cache = {}, not_exists = {}, views_dir_paths = {}, base_path = {}, views_dir = {}, *path;
 	zval key = {}, lifetime = {}, view_options = {}, cache_options = {}, cached_view = {};
-	zval view_params = {}, *engine, event_name = {}, status = {}, exception_message = {};
+	zval view_params = {}, *engine, event_name = {}, exception_message = {};
+	zval stat_paths = {}, resolved_paths = {}, resolve_key = {}, resolved_path = {}, resolved_file = {}, skip_path = {};
 	zend_string *str_key;
+	int probe = 1, found = 0, rendered = 0, flag;
 
 	phalcon_fetch_params(0, 4, 1, &engines, &view_path, &silence, &must_clean, &absolute_path);
 
@@ -1070,6 +1314,10 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 		PHALCON_CALL_METHOD(&cached_view, &cache, "start", &key, &lifetime, &PHALCON_GLOBAL(z_true));
 		zval_ptr_dtor(&key);
 		if (Z_TYPE(cached_view) != IS_NULL) {
+			/**
+			 * The cached output replaces whatever was streamed so far
+			 */
+			phalcon_update_property_null(getThis(), SL("_contentChunks"));
 			phalcon_update_property(getThis(), SL("_content"), &cached_view);
 			zval_ptr_dtor(&cached_view);
 			zval_ptr_dtor(&cache);
@@ -1086,68 +1334,135 @@ PHP_METHOD(Phalcon_Mvc_View, _engineRender){
 	phalcon_read_property(&view_params, getThis(), SL("_viewParams"), PH_NOISY|PH_READONLY);
 
 	/**
-	 * Views are rendered in each engine
+	 * Views already resolved are rendered straight from the path found the first time
 	 */
-	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(engines), str_key, engine) {
-		zval extension = {};
-		if (!str_key) {
-			continue;
-		}
-		ZVAL_STR(&extension, str_key);
-		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(views_dir_paths), path) {
-			zval view_engine_path = {};
-			PHALCON_CONCAT_VV(&view_engine_path, path, &extension);
-
-			if (phalcon_file_exists(&view_engine_path) != SUCCESS) {
-				if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
-					PHALCON_CONCAT_SV(&debug_message, "--Not Found: ", &view_engine_path);
-					PHALCON_DEBUG_LOG(&debug_message);
-					zval_ptr_dtor(&debug_message);
+	if (phalcon_mvc_view_load_resolved_paths(getThis(), engines) == FAILURE) {
+		goto end;
+	}
+
+	phalcon_read_property(&stat_paths, getThis(), SL("_statPaths"), PH_READONLY);
+	phalcon_read_property(&resolved_paths, getThis(), SL("_resolvedPaths"), PH_READONLY);
+	if (zend_is_true(absolute_path)) {
+		PHALCON_CONCAT_SV(&resolve_key, "a:", view_path);
+	} else {
+		PHALCON_CONCAT_SV(&resolve_key, "r:", view_path);
+	}
+
+	if (phalcon_array_isset_fetch(&resolved_path, &resolved_paths, &resolve_key, PH_COPY)) {
+		if (Z_TYPE(resolved_path) == IS_ARRAY) {
+			zval resolved_extension = {};
+			phalcon_array_fetch_long(&resolved_extension, &resolved_path, 0, PH_NOISY|PH_READONLY);
+			phalcon_array_fetch_long(&resolved_file, &resolved_path, 1, PH_NOISY|PH_READONLY);
+
+			if (Z_TYPE(resolved_extension) == IS_STRING && (engine = zend_hash_find(Z_ARRVAL_P(engines), Z_STR(resolved_extension))) != NULL) {
+				if (!zend_is_true(&stat_paths) || phalcon_file_exists(&resolved_file) == SUCCESS) {
+					rendered = phalcon_mvc_view_render_path(getThis(), engine, &resolved_file, &view_params, must_clean);
+					if (rendered < 0) {
+						goto end;
+					}
+
+					/**
+					 * If a listener skipped it the other candidates are still checked
+					 */
+					probe = rendered ? 0 : 1;
+					ZVAL_COPY_VALUE(&skip_path, &resolved_file);
 				}
-				zval_ptr_dtor(&view_engine_path);
-				continue;
 			}
+		} else if (!zend_is_true(&stat_paths)) {
+			probe = 0;
+		}
+	}
 
-			phalcon_update_property(getThis(), SL("_activeRenderPath"), &view_engine_path);
-			if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
-				PHALCON_CONCAT_SV(&debug_message, "--Found: ", &view_engine_path);
-				PHALCON_DEBUG_LOG(&debug_message);
-				zval_ptr_dtor(&debug_message);
+	/**
+	 * Views are rendered in each engine
+	 */
+	if (probe) {
+		ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(engines), str_key, engine) {
+			zval extension = {};
+			if (!str_key) {
+				continue;
 			}
+			ZVAL_STR(&extension, str_key);
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(views_dir_paths), path) {
+				zval view_engine_path = {};
+				PHALCON_CONCAT_VV(&view_engine_path, path, &extension);
+
+				if (Z_TYPE(skip_path) == IS_STRING && zend_is_identical(&view_engine_path, &skip_path)) {
+					zval_ptr_dtor(&view_engine_path);
+					found = 1;
+					continue;
+				}
 
-			/**
-			 * Call beforeRenderView if there is a events manager available
-			 */
-			ZVAL_STRING(&event_name, "view:beforeRenderView");
-			PHALCON_CALL_METHOD(&status, getThis(), "fireeventcancel", &event_name, &view_engine_path);
-			zval_ptr_dtor(&event_name);
+				if (phalcon_file_exists(&view_engine_path) != SUCCESS) {
+					if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
+						PHALCON_CONCAT_SV(&debug_message, "--Not Found: ", &view_engine_path);
+						PHALCON_DEBUG_LOG(&debug_message);
+						zval_ptr_dtor(&debug_message);
+					}
+					zval_ptr_dtor(&view_engine_path);
+					continue;
+				}
 
-			if (PHALCON_IS_FALSE(&status)) {
-				zval_ptr_dtor(&view_engine_path);
-				continue;
-			}
-			zval_ptr_dtor(&status);
+				/**
+				 * The first file found is the one the next renders go to
+				 */
+				if (!found) {
+					zval resolved = {};
+					found = 1;
+
+					array_init_size(&resolved, 2);
+					phalcon_array_append(&resolved, &extension, PH_COPY);
+					phalcon_array_append(&resolved, &view_engine_path, PH_COPY);
+					flag = phalcon_mvc_view_store_resolved_path(getThis(), &resolve_key, &resolved);
+					zval_ptr_dtor(&resolved);
+					if (flag == FAILURE) {
+						zval_ptr_dtor(&view_engine_path);
+						goto end;
+					}
+				}
 
-			PHALCON_CALL_METHOD(NULL, engine, "render", &view_engine_path, &view_params, must_clean);
-			zval_ptr_dtor(&view_engine_path);
+				rendered = phalcon_mvc_view_render_path(getThis(), engine, &view_engine_path, &view_params, must_clean);
+				zval_ptr_dtor(&view_engine_path);
+				if (rendered < 0) {
+					goto end;
+				}
 
-			/**
-			 * Call afterRenderView if there is a events manager available
-			 */
-			ZVAL_FALSE(&not_exists);
+				if (rendered) {
+					break;
+				}
+			} ZEND_HASH_FOREACH_END();
 
-			ZVAL_STRING(&event_name, "view:afterRenderView");
-			PHALCON_CALL_METHOD(NULL, getThis(), "fireevent", &event_name);
-			zval_ptr_dtor(&event_name);
-			break;
+			if (rendered) {
+				break;
+			}
 		} ZEND_HASH_FOREACH_END();
 
-		if (!zend_is_true(&not_exists)) {
-			break;
+		if (!found && (Z_TYPE(resolved_path) == IS_UNDEF || Z_TYPE(resolved_path) == IS_ARRAY)) {
+			if (phalcon_mvc_view_store_resolved_path(getThis(), &resolve_key, &PHALCON_GLOBAL(z_false)) == FAILURE) {
+				goto end;
+			}
 		}
-	} ZEND_HASH_FOREACH_END();
+	}
+
+	if (rendered) {
+		ZVAL_FALSE(&not_exists);
+	}
+
+end:
+	zval_ptr_dtor(&resolved_path);
+	zval_ptr_dtor(&resolve_key);
 	zval_ptr_dtor(&views_dir_paths);
 
+	/**
+	 * The paths resolved here are written back to the cache whatever the view did
+	 */
+	phalcon_mvc_view_save_resolved_paths(getThis());
+
+	if (EG(exception)) {
+		zval_ptr_dtor(&cache);
+		return;
+	}
+
 	if (PHALCON_IS_TRUE(&not_exists)) {
 		if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) {
 			ZVAL_STRING(&debug_message, "--Not Found View");
@@ -1216,6 +1531,7 @@ PHP_METHOD(Phalcon_Mvc_View, registerEngines){
 		return;
 	}
 	phalcon_update_property(getThis(), SL("_registeredEngines"), engines);
+	phalcon_update_property_null(getThis(), SL("_resolvedPaths"));
 
 	RETURN_THIS();
 }
@@ -1499,6 +1815,7 @@ PHP_METHOD(Phalcon_Mvc_View, render){
 			zval model_content = {};
 			PHALCON_CALL_METHOD(NULL, view_model, "setview", getThis());
 			PHALCON_CALL_METHOD(&model_content, view_model, "render");
+			phalcon_update_property_null(getThis(), SL("_contentChunks"));
 			phalcon_update_property(getThis(), SL("_content"), &model_content);
 			zval_ptr_dtor(&model_content);
 		}
@@ -2015,12 +2332,25 @@ PHP_METHOD(Phalcon_Mvc_View, setContent){
 	}
 
 	if (append && Z_TYPE_P(append) == IS_TRUE) {
-		zval old_content = {}, new_content = {};
+		zval old_content = {}, new_content = {}, content_chunks = {};
+
+		/**
+		 * Streamed content grows by one more chunk instead of being copied
+		 */
+		phalcon_read_property(&content_chunks, getThis(), SL("_contentChunks"), PH_READONLY);
+		if (Z_TYPE(content_chunks) == IS_ARRAY) {
+			if (Z_STRLEN_P(content)) {
+				phalcon_update_property_array_append(getThis(), SL("_contentChunks"), content);
+			}
+			RETURN_THIS();
+		}
+
 		phalcon_read_property(&old_content, getThis(), SL("_content"), PH_NOISY|PH_READONLY);
 		PHALCON_CONCAT_VV(&new_content, &old_content, content);
 		phalcon_update_property(getThis(), SL("_content"), &new_content);
 		zval_ptr_dtor(&new_content);
 	} else {
+		phalcon_update_property_null(getThis(), SL("_contentChunks"));
 		phalcon_update_property(getThis(), SL("_content"), content);
 	}
 
@@ -2028,12 +2358,21 @@ PHP_METHOD(Phalcon_Mvc_View, setContent){
 }
 
 /**
- * Returns cached output from another view stage
+ * Returns cached output from another view stage, streamed content is joined the first time it is requested
  *
  * @return string
  */
 PHP_METHOD(Phalcon_Mvc_View, getContent){
 
+	zval content_chunks = {}, content = {};
+
+	phalcon_read_property(&content_chunks, getThis(), SL("_contentChunks"), PH_READONLY);
+	if (Z_TYPE(content_chunks) == IS_ARRAY) {
+		phalcon_fast_join_str(&content, SL(""), &content_chunks);
+		phalcon_update_property(getThis(), SL("_content"), &content);
+		phalcon_update_property_null(getThis(), SL("_contentChunks"));
+		RETURN_ZVAL(&content, 0, 0);
+	}
 
 	RETURN_MEMBER(getThis(), "_content");
 }
@@ -2190,6 +2529,70 @@ PHP_METHOD(Phalcon_Mvc_View, disableLowerCase){
 	RETURN_THIS();
 }
 
+/**
+ * Enables streaming render. Each level keeps the fragments it rendered as a list of strings
+ * instead of one string. Layouts rendered by Phalcon\Mvc\View\Engine\Php that output the
+ * previous level with $this->content() reference its fragments rather than copy them, and
+ * Phalcon\Mvc\Application hands the fragments to the response which writes them one by one.
+ *
+ *<code>
+ * $view->enableStreaming();
+ *
+ * //app/views/index.phtml
+ * <html><?php $this->content() ?></html>
+ *</code>
+ *
+ * @return Phalcon\Mvc\View
+ */
+PHP_METHOD(Phalcon_Mvc_View, enableStreaming){
+
+	phalcon_update_property_bool(getThis(), SL("_streaming"), 1);
+	RETURN_THIS();
+}
+
+/**
+ * Disables streaming render
+ *
+ * @return Phalcon\Mvc\View
+ */
+PHP_METHOD(Phalcon_Mvc_View, disableStreaming){
+
+	phalcon_update_property_bool(getThis(), SL("_streaming"), 0);
+	RETURN_THIS();
+}
+
+/**
+ * Whether the view is rendered in streaming mode
+ *
+ * @return boolean
+ */
+PHP_METHOD(Phalcon_Mvc_View, isStreaming){
+
+	RETURN_MEMBER(getThis(), "_streaming");
+}
+
+/**
+ * Returns the rendered content as a list of fragments, without joining them
+ *
+ * @return array
+ */
+PHP_METHOD(Phalcon_Mvc_View, getContentChunks){
+
+	zval content_chunks = {}, content = {};
+
+	phalcon_read_property(&content_chunks, getThis(), SL("_contentChunks"), PH_READONLY);
+	if (Z_TYPE(content_chunks) == IS_ARRAY) {
+		RETURN_ZVAL(&content_chunks, 1, 0);
+	}
+
+	array_init(return_value);
+
+	phalcon_read_property(&content, getThis(), SL("_content"), PH_READONLY);
+	if (Z_TYPE(content) == IS_STRING && Z_STRLEN(content)) {
+		phalcon_array_append(return_value, &content, PH_COPY);
+	}
+}
+
 /**
  * Adds a converter
  *
@@ -2245,6 +2648,7 @@ PHP_METHOD(Phalcon_Mvc_View, reset){
 	phalcon_update_property_long(getThis(), SL("_renderLevel"), 5);
 	phalcon_update_property(getThis(), SL("_cacheLevel"), &PHALCON_GLOBAL(z_zero));
 	phalcon_update_property(getThis(), SL("_content"), &PHALCON_GLOBAL(z_null));
+	phalcon_update_property(getThis(), SL("_contentChunks"), &PHALCON_GLOBAL(z_null));
 	phalcon_update_property_empty_array(getThis(), SL("_sections"));
 	phalcon_update_property(getThis(), SL("_templatesBefore"), &PHALCON_GLOBAL(z_null));
 	phalcon_update_property(getThis(), SL("_templatesAfter"), &PHALCON_GLOBAL(z_null));
@@ -33,6 +33,7 @@
 #include "kernel/concat.h"
 #include "kernel/operators.h"
 #include "kernel/exception.h"
+#include "kernel/output.h"
 
 #include "interned-strings.h"
 
@@ -46,6 +47,7 @@ zend_class_entry *phalcon_mvc_view_engine_ce;
 
 PHP_METHOD(Phalcon_Mvc_View_Engine, __construct);
 PHP_METHOD(Phalcon_Mvc_View_Engine, getContent);
+PHP_METHOD(Phalcon_Mvc_View_Engine, content);
 PHP_METHOD(Phalcon_Mvc_View_Engine, startSection);
 PHP_METHOD(Phalcon_Mvc_View_Engine, stopSection);
 PHP_METHOD(Phalcon_Mvc_View_Engine, section);
@@ -62,6 +64,7 @@ ZEND_END_ARG_INFO()
 static const zend_function_entry phalcon_mvc_view_engine_method_entry[] = {
 	PHP_ME(Phalcon_Mvc_View_Engine, __construct, arginfo_phalcon_mvc_view_engine___construct, ZEND_ACC_PUBLIC|ZEND_ACC_CTOR)
 	PHP_ME(Phalcon_Mvc_View_Engine, getContent, NULL, ZEND_ACC_PUBLIC)
+	PHP_ME(Phalcon_Mvc_View_Engine, content, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View_Engine, startSection, arginfo_phalcon_mvc_view_engineinterface_startsection, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View_Engine, stopSection, NULL, ZEND_ACC_PUBLIC)
 	PHP_ME(Phalcon_Mvc_View_Engine, section, arginfo_phalcon_mvc_view_engineinterface_section, ZEND_ACC_PUBLIC)
@@ -83,6 +86,8 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View_Engine){
 	zend_declare_property_null(phalcon_mvc_view_engine_ce, SL("_layout"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_view_engine_ce, SL("_params"), ZEND_ACC_PROTECTED);
 	zend_declare_property_null(phalcon_mvc_view_engine_ce, SL("_methods"), ZEND_ACC_PROTECTED);
+	zend_declare_property_null(phalcon_mvc_view_engine_ce, SL("_chunks"), ZEND_ACC_PROTECTED);
+	zend_declare_property_long(phalcon_mvc_view_engine_ce, SL("_chunksLevel"), 0, ZEND_ACC_PROTECTED);
 
 	zend_class_implements(phalcon_mvc_view_engine_ce, 1, phalcon_mvc_view_engineinterface_ce);
 
@@ -120,6 +125,45 @@ PHP_METHOD(Phalcon_Mvc_View_Engine, getContent){
 	PHALCON_RETURN_CALL_METHOD(&view, "getcontent");
 }
 
+/**
+ * Outputs the content of the previous view stage. When the view is streaming, the fragments
+ * of the previous stage are referenced by the current one instead of being copied into the
+ * output buffer
+ */
+PHP_METHOD(Phalcon_Mvc_View_Engine, content){
+
+	zval view = {}, chunks = {}, chunks_level = {}, head = {}, content_chunks = {}, *chunk, content = {};
+
+	phalcon_read_property(&view, getThis(), SL("_view"), PH_NOISY|PH_READONLY);
+	phalcon_read_property(&chunks, getThis(), SL("_chunks"), PH_READONLY);
+	phalcon_read_property(&chunks_level, getThis(), SL("_chunksLevel"), PH_READONLY);
+
+	/**
+	 * Only splice when the template did not open buffers of its own
+	 */
+	if (Z_TYPE(chunks) == IS_ARRAY && phalcon_ob_get_level() == phalcon_get_intval(&chunks_level)) {
+		phalcon_ob_get_contents(&head);
+		phalcon_ob_clean();
+		if (Z_TYPE(head) == IS_STRING && Z_STRLEN(head)) {
+			phalcon_update_property_array_append(getThis(), SL("_chunks"), &head);
+		}
+		zval_ptr_dtor(&head);
+
+		PHALCON_CALL_METHOD(&content_chunks, &view, "getcontentchunks");
+		if (Z_TYPE(content_chunks) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(content_chunks), chunk) {
+				phalcon_update_property_array_append(getThis(), SL("_chunks"), chunk);
+			} ZEND_HASH_FOREACH_END();
+		}
+		zval_ptr_dtor(&content_chunks);
+		return;
+	}
+
+	PHALCON_CALL_METHOD(&content, &view, "getcontent");
+	zend_print_zval(&content, 0);
+	zval_ptr_dtor(&content);
+}
+
 /**
  * Start a new section block
  *
@@ -20,6 +20,7 @@
 #include "mvc/view/engine/php.h"
 #include "mvc/view/engine.h"
 #include "mvc/view/engineinterface.h"
+#include "mvc/view.h"
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -67,10 +68,11 @@ PHALCON_INIT_CLASS(Phalcon_Mvc_View_Engine_Php){
 PHP_METHOD(Phalcon_Mvc_View_Engine_Php, render){
 
 	zval *path, *params, *must_clean = NULL, *partial = NULL, contents = {}, view = {}, *value = NULL;
+	zval streaming = {}, chunks = {}, previous_chunks = {}, previous_level = {};
 	zend_string *str_key;
 	zend_array *symbol_table;
 	ulong idx;
-	int clean = 0;
+	int clean = 0, stream = 0, flag;
 
 	phalcon_fetch_params(0, 2, 2, &path, &params, &must_clean, &partial);
 
@@ -90,6 +92,23 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Php, render){
 		}
 
 		phalcon_ob_clean();
+
+		/**
+		 * A streaming view collects the fragments of this stage, $this->content() adds the
+		 * previous stage to them by reference
+		 */
+		phalcon_read_property(&view, getThis(), SL("_view"), PH_NOISY|PH_READONLY);
+		if (Z_TYPE(view) == IS_OBJECT && instanceof_function(Z_OBJCE(view), phalcon_mvc_view_ce)) {
+			phalcon_read_property(&streaming, &view, SL("_streaming"), PH_READONLY);
+			stream = zend_is_true(&streaming);
+		}
+
+		if (stream) {
+			phalcon_read_property(&previous_chunks, getThis(), SL("_chunks"), PH_COPY);
+			phalcon_read_property(&previous_level, getThis(), SL("_chunksLevel"), PH_COPY);
+			phalcon_update_property_empty_array(getThis(), SL("_chunks"));
+			phalcon_update_property_long(getThis(), SL("_chunksLevel"), phalcon_ob_get_level());
+		}
 	}
 
 	// phalcon_exec_file(NULL, getThis(), path, params);
@@ -122,14 +141,34 @@ PHP_METHOD(Phalcon_Mvc_View_Engine_Php, render){
 		phalcon_ob_get_contents(&contents);
 		phalcon_ob_clean();
 
-		phalcon_read_property(&view, getThis(), SL("_view"), PH_NOISY|PH_READONLY);
-		PHALCON_CALL_METHOD(NULL, &view, "setcontent", &contents);
-		zval_ptr_dtor(&contents);
+		if (stream) {
+			if (Z_TYPE(contents) == IS_STRING && Z_STRLEN(contents)) {
+				phalcon_update_property_array_append(getThis(), SL("_chunks"), &contents);
+			}
+			zval_ptr_dtor(&contents);
+
+			phalcon_read_property(&chunks, getThis(), SL("_chunks"), PH_READONLY);
+			phalcon_update_property(&view, SL("_contentChunks"), &chunks);
+			phalcon_update_property_str(&view, SL("_content"), SL(""));
+		} else {
+			PHALCON_CALL_METHOD_FLAG(flag, NULL, &view, "setcontent", &contents);
+			zval_ptr_dtor(&contents);
+			if (flag == FAILURE) {
+				goto end;
+			}
+		}
 	}
 
 	ZVAL_TRUE(return_value);
 
 end:
+	if (stream) {
+		phalcon_update_property(getThis(), SL("_chunks"), &previous_chunks);
+		phalcon_update_property(getThis(), SL("_chunksLevel"), &previous_level);
+		zval_ptr_dtor(&previous_chunks);
+		zval_ptr_dtor(&previous_level);
+	}
+
 	if (Z_TYPE_P(params) == IS_ARRAY) {
 		ZEND_HASH_FOREACH_KEY(Z_ARRVAL_P(params), idx, str_key) {
 			zval key = {};
@@ -80,6 +80,12 @@ PHP_INI_BEGIN()
 	STD_PHP_INI_BOOLEAN("phalcon.orm.enable_auto_convert",      "1",    PHP_INI_ALL,    OnUpdateBool, orm.enable_auto_convert,      zend_phalcon_globals, phalcon_globals)
 	STD_PHP_INI_BOOLEAN("phalcon.orm.allow_update_primary",     "0",    PHP_INI_ALL,    OnUpdateBool, orm.allow_update_primary,     zend_phalcon_globals, phalcon_globals)
 	STD_PHP_INI_BOOLEAN("phalcon.orm.enable_strict",            "0",    PHP_INI_ALL,    OnUpdateBool, orm.enable_strict,            zend_phalcon_globals, phalcon_globals)
+	/* Enables/Disables keeping a snapshot of the fetched data in every record */
+	STD_PHP_INI_BOOLEAN("phalcon.orm.enable_snapshots",         "1",    PHP_INI_ALL,    OnUpdateBool, orm.enable_snapshots,         zend_phalcon_globals, phalcon_globals)
+	/* Enables/Disables reusing the compiled SQL of PHQL SELECT statements */
+	STD_PHP_INI_BOOLEAN("phalcon.orm.enable_plan_cache",        "1",    PHP_INI_ALL,    OnUpdateBool, orm.enable_plan_cache,        zend_phalcon_globals, phalcon_globals)
+	/* Enables/Disables the PHQL AST cache shared between processes (requires yac) */
+	STD_PHP_INI_BOOLEAN("phalcon.orm.enable_shared_ast_cache",  "0",    PHP_INI_ALL,    OnUpdateBool, orm.enable_shared_ast_cache,  zend_phalcon_globals, phalcon_globals)
 	/* Enables/Disables allow empty */
 	STD_PHP_INI_BOOLEAN("phalcon.validation.allow_empty",       "0",    PHP_INI_ALL,    OnUpdateBool, validation.allow_empty,       zend_phalcon_globals, phalcon_globals)
 	/* Enables/Disables auttomatic escape */
@@ -446,6 +452,7 @@ static PHP_MINIT_FUNCTION(phalcon)
 	PHALCON_INIT(Phalcon_Db_Profiler);
 	PHALCON_INIT(Phalcon_Db_Profiler_Item);
 	PHALCON_INIT(Phalcon_Db_RawValue);
+	PHALCON_INIT(Phalcon_Db_Pool);
 	PHALCON_INIT(Phalcon_Db_Reference);
 	PHALCON_INIT(Phalcon_Db_Result_Pdo);
 	PHALCON_INIT(Phalcon_Kernel);
@@ -473,6 +480,7 @@ static PHP_MINIT_FUNCTION(phalcon)
 	PHALCON_INIT(Phalcon_Annotations_Adapter_Files);
 	PHALCON_INIT(Phalcon_Annotations_Adapter_Memory);
 	PHALCON_INIT(Phalcon_Annotations_Adapter_Cache);
+	PHALCON_INIT(Phalcon_Annotations_Adapter_Yac);
 	PHALCON_INIT(Phalcon_Loader);
 	PHALCON_INIT(Phalcon_Logger);
 	PHALCON_INIT(Phalcon_Logger_Item);
@@ -554,6 +562,7 @@ static PHP_MINIT_FUNCTION(phalcon)
 	PHALCON_INIT(Phalcon_Mvc_Model_Resultset);
 	PHALCON_INIT(Phalcon_Mvc_Model_Behavior);
 	PHALCON_INIT(Phalcon_Mvc_Model_Row);
+	PHALCON_INIT(Phalcon_Mvc_Model_Row_Columnar);
 	PHALCON_INIT(Phalcon_Mvc_Model_Query);
 	PHALCON_INIT(Phalcon_Mvc_Micro_Collection);
 	PHALCON_INIT(Phalcon_Mvc_Micro_LazyLoader);
@@ -583,6 +592,7 @@ static PHP_MINIT_FUNCTION(phalcon)
 #endif
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Cache);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Memory);
+	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Snapshot);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Strategy_Annotations);
 	PHALCON_INIT(Phalcon_Mvc_Model_MetaData_Strategy_Introspection);
 	PHALCON_INIT(Phalcon_Mvc_Model_Transaction);
@@ -715,6 +725,7 @@ static PHP_MSHUTDOWN_FUNCTION(phalcon){
 	phalcon_deinitialize_memory();
 
 	assert(PHALCON_GLOBAL(orm).ast_cache == NULL);
+	assert(PHALCON_GLOBAL(orm).plan_cache == NULL);
 #ifdef PHALCON_CACHE_YAC
 	if (PHALCON_GLOBAL(cache).enable_yac) {
 		phalcon_cache_yac_storage_shutdown();
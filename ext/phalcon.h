@@ -25,6 +25,7 @@
 #include "annotations/adapter.h"
 #include "annotations/adapterinterface.h"
 #include "annotations/adapter/apc.h"
+#include "annotations/adapter/yac.h"
 #include "annotations/adapter/files.h"
 #include "annotations/adapter/memory.h"
 #include "annotations/adapter/cache.h"
@@ -107,6 +108,7 @@
 #include "db/profiler.h"
 #include "db/profiler/item.h"
 #include "db/rawvalue.h"
+#include "db/pool.h"
 #include "db/reference.h"
 #include "db/referenceinterface.h"
 #include "db/resultinterface.h"
@@ -281,6 +283,7 @@
 #include "mvc/model/metadata/apc.h"
 #include "mvc/model/metadata/files.h"
 #include "mvc/model/metadata/memory.h"
+#include "mvc/model/metadata/snapshot.h"
 #include "mvc/model/metadata/session.h"
 #include "mvc/model/metadata/memcached.h"
 #include "mvc/model/metadata/redis.h"
@@ -310,6 +313,7 @@
 #include "mvc/model/resultset/complex.h"
 #include "mvc/model/resultset/simple.h"
 #include "mvc/model/row.h"
+#include "mvc/model/row/columnar.h"
 #include "mvc/model/transaction.h"
 #include "mvc/model/transactioninterface.h"
 #include "mvc/model/transaction/exception.h"
@@ -50,6 +50,8 @@ typedef struct _phalcon_debug_options {
 /** ORM options */
 typedef struct _phalcon_orm_options {
 	HashTable *ast_cache;
+	HashTable *plan_cache;
+	long plan_id;
 	int cache_level;
 	zend_bool events;
 	zend_bool virtual_foreign_keys;
@@ -58,10 +60,13 @@ typedef struct _phalcon_orm_options {
 	zend_bool exception_on_failed_save;
 	zend_bool enable_literals;
 	zend_bool enable_ast_cache;
+	zend_bool enable_shared_ast_cache;
 	zend_bool enable_property_method;
 	zend_bool enable_auto_convert;
 	zend_bool allow_update_primary;
 	zend_bool enable_strict;
+	zend_bool enable_snapshots;
+	zend_bool enable_plan_cache;
 } phalcon_orm_options;
 
 /** Validation options */
@@ -131,8 +131,15 @@ struct phalcon_server_context_pool *phalcon_server_init_pool(int size)
 
 void phalcon_server_free_pool(struct phalcon_server_context_pool *pool)
 {
+	int i;
+
 	if (pool) {
 		if (pool->arr) {
+			for (i = 0; i < pool->total; i++) {
+				if (pool->arr[i].out) {
+					free(pool->arr[i].out);
+				}
+			}
 			free(pool->arr);
 		}
 		free(pool);
@@ -151,7 +158,11 @@ struct phalcon_server_conn_context *phalcon_server_alloc_context(struct phalcon_
 
 	ret->fd = 0;
 	ret->fd_added = 0;
+	ret->flags = 0;
 	ret->next_idx = -1;
+	ret->user_data = NULL;
+	ret->out_head = 0;
+	ret->out_num = 0;
 
 	ret->pool = pool;
 
@@ -206,6 +217,13 @@ int phalcon_server_init_single_server(struct phalcon_server_context *ctx, struct
 		phalcon_server_exit_cleanup(ctx);
 	}
 
+#ifdef SO_REUSEPORT
+	if (ctx->reuse_port && setsockopt(serverfd, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) == -1) {
+		perror("Unable to set socket reuseport option");
+		phalcon_server_exit_cleanup(ctx);
+	}
+#endif
+
 	memset(&addr, 0, addrlen);
 	addr.sin_family = AF_INET;
 	addr.sin_port = htons(port);
@@ -233,7 +251,8 @@ void phalcon_server_init_server(struct phalcon_server_context *ctx)
 	assert(ctx->start_cpu >= 0 && ctx->start_cpu < phalcon_server_get_cpu_num());
 	assert(ctx->start_cpu <= phalcon_server_get_cpu_num() - ctx->start_cpu);
 
-	for (i = 0; i < ctx->la_num; i++){
+	/* With SO_REUSEPORT every worker opens its own listener, the kernel then spreads connections over the per-worker accept queues */
+	for (i = 0; !ctx->reuse_port && i < ctx->la_num; i++){
 		struct in_addr ip;
 		uint16_t port;
 
@@ -338,6 +357,15 @@ void phalcon_server_process_clients(struct phalcon_server_context *ctx, void *ar
 		phalcon_server_exit_cleanup(ctx);
 	}
 
+	if (ctx->reuse_port) {
+		for (i = 0; i < ctx->la_num; i++) {
+			ctx->la[i].listen_fd = phalcon_server_init_single_server(ctx, ctx->la[i].listenip, ctx->la[i].param_port);
+		}
+	}
+#if PHALCON_USE_THREADPOOL
+	FD_ZERO(&listen_fds);
+#endif
+
 	ctx->pool = phalcon_server_init_pool(PHALCON_SERVER_MAX_CONNS_PER_WORKER);
 
 	if ((ep_fd = epoll_create(PHALCON_SERVER_MAX_CONNS_PER_WORKER)) < 0) {
@@ -354,6 +382,12 @@ void phalcon_server_process_clients(struct phalcon_server_context *ctx, void *ar
 		listen_ctx->ep_fd = ep_fd;
 
 		evt.events = EPOLLIN | EPOLLHUP | EPOLLERR;
+#ifdef EPOLLEXCLUSIVE
+		/* Only needed when the listener is shared, a private SO_REUSEPORT socket has a single waiter */
+		if (ctx->exclusive && !ctx->reuse_port) {
+			evt.events |= EPOLLEXCLUSIVE;
+		}
+#endif
 		evt.data.ptr = listen_ctx;
 
 		if (epoll_ctl(listen_ctx->ep_fd, EPOLL_CTL_ADD, listen_ctx->fd, &evt) < 0) {
@@ -476,6 +510,150 @@ void phalcon_server_client_close(struct phalcon_server_conn_context *ctx)
 	close(fd);
 }
 
+static struct phalcon_server_output *phalcon_server_output_alloc(struct phalcon_server_conn_context *client_ctx)
+{
+	struct phalcon_server_output *out;
+
+	if (client_ctx->out_num == client_ctx->out_size) {
+		client_ctx->out_size = client_ctx->out_size ? client_ctx->out_size * 2 : 8;
+		client_ctx->out = realloc(client_ctx->out, sizeof(struct phalcon_server_output) * client_ctx->out_size);
+		assert(client_ctx->out);
+	}
+
+	out = &client_ctx->out[client_ctx->out_num++];
+	memset(out, 0, sizeof(struct phalcon_server_output));
+	out->fd = -1;
+
+	return out;
+}
+
+/**
+ * Queues a string, the connection keeps a reference instead of copying it
+ */
+void phalcon_server_output_string(struct phalcon_server_conn_context *client_ctx, zend_string *str)
+{
+	struct phalcon_server_output *out;
+
+	if (!ZSTR_LEN(str)) {
+		return;
+	}
+
+	out = phalcon_server_output_alloc(client_ctx);
+	out->str = zend_string_copy(str);
+}
+
+/**
+ * Queues a file region, the connection owns the descriptor from now on
+ */
+void phalcon_server_output_file(struct phalcon_server_conn_context *client_ctx, int fd, off_t offset, size_t len)
+{
+	struct phalcon_server_output *out;
+
+	if (!len) {
+		close(fd);
+		return;
+	}
+
+	out = phalcon_server_output_alloc(client_ctx);
+	out->fd = fd;
+	out->file_offset = offset;
+	out->file_len = len;
+}
+
+static void phalcon_server_output_release(struct phalcon_server_output *out)
+{
+	if (out->str) {
+		zend_string_release(out->str);
+		out->str = NULL;
+	}
+	if (out->fd >= 0) {
+		close(out->fd);
+		out->fd = -1;
+	}
+}
+
+void phalcon_server_output_free(struct phalcon_server_conn_context *client_ctx)
+{
+	int i;
+
+	for (i = client_ctx->out_head; i < client_ctx->out_num; i++) {
+		phalcon_server_output_release(&client_ctx->out[i]);
+	}
+
+	client_ctx->out_head = 0;
+	client_ctx->out_num = 0;
+}
+
+/**
+ * Writes as much of the queued output as the socket accepts. Consecutive strings go out in
+ * one writev() call, files with sendfile(). Returns 1 when everything was written, 0 when the
+ * socket would block and -1 on errors
+ */
+int phalcon_server_output_flush(struct phalcon_server_conn_context *client_ctx)
+{
+	struct iovec iov[PHALCON_SERVER_MAX_IOVEC];
+	struct phalcon_server_output *out;
+	ssize_t ret;
+	size_t written;
+	int i, iovcnt;
+
+	while (client_ctx->out_head < client_ctx->out_num) {
+		out = &client_ctx->out[client_ctx->out_head];
+
+		if (out->fd >= 0) {
+			ret = sendfile(client_ctx->fd, out->fd, &out->file_offset, out->file_len > PHALCON_SERVER_SENDFILE_CHUNK ? PHALCON_SERVER_SENDFILE_CHUNK : out->file_len);
+			if (ret < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+			}
+			if (ret == 0) {
+				/* The file was truncated, the announced length can't be honoured anymore */
+				return -1;
+			}
+
+			out->file_len -= ret;
+			if (!out->file_len) {
+				phalcon_server_output_release(out);
+				client_ctx->out_head++;
+			}
+			continue;
+		}
+
+		for (i = client_ctx->out_head, iovcnt = 0; i < client_ctx->out_num && iovcnt < PHALCON_SERVER_MAX_IOVEC && client_ctx->out[i].fd < 0; i++, iovcnt++) {
+			iov[iovcnt].iov_base = ZSTR_VAL(client_ctx->out[i].str) + client_ctx->out[i].offset;
+			iov[iovcnt].iov_len = ZSTR_LEN(client_ctx->out[i].str) - client_ctx->out[i].offset;
+		}
+
+		ret = writev(client_ctx->fd, iov, iovcnt);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+		}
+
+		/* Advance over fully written chunks and remember the offset inside the last one */
+		written = ret;
+		while (written && client_ctx->out_head < client_ctx->out_num) {
+			out = &client_ctx->out[client_ctx->out_head];
+			if (written < ZSTR_LEN(out->str) - out->offset) {
+				out->offset += written;
+				break;
+			}
+			written -= ZSTR_LEN(out->str) - out->offset;
+			phalcon_server_output_release(out);
+			client_ctx->out_head++;
+		}
+	}
+
+	client_ctx->out_head = 0;
+	client_ctx->out_num = 0;
+
+	return 1;
+}
+
 void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, struct phalcon_server_conn_context * listen_ctx)
 {
 	int client_fd, listen_fd;
@@ -486,7 +664,7 @@ void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, s
 
 	int cpu_id = listen_ctx->cpu_id;
 	int ret = 0;
-	int i;
+	int i, accept_batch;
 
 	listen_fd = listen_ctx->fd;
 
@@ -494,7 +672,12 @@ void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, s
 	if (events & (EPOLLHUP | EPOLLERR))
 		return;
 
-	for (i = 0; i < PHALCON_SERVER_ACCEPT_PER_LISTEN_EVENT; i++) {
+	accept_batch = ctx->accept_batch > 0 ? ctx->accept_batch : PHALCON_SERVER_ACCEPT_PER_LISTEN_EVENT;
+
+	ctx->wdata[cpu_id].accept_wakeups++;
+
+	/* The listener is level triggered, whatever is left after the batch wakes us up again */
+	for (i = 0; i < accept_batch; i++) {
 		struct pahlcon_server_socket_address client_addr;
     	socklen_t client_addrlen = sizeof(client_addr);
 #ifdef HAVE_ACCEPT4
@@ -504,7 +687,12 @@ void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, s
         client_fd = accept(listen_fd, (struct sockaddr *) &client_addr, &client_addrlen);
 #endif
 		if (client_fd < 0) {
-			ctx->wdata[cpu_id].accept_cnt++;
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				ctx->wdata[cpu_id].accept_cnt++;
+			}
 			goto back;
 		}
 
@@ -520,6 +708,7 @@ void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, s
 		assert(client_ctx);
 
 		client_ctx->fd = client_fd;
+		client_ctx->start_usec = 0;
 
 		client_ctx->handler = ctx->read;
 
@@ -586,16 +775,30 @@ void phalcon_server_do_stats(struct phalcon_server_context *ctx)
 
 			for(i = 0; i < ctx->num_workers; i++)
 			{
-				acceptcnt += ctx->wdata[i].acceptcnt - ctx->wdata[i].acceptcnt_prev;
-				trancnt += ctx->wdata[i].trancnt - ctx->wdata[i].trancnt_prev;
-				if (unlikely(ctx->enable_verbose))
+				uint64_t worker_accept, worker_wakeups, worker_tran, worker_latency;
+
+				worker_accept = ctx->wdata[i].acceptcnt - ctx->wdata[i].acceptcnt_prev;
+				worker_wakeups = ctx->wdata[i].accept_wakeups - ctx->wdata[i].accept_wakeups_prev;
+				worker_tran = ctx->wdata[i].trancnt - ctx->wdata[i].trancnt_prev;
+				worker_latency = ctx->wdata[i].latency_sum - ctx->wdata[i].latency_sum_prev;
+
+				acceptcnt += worker_accept;
+				trancnt += worker_tran;
+				if (unlikely(ctx->enable_verbose)) {
 					fprintf(p, "%"PRIu64"[%"PRIu64"-%"PRIu64"-%"PRIu64"-%"PRIu64"-%"PRIu64"-%"PRIu64"-%"PRIu64"-%"PRIu64"]  ",
-						ctx->wdata[i].trancnt - ctx->wdata[i].trancnt_prev, ctx->wdata[i].polls_mpt,
+						worker_tran, ctx->wdata[i].polls_mpt,
 						ctx->wdata[i].polls_lst, ctx->wdata[i].polls_min, ctx->wdata[i].polls_max,
 						ctx->wdata[i].polls_avg, ctx->wdata[i].accept_cnt, ctx->wdata[i].read_cnt,
 						ctx->wdata[i].write_cnt);
+					fprintf(p, "cpu%d{accept %"PRIu64"/%"PRIu64" latency %"PRIu64"us max %"PRIu64"us}  ",
+						ctx->wdata[i].cpu_id, worker_accept, worker_wakeups,
+						worker_tran ? worker_latency / worker_tran : 0, ctx->wdata[i].latency_max);
+				}
 				ctx->wdata[i].acceptcnt_prev = ctx->wdata[i].acceptcnt;
+				ctx->wdata[i].accept_wakeups_prev = ctx->wdata[i].accept_wakeups;
 				ctx->wdata[i].trancnt_prev = ctx->wdata[i].trancnt;
+				ctx->wdata[i].latency_sum_prev = ctx->wdata[i].latency_sum;
+				ctx->wdata[i].latency_max = 0;
 			}
 
 			fprintf(p, "\tRequest/s %8"PRIu64",%8"PRIu64"\n", acceptcnt, trancnt);
@@ -49,6 +49,10 @@
 #include <arpa/inet.h>
 #include <sys/un.h>
 #include <pthread.h>
+#include <time.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
 
 #if HAVE_EPOLL
 #include <sys/epoll.h>
@@ -63,8 +67,14 @@
 
 #define PHALCON_SERVER_EVENTS_PER_BATCH			64
 #define PHALCON_SERVER_ACCEPT_PER_LISTEN_EVENT	1
+#define PHALCON_SERVER_MAX_ACCEPT_PER_LISTEN_EVENT	1024
 #define PHALCON_SERVER_MAX_WORKER_THREADS		4
 
+#define PHALCON_SERVER_CONN_CLOSE				0x01
+
+#define PHALCON_SERVER_MAX_IOVEC				64
+#define PHALCON_SERVER_SENDFILE_CHUNK			(1024 * 1024)
+
 typedef struct phalcon_server_conn_context phalcon_server_conn_context_t;
 typedef struct phalcon_server_context phalcon_server_context_t;
 typedef struct phalcon_server_context_pool phalcon_server_context_pool_t;
@@ -78,6 +88,15 @@ struct pahlcon_server_socket_address {
     socklen_t len;
 };
 
+/* A pending piece of the response, either a string or a file region sent with sendfile() */
+struct phalcon_server_output {
+	zend_string *str;
+	size_t offset;
+	int fd;
+	off_t file_offset;
+	size_t file_len;
+};
+
 struct phalcon_server_conn_context {
 	int fd;
 	int fd_added;
@@ -88,9 +107,13 @@ struct phalcon_server_conn_context {
 	int events;
 	int data_len;
 	int next_idx;
+	uint64_t start_usec;
 	char buf[PHALCON_SERVER_MAX_BUFSIZE];
 	void *user_data;
-	zend_string *response;
+	struct phalcon_server_output *out;
+	int out_head;
+	int out_num;
+	int out_size;
 	phalcon_server_context_pool_t *pool;
 } *arr;
 
@@ -134,6 +157,11 @@ struct phalcon_server_worker_data {
 	uint64_t accept_cnt;
 	uint64_t read_cnt;
 	uint64_t write_cnt;
+	uint64_t accept_wakeups;
+	uint64_t accept_wakeups_prev;
+	uint64_t latency_sum;
+	uint64_t latency_sum_prev;
+	uint64_t latency_max;
 	int shutdown;
 #if PHALCON_USE_THREADPOOL
 	pthread_t main_thread;
@@ -147,6 +175,9 @@ struct phalcon_server_context {
 	int num_workers;
 	int start_cpu;
 	int la_num;
+	int reuse_port;
+	int exclusive;
+	int accept_batch;
 	int pfd;
 	FILE *log_file;
 	zend_string *log_path;
@@ -173,12 +204,28 @@ struct phalcon_server_conn_context *phalcon_server_alloc_context(struct phalcon_
 void phalcon_server_free_context(struct phalcon_server_conn_context *client_ctx);
 struct phalcon_server_conn_context *phalcon_server_get_context(struct phalcon_server_context_pool *pool, int fd);
 
+void phalcon_server_output_string(struct phalcon_server_conn_context *client_ctx, zend_string *str);
+void phalcon_server_output_file(struct phalcon_server_conn_context *client_ctx, int fd, off_t offset, size_t len);
+int phalcon_server_output_flush(struct phalcon_server_conn_context *client_ctx);
+void phalcon_server_output_free(struct phalcon_server_conn_context *client_ctx);
+
+static inline int phalcon_server_output_pending(struct phalcon_server_conn_context *client_ctx){
+	return client_ctx->out_head < client_ctx->out_num;
+}
+
 void phalcon_server_builtin_process_accept(struct phalcon_server_context *ctx, struct phalcon_server_conn_context * listen_ctx);
 
 static inline int phalcon_server_get_cpu_num(){
 	return sysconf(_SC_NPROCESSORS_ONLN);
 }
 
+static inline uint64_t phalcon_server_now_usec(){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 #define phalcon_server_log_printf(ctx, fmt, args...) ({\
 		if (unlikely(PHALCON_GLOBAL(debug).enable_debug)) \
 			printf("Worker[%lu] %s:%d\t" fmt, syscall(__NR_gettid),__FUNCTION__ , __LINE__, ## args); \
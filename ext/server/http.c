@@ -22,6 +22,12 @@
 #include "server/core.h"
 #include "server/exception.h"
 #include "server/utils.h"
+#include "http/request.h"
+#include "http/response.h"
+#include "diinterface.h"
+
+#include <main/SAPI.h>
+#include <ctype.h>
 
 #include "kernel/main.h"
 #include "kernel/memory.h"
@@ -41,6 +47,12 @@
  *	$server = new Phalcon\Server\Http('127.0.0.1', 8989);
  *  $server->start($application);
  *
+ *	// One SO_REUSEPORT listener per worker, accepting up to 64 connections per wakeup
+ *	$server = new Phalcon\Server\Http(['host' => '0.0.0.0', 'port' => 8989, 'worker' => 4, 'reuseport' => true, 'accept_batch' => 64]);
+ *
+ *	// Persistent connections, pipelined requests are answered in order
+ *	$server = new Phalcon\Server\Http(['port' => 8989, 'keepalive' => true]);
+ *
  *</code>
  */
 zend_class_entry *phalcon_server_http_ce;
@@ -106,7 +118,7 @@ PHALCON_INIT_CLASS(Phalcon_Server_Http){
  */
 PHP_METHOD(Phalcon_Server_Http, __construct){
 
-	zval *config, verbose = {}, worker = {}, log_path = {}, host = {}, port = {};
+	zval *config, verbose = {}, worker = {}, log_path = {}, host = {}, port = {}, reuse_port = {}, exclusive = {}, accept_batch = {}, keepalive = {};
 	phalcon_server_http_object *intern;
 	int num_workers = 2;
 
@@ -124,6 +136,10 @@ PHP_METHOD(Phalcon_Server_Http, __construct){
 		num_workers = Z_LVAL(worker);
 	}
 
+	if (phalcon_array_isset_fetch_str(&keepalive, config, SL("keepalive"), PH_READONLY)) {
+		intern->enable_keepalive = zend_is_true(&keepalive);
+	}
+
 	intern->ctx.num_workers = num_workers > phalcon_server_get_cpu_num() ? phalcon_server_get_cpu_num() : num_workers;
 
 	if (phalcon_array_isset_fetch_str(&log_path, config, SL("log"), PH_READONLY) && Z_TYPE(log_path) == IS_STRING) {
@@ -142,11 +158,44 @@ PHP_METHOD(Phalcon_Server_Http, __construct){
 	} else {
 		intern->ctx.la[0].param_port = 8383;
 	}
+
+	if (phalcon_array_isset_fetch_str(&reuse_port, config, SL("reuseport"), PH_READONLY) && zend_is_true(&reuse_port)) {
+#ifdef SO_REUSEPORT
+		intern->ctx.reuse_port = 1;
+#else
+		PHALCON_THROW_EXCEPTION_STR(phalcon_server_exception_ce, "SO_REUSEPORT is not supported on this platform");
+		return;
+#endif
+	}
+
+	if (phalcon_array_isset_fetch_str(&exclusive, config, SL("exclusive"), PH_READONLY)) {
+		intern->ctx.exclusive = zend_is_true(&exclusive);
+	}
+
+	intern->ctx.accept_batch = PHALCON_SERVER_ACCEPT_PER_LISTEN_EVENT;
+	if (phalcon_array_isset_fetch_str(&accept_batch, config, SL("accept_batch"), PH_READONLY) && Z_TYPE(accept_batch) == IS_LONG) {
+		if (Z_LVAL(accept_batch) < 1 || Z_LVAL(accept_batch) > PHALCON_SERVER_MAX_ACCEPT_PER_LISTEN_EVENT) {
+			PHALCON_THROW_EXCEPTION_FORMAT(phalcon_server_exception_ce, "Accept batch must be between 1 and %d", PHALCON_SERVER_MAX_ACCEPT_PER_LISTEN_EVENT);
+			return;
+		}
+		intern->ctx.accept_batch = Z_LVAL(accept_batch);
+	}
+}
+
+/**
+ * Every message starts its own latency clock, also the pipelined and keep-alive ones
+ */
+static int phalcon_server_http_on_message_begin(http_parser *p)
+{
+	phalcon_http_parser_data *data = (phalcon_http_parser_data *)p->data;
+
+	data->start_usec = phalcon_server_now_usec();
+	return phalcon_http_parser_on_message_begin(p);
 }
 
 /* Http parser */
 struct http_parser_settings http_parser_request_settings = {
-    .on_message_begin = phalcon_http_parser_on_message_begin,
+    .on_message_begin = phalcon_server_http_on_message_begin,
     .on_url = phalcon_http_parser_on_url,
     .on_status = phalcon_http_parser_on_status,
     .on_header_field = phalcon_http_parser_on_header_field,
@@ -165,14 +214,347 @@ char *http_200="HTTP/1.0 200 OK\r\n"
 	"\r\n"
 	"<html><body><h1>200 OK</h1>\nEverything is fine.\n</body></html>\n";
 
+char *http_413="HTTP/1.1 413 Payload Too Large\r\n"
+	"Connection: close\r\n"
+	"Content-Type: text/html\r\n"
+	"Content-Length: 57\r\n"
+	"\r\n"
+	"<html><body><h1>413 Payload Too Large</h1></body></html>\n";
+
+static void phalcon_server_http_close(struct phalcon_server_conn_context *client_ctx)
+{
+	if (client_ctx->user_data) {
+		phalcon_http_parser_data_free((phalcon_http_parser_data *)client_ctx->user_data);
+		client_ctx->user_data = NULL;
+	}
+	phalcon_server_output_free(client_ctx);
+	// __sync_synchronize();
+	phalcon_server_client_close(client_ctx);
+	// __sync_synchronize();
+	phalcon_server_free_context(client_ctx);
+}
+
+static void phalcon_server_http_parse_variables(zval *variables, const char *str, size_t len)
+{
+	array_init(variables);
+	if (len) {
+		/* treat_data() takes ownership of the buffer */
+		sapi_module.treat_data(PARSE_STRING, estrndup(str, len), variables);
+	}
+}
+
+/**
+ * Builds a Phalcon\Http\Request from the parsed message, the request keeps its own
+ * $_SERVER, $_GET, $_POST and $_REQUEST so nothing is shared between requests
+ */
+static void phalcon_server_http_create_request(zval *request, zval *uri, struct phalcon_server_conn_context *client_ctx, phalcon_http_parser_data *parser_data)
+{
+	zval globals = {}, server = {}, query = {}, post = {}, merged = {}, *value;
+	zend_string *str_key;
+	struct pahlcon_server_socket_address addr;
+	char ip[INET6_ADDRSTRLEN];
+	const char *url = "", *query_string, *fragment;
+	size_t url_len = 0, path_len;
+
+	if (parser_data->url.s) {
+		url = ZSTR_VAL(parser_data->url.s);
+		url_len = ZSTR_LEN(parser_data->url.s);
+	}
+
+	fragment = memchr(url, '#', url_len);
+	if (fragment) {
+		url_len = fragment - url;
+	}
+
+	query_string = memchr(url, '?', url_len);
+	path_len = query_string ? (size_t)(query_string - url) : url_len;
+
+	ZVAL_STRINGL(uri, url, path_len);
+
+	array_init(&server);
+	phalcon_array_update_str_str(&server, SL("REQUEST_METHOD"), (char *)http_method_str(parser_data->parser->method), strlen(http_method_str(parser_data->parser->method)), 0);
+	phalcon_array_update_str_str(&server, SL("REQUEST_URI"), (char *)url, url_len, 0);
+	phalcon_array_update_str_str(&server, SL("PATH_INFO"), (char *)url, path_len, 0);
+	if (query_string) {
+		phalcon_array_update_str_str(&server, SL("QUERY_STRING"), (char *)query_string + 1, url_len - path_len - 1, 0);
+	} else {
+		phalcon_array_update_str_str(&server, SL("QUERY_STRING"), "", 0, 0);
+	}
+	if (parser_data->parser->http_major == 1 && parser_data->parser->http_minor == 0) {
+		phalcon_array_update_str_str(&server, SL("SERVER_PROTOCOL"), SL("HTTP/1.0"), 0);
+	} else {
+		phalcon_array_update_str_str(&server, SL("SERVER_PROTOCOL"), SL("HTTP/1.1"), 0);
+	}
+	phalcon_array_update_str_long(&server, SL("REQUEST_TIME"), time(NULL), 0);
+
+	addr.len = sizeof(addr.addr);
+	if (getpeername(client_ctx->fd, (struct sockaddr *)&addr.addr, &addr.len) == 0) {
+		if (addr.addr.inet_v4.sin_family == AF_INET) {
+			inet_ntop(AF_INET, &addr.addr.inet_v4.sin_addr, ip, sizeof(ip));
+			phalcon_array_update_str_str(&server, SL("REMOTE_ADDR"), ip, strlen(ip), 0);
+			phalcon_array_update_str_long(&server, SL("REMOTE_PORT"), ntohs(addr.addr.inet_v4.sin_port), 0);
+		} else if (addr.addr.inet_v6.sin6_family == AF_INET6) {
+			inet_ntop(AF_INET6, &addr.addr.inet_v6.sin6_addr, ip, sizeof(ip));
+			phalcon_array_update_str_str(&server, SL("REMOTE_ADDR"), ip, strlen(ip), 0);
+			phalcon_array_update_str_long(&server, SL("REMOTE_PORT"), ntohs(addr.addr.inet_v6.sin6_port), 0);
+		}
+	}
+
+	/* Same naming as the CGI variables: Content-Type => CONTENT_TYPE, X-Foo => HTTP_X_FOO */
+	ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(parser_data->head), str_key, value) {
+		zend_string *name;
+		char *c;
+
+		if (!str_key) {
+			continue;
+		}
+
+		if (!strcasecmp(ZSTR_VAL(str_key), "Content-Type") || !strcasecmp(ZSTR_VAL(str_key), "Content-Length")) {
+			name = zend_string_init(ZSTR_VAL(str_key), ZSTR_LEN(str_key), 0);
+			c = ZSTR_VAL(name);
+		} else {
+			name = zend_string_alloc(ZSTR_LEN(str_key) + 5, 0);
+			memcpy(ZSTR_VAL(name), "HTTP_", 5);
+			memcpy(ZSTR_VAL(name) + 5, ZSTR_VAL(str_key), ZSTR_LEN(str_key) + 1);
+			c = ZSTR_VAL(name) + 5;
+		}
+
+		for (; *c; c++) {
+			*c = (*c == '-') ? '_' : toupper((unsigned char)*c);
+		}
+
+		Z_TRY_ADDREF_P(value);
+		zend_symtable_update(Z_ARRVAL(server), name, value);
+		zend_string_release(name);
+	} ZEND_HASH_FOREACH_END();
+
+	phalcon_server_http_parse_variables(&query, query_string ? query_string + 1 : "", query_string ? url_len - path_len - 1 : 0);
+
+	value = zend_hash_str_find(Z_ARRVAL(server), SL("CONTENT_TYPE"));
+	if (parser_data->parser->method == HTTP_POST && parser_data->body.s && value && Z_TYPE_P(value) == IS_STRING
+		&& !strncasecmp(Z_STRVAL_P(value), "application/x-www-form-urlencoded", sizeof("application/x-www-form-urlencoded") - 1)) {
+		phalcon_server_http_parse_variables(&post, ZSTR_VAL(parser_data->body.s), ZSTR_LEN(parser_data->body.s));
+	} else {
+		array_init(&post);
+	}
+
+	phalcon_fast_array_merge(&merged, &query, &post);
+
+	array_init_size(&globals, 4);
+	phalcon_array_update_str(&globals, SL("_SERVER"), &server, 0);
+	phalcon_array_update_str(&globals, SL("_GET"), &query, 0);
+	phalcon_array_update_str(&globals, SL("_POST"), &post, 0);
+	phalcon_array_update_str(&globals, SL("_REQUEST"), &merged, 0);
+
+	object_init_ex(request, phalcon_http_request_ce);
+	PHALCON_CALL_METHOD(NULL, request, "__construct");
+
+	phalcon_update_property(request, SL("_globals"), &globals);
+	zval_ptr_dtor(&globals);
+
+	if (parser_data->body.s) {
+		phalcon_update_property_str(request, SL("_rawBody"), ZSTR_VAL(parser_data->body.s), ZSTR_LEN(parser_data->body.s));
+	} else {
+		phalcon_update_property_str(request, SL("_rawBody"), SL(""));
+	}
+}
+
+/**
+ * Runs the application for one parsed message and queues the response on the connection
+ */
+static void phalcon_server_http_handle_request(struct phalcon_server_context *ctx, struct phalcon_server_conn_context *client_ctx, phalcon_http_parser_data *parser_data)
+{
+	zval uri = {}, request = {}, dependency_injector = {}, service = {}, response = {}, content = {}, body = {}, file = {}, headers = {}, headers_array = {};
+	zval *chunk;
+	phalcon_server_http_object *intern;
+	zend_string *head;
+	struct stat st;
+	size_t content_length = 0;
+	int flag = 0, keepalive, file_fd = -1, file_status = 0;
+
+	intern = phalcon_server_http_object_from_ctx(ctx);
+	keepalive = intern->enable_keepalive && parser_data->keep_alive;
+
+	/* Pipelined responses are written together, the latency counts from the oldest message */
+	if (!client_ctx->start_usec) {
+		client_ctx->start_usec = parser_data->start_usec;
+	}
+	if (!keepalive) {
+		client_ctx->flags |= PHALCON_SERVER_CONN_CLOSE;
+	}
+
+	phalcon_server_http_create_request(&request, &uri, client_ctx, parser_data);
+
+	PHALCON_CALL_METHOD_FLAG(flag, &dependency_injector, &intern->application, "getdi");
+	if (flag == SUCCESS && Z_TYPE(dependency_injector) == IS_OBJECT) {
+		ZVAL_STR(&service, IS(request));
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &dependency_injector, "setshared", &service, &request);
+		PHALCON_CALL_METHOD_FLAG(flag, NULL, &request, "setdi", &dependency_injector);
+	}
+	zval_ptr_dtor(&dependency_injector);
+
+	PHALCON_CALL_METHOD_FLAG(flag, &response, &intern->application, "handle", &uri);
+	zval_ptr_dtor(&request);
+	zval_ptr_dtor(&uri);
+
+	if (flag == FAILURE) {
+		if (EG(exception)) {
+			zval ex = {}, msg = {};
+			ZVAL_OBJ(&ex, EG(exception));
+			phalcon_read_property(&msg, &ex, SL("message"), PH_NOISY|PH_READONLY);
+			if (Z_TYPE(msg) == IS_STRING) {
+				ZVAL_COPY(&content, &msg);
+			}
+			zend_clear_exception();
+		}
+	} else if (Z_TYPE(response) == IS_OBJECT) {
+		if (instanceof_function(Z_OBJCE(response), phalcon_http_response_ce)) {
+			phalcon_read_property(&body, &response, SL("_content"), PH_NOISY|PH_READONLY);
+		}
+		if (Z_TYPE(body) == IS_ARRAY) {
+			/* A streamed view, every fragment becomes its own iovec instead of being joined */
+			ZVAL_COPY(&content, &body);
+		} else {
+			PHALCON_CALL_METHOD_FLAG(flag, &content, &response, "getcontent");
+		}
+		if (Z_TYPE(content) != IS_STRING && Z_TYPE(content) != IS_ARRAY && instanceof_function(Z_OBJCE(response), phalcon_http_response_ce)) {
+			/* Response::setFileToSend(), the file goes from the page cache to the socket with sendfile() */
+			phalcon_read_property(&file, &response, SL("_file"), PH_NOISY|PH_READONLY);
+			if (Z_TYPE(file) == IS_STRING && Z_STRLEN(file)) {
+				file_fd = open(Z_STRVAL(file), O_RDONLY | O_CLOEXEC);
+				if (file_fd < 0) {
+					file_status = (errno == ENOENT || errno == ENOTDIR) ? 404 : 500;
+				} else if (fstat(file_fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+					/* Directories and other special files are not something to send */
+					file_status = 404;
+					close(file_fd);
+					file_fd = -1;
+				} else {
+					content_length = st.st_size;
+				}
+			}
+		}
+		PHALCON_CALL_METHOD_FLAG(flag, &headers, &response, "getheaders");
+		if (flag == SUCCESS && Z_TYPE(headers) == IS_OBJECT) {
+			PHALCON_CALL_METHOD_FLAG(flag, &headers_array, &headers, "toarray");
+		}
+		zval_ptr_dtor(&headers);
+	}
+	zval_ptr_dtor(&response);
+
+	/* The file to send can't be read, the headers of the response described it so they are dropped */
+	if (file_status) {
+		zval_ptr_dtor(&headers_array);
+		array_init(&headers_array);
+		zval_ptr_dtor(&content);
+		if (file_status == 404) {
+			add_assoc_null(&headers_array, "HTTP/1.1 404 Not Found");
+			ZVAL_STRING(&content, "<html><body><h1>404 Not Found</h1></body></html>\n");
+		} else {
+			add_assoc_null(&headers_array, "HTTP/1.1 500 Internal Server Error");
+			ZVAL_STRING(&content, "<html><body><h1>500 Internal Server Error</h1></body></html>\n");
+		}
+	}
+
+	if (Z_TYPE(content) == IS_STRING) {
+		content_length = Z_STRLEN(content);
+	} else if (Z_TYPE(content) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_VAL(Z_ARRVAL(content), chunk) {
+			if (Z_TYPE_P(chunk) == IS_STRING) {
+				content_length += Z_STRLEN_P(chunk);
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	head = phalcon_server_http_get_headers(&headers_array, keepalive, content_length);
+	phalcon_server_http_reset_headers();
+	zval_ptr_dtor(&headers_array);
+
+	/* Head and body are separate iovecs, the body is referenced rather than copied */
+	phalcon_server_output_string(client_ctx, head);
+	zend_string_release(head);
+
+	if (parser_data->parser->method == HTTP_HEAD) {
+		if (file_fd >= 0) {
+			close(file_fd);
+		}
+	} else if (file_fd >= 0) {
+		phalcon_server_output_file(client_ctx, file_fd, 0, content_length);
+	} else if (content_length) {
+		if (Z_TYPE(content) == IS_ARRAY) {
+			ZEND_HASH_FOREACH_VAL(Z_ARRVAL(content), chunk) {
+				if (Z_TYPE_P(chunk) == IS_STRING) {
+					phalcon_server_output_string(client_ctx, Z_STR_P(chunk));
+				}
+			} ZEND_HASH_FOREACH_END();
+		} else {
+			phalcon_server_output_string(client_ctx, Z_STR(content));
+		}
+	}
+	zval_ptr_dtor(&content);
+}
+
+/**
+ * Feeds the parser, every complete message pauses it so pipelined requests are answered in order
+ */
+static int phalcon_server_http_parse(struct phalcon_server_context *ctx, struct phalcon_server_conn_context *client_ctx, const char *buf, size_t len)
+{
+	phalcon_http_parser_data *parser_data;
+	size_t offset = 0, parsed;
+
+	while (offset < len) {
+		if (!client_ctx->user_data) {
+			client_ctx->user_data = phalcon_http_parser_data_new(&http_parser_request_settings);
+		}
+		parser_data = (phalcon_http_parser_data *)client_ctx->user_data;
+
+		parsed = http_parser_execute(parser_data->parser, parser_data->settings, buf + offset, len - offset);
+		offset += parsed;
+
+		if (HTTP_PARSER_ERRNO(parser_data->parser) == HPE_PAUSED) {
+			http_parser_pause(parser_data->parser, 0);
+
+			phalcon_server_http_handle_request(ctx, client_ctx, parser_data);
+			phalcon_http_parser_data_reset(parser_data);
+
+			if (client_ctx->flags & PHALCON_SERVER_CONN_CLOSE) {
+				/* Anything after a non persistent request is discarded */
+				return SUCCESS;
+			}
+			continue;
+		}
+
+		if (parser_data->too_large) {
+			zend_string *response = zend_string_init(http_413, strlen(http_413), 0);
+
+			/* Answer after the responses already queued, then close */
+			phalcon_server_log_printf(ctx, "Request body too large on socket %d\n", client_ctx->fd);
+			phalcon_server_output_string(client_ctx, response);
+			zend_string_release(response);
+			client_ctx->flags |= PHALCON_SERVER_CONN_CLOSE;
+			return SUCCESS;
+		}
+
+		if (HTTP_PARSER_ERRNO(parser_data->parser) != HPE_OK || parser_data->parser->upgrade) {
+			phalcon_server_log_printf(ctx, "Parser error %s on socket %d\n", http_errno_name(HTTP_PARSER_ERRNO(parser_data->parser)), client_ctx->fd);
+			return FAILURE;
+		}
+
+		if (!parsed) {
+			break;
+		}
+	}
+
+	return SUCCESS;
+}
+
 void phalcon_server_http_process_write(struct phalcon_server_context *ctx, struct phalcon_server_conn_context *client_ctx)
 {
 	int ep_fd, fd;
 	int events = client_ctx->events;
 	int cpu_id = client_ctx->cpu_id;
-	int old_len, ret;
+	int ret;
 	struct epoll_event evt;
-	phalcon_server_http_object *intern;
 
 	ep_fd = client_ctx->ep_fd;
 	fd = client_ctx->fd;
@@ -184,30 +566,23 @@ void phalcon_server_http_process_write(struct phalcon_server_context *ctx, struc
 		goto free_back;
 	}
 
-	old_len = ZSTR_LEN(client_ctx->response);
-	if (ZSTR_LEN(client_ctx->response)) {
-		ret = write(fd, ZSTR_VAL(client_ctx->response), old_len);
+	if (phalcon_server_output_pending(client_ctx)) {
+		ret = phalcon_server_output_flush(client_ctx);
 		if (ret < 0) {
 			ctx->wdata[cpu_id].write_cnt++;
 			perror("process_write() can't write client socket");
 			goto free_back;
 		}
-		if (ret < old_len) {
-			zend_string *new_response = zend_string_alloc(old_len - ret, 0);
-			memcpy(ZSTR_VAL(new_response), ZSTR_VAL(client_ctx->response) + ret, old_len - ret);
-			zend_string_release(client_ctx->response);
-			client_ctx->response = new_response;
+		if (ret == 0) {
+			/* Wait for the socket to drain, the queue remembers how far we got */
 			evt.events = EPOLLOUT | EPOLLHUP | EPOLLERR;
 			evt.data.ptr = client_ctx;
 			ret = epoll_ctl(ep_fd, EPOLL_CTL_MOD, fd, &evt);
 			if (ret < 0) {
-				perror("Unable to add client socket read event to epoll");
+				perror("Unable to add client socket write event to epoll");
 				goto free_back;
 			}
 			goto back;
-		} else {
-			zend_string_release(client_ctx->response);
-			client_ctx->response = NULL;
 		}
 	} else {
 		ret = write(fd, http_200, strlen(http_200));
@@ -216,14 +591,22 @@ void phalcon_server_http_process_write(struct phalcon_server_context *ctx, struc
 			perror("process_write() can't write client socket");
 			goto free_back;
 		}
+		client_ctx->flags |= PHALCON_SERVER_CONN_CLOSE;
 	}
 
-	phalcon_server_log_printf(ctx, "Write %d to socket %d\n", ret, fd);
+	phalcon_server_log_printf(ctx, "Write to socket %d done\n", fd);
 
 	ctx->wdata[cpu_id].trancnt++;
+	if (client_ctx->start_usec) {
+		uint64_t latency = phalcon_server_now_usec() - client_ctx->start_usec;
+		ctx->wdata[cpu_id].latency_sum += latency;
+		if (latency > ctx->wdata[cpu_id].latency_max) {
+			ctx->wdata[cpu_id].latency_max = latency;
+		}
+		client_ctx->start_usec = 0;
+	}
 
-	intern = phalcon_server_http_object_from_ctx(ctx);
-	if (!intern->enable_keepalive)
+	if (client_ctx->flags & PHALCON_SERVER_CONN_CLOSE)
 		goto free_back;
 
 	client_ctx->handler = ctx->read;
@@ -240,10 +623,7 @@ void phalcon_server_http_process_write(struct phalcon_server_context *ctx, struc
 	goto back;
 
 free_back:
-	// __sync_synchronize();
-	phalcon_server_client_close(client_ctx);
-	// __sync_synchronize();
-	phalcon_server_free_context(client_ctx);
+	phalcon_server_http_close(client_ctx);
 
 back:
 	return;
@@ -273,86 +653,52 @@ static void phalcon_server_http_process_read(struct phalcon_server_context *ctx,
 
 	phalcon_server_log_printf(ctx, "Process read event[%02x] on socket %d\n", events, fd);
 
-    ret = read(fd, buf, PHALCON_SERVER_MAX_BUFSIZE);
-	client_ctx->data_len = ret;
-	if (ret < 0) {
-		ctx->wdata[cpu_id].read_cnt++;
-		perror("process_read() can't read client socket");
-		goto free_back;
-	} else if (ret == 0) {
-		phalcon_server_log_printf(ctx, "Socket %d is closed\n", fd);
-		goto free_back;
-	} else {
-		phalcon_http_parser_data *parser_data;
-		if (!client_ctx->user_data) {
-			client_ctx->user_data = phalcon_http_parser_data_new(&http_parser_request_settings);
-		}
-		parser_data = (phalcon_http_parser_data *)client_ctx->user_data;
-
-		http_parser_execute(parser_data->parser, parser_data->settings, buf, ret);
-
-		phalcon_server_log_printf(ctx, "Parser state %d, request from socket %d\n", parser_data->parser->state, fd);
-        if (parser_data->parser->state >= HTTP_PARSER_STATE_END || ret < PHALCON_SERVER_MAX_BUFSIZE) {
-			zval url = {}, response = {}, content = {};
-			phalcon_server_http_object *intern;
-			int flag = 0;
-
-			ZVAL_STR(&url, parser_data->url.s);
-			intern = phalcon_server_http_object_from_ctx(ctx);
-
-			PHALCON_CALL_METHOD_FLAG(flag, &response, &intern->application, "handle", &url);
-			phalcon_http_parser_data_free(parser_data);
-			client_ctx->user_data = NULL;
-			client_ctx->response = phalcon_server_http_get_headers();
-			if (flag == FAILURE) {
-				if (EG(exception)) {
-					zval ex, msg;
-					ZVAL_OBJ(&ex, EG(exception));
-					phalcon_read_property(&msg, &ex, SL("message"), PH_NOISY|PH_READONLY);
-					if (Z_TYPE(msg) == IS_STRING) {
-						PHALCON_SERVER_STRING_APPEND(client_ctx->response, Z_STR(msg));
-					}
-					zend_clear_exception();
-				}
-			} else {
-				PHALCON_CALL_METHOD_FLAG(flag, &content, &response, "getcontent");
-				if (Z_TYPE(content) == IS_STRING) {
-					PHALCON_SERVER_STRING_APPEND(client_ctx->response, Z_STR(content));
-				}
-				zval_ptr_dtor(&content);
-				zval_ptr_dtor(&response);
+	/* Edge triggered, drain the socket; the parser keeps partial messages between reads */
+	while (!(client_ctx->flags & PHALCON_SERVER_CONN_CLOSE)) {
+		ret = read(fd, buf, PHALCON_SERVER_MAX_BUFSIZE);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
 			}
-			client_ctx->handler = ctx->write;
-			evt.events = EPOLLOUT | EPOLLHUP | EPOLLERR;
-			evt.data.ptr = client_ctx;
-			ret = epoll_ctl(ep_fd, EPOLL_CTL_MOD, fd, &evt);
-			if (ret < 0) {
-				perror("Unable to add client socket write event to epoll");
-				goto free_back;
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				break;
 			}
-			goto back;
-        }
+			ctx->wdata[cpu_id].read_cnt++;
+			perror("process_read() can't read client socket");
+			goto free_back;
+		} else if (ret == 0) {
+			phalcon_server_log_printf(ctx, "Socket %d is closed\n", fd);
+			goto free_back;
+		}
 
+		client_ctx->data_len = ret;
 		phalcon_server_log_printf(ctx, "Read %d from socket %d\n", ret, fd);
-		client_ctx->handler = ctx->read;
-		evt.events = EPOLLIN | EPOLLERR | EPOLLET;
-		evt.data.ptr = client_ctx;
 
-		ret = epoll_ctl(ep_fd, EPOLL_CTL_MOD, fd, &evt);
-		if (ret < 0) {
-			perror("Unable to add client socket read event to epoll");
+		if (phalcon_server_http_parse(ctx, client_ctx, buf, ret) == FAILURE) {
 			goto free_back;
 		}
 	}
 
+	if (phalcon_server_output_pending(client_ctx)) {
+		client_ctx->handler = ctx->write;
+		evt.events = EPOLLOUT | EPOLLHUP | EPOLLERR;
+	} else {
+		client_ctx->handler = ctx->read;
+		evt.events = EPOLLIN | EPOLLERR | EPOLLET;
+	}
+	evt.data.ptr = client_ctx;
+
+	ret = epoll_ctl(ep_fd, EPOLL_CTL_MOD, fd, &evt);
+	if (ret < 0) {
+		perror("Unable to modify client socket event in epoll");
+		goto free_back;
+	}
+
 	goto back;
 
 free_back:
 	phalcon_server_log_printf(ctx, "cpu[%d] close socket %d\n", cpu_id, client_ctx->fd);
-	//__sync_synchronize();
-	phalcon_server_client_close(client_ctx);
-	//__sync_synchronize();
-	phalcon_server_free_context(client_ctx);
+	phalcon_server_http_close(client_ctx);
 
 back:
 	return;
@@ -39,9 +39,29 @@ phalcon_http_parser_data *phalcon_http_parser_data_new(struct http_parser_settin
     return data;
 }
 
+void phalcon_http_parser_data_reset(phalcon_http_parser_data *data)
+{
+    zval_ptr_dtor(&data->head);
+    array_init(&data->head);
+
+    smart_str_free(&data->url);
+    smart_str_free(&data->body);
+
+    if (data->last_key) {
+        zend_string_release(data->last_key);
+        data->last_key = NULL;
+    }
+
+    data->keep_alive = 0;
+    data->too_large = 0;
+    data->state = HTTP_PARSER_STATE_NONE;
+}
+
 void phalcon_http_parser_data_free(phalcon_http_parser_data *data)
 {
     if (!data) return;
+    phalcon_http_parser_data_reset(data);
+    zval_ptr_dtor(&data->head);
     efree(data->parser);
     efree(data);
     data = NULL;
@@ -117,6 +137,10 @@ int phalcon_http_parser_on_body(http_parser *p, const char *at, size_t length)
 {
     phalcon_http_parser_data *data = (phalcon_http_parser_data *)p->data;
     data->state = HTTP_PARSER_STATE_BODY;
+    if ((data->body.s ? ZSTR_LEN(data->body.s) : 0) + length > PHALCON_HTTP_PARSER_MAX_BODYSIZE) {
+        data->too_large = 1;
+        return 1;
+    }
     smart_str_appendl(&data->body, at, length);
     return 0;
 }
@@ -125,8 +149,11 @@ int phalcon_http_parser_on_message_complete(http_parser *p)
 {
     phalcon_http_parser_data *data = (phalcon_http_parser_data *)p->data;
     data->state = HTTP_PARSER_STATE_END;
+    data->keep_alive = http_should_keep_alive(p);
 	smart_str_0(&data->url);
 	smart_str_0(&data->body);
+    /* Hand the request over before parsing the next pipelined one */
+    http_parser_pause(p, 1);
     return 0;
 }
 
@@ -140,7 +167,7 @@ int phalcon_http_parser_on_chunk_header(http_parser *p)
 int phalcon_http_parser_on_chunk_complete(http_parser *p)
 {
     phalcon_http_parser_data *data = (phalcon_http_parser_data *)p->data;
-    data->state = HTTP_PARSER_STATE_END;
+    data->state = HTTP_PARSER_STATE_CHUNK;
     return 0;
 }
 
@@ -248,7 +275,7 @@ static void append_http_status_line(smart_str *buffer, int protocol_version, int
 	smart_str_appendl_ex(buffer, "\r\n", 2, persistent);
 }
 
-static void append_essential_headers(smart_str* buffer)
+static void append_essential_headers(smart_str* buffer, int keepalive, size_t content_length)
 {
 	struct timeval tv = {0};
 
@@ -260,35 +287,106 @@ static void append_essential_headers(smart_str* buffer)
 		zend_string_release(dt);
 	}
 
-	smart_str_appendl_ex(buffer, "Connection: close\r\n", sizeof("Connection: close\r\n") - 1, 0);
+	if (keepalive) {
+		smart_str_appendl_ex(buffer, "Connection: keep-alive\r\n", sizeof("Connection: keep-alive\r\n") - 1, 0);
+	} else {
+		smart_str_appendl_ex(buffer, "Connection: close\r\n", sizeof("Connection: close\r\n") - 1, 0);
+	}
+
+	smart_str_appendl_ex(buffer, "Content-Length: ", sizeof("Content-Length: ") - 1, 0);
+	smart_str_append_unsigned_ex(buffer, content_length, 0);
+	smart_str_appendl_ex(buffer, "\r\n", 2, 0);
+}
+
+static int is_essential_header(const char *header, size_t header_len)
+{
+	return (header_len == sizeof("Connection") - 1 && !strncasecmp(header, "Connection", header_len))
+		|| (header_len == sizeof("Content-Length") - 1 && !strncasecmp(header, "Content-Length", header_len))
+		|| (header_len == sizeof("Status") - 1 && !strncasecmp(header, "Status", header_len));
 }
 
-zend_string *phalcon_server_http_get_headers()
+/**
+ * Builds the response head, headers is the array returned by Phalcon\Http\Response\Headers::toArray()
+ */
+zend_string *phalcon_server_http_get_headers(zval *headers, int keepalive, size_t content_length)
 {
-	zend_llist *headers = &SG(sapi_headers).headers;
+	zend_llist *sapi_headers = &SG(sapi_headers).headers;
 	sapi_header_struct *h;
 	zend_llist_position pos;
 	smart_str buffer = {0};
-	int protocol_version = 100;
+	zend_string *str_key;
+	zval *value;
+	int protocol_version = 101, status_sent = 0;
 
 	if (SG(sapi_headers).http_status_line) {
 		smart_str_appends(&buffer, SG(sapi_headers).http_status_line);
 		smart_str_appendl(&buffer, "\r\n", 2);
-	} else {
+		status_sent = 1;
+	} else if (headers && Z_TYPE_P(headers) == IS_ARRAY) {
+		/* Response::setStatusCode() stores the status line as a raw header */
+		ZEND_HASH_FOREACH_STR_KEY(Z_ARRVAL_P(headers), str_key) {
+			if (str_key && ZSTR_LEN(str_key) > 5 && !strncmp(ZSTR_VAL(str_key), "HTTP/", 5)) {
+				smart_str_append(&buffer, str_key);
+				smart_str_appendl(&buffer, "\r\n", 2);
+				status_sent = 1;
+				break;
+			}
+		} ZEND_HASH_FOREACH_END();
+	}
+
+	if (!status_sent) {
 		append_http_status_line(&buffer, protocol_version, SG(sapi_headers).http_response_code, 0);
 	}
 
-	append_essential_headers(&buffer);
+	append_essential_headers(&buffer, keepalive, content_length);
 
-	h = (sapi_header_struct*)zend_llist_get_first_ex(headers, &pos);
+	h = (sapi_header_struct*)zend_llist_get_first_ex(sapi_headers, &pos);
 	while (h) {
 		if (h->header_len) {
-			smart_str_appendl(&buffer, h->header, h->header_len);
-			smart_str_appendl(&buffer, "\r\n", 2);
+			char *colon = memchr(h->header, ':', h->header_len);
+			if (!colon || !is_essential_header(h->header, colon - h->header)) {
+				smart_str_appendl(&buffer, h->header, h->header_len);
+				smart_str_appendl(&buffer, "\r\n", 2);
+			}
 		}
-		h = (sapi_header_struct*)zend_llist_get_next_ex(headers, &pos);
+		h = (sapi_header_struct*)zend_llist_get_next_ex(sapi_headers, &pos);
 	}
+
+	if (headers && Z_TYPE_P(headers) == IS_ARRAY) {
+		ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(headers), str_key, value) {
+			if (!str_key || (ZSTR_LEN(str_key) > 5 && !strncmp(ZSTR_VAL(str_key), "HTTP/", 5))) {
+				continue;
+			}
+			if (is_essential_header(ZSTR_VAL(str_key), ZSTR_LEN(str_key))) {
+				continue;
+			}
+			smart_str_append(&buffer, str_key);
+			if (Z_TYPE_P(value) == IS_STRING && Z_STRLEN_P(value)) {
+				smart_str_appendl(&buffer, ": ", 2);
+				smart_str_append(&buffer, Z_STR_P(value));
+			}
+			smart_str_appendl(&buffer, "\r\n", 2);
+		} ZEND_HASH_FOREACH_END();
+	}
+
 	smart_str_appendl(&buffer, "\r\n", 2);
+	smart_str_0(&buffer);
 
 	return buffer.s;
 }
+
+/**
+ * Forgets the headers sent with header() so they don't leak into the next request of the worker
+ */
+void phalcon_server_http_reset_headers()
+{
+	zend_llist_clean(&SG(sapi_headers).headers);
+
+	if (SG(sapi_headers).http_status_line) {
+		efree(SG(sapi_headers).http_status_line);
+		SG(sapi_headers).http_status_line = NULL;
+	}
+
+	SG(sapi_headers).http_response_code = 0;
+	SG(headers_sent) = 0;
+}
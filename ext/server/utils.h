@@ -26,6 +26,8 @@
 
 #include <Zend/zend_smart_str.h>
 
+#define PHALCON_HTTP_PARSER_MAX_BODYSIZE	(8 * 1024 * 1024)
+
 int phalcon_http_parser_on_message_begin(http_parser *);
 int phalcon_http_parser_on_url(http_parser *, const char *at, size_t length);
 int phalcon_http_parser_on_status(http_parser *, const char *at, size_t length);
@@ -49,14 +51,19 @@ typedef struct {
     smart_str url;
     smart_str body;
     zend_string *last_key;
+    int keep_alive;
+    int too_large;
+    uint64_t start_usec;
 } phalcon_http_parser_data;
 
 phalcon_http_parser_data *phalcon_http_parser_data_new();
+void phalcon_http_parser_data_reset(phalcon_http_parser_data *hp);
 void phalcon_http_parser_data_free(phalcon_http_parser_data *hp);
 
 extern char *http_200;
 extern char *http_200_keepalive;
 
-zend_string *phalcon_server_http_get_headers();
+zend_string *phalcon_server_http_get_headers(zval *headers, int keepalive, size_t content_length);
+void phalcon_server_http_reset_headers();
 
 #endif /* PHALCON_SERVER_UTILS_H */
@@ -119,6 +119,42 @@ class AnnotationsAdaptersTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($property->count(), 4);
 	}
 
+	public function testYacAdapter()
+	{
+		$adapter = new Phalcon\Annotations\Adapter\Yac();
+
+		$classAnnotations = $adapter->get('TestClass');
+		$this->assertTrue(is_object($classAnnotations));
+		$this->assertEquals(get_class($classAnnotations), 'Phalcon\Annotations\Reflection');
+		$this->assertEquals(get_class($classAnnotations->getClassAnnotations()), 'Phalcon\Annotations\Collection');
+
+		// A new adapter reads the entry from the shared memory when yac is enabled
+		$adapter = new Phalcon\Annotations\Adapter\Yac();
+
+		$classAnnotations = $adapter->get('TestClass');
+		$this->assertTrue(is_object($classAnnotations));
+		$this->assertEquals(get_class($classAnnotations->getClassAnnotations()), 'Phalcon\Annotations\Collection');
+
+		$method = $adapter->getMethod('TestClass', 'testMethod1');
+		$this->assertEquals(get_class($method), 'Phalcon\Annotations\Collection');
+		$this->assertEquals($method->count(), 5);
+		$this->assertTrue($method->has('NamedMultipleParams'));
+
+		// The collection of a member is built once
+		$this->assertSame($adapter->getMethod('TestClass', 'testMethod1'), $method);
+
+		$property = $adapter->getProperty('TestClass', 'testProp1');
+		$this->assertEquals(get_class($property), 'Phalcon\Annotations\Collection');
+		$this->assertEquals($property->count(), 4);
+		$this->assertSame($adapter->getProperty('TestClass', 'testProp1'), $property);
+
+		$property = $adapter->getProperty('TestClass', 'unknownProperty');
+		$this->assertEquals($property->count(), 0);
+
+		$reader = new Phalcon\Annotations\Reader();
+		$this->assertEquals($classAnnotations->getReflectionData(), $reader->parse('TestClass'));
+	}
+
 	public function testCacheAdapter()
 	{
 		$frontCache = new Phalcon\Cache\Frontend\Data(array('lifetime' => 1800));
@@ -304,4 +304,43 @@ class ApplicationMvcTest extends PHPUnit\Framework\TestCase
 		$loader->unregister();
 	}
 
+	public function testApplicationStreamingView()
+	{
+		// Creates the autoloader
+		$loader = new \Phalcon\Loader();
+
+		$loader->registerDirs(array(
+			'unit-tests/controllers/'
+		));
+
+		$loader->register();
+
+		foreach (array('Phalcon\Http\Response' => '', 'CustomResponse' => 'Response') as $responseClass => $suffix) {
+			$_GET['_url'] = '/test2/index';
+
+			Phalcon\Di::reset();
+			$di = new Phalcon\Di\FactoryDefault();
+
+			$di->set('view', function() {
+				$view = new \Phalcon\Mvc\View();
+				$view->enableStreaming();
+				$view->setViewsDir('unit-tests/views/');
+				return $view;
+			});
+			$di->set('response', $responseClass);
+
+			$application = new Phalcon\Mvc\Application();
+			$application->setDi($di);
+
+			$response = $application->handle();
+			$this->assertInstanceOf($responseClass, $response);
+
+			ob_start();
+			$response->send();
+			$this->assertEquals(ob_get_clean(), '<html>here</html>'.PHP_EOL.$suffix);
+		}
+
+		$loader->unregister();
+	}
+
 }
@@ -270,6 +270,74 @@ class CacheTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals(3, $cache->get('foo'));
 	}
 
+	public function testMemoryCacheMultiple()
+	{
+		$frontCache = new Phalcon\Cache\Frontend\Data(array('lifetime' => 10));
+
+		$fast = new Phalcon\Cache\Backend\Memory($frontCache, array('prefix' => 'fast'));
+		$slow = new Phalcon\Cache\Backend\Memory($frontCache, array('prefix' => 'slow'));
+
+		$this->assertTrue($slow->saveMultiple(array('a' => 1, 'b' => array(2, 3), 'c' => null)));
+		$this->assertEquals($slow->getMultiple(array('a', 'b', 'c')), array('a' => 1, 'b' => array(2, 3), 'c' => null));
+
+		$cache = new Phalcon\Cache\Multiple(array($fast, $slow));
+
+		$this->assertEquals($cache->getMultiple(array('b', 'x', 'a')), array('b' => array(2, 3), 'x' => null, 'a' => 1));
+
+		//The faster backend is filled with the keys it missed
+		$this->assertEquals($fast->get('a'), 1);
+		$this->assertEquals($fast->get('b'), array(2, 3));
+
+		$this->assertTrue($cache->deleteMultiple(array('a', 'b')));
+		$this->assertEquals($cache->getMultiple(array('a', 'b')), array('a' => null, 'b' => null));
+	}
+
+	public function testMemoryCacheGetOrCompute()
+	{
+		$frontCache = new Phalcon\Cache\Frontend\Data(array('lifetime' => 10));
+
+		$cache = new Phalcon\Cache\Backend\Memory($frontCache, array('prefix' => 'unit'));
+
+		$calls = 0;
+		$producer = function($key) use (&$calls) {
+			$calls++;
+			return array($key, $calls);
+		};
+
+		$this->assertEquals($cache->getOrCompute('computed', $producer, 10, 5), array('computed', 1));
+		$this->assertEquals($cache->getOrCompute('computed', $producer, 10, 5), array('computed', 1));
+		$this->assertEquals($calls, 1);
+
+		//Expired entries are regenerated by the process holding the lock
+		$this->assertEquals($cache->getOrCompute('stale', $producer, 0, 5), array('stale', 2));
+		$this->assertEquals($cache->getOrCompute('stale', $producer, 0, 5), array('stale', 3));
+		$this->assertEquals($calls, 3);
+
+		//Producers calling getOrCompute() don't wait for the locks their process holds
+		$start = microtime(true);
+		$nested = function($key) use ($cache, $producer) {
+			if ($key == 'outer') {
+				return array($cache->getOrCompute('inner', $producer, 10), $cache->getOrCompute('outer', $producer, 10));
+			}
+		};
+		$this->assertEquals($cache->getOrCompute('outer', $nested, 10), array(array('inner', 4), array('outer', 5)));
+		$this->assertTrue(microtime(true) - $start < 0.5);
+
+		//A producer that throws releases the lock
+		try {
+			$cache->getOrCompute('failed', function($key) {
+				throw new Exception('failed');
+			}, 10);
+			$this->assertTrue(false);
+		} catch (Exception $e) {
+			$this->assertEquals($e->getMessage(), 'failed');
+		}
+
+		$start = microtime(true);
+		$this->assertEquals($cache->getOrCompute('failed', $producer, 10), array('failed', 6));
+		$this->assertTrue(microtime(true) - $start < 0.5);
+	}
+
 	private function _prepareIgbinary()
 	{
 
@@ -1135,6 +1135,31 @@ class DbDialectTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($dialect->describeColumns('table', 'database.name.with.dots'), "PRAGMA table_info('table')");
 	}
 
+	public function testMultipleInserts()
+	{
+		$fields = array('"id"', '"name"', '"type"');
+		$rows = array(array('?', '?', '?'), array('?', 'null', '?'));
+
+		// Mysql
+		$dialect = new \Phalcon\Db\Dialect\Mysql();
+
+		$this->assertEquals($dialect->insertMultiple('`robots`', array('`id`', '`name`'), array(array('?', '?'), array('?', '?'))), 'INSERT INTO `robots` (`id`, `name`) VALUES (?, ?), (?, ?)');
+		$this->assertEquals($dialect->upsertMultiple('`robots`', array('`id`', '`name`'), array(array('?', '?'), array('?', '?')), array('`name`'), array('`id`')), 'INSERT INTO `robots` (`id`, `name`) VALUES (?, ?), (?, ?) ON DUPLICATE KEY UPDATE `name` = VALUES(`name`)');
+
+		// Postgresql
+		$dialect = new \Phalcon\Db\Dialect\Postgresql();
+
+		$this->assertEquals($dialect->insertMultiple('"robots"', $fields, $rows), 'INSERT INTO "robots" ("id", "name", "type") VALUES (?, ?, ?), (?, null, ?)');
+		$this->assertEquals($dialect->upsertMultiple('"robots"', $fields, $rows, null, array('"id"')), 'INSERT INTO "robots" ("id", "name", "type") VALUES (?, ?, ?), (?, null, ?) ON CONFLICT ("id") DO UPDATE SET "name" = EXCLUDED."name", "type" = EXCLUDED."type"');
+		$this->assertEquals($dialect->upsertMultiple('"robots"', array('"id"'), array(array('?')), null, array('"id"')), 'INSERT INTO "robots" ("id") VALUES (?) ON CONFLICT ("id") DO NOTHING');
+
+		// SQLite
+		$dialect = new \Phalcon\Db\Dialect\Sqlite();
+
+		$this->assertEquals($dialect->insertMultiple('"robots"', $fields, $rows), 'INSERT INTO "robots" ("id", "name", "type") VALUES (?, ?, ?), (?, null, ?)');
+		$this->assertEquals($dialect->upsertMultiple('"robots"', $fields, $rows, null, array('"id"')), 'INSERT OR REPLACE INTO "robots" ("id", "name", "type") VALUES (?, ?, ?), (?, null, ?)');
+	}
+
 	public function testViews()
 	{
 		// MySQL
@@ -84,6 +84,10 @@ class DbProfilerTest extends PHPUnit\Framework\TestCase
 		$connection = new Phalcon\Db\Adapter\Pdo\Mysql($configMysql);
 
 		$this->_executeTests($connection);
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Mysql(array_merge($configMysql, array('statementCacheSize' => 2)));
+
+		$this->_executeTestsStatementCache($connection);
 	}
 
 	public function testDbPostgresql()
@@ -98,6 +102,10 @@ class DbProfilerTest extends PHPUnit\Framework\TestCase
 		$connection = new Phalcon\Db\Adapter\Pdo\Postgresql($configPostgresql);
 
 		$this->_executeTests($connection);
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Postgresql(array_merge($configPostgresql, array('statementCacheSize' => 2)));
+
+		$this->_executeTestsStatementCache($connection);
 	}
 
 	public function testDbSqlite()
@@ -112,6 +120,10 @@ class DbProfilerTest extends PHPUnit\Framework\TestCase
 		$connection = new Phalcon\Db\Adapter\Pdo\Sqlite($configSqlite);
 
 		$this->_executeTests($connection);
+
+		$connection = new Phalcon\Db\Adapter\Pdo\Sqlite(array_merge($configSqlite, array('statementCacheSize' => 2)));
+
+		$this->_executeTestsStatementCache($connection);
 	}
 
 	public function _executeTests($connection)
@@ -164,4 +176,50 @@ class DbProfilerTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($profiler->getNumberTotalStatements(), 0);
 	}
 
+	public function _executeTestsStatementCache($connection)
+	{
+		$profiler = new Phalcon\Db\Profiler();
+		$connection->setProfiler($profiler);
+
+		$connection->query("SELECT * FROM personas LIMIT 3");
+		$connection->query("SELECT * FROM personas LIMIT 3");
+		$this->assertEquals($profiler->getStatementCacheMisses(), 1);
+		$this->assertEquals($profiler->getStatementCacheHits(), 1);
+
+		// A statement still used by a resultset is not reused
+		$result = $connection->query("SELECT * FROM personas LIMIT 3");
+		$connection->query("SELECT * FROM personas LIMIT 3");
+		$this->assertEquals($profiler->getStatementCacheMisses(), 2);
+		$this->assertEquals($profiler->getStatementCacheHits(), 2);
+		$this->assertEquals(count($result->fetchAll()), 3);
+		unset($result);
+
+		// The least recently used statement is evicted
+		$connection->query("SELECT * FROM personas LIMIT 5");
+		$connection->query("SELECT * FROM personas LIMIT 10");
+		$connection->query("SELECT * FROM personas LIMIT 3");
+		$this->assertEquals($profiler->getStatementCacheMisses(), 5);
+
+		$connection->close();
+		$connection->connect();
+		$connection->query("SELECT * FROM personas LIMIT 10");
+		$this->assertEquals($profiler->getStatementCacheMisses(), 6);
+		$this->assertEquals($profiler->getStatementCacheHits(), 2);
+
+		// A released statement has its cursor closed and is reused from the first row
+		$result = $connection->query("SELECT * FROM personas LIMIT 3");
+		$this->assertTrue(is_array($result->fetch()));
+		unset($result);
+
+		$connection->query("SELECT * FROM personas LIMIT 10");
+
+		$result = $connection->query("SELECT * FROM personas LIMIT 3");
+		$this->assertEquals($profiler->getStatementCacheHits(), 4);
+		$this->assertEquals(count($result->fetchAll()), 3);
+		unset($result);
+
+		$profiler->reset();
+		$this->assertEquals($profiler->getStatementCacheHits(), 0);
+		$this->assertEquals($profiler->getStatementCacheMisses(), 0);
+	}
 }
@@ -110,6 +110,62 @@ class DbTest extends PHPUnit\Framework\TestCase
 
 	}
 
+	public function testDbPool()
+	{
+		if (!extension_loaded('pdo_sqlite')) {
+			$this->markTestSkipped("Skipped");
+			return;
+		}
+
+		$primary = new Phalcon\Db\Adapter\Pdo\Sqlite(array('dbname' => ':memory:'));
+		$replica1 = new Phalcon\Db\Adapter\Pdo\Sqlite(array('dbname' => ':memory:'));
+		$replica2 = new Phalcon\Db\Adapter\Pdo\Sqlite(array('dbname' => ':memory:'));
+
+		$pool = new Phalcon\Db\Pool(array('cooldown' => 60, 'maxLag' => 5));
+		$pool->addWriteConnection($primary);
+		$pool->addReadConnection($replica1, 2);
+		$pool->addReadConnection(function() use ($replica2) {
+			return $replica2;
+		});
+
+		// Weighted round-robin
+		$this->assertSame($pool->getReadConnection(), $replica1);
+		$this->assertSame($pool->getReadConnection(), $replica2);
+		$this->assertSame($pool->getReadConnection(), $replica1);
+		$this->assertSame($pool->getReadConnection(), $replica1);
+
+		// Unhealthy and lagging replicas are skipped
+		$this->assertTrue($pool->markUnhealthy($replica1));
+		$this->assertSame($pool->getReadConnection(), $replica2);
+		$this->assertTrue($pool->setReplicationLag($replica2, 10));
+		$this->assertSame($pool->getReadConnection(), $primary);
+		$pool->setReplicationLag($replica2, 0);
+
+		// Reads are pinned to the primary after a write
+		$this->assertSame($pool->getWriteConnection('robots'), $primary);
+		$this->assertTrue($pool->isPinned('robots'));
+		$this->assertFalse($pool->isPinned('parts'));
+		$this->assertSame($pool->getReadConnection('robots'), $primary);
+		$this->assertSame($pool->getReadConnection('parts'), $replica2);
+
+		$pool->pin();
+		$this->assertSame($pool->getReadConnection('parts'), $primary);
+
+		$pool->unpin();
+		$this->assertFalse($pool->isPinned('robots'));
+		$this->assertSame($pool->getReadConnection('robots'), $replica2);
+
+		// Least outstanding
+		$pool = new Phalcon\Db\Pool(array('strategy' => Phalcon\Db\Pool::STRATEGY_LEAST_OUTSTANDING));
+		$pool->addWriteConnection($primary);
+		$pool->addReadConnection($replica1);
+		$pool->addReadConnection($replica2);
+
+		$this->assertSame($pool->getReadConnection(), $replica1);
+		$this->assertSame($pool->getReadConnection(), $replica2);
+		$this->assertSame($pool->getReadConnection(), $replica1);
+	}
+
 	protected function _executeTests($connection)
 	{
 
@@ -427,4 +427,35 @@ class DiTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals(get_class($di->eventsManager), 'Phalcon\Events\Manager');
 		$loader->unregister();
 	}
+
+	public function testResolveEvents()
+	{
+		$eventsManager = new Phalcon\Events\Manager();
+		$this->_di->setEventsManager($eventsManager);
+
+		$this->_di->set('component', function() {
+			return new SomeComponent($this);
+		});
+
+		// Nothing is listening to the container
+		$eventsManager->attach('dispatch', function() {});
+		$component = $this->_di->get('component');
+		$this->assertSame($component->someProperty, $this->_di);
+
+		$resolved = array();
+		$eventsManager->attach('di:afterServiceResolve', function($event, $di, $data) use (&$resolved) {
+			$resolved[] = $data['name'];
+		});
+
+		$this->_di->get('component');
+		$this->_di->get('SimpleComponent');
+		$this->assertEquals($resolved, array('component', 'SimpleComponent'));
+
+		// String definitions are looked up again when they change
+		$service = $this->_di->set('simple', 'SimpleComponent');
+		$this->assertInstanceOf('SimpleComponent', $this->_di->get('simple'));
+		$service->setDefinition('InjectableComponent');
+		$this->assertInstanceOf('InjectableComponent', $this->_di->get('simple'));
+		$this->assertInstanceOf('InjectableComponent', $this->_di->get('simple'));
+	}
 }
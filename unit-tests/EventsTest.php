@@ -223,6 +223,54 @@ class EventsTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($number, 2);
 	}
 
+	public function testEventsDispatchCache()
+	{
+		$eventsManager = new Phalcon\Events\Manager();
+
+		$this->assertNull($eventsManager->fire('some-type:beforeSome', $this));
+		$this->assertNull($eventsManager->getCurrentEvent());
+
+		$calls = array();
+		$first = function($event, $component, $data) use (&$calls) {
+			$calls[] = 'first';
+		};
+		$second = function($event, $component, $data) use (&$calls) {
+			$calls[] = 'second';
+		};
+
+		$eventsManager->attach('some-type', $first);
+		$eventsManager->fire('some-type:beforeSome', $this);
+		$this->assertEquals($calls, array('first'));
+		$this->assertInstanceOf('Phalcon\Events\Event', $eventsManager->getCurrentEvent());
+
+		$eventsManager->attach('some-type:beforeSome', $second);
+		$eventsManager->fire('some-type:beforeSome', $this);
+		$this->assertEquals($calls, array('first', 'first', 'second'));
+
+		$eventsManager->detach('some-type', $first);
+		$eventsManager->fire('some-type:beforeSome', $this);
+		$this->assertEquals($calls, array('first', 'first', 'second', 'second'));
+
+		$eventsManager->detachAll('some-type:beforeSome');
+		$this->assertNull($eventsManager->fire('some-type:beforeSome', $this));
+		$this->assertEquals(count($calls), 4);
+	}
+
+	public function testEventsDispatchCachePriorities()
+	{
+		$eventsManager = new Phalcon\Events\Manager();
+		$eventsManager->enablePriorities(true);
+
+		$calls = array();
+		$eventsManager->attach('some-type', function() use (&$calls) { $calls[] = 'low'; }, 10);
+		$eventsManager->attach('some-type', function() use (&$calls) { $calls[] = 'high'; }, 200);
+
+		$eventsManager->fire('some-type:beforeSome', $this);
+		$eventsManager->fire('some-type:beforeSome', $this);
+
+		$this->assertEquals($calls, array('high', 'low', 'high', 'low'));
+	}
+
 	public function testEventsWeakref()
 	{
 		if (!class_exists('WeakRef')) {
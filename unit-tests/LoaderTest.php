@@ -224,4 +224,120 @@ class LoaderTest extends PHPUnit\Framework\TestCase
 		$loader->unregister();
 	}
 
+	public function testClassMap()
+	{
+
+		$file = sys_get_temp_dir() . '/phalcon-loader-classmap.php';
+
+		$loader = new Phalcon\Loader();
+
+		$loader->registerDirs(array(
+			"unit-tests/vendor/example/other"
+		));
+
+		$loader->registerNamespaces(array(
+			"Example\Adapter" => "unit-tests/vendor/example/adapter/"
+		));
+
+		$loader->registerPrefixes(array(
+			"Pseudo" => "unit-tests/vendor/example/Pseudo/"
+		));
+
+		$classMap = $loader->dumpClassMap($file);
+
+		$this->assertEquals($classMap['VousTest'], 'unit-tests/vendor/example/other/VousTest.php');
+		$this->assertEquals($classMap['Example\Adapter\Some'], 'unit-tests/vendor/example/adapter/Some.php');
+		$this->assertEquals($classMap['Pseudo_Some_Something'], 'unit-tests/vendor/example/Pseudo/Some/Something.php');
+		$this->assertFalse(isset($classMap['Example\Adapter\LeAnotherSome']));
+		$this->assertEquals(require $file, $classMap);
+
+		$loader = new Phalcon\Loader();
+
+		$loader->loadClassMap($file, true);
+
+		$this->assertEquals($loader->getClasses(), $classMap);
+
+		$loader->register();
+
+		$test = new VousTest();
+		$this->assertEquals(get_class($test), 'VousTest');
+
+		$this->assertFalse(class_exists('VousTest4'));
+
+		$loader->unregister();
+
+		unlink($file);
+	}
+
+	public function testClassMapPseudoSeparator()
+	{
+
+		$file = sys_get_temp_dir() . '/phalcon-loader-classmap-pseudo.php';
+
+		$loader = new Phalcon\Loader();
+
+		$loader->registerDirs(array(
+			"unit-tests/vendor/example/"
+		));
+
+		$loader->registerNamespaces(array(
+			"Example" => "unit-tests/vendor/example/"
+		));
+
+		$classMap = $loader->dumpClassMap($file);
+
+		$this->assertEquals($classMap['Pseudo\Some\Something'], 'unit-tests/vendor/example/Pseudo/Some/Something.php');
+		$this->assertEquals($classMap['Pseudo_Some_Something'], 'unit-tests/vendor/example/Pseudo/Some/Something.php');
+		$this->assertEquals($classMap['Example\Pseudo_Base'], 'unit-tests/vendor/example/Pseudo/Base.php');
+		$this->assertEquals($classMap['Example\Pseudo\Some_Something'], 'unit-tests/vendor/example/Pseudo/Some/Something.php');
+
+		$loader = new Phalcon\Loader();
+
+		$loader->loadClassMap($file, true);
+
+		$loader->register();
+
+		$some = new Pseudo_Some_Something();
+		$this->assertEquals(get_class($some), 'Pseudo_Some_Something');
+
+		$loader->unregister();
+
+		unlink($file);
+	}
+
+	public function testMissingClasses()
+	{
+
+		$loader = new Phalcon\Loader();
+
+		$loader->registerDirs(array(
+			"unit-tests/vendor/example/other/"
+		));
+
+		$eventsManager = new Phalcon\Events\Manager();
+
+		$checks = 0;
+
+		$eventsManager->attach('loader:beforeCheckClass', function($event, $loader) use (&$checks) {
+			$checks++;
+		});
+
+		$loader->setEventsManager($eventsManager);
+
+		$loader->register();
+
+		$this->assertFalse(class_exists('VousTest5'));
+		$this->assertFalse(class_exists('VousTest5'));
+		$this->assertEquals($checks, 1);
+
+		$loader->registerDirs(array(
+			"unit-tests/vendor/example/"
+		), true);
+
+		$this->assertFalse(class_exists('VousTest5'));
+		$this->assertEquals($checks, 2);
+
+		$loader->unregister();
+	}
+
 }
@@ -96,6 +96,16 @@ class ModelsDynamicOperationsTest extends PHPUnit\Framework\TestCase
 
 		$tracer = array();
 		$this->_executeTestsRenamed($di, $tracer);
+
+		$tracer = array();
+		$this->_executeTestsSnapshotsWithinMethods($di, $tracer);
+
+		Phalcon\Mvc\Model::setup(array('snapshots' => false));
+
+		$tracer = array();
+		$this->_executeTestsWithoutSnapshots($di, $tracer);
+
+		Phalcon\Mvc\Model::setup(array('snapshots' => true));
 	}
 
 	protected function _executeTestsNormal($di, &$tracer)
@@ -141,4 +151,53 @@ class ModelsDynamicOperationsTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals('UPDATE `personas` SET `nombres` = :navnes, `direccion` = :adresse WHERE `personas`.`cedula` = :pha_borgerId', $tracer[4]);
 	}
 
+	protected function _executeTestsSnapshotsWithinMethods($di, &$tracer)
+	{
+		$persona = Dynamic\Personas::findFirst();
+		$this->assertTrue($persona->hasSnapshotData());
+
+		// Writes made inside the model are compared against the snapshot
+		$persona->nombres = 'Name '.mt_rand(0, 150000);
+		$this->assertTrue($persona->save());
+		$count = count($tracer);
+
+		$persona->appendToNombres('!');
+		$this->assertEquals($persona->getChangedFields(), array('nombres'));
+		$this->assertTrue($persona->save());
+
+		$this->assertEquals(count($tracer), $count + 1);
+		$this->assertEquals('UPDATE `personas` SET `nombres` = :nombres WHERE `personas`.`cedula` = :pha_cedula', end($tracer));
+
+		// Writing back the same value doesn't update anything
+		$persona->appendToNombres('');
+		$this->assertTrue($persona->save());
+		$this->assertEquals(count($tracer), $count + 1);
+	}
+
+	protected function _executeTestsWithoutSnapshots($di, &$tracer)
+	{
+		$persona = Dynamic\Personas::findFirst();
+		$this->assertFalse($persona->hasSnapshotData());
+		$this->assertEquals($persona->getChangedFields(), array());
+
+		$persona->nombres = 'Other Name '.mt_rand(0, 150000);
+		$this->assertTrue($persona->hasChanged('nombres'));
+		$this->assertFalse($persona->hasChanged('direccion'));
+		$this->assertEquals($persona->getChangedFields(), array('nombres'));
+		$this->assertTrue($persona->save());
+
+		// Without a snapshot every field is updated
+		$this->assertEquals(strpos(end($tracer), 'UPDATE `personas` SET `tipo_documento_id` = :tipo_documento_id, `nombres` = :nombres'), 0);
+		$this->assertFalse($persona->hasChanged());
+
+		// Writes made inside the model are not lost
+		$nombres = $persona->nombres;
+		$persona->appendToNombres('!');
+		$this->assertTrue($persona->save());
+		$this->assertTrue(strpos(end($tracer), '`nombres` = :nombres') !== false);
+
+		$persona = Dynamic\Personas::findFirst(array('cedula = ?0', 'bind' => array($persona->cedula)));
+		$this->assertEquals($persona->nombres, $nombres.'!');
+	}
+
 }
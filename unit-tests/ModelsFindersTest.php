@@ -77,6 +77,7 @@ class ModelsFindersTest extends PHPUnit\Framework\TestCase
 
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
+		$this->_executeTestsIdentityMap($di);
 	}
 
 	public function testModelsSqlite()
@@ -96,6 +97,7 @@ class ModelsFindersTest extends PHPUnit\Framework\TestCase
 
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
+		$this->_executeTestsIdentityMap($di);
 	}
 
 	protected function _executeTestsNormal($di)
@@ -117,6 +119,46 @@ class ModelsFindersTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($number, 2);
 	}
 
+	protected function _executeTestsIdentityMap($di)
+	{
+		$manager = $di->getShared('modelsManager');
+		$this->assertFalse($manager->isUsingIdentityMap());
+
+		$this->assertNotSame(Robots::findFirst(1), Robots::findFirst(1));
+
+		$manager->useIdentityMap(true);
+
+		$robot = Robots::findFirst(1);
+		$this->assertSame($robot, Robots::findFirst(1));
+		$this->assertSame($robot, $manager->getIdentity('Robots', 1));
+		$this->assertNotSame($robot, Robots::findFirst(2));
+
+		$robot->refresh();
+		$this->assertNull($manager->getIdentity('Robots', 1));
+		$this->assertNotSame($robot, Robots::findFirst(1));
+
+		$manager->clearIdentityMap();
+		$this->assertNull($manager->getIdentity('Robots', 1));
+
+		// Partial rows are never mapped
+		$row = Robots::findFirst(array('id = 1', 'columns' => 'id, name'));
+		$this->assertInstanceOf('Phalcon\Mvc\Model\Row', $row);
+		$this->assertFalse($manager->addIdentity($row));
+		$this->assertNull($manager->getIdentity('Robots', 1));
+
+		// Relations asked with parameters don't come from the map
+		$robot = Robots::findFirst(1);
+		$robotPart = RobotsParts::findFirst('robots_id = 1');
+		$this->assertSame($robot, $robotPart->getRobots());
+		$row = $robotPart->getRobots(array('columns' => 'id, name'));
+		$this->assertInstanceOf('Phalcon\Mvc\Model\Row', $row);
+		$this->assertEquals($row->id, 1);
+		$this->assertFalse($robotPart->getRobots('id = 2'));
+		$this->assertSame($robot, $manager->getIdentity('Robots', 1));
+
+		$manager->useIdentityMap(false);
+	}
+
 	protected function _executeTestsRenamed($di)
 	{
 
@@ -84,6 +84,7 @@ class ModelsHydrationTest extends PHPUnit\Framework\TestCase
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
 		$this->_executeTestsNormalComplex($di);
+		$this->_executeTestsColumnar($di);
 	}
 
 	public function testModelsPostgresql()
@@ -104,6 +105,7 @@ class ModelsHydrationTest extends PHPUnit\Framework\TestCase
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
 		$this->_executeTestsNormalComplex($di);
+		$this->_executeTestsColumnar($di);
 	}
 
 	public function testModelsSQLite()
@@ -124,6 +126,7 @@ class ModelsHydrationTest extends PHPUnit\Framework\TestCase
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
 		$this->_executeTestsNormalComplex($di);
+		$this->_executeTestsColumnar($di);
 	}
 
 	protected function _executeTestsNormal($di)
@@ -268,6 +271,44 @@ class ModelsHydrationTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($number, 33 * 4);
 	}
 
+	protected function _executeTestsColumnar($di)
+	{
+		$number = 0;
+
+		$robots = Robots::find(array('order' => 'id'));
+		$robots->setHydrateMode(Phalcon\Mvc\Model\Resultset::HYDRATE_COLUMNAR);
+
+		foreach ($robots as $robot) {
+			$this->assertEquals(get_class($robot), 'Phalcon\Mvc\Model\Row\Columnar');
+			$this->assertEquals(count($robot), 4);
+			$this->assertTrue(isset($robot->name));
+			$this->assertEquals($robot['name'], $robot->name);
+			$number++;
+		}
+
+		$this->assertEquals($number, 3);
+
+		$ids = $robots->column('id');
+		$this->assertEquals(count($ids), 3);
+		$this->assertTrue(is_int($ids[0]));
+		$this->assertEquals($robots[1]->id, $ids[1]);
+		$this->assertEquals(count($robots->toArray()), 3);
+
+		$number = 0;
+
+		$people = Personers::find(array('limit' => 33));
+		$people->setHydrateMode(Phalcon\Mvc\Model\Resultset::HYDRATE_COLUMNAR);
+
+		foreach ($people as $person) {
+			$this->assertTrue(isset($person->navnes));
+			$this->assertTrue(isset($person['navnes']));
+			$number++;
+		}
+
+		$this->assertEquals($number, 33);
+		$this->assertEquals(count($people->column('navnes')), 33);
+	}
+
 	protected function _executeTestsNormalComplex($di)
 	{
 		$result = $di->get('modelsManager')->executeQuery('SELECT id FROM Robots');
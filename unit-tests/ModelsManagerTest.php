@@ -19,6 +19,14 @@
   +------------------------------------------------------------------------+
 */
 
+class BatchSubscriptores extends Phalcon\Mvc\Model
+{
+	public function getSource()
+	{
+		return 'subscriptores';
+	}
+}
+
 class ModelsManagerTest extends PHPUnit\Framework\TestCase
 {
 
@@ -54,6 +62,10 @@ class ModelsManagerTest extends PHPUnit\Framework\TestCase
 			return $manager;
 		});
 
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Memory();
+		});
+
 		$di->set('db', $dbService, true);
 
 		return $di;
@@ -74,6 +86,7 @@ class ModelsManagerTest extends PHPUnit\Framework\TestCase
 		});
 
 		$this->_executeTestsNormal($di);
+		$this->_executeTestsSaveBatch($di);
 	}
 
 	public function testModelsPostgresql()
@@ -90,6 +103,7 @@ class ModelsManagerTest extends PHPUnit\Framework\TestCase
 		});
 
 		$this->_executeTestsNormal($di);
+		$this->_executeTestsSaveBatch($di);
 	}
 
 	public function testModelsSqlite()
@@ -106,6 +120,7 @@ class ModelsManagerTest extends PHPUnit\Framework\TestCase
 		});
 
 		$this->_executeTestsNormal($di);
+		$this->_executeTestsSaveBatch($di);
 	}
 
 	protected function _executeTestsNormal($di)
@@ -129,4 +144,39 @@ class ModelsManagerTest extends PHPUnit\Framework\TestCase
 		$query->setDI($di);
 		$this->assertEquals($query->parse(), $expected);
 	}
+
+	protected function _executeTestsSaveBatch($di)
+	{
+		$connection = $di->getShared('db');
+		$connection->delete('subscriptores', "email LIKE 'batch%'");
+
+		$subscriptores = array();
+		for ($i = 0; $i < 3; $i++) {
+			$subscriptor = new BatchSubscriptores();
+			$subscriptor->email = 'batch'.$i.'@hotmail.com';
+			$subscriptor->created_at = '2012-04-14 23:30:33';
+			$subscriptor->status = 'P';
+			$subscriptores[] = $subscriptor;
+		}
+
+		$this->assertTrue($di->getShared('modelsManager')->saveBatch($subscriptores));
+
+		foreach ($subscriptores as $subscriptor) {
+			$this->assertEquals($subscriptor->getDirtyState(), Phalcon\Mvc\Model::DIRTY_STATE_PERSISTENT);
+			$this->assertTrue($subscriptor->id > 0);
+
+			$record = BatchSubscriptores::findFirst($subscriptor->id);
+			$this->assertEquals($record->email, $subscriptor->email);
+		}
+
+		// Saving again updates the batch records instead of inserting them twice
+		$subscriptor = $subscriptores[1];
+		$subscriptor->status = 'I';
+		$this->assertTrue($subscriptor->save());
+
+		$this->assertEquals(BatchSubscriptores::count("email LIKE 'batch%'"), 3);
+		$this->assertEquals(BatchSubscriptores::findFirst($subscriptor->id)->status, 'I');
+
+		$connection->delete('subscriptores', "email LIKE 'batch%'");
+	}
 }
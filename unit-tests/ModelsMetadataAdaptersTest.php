@@ -288,6 +288,47 @@ class ModelsMetadataAdaptersTest extends PHPUnit\Framework\TestCase
 		Robots::findFirst();
 	}
 
+	public function testMetadataSnapshot()
+	{
+		require 'unit-tests/config.db.php';
+		if (empty($configMysql)) {
+			$this->markTestSkipped('Test skipped');
+			return;
+		}
+
+		$di = $this->_getDI();
+
+		$di->set('modelsMetadata', function(){
+			return new Phalcon\Mvc\Model\Metadata\Snapshot(array(
+				'snapshotFile' => 'unit-tests/cache/metadata-snapshot.php',
+			));
+		});
+
+		$metaData = $di->getShared('modelsMetadata');
+
+		$metaData->reset();
+
+		$this->assertTrue($metaData->isEmpty());
+
+		$this->assertTrue($metaData->compile(array('Robots')));
+
+		$snapshot = require 'unit-tests/cache/metadata-snapshot.php';
+		$this->assertEquals($snapshot['meta']['robots-robots'], $this->_data['meta-robots-robots']);
+		$this->assertEquals($snapshot['map']['robots-robots'], $this->_data['map-robots-robots']);
+
+		$metaData = new Phalcon\Mvc\Model\Metadata\Snapshot(array(
+			'snapshotFile' => 'unit-tests/cache/metadata-snapshot.php',
+		));
+		$metaData->setDI($di);
+
+		$this->assertFalse($metaData->isEmpty());
+		$this->assertEquals($metaData->getDataTypes(new Robots()), $this->_data['meta-robots-robots'][Phalcon\Mvc\Model\MetaData::MODELS_DATA_TYPES]);
+
+		$metaData->reset();
+		$this->assertTrue($metaData->isEmpty());
+		$this->assertFalse(file_exists('unit-tests/cache/metadata-snapshot.php'));
+	}
+
 	public function testMetadataMemcached()
 	{
 		if (!extension_loaded('memcached')) {
@@ -28,6 +28,16 @@ class Issue_2019 extends \Phalcon\Mvc\Model
 	}
 }
 
+class RobotsShard extends \Phalcon\Mvc\Model
+{
+	public static $shard = 'robots';
+
+	public function selectSource($query)
+	{
+		return self::$shard;
+	}
+}
+
 class ModelsQueryExecuteTest extends PHPUnit\Framework\TestCase
 {
 
@@ -98,6 +108,8 @@ class ModelsQueryExecuteTest extends PHPUnit\Framework\TestCase
 
 		$this->_testIssue2019($di);
 		$this->_testIssue1803($di);
+		$this->_testSelectStreaming($di);
+		$this->_testSelectPlanCache($di);
 	}
 
 	public function testExecutePostgresql()
@@ -123,7 +135,8 @@ class ModelsQueryExecuteTest extends PHPUnit\Framework\TestCase
 		$this->_testUpdateRenamedExecute2($di);
 		$this->_testDeleteExecute2($di);
 		$this->_testDeleteRenamedExecute($di);
-
+		$this->_testSelectStreaming($di);
+		$this->_testSelectPlanCache($di);
 	}
 
 	public function testExecuteSqlite()
@@ -149,7 +162,8 @@ class ModelsQueryExecuteTest extends PHPUnit\Framework\TestCase
 		$this->_testUpdateRenamedExecute2($di);
 		$this->_testDeleteExecute2($di);
 		$this->_testDeleteRenamedExecute($di);
-
+		$this->_testSelectStreaming($di);
+		$this->_testSelectPlanCache($di);
 	}
 
 	public function _testIssue2019($di)
@@ -937,6 +951,150 @@ class ModelsQueryExecuteTest extends PHPUnit\Framework\TestCase
 
 	}
 
+	public function _testSelectStreaming($di)
+	{
+		$manager = $di->getShared('modelsManager');
+
+		$robots = $manager->createQuery('SELECT * FROM Robots ORDER BY id')->setStreaming(2)->execute();
+		$this->assertInstanceOf('Phalcon\Mvc\Model\Resultset\Simple', $robots);
+		$this->assertEquals($robots->getType(), Phalcon\Mvc\Model\Resultset::TYPE_RESULT_STREAM);
+
+		$ids = array();
+		foreach ($robots as $robot) {
+			$this->assertInstanceOf('Robots', $robot);
+			$ids[] = $robot->id;
+		}
+		$this->assertEquals($ids, array(1, 2, 3));
+		$this->assertEquals(count($robots), 3);
+
+		try {
+			foreach ($robots as $robot) {
+			}
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertEquals($e->getMessage(), 'Streaming resultsets can only be traversed once');
+		}
+
+		$robots = $manager->createQuery('SELECT * FROM Robots')->setStreaming(true)->execute();
+		try {
+			count($robots);
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		$number = 0;
+		foreach ($robots as $robot) {
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+
+		//Streamed rows can't be traversed again to load their relations
+		try {
+			$manager->createQuery('SELECT * FROM Robots')->setStreaming(true)->setWith('robotsParts')->execute();
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Query\Exception $e) {
+			$this->assertEquals($e->getMessage(), "Relations can't be eager loaded on streaming resultsets");
+		}
+
+		$robots = $manager->createQuery('SELECT * FROM Robots')->setStreaming(true)->execute();
+		try {
+			$manager->eagerLoad($robots, 'robotsParts');
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertEquals($e->getMessage(), "Relations can't be eager loaded on streaming resultsets");
+		}
+
+		//Columns are built by reading the rows again
+		$robots = $manager->createQuery('SELECT * FROM Robots')->setStreaming(true)->execute();
+		try {
+			$robots->setHydrateMode(Phalcon\Mvc\Model\Resultset::HYDRATE_COLUMNAR);
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertEquals($e->getMessage(), "Streaming resultsets can't be read by columns");
+		}
+
+		try {
+			$robots->column('id');
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Model\Exception $e) {
+			$this->assertEquals($e->getMessage(), "Streaming resultsets can't be read by columns");
+		}
+
+		$number = 0;
+		foreach ($robots as $robot) {
+			$number++;
+		}
+		$this->assertEquals($number, 3);
+	}
+
+	public function _testSelectPlanCache($di)
+	{
+		$manager = $di->getShared('modelsManager');
+
+		// The same statement is executed with a different number of bound values every time
+		for ($i = 1; $i <= 3; $i++) {
+			$robots = $manager->executeQuery('SELECT * FROM Robots WHERE id IN ({ids}) ORDER BY id', array('ids' => range(1, $i)));
+			$this->assertInstanceOf('Phalcon\Mvc\Model\Resultset\Simple', $robots);
+			$this->assertEquals(count($robots), $i);
+			$this->assertInstanceOf('Robots', $robots[$i - 1]);
+			$this->assertEquals($robots[$i - 1]->id, $i);
+		}
+
+		// Complex resultsets get the model instances back from the cached plan
+		for ($i = 0; $i < 2; $i++) {
+			$result = $manager->executeQuery('SELECT r.*, r.name AS robotName FROM Robots r WHERE r.id = :id: ORDER BY r.id', array('id' => 2));
+			$this->assertInstanceOf('Phalcon\Mvc\Model\Resultset\Complex', $result);
+			$this->assertEquals(count($result), 1);
+			$this->assertInstanceOf('Robots', $result[0]->r);
+			$this->assertEquals($result[0]->r->id, 2);
+			$this->assertEquals($result[0]->robotName, $result[0]->r->name);
+		}
+
+		// A statement changed by a listener is never taken from the plan cache
+		$eventsManager = new Phalcon\Events\Manager();
+		$eventsManager->attach('query:afterGenerateSQLStatement', function($event, $query, $sql) {
+			return $sql . ' LIMIT 1';
+		});
+
+		$query = $manager->createQuery('SELECT * FROM Robots ORDER BY id');
+		$query->setEventsManager($eventsManager);
+		$this->assertEquals(count($query->execute()), 1);
+		$this->assertEquals(count($manager->executeQuery('SELECT * FROM Robots ORDER BY id')), 3);
+
+		$robots = count($manager->executeQuery('SELECT id FROM Robots'));
+		$parts = count($manager->executeQuery('SELECT id FROM Parts'));
+
+		// Models choosing their source for every query are resolved every time
+		RobotsShard::$shard = 'robots';
+		$this->assertEquals(count($manager->executeQuery('SELECT id, name FROM RobotsShard')), $robots);
+		RobotsShard::$shard = 'parts';
+		$this->assertEquals(count($manager->executeQuery('SELECT id, name FROM RobotsShard')), $parts);
+		RobotsShard::$shard = 'robots';
+
+		// Changing the source of a model drops the plans resolved with the old one
+		$manager->setModelSource('Robots', 'parts');
+		$this->assertEquals(count($manager->executeQuery('SELECT id FROM Robots')), $parts);
+		$manager->setModelSource('Robots', 'robots');
+		$this->assertEquals(count($manager->executeQuery('SELECT id FROM Robots')), $robots);
+
+		// Another container doesn't share the plans of this one
+		$other = new Phalcon\Di();
+		$other->setShared('modelsManager', function() {
+			$manager = new Phalcon\Mvc\Model\Manager();
+			$manager->setModelSource('Robots', 'parts');
+			return $manager;
+		});
+		$other->setShared('modelsMetadata', new Phalcon\Mvc\Model\Metadata\Memory());
+		$other->setShared('db', $di->getShared('db'));
+
+		$query = new Query('SELECT id FROM Robots', $other);
+		$this->assertEquals(count($query->execute()), $parts);
+		Phalcon\Di::setDefault($di);
+
+		$this->assertEquals(count($manager->executeQuery('SELECT id FROM Robots')), $robots);
+	}
+
 	public function _testIssue1803($di)
 	{
 		$manager = $di->getShared('modelsManager');
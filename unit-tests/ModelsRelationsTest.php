@@ -120,6 +120,7 @@ class ModelsRelationsTest extends PHPUnit\Framework\TestCase
 		$this->_executeTestsNormal($di);
 		$this->_executeTestsRenamed($di);
 		$this->_testIssue938($di);
+		$this->_testEagerLoading($di);
 	}
 
 	public function _executeTestsNormal($di)
@@ -327,6 +328,63 @@ class ModelsRelationsTest extends PHPUnit\Framework\TestCase
 
 	}
 
+	protected function _testEagerLoading($di)
+	{
+		$robots = RelationsRobots::find(array(
+			'order' => 'id',
+			'with' => array('relationsRobotsParts', 'relationsRobotsParts.relationsParts', 'relationsParts')
+		));
+
+		$queries = 0;
+		$eventsManager = new Phalcon\Events\Manager();
+		$eventsManager->attach('db:beforeQuery', function() use (&$queries) {
+			$queries++;
+		});
+		$di->getShared('db')->setEventsManager($eventsManager);
+
+		$robot = $robots->getFirst();
+
+		$robotsParts = $robot->relationsRobotsParts;
+		$this->assertEquals(get_class($robotsParts), 'Phalcon\Mvc\Model\Resultset\Simple');
+		$this->assertEquals(count($robotsParts), 3);
+		$this->assertEquals(get_class($robotsParts->getFirst()->relationsParts), 'RelationsParts');
+		$this->assertEquals($robotsParts->getFirst()->relationsParts->id, $robotsParts->getFirst()->parts_id);
+
+		$this->assertEquals(count($robot->relationsParts), 3);
+		$this->assertEquals(count($robotsParts->toArray()), 3);
+
+		$this->assertEquals($queries, 0);
+
+		$robots = RelationsRobots::query()->with('relationsRobotsParts')->execute();
+		$this->assertEquals(count($robots->getFirst()->relationsRobotsParts), 3);
+		$this->assertEquals($queries, 2);
+
+		//Keys beyond the bind parameters of the connection are loaded in several queries
+		$db = $di->getShared('db');
+		$property = new ReflectionProperty($db, '_maxBindParameters');
+		$property->setAccessible(true);
+		$maxBindParameters = $property->getValue($db);
+		$property->setValue($db, 2);
+
+		$robots = RelationsRobots::find(array('order' => 'id'));
+		$this->assertEquals(count($robots), 3);
+
+		$queries = 0;
+		$di->getShared('modelsManager')->eagerLoad($robots, 'relationsRobotsParts');
+		$this->assertEquals($queries, 2);
+
+		$number = 0;
+		foreach ($robots as $robot) {
+			$number += count($robot->relationsRobotsParts);
+		}
+		$this->assertEquals($number, RelationsRobotsParts::count());
+		$this->assertEquals($queries, 2);
+
+		$property->setValue($db, $maxBindParameters);
+
+		$eventsManager->detachAll('db');
+	}
+
 	protected function _testIssue938($di)
 	{
 		$manager = $di->getShared('modelsManager');
@@ -1037,4 +1037,175 @@ class RouterMvcTest extends PHPUnit\Framework\TestCase
 			$this->assertEquals($router->getActionName(), $paths['action']);
 		}
 	}
+
+	public function testCompiledRouter()
+	{
+		Phalcon\Mvc\Router\Route::reset();
+
+		$di = new Phalcon\Di();
+
+		$di->set('request', function(){
+			return new Phalcon\Http\Request();
+		});
+
+		$router = new Phalcon\Mvc\Router();
+		$router->setDI($di);
+
+		$router->add('/docs/index', array(
+			'controller' => 'documentation2',
+			'action' => 'index'
+		));
+
+		$router->addPost('/docs/index', array(
+			'controller' => 'documentation3',
+			'action' => 'index'
+		));
+
+		$router->addGet('/products/{id:[0-9]+}', array(
+			'controller' => 'products',
+			'action' => 'show'
+		));
+
+		/* A top level alternation can't be indexed by the literals of its first branch */
+		$router->add('#^/reports/daily|/summary$#', array(
+			'controller' => 'reports',
+			'action' => 'daily'
+		));
+
+		$router->compile();
+
+		$tests = array(
+			array(
+				'method' => 'GET',
+				'uri' => '/summary',
+				'controller' => 'reports',
+				'action' => 'daily',
+				'params' => array()
+			),
+			array(
+				'method' => 'GET',
+				'uri' => '/docs/index',
+				'controller' => 'documentation2',
+				'action' => 'index',
+				'params' => array()
+			),
+			array(
+				'method' => 'POST',
+				'uri' => '/docs/index',
+				'controller' => 'documentation3',
+				'action' => 'index',
+				'params' => array()
+			),
+			array(
+				'method' => 'GET',
+				'uri' => '/products/10',
+				'controller' => 'products',
+				'action' => 'show',
+				'params' => array('id' => 10)
+			),
+			array(
+				'method' => 'POST',
+				'uri' => '/products/10',
+				'controller' => 'products',
+				'action' => '10',
+				'params' => array()
+			),
+			array(
+				'method' => 'GET',
+				'uri' => '/posts/edit',
+				'controller' => 'posts',
+				'action' => 'edit',
+				'params' => array()
+			),
+		);
+
+		foreach ($tests as $n => $test) {
+			$_SERVER['REQUEST_METHOD'] = $test['method'];
+			$this->_runTest($router, $test);
+		}
+
+		/* Adding routes invalidates the compiled tree */
+		$router->addGet('/products/featured', array(
+			'controller' => 'products',
+			'action' => 'featured'
+		));
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$this->_runTest($router, array(
+			'uri' => '/products/featured',
+			'controller' => 'products',
+			'action' => 'featured',
+			'params' => array()
+		));
+	}
+
+	public function testRouterExport()
+	{
+		Phalcon\Mvc\Router\Route::reset();
+
+		$di = new Phalcon\Di();
+
+		$di->set('request', function(){
+			return new Phalcon\Http\Request();
+		});
+
+		$router = new Phalcon\Mvc\Router(false);
+
+		$router->addGet('/products/{id:[0-9]+}', array(
+			'controller' => 'products',
+			'action' => 'show'
+		))->setName('product');
+
+		$router->addPost('/products', 'Products::create');
+
+		$data = $router->export();
+		$this->assertTrue(is_string($data));
+
+		$router = new Phalcon\Mvc\Router(false);
+		$router->setDI($di);
+		$router->fromCache($data);
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$this->assertTrue($router->handle('/products/5'));
+		$this->assertEquals($router->getControllerName(), 'products');
+		$this->assertEquals($router->getActionName(), 'show');
+		$this->assertEquals($router->getParams(), array('id' => 5));
+
+		$_SERVER['REQUEST_METHOD'] = 'POST';
+		$this->assertTrue($router->handle('/products'));
+		$this->assertEquals($router->getActionName(), 'create');
+
+		$this->assertEquals($router->getRouteByName('product')->getPattern(), '/products/{id:[0-9]+}');
+		$this->assertEquals(count($router->getRoutes()), 2);
+
+		$file = sys_get_temp_dir() . '/phalcon-router-routes.php';
+		$exported = new Phalcon\Mvc\Router(false);
+		$exported->addGet('/products/{id:[0-9]+}', 'Products::show')->setName('product');
+		$this->assertTrue($exported->export($file));
+
+		$cached = new Phalcon\Mvc\Router(false);
+		$cached->setDI($di);
+		$cached->fromCache(require $file);
+		unlink($file);
+
+		$_SERVER['REQUEST_METHOD'] = 'GET';
+		$this->assertTrue($cached->handle('/products/7'));
+		$this->assertEquals($cached->getActionName(), 'show');
+		$this->assertEquals($cached->getParams(), array('id' => 7));
+
+		$router->add('/about', 'About::index');
+		$this->assertEquals($router->getRouteByName('product')->getRouteId(), 0);
+		$this->assertEquals(count($router->getRoutes()), 3);
+
+		$router->add('/x', array('controller' => 'x'))->beforeMatch(function() {
+			return true;
+		});
+
+		try {
+			$router->export();
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\Router\Exception $e) {
+			$this->assertTrue(true);
+		}
+	}
 }
@@ -131,6 +131,47 @@ class ViewCacheTest extends PHPUnit\Framework\TestCase
 		$this->assertEquals($view2->getContent(), $content);
 	}
 
+	public function testCacheStreaming()
+	{
+		$date = date("r");
+
+		$di = $this->_getDi();
+
+		$view = new View();
+		$view->setDI($di);
+		$view->setViewsDir('unit-tests/views/');
+		$view->setVar("date", $date);
+
+		//First hit fills the cache
+		$view->start();
+		$view->cache(true);
+		$view->render('test8', 'index');
+		$view->finish();
+
+		$view->reset();
+		$view->setVar("date", "changed");
+
+		$view->start();
+		$view->cache(true);
+		$view->render('test8', 'index');
+		$view->finish();
+		$content = $view->getContent();
+
+		//A streaming view gets the same cached output and no stale fragments
+		$view = new View();
+		$view->setDI($di);
+		$view->enableStreaming();
+		$view->setViewsDir('unit-tests/views/');
+		$view->setVar("date", "changed");
+
+		$view->start();
+		$view->cache(true);
+		$view->render('test8', 'index');
+		$view->finish();
+		$this->assertEquals(implode('', $view->getContentChunks()), $content);
+		$this->assertEquals($view->getContent(), $content);
+	}
+
 	public function testViewOptions()
 	{
 		$config = array(
@@ -477,4 +477,99 @@ class ViewTest extends PHPUnit\Framework\TestCase
 
 		$this->assertEquals('<html><span>one</span><span>two</span><span>three</span></html>' . PHP_EOL, $view->getContent());
 	}
+
+	public function testPathCache()
+	{
+		$di = new Phalcon\Di();
+
+		$di->set('viewPathsCache', function(){
+			return new Phalcon\Cache\Backend\Memory(new Phalcon\Cache\Frontend\Data());
+		}, true);
+
+		$view = new View(array('pathCache' => array('service' => 'viewPathsCache')));
+		$view->setDI($di);
+		$view->setBasePath(__DIR__.'/../');
+		$view->setViewsDir('unit-tests/views/');
+
+		$view->start();
+		$view->render('test2', 'index');
+		$view->finish();
+		$this->assertEquals($view->getContent(), '<html>here</html>'.PHP_EOL);
+
+		$cache = $di->getShared('viewPathsCache');
+		$keys = $cache->queryKeys();
+		$this->assertEquals(count($keys), 1);
+
+		$paths = $cache->get($keys[0]);
+		$this->assertEquals($paths['r:test2/index'], array('.phtml', __DIR__.'/../unit-tests/views/test2/index.phtml'));
+		$this->assertFalse($paths['r:layouts/test2']);
+
+		// A new view renders from the resolved paths
+		$eventsManager = new Phalcon\Events\Manager();
+
+		$rendered = array();
+		$eventsManager->attach('view:beforeRenderView', function($event, $view, $path) use (&$rendered) {
+			$rendered[] = $path;
+		});
+
+		$view = new View(array('pathCache' => array('service' => 'viewPathsCache')));
+		$view->setDI($di);
+		$view->setEventsManager($eventsManager);
+		$view->setBasePath(__DIR__.'/../');
+		$view->setViewsDir('unit-tests/views/');
+
+		$view->start();
+		$view->render('test2', 'index');
+		$view->finish();
+		$this->assertEquals($view->getContent(), '<html>here</html>'.PHP_EOL);
+		$this->assertEquals($rendered, array(
+			__DIR__.'/../unit-tests/views/test2/index.phtml',
+			__DIR__.'/../unit-tests/views/index.phtml'
+		));
+
+		// Paths resolved by a partial that throws are written back too
+		$view = new View(array('pathCache' => array('service' => 'viewPathsCache')));
+		$view->setDI($di);
+		$view->setBasePath(__DIR__.'/../');
+		$view->setViewsDir('unit-tests/views/');
+
+		try {
+			$view->partial('partials/_missing');
+			$this->assertTrue(false);
+		} catch (Phalcon\Mvc\View\Exception $e) {
+			$this->assertTrue(true);
+		}
+
+		$paths = $cache->get($keys[0]);
+		$this->assertFalse($paths['r:partials/_missing']);
+	}
+
+	public function testStreaming()
+	{
+		$view = new View();
+		$view->enableStreaming();
+		$view->disableLevel(View::LEVEL_MAIN_LAYOUT);
+		$view->setBasePath(__DIR__.'/../');
+		$view->setViewsDir('unit-tests/views/');
+
+		$this->assertTrue($view->isStreaming());
+
+		$view->start();
+		$view->render('test16', 'index');
+		$view->finish();
+
+		$this->assertEquals($view->getContentChunks(), array('<div>', '<p>here</p>'.PHP_EOL, '</div>'.PHP_EOL));
+		$this->assertEquals($view->getContent(), '<div><p>here</p>'.PHP_EOL.'</div>'.PHP_EOL);
+
+		// Templates using getContent() still work while streaming
+		$view = new View();
+		$view->enableStreaming();
+		$view->setBasePath(__DIR__.'/../');
+		$view->setViewsDir('unit-tests/views/');
+
+		$view->start();
+		$view->render('test2', 'index');
+		$view->finish();
+		$this->assertEquals($view->getContent(), '<html>here</html>'.PHP_EOL);
+	}
 }
@@ -15,4 +15,9 @@ class Personas extends \Phalcon\Mvc\Model
 		$this->useDynamicUpdate(true);
 	}
 
+	public function appendToNombres($suffix)
+	{
+		$this->nombres = $this->nombres . $suffix;
+	}
+
 }
\ No newline at end of file